@@ -38,6 +38,16 @@ inconvenience this causes.
 </p>
 
 <ol>
+  <li> Changed: Triangulation::execute_coarsening_and_refinement() now asks
+  the manifolds for the midpoints of refined lines and the centers of
+  refined cells from several threads at once. Classes derived from Manifold
+  whose get_new_point_on_line(), get_new_point() or project_to_manifold()
+  functions modify mutable member variables now need to protect them, for
+  example by a Threads::Mutex.
+  <br>
+  (agent, 2026/10/19)
+  </li>
+
   <li> Removed: Functions with names containing <code>boundary_indicator</code>
   have been removed. They had previously already been deprecated, and replaced
   by functions containing the string <code>boundary_id</code> instead, to keep
@@ -94,6 +104,241 @@ inconvenience this causes.
 
 
 <ol>
+  <li> Improved: IndexSet now builds lookup tables for the ranges of
+  compressed sets with many ranges, making is_element(),
+  index_within_set() and nth_index_in_set() faster. The functions
+  DoFTools::extract_locally_active_dofs(),
+  DoFTools::extract_locally_relevant_dofs() and
+  DoFTools::extract_locally_relevant_level_dofs() now collect the
+  indices on several threads. The lookup tables are not stored by
+  IndexSet::serialize(), so the format of archives is unchanged.
+  <br>
+  (agent, 2026/10/19)
+  </li>
+
+ <li> Improved: If deal.II is configured with 64-bit indices, DoFHandler
+ stores the cached DoF indices of cells as 32-bit offsets to the smallest
+ index of each level whenever the range of indices allows this. This halves
+ the memory of the cache on each processor of a parallel computation and the
+ amount of data DoFCellAccessor::get_dof_indices() and related functions
+ read. Archives always contain the uncompressed cache. As a side
+ effect, DoFCellAccessor::get_dof_values() with a ConstraintMatrix argument
+ now compiles.
+ <br>
+ (agent, 2026/10/19)
+ </li>
+
+ <li> Improved: DoFTools::make_hanging_node_constraints() computes the
+ constraints for a DoFHandler with a single element from per-subface
+ templates that are set up once, and treats the cells in parallel. The new
+ function ConstraintMatrix::add_constraint() adds a complete constraint
+ for one degree of freedom at once.
+ <br>
+ (agent, 2026/10/19)
+ </li>
+
+ <li> Improved: DoFTools::make_sparsity_pattern() and
+ DoFTools::make_flux_sparsity_pattern() for a single DoFHandler now compute
+ the entries of the cells in parallel. For DynamicSparsityPattern and
+ BlockDynamicSparsityPattern, each task sorts the entries of its cells into
+ blocks of rows, and these blocks are then added to the sparsity pattern in
+ parallel. The cells are worked on in chunks of bounded size, so the
+ additional memory does not grow with the mesh. Other sparsity pattern types get the entries one cell after the
+ other. The resulting sparsity pattern is the same as before.
+ <br>
+ (agent, 2026/10/19)
+ </li>
+
+ <li> New: DoFRenumbering::cell_wise_locality() numbers the degrees of
+ freedom cell by cell, with the cells ordered along a space-filling curve,
+ to improve the memory locality of loops over cells. The new function
+ DoFTools::average_cell_dof_index_span() measures how close to each other
+ the indices on a cell are.
+ <br>
+ (agent, 2026/10/19)
+ </li>
+
+  <li> New: The class DoFTools::CellColoring colors the locally owned active
+  cells of a DoFHandler so that no two cells of one color share a degree of
+  freedom, also through a ConstraintMatrix. It keeps the coloring until the
+  mesh changes or a cell writes into other rows than before, for example
+  because the degrees of freedom were redistributed or the constraints
+  changed. Its function DoFTools::CellColoring::run() calls WorkStream::run()
+  on the colors, so the copier runs concurrently within each color.
+  <br>
+  (agent, 2026/10/19)
+  </li>
+
+  <li> New: There is now a version of
+  ConstraintMatrix::distribute_local_to_global() that takes the local
+  matrices, vectors and dof indices of many cells at once. It resolves the
+  constraints of all cells in parallel and then writes the entries into the
+  global matrix and vector with threads working on different ranges of rows.
+  <br>
+  (agent, 2026/10/19)
+  </li>
+
+  <li> Improved: ConstraintMatrix::close() now also stores the entries of
+  all constraint lines in one contiguous array. ConstraintMatrix::distribute(),
+  the ConstraintMatrix::distribute_local_to_global() functions and
+  ConstraintMatrix::get_dof_values() read the constraints from there instead
+  of from the separately allocated entries of each line.
+  <br>
+  (agent, 2026/10/19)
+  </li>
+
+  <li> Improved: ConstraintMatrix::close() now orders the constraint lines
+  by the length of the chains of constraints starting at them and resolves
+  each line exactly once, treating lines of the same chain length in
+  parallel. It also detects cycles in the constraints in release mode.
+  ConstraintMatrix::merge() into a closed object only sorts in the new
+  lines and only resolves the lines it adds or changes, rather than closing
+  the whole object again.
+  <br>
+  (agent, 2026/10/19)
+  </li>
+
+Improved: DoFHandler::distribute_dofs() now numbers the degrees of freedom
+in parallel on chunks of cells, and DoFHandler::renumber_dofs() updates the
+stored indices and the cell caches in parallel. The resulting numbering is
+the same as before and does not depend on the number of threads.
+
+Improved: parallel::distributed::Triangulation::load() now reads the
+<tt>.info</tt> file written by save() only on the first processor and
+broadcasts its contents, rather than opening the file on every processor.
+
+Improved: parallel::distributed::Triangulation now collects the cell weights
+for a weighted repartitioning (see the Triangulation::Signals::cell_weight
+signal) in a single pass over the locally owned quadrants, rather than by a
+binary search for each cell.
+
+  <li> Improved: GridReordering now finds the edges of 3d meshes with a
+  hash table of compact integer keys instead of a std::map, and stores the
+  cells adjacent to each edge in a single compressed array. The check
+  whether a 2d mesh is already consistently oriented sorts integer keys
+  instead of filling a std::set. Together, this makes setting up large
+  coarse meshes considerably faster and less memory intensive.
+  <br>
+  (agent, 2026/10/19)
+  </li>
+
+  <li> Improved: GridIn::read_msh() and GridIn::read_ucd() have new
+  overloads that take a file name. They map the file into memory, split
+  the lists of vertices and cells into lines, and parse these lines in
+  parallel without using locale-dependent stream input. They require that
+  every vertex and cell is given on a line of its own. GridIn::read() uses
+  them for files in these formats and falls back to the unchanged
+  functions that read from a stream if they fail.
+  <br>
+  (agent, 2026/10/19)
+  </li>
+
+  <li> New: GridOut::write_binary() and GridIn::read_binary() write and read
+  meshes in a binary format that stores vertices, cells, and boundary and
+  manifold ids in contiguous arrays. Reading such a file requires no
+  parsing, maps the file into memory where possible, and skips the
+  reordering of cells for meshes written by deal.II.
+  <br>
+  (agent, 2026/10/19)
+  </li>
+
+  <li> Improved: The <tt>*_list</tt> functions of Functions::FEFieldFunction
+  now locate the points in parallel with a per-thread cell hint and a
+  GridTools::Cache, group them by cell without searching all remaining
+  points for each cell, and evaluate the cells in parallel with one FEValues
+  object per cell.
+  <br>
+  (agent, 2026/10/19)
+  </li>
+
+  <li> New: GridTools::Cache stores a tree of the bounding boxes of the
+  active cells of a triangulation and uses it to find the cells around
+  points in ${\cal O}(\log N)$ operations, also for many points at once on
+  several threads. Functions::FEFieldFunction now uses it to locate points,
+  and there are new versions of VectorTools::point_value() that take a
+  GridTools::Cache object.
+  <br>
+  (agent, 2026/10/19)
+  </li>
+
+  <li> Improved: The internal flags that store whether a cell, face, or edge
+  of a triangulation is used, whether its user flag is set, and whether a
+  cell is flagged for coarsening are now stored as one byte per object rather
+  than in bit-packed <code>std::vector&lt;bool&gt;</code> arrays. This makes
+  the checks done by every iterator increment and accessor query cheaper.
+  Furthermore, the active cell index, the subdomain id and the refinement
+  and coarsening flags of a cell are now stored next to each other rather
+  than in four separate arrays, since loops over the active cells typically
+  ask for several of them. The new benchmark in
+  <code>tests/benchmarks/test_traversal</code> times such loops.
+  <br>
+  (agent, 2026/10/19)
+  </li>
+
+  <li> Improved: Triangulation::execute_coarsening_and_refinement() now
+  computes the locations of the new vertices at the midpoints of refined
+  lines in parallel in 2d and 3d, after the lines have been refined. The
+  new vertices at the centers of isotropically refined cells in 2d and
+  hexes in 3d are likewise computed in parallel before the children are
+  created. For curved manifolds, asking the manifold for new points is the
+  most expensive part of refinement. The resulting mesh is the same as
+  before. Manifold::get_new_point_on_line() and the functions it calls may
+  therefore now be called concurrently from several threads, see the
+  section on thread safety in the documentation of the Manifold class.
+  <br>
+  (agent, 2026/10/19)
+  </li>
+
+  <li> New: Quadrature::is_tensor_product() and Quadrature::get_tensor_basis()
+  tell whether a quadrature formula is the tensor product of one-dimensional
+  formulas (as for QGauss, QGaussLobatto, QIterated, QAnisotropic and the
+  other formulas built by tensor products) and return these formulas. The
+  new function TensorProductPolynomials::compute() that takes such a
+  quadrature formula only evaluates the one-dimensional polynomials on the
+  one-dimensional points and is used by FE_Poly, e.g. for FE_Q and FE_DGQ,
+  to set up the shape function tables on cells.
+  <br>
+  (agent, 2026/10/19)
+  </li>
+
+  <li> New: hp::FEValues, hp::FEFaceValues and hp::FESubfaceValues can now
+  create their FE*Values objects for all combinations of indices up front
+  through precalculate_fe_values(). Copies of these classes, such as the
+  scratch data objects WorkStream::run() creates for every thread, no longer
+  share the FE*Values objects with the original but set up their own ones
+  for all index combinations that were set up in the original, in parallel.
+  Assigning these objects to each other is no longer allowed.
+  <br>
+  (agent, 2026/10/19)
+  </li>
+
+  <li> New: FEEvaluation::submit_hessian() and a third argument to
+  FEEvaluation::integrate() allow to test by the second derivatives of the
+  basis functions in matrix-free operator evaluation, the counterpart of
+  FEEvaluation::get_hessian(). On curved cells, the contribution of the
+  derivative of the Jacobian is added to the integration of gradients.
+  <br>
+  (agent, 2026/10/19)
+  </li>
+
+ <li> New: There is now a variant of FETools::compute_embedding_matrices()
+ that computes the embedding matrices for a single RefinementCase. FE_Nedelec,
+ FE_RaviartThomas and FE_DGQ use it to compute their prolongation matrices
+ separately for each refinement case upon first request, so that programs
+ using only isotropic refinement no longer pay for the anisotropic ones.
+ <br>
+ (agent, 2026/10/19)
+ </li>
+
+ <li> Improved: FE_RaviartThomas now computes its embedding and restriction
+ matrices upon the first request to get_prolongation_matrix() or
+ get_restriction_matrix() rather than in the constructor, as was already
+ done for FE_Q and FE_Nedelec. This makes the construction of high order
+ elements considerably cheaper in programs that never use these matrices.
+ <br>
+ (agent, 2026/10/19)
+ </li>
+
  <li> New: Add NURBSPatchManifold. This class is a child of ChartManifold and
  implements a manifold descriptor for the face of a CAD imported usign 
  OpenCASCADE.
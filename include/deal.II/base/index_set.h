@@ -60,6 +60,16 @@ DEAL_II_NAMESPACE_OPEN
  * in the
  * @ref distributed_paper "Distributed Computing paper".
  *
+ * Looking up an index with is_element(), index_within_set(), or
+ * nth_index_in_set() takes constant time if the index lies in the largest
+ * range of the set. For index sets that consist of many ranges, such as the
+ * locally relevant degrees of freedom of a parallel computation whose ghost
+ * degrees of freedom are scattered over the index space, compress() also
+ * sets up two tables that divide the index space and the numbers of the
+ * elements into buckets with about one range each. Lookups of other indices
+ * then only search the few ranges of one bucket, instead of doing a binary
+ * search over all ranges.
+ *
  * @author Wolfgang Bangerth, 2009
  */
 class IndexSet
@@ -781,10 +791,75 @@ private:
    */
   mutable size_type largest_range;
 
+  /**
+   * The number of ranges from which on do_compress() sets up the lookup
+   * tables #index_buckets and #nth_index_buckets. For fewer ranges, a binary
+   * search over all ranges is about as fast.
+   */
+  static const unsigned int n_ranges_for_lookup_tables = 32;
+
+  /**
+   * A table for finding the range an index belongs to. The indices from the
+   * first index of the first range to the last index of the last range are
+   * divided into buckets of <tt>2^index_bucket_shift</tt> indices, and
+   * element @p b of this table is the number of the first range that ends
+   * after the first index of bucket @p b. The last element of the table is
+   * the number of the last range. The range an index of bucket @p b belongs
+   * to, if any, is therefore one of the ranges between the elements @p b and
+   * @p b+1 of the table.
+   *
+   * The table is empty if the set has fewer than n_ranges_for_lookup_tables
+   * ranges, or if it is not compressed.
+   */
+  mutable std::vector<unsigned int> index_buckets;
+
+  /**
+   * The same as #index_buckets, but for the numbers
+   * <tt>0...n_elements()-1</tt> of the elements of the set as used by
+   * nth_index_in_set(): element @p b is the number of the first range that
+   * contains or follows element number <tt>b*2^nth_index_bucket_shift</tt>.
+   */
+  mutable std::vector<unsigned int> nth_index_buckets;
+
+  /**
+   * The base 2 logarithm of the number of indices in each bucket of
+   * #index_buckets.
+   */
+  mutable unsigned int index_bucket_shift;
+
+  /**
+   * The base 2 logarithm of the number of elements in each bucket of
+   * #nth_index_buckets.
+   */
+  mutable unsigned int nth_index_bucket_shift;
+
   /**
    * Actually perform the compress() operation.
    */
   void do_compress() const;
+
+  /**
+   * Set up #index_buckets and #nth_index_buckets, or clear them if the set
+   * has too few ranges. Called by do_compress() and when loading a set from
+   * an archive in serialize().
+   */
+  void compute_lookup_tables () const;
+
+  /**
+   * Return the first range that ends after @p index, using #index_buckets.
+   * The table needs to be set up, and @p index needs to lie between the
+   * first index of the first range and the last index of the last range.
+   */
+  std::vector<Range>::const_iterator
+  find_range_by_index (const size_type index) const;
+
+  /**
+   * Return the range that contains element number @p n of the set, using
+   * #nth_index_buckets. The table needs to be set up, and @p n needs to be
+   * less than n_elements().
+   */
+  std::vector<Range>::const_iterator
+  find_range_by_nth_index (const size_type n) const;
 };
 
 
@@ -1203,7 +1278,9 @@ IndexSet::IndexSet ()
   :
   is_compressed (true),
   index_space_size (0),
-  largest_range (numbers::invalid_unsigned_int)
+  largest_range (numbers::invalid_unsigned_int),
+  index_bucket_shift (0),
+  nth_index_bucket_shift (0)
 {}
 
 
@@ -1213,7 +1290,9 @@ IndexSet::IndexSet (const size_type size)
   :
   is_compressed (true),
   index_space_size (size),
-  largest_range (numbers::invalid_unsigned_int)
+  largest_range (numbers::invalid_unsigned_int),
+  index_bucket_shift (0),
+  nth_index_bucket_shift (0)
 {}
 
 
@@ -1224,6 +1303,8 @@ IndexSet::clear ()
 {
   ranges.clear ();
   largest_range = 0;
+  index_buckets.clear ();
+  nth_index_buckets.clear ();
   is_compressed = true;
 }
 
@@ -1312,6 +1393,44 @@ IndexSet::add_indices (const ForwardIterator &begin,
 
 
 
+inline
+std::vector<IndexSet::Range>::const_iterator
+IndexSet::find_range_by_index (const size_type index) const
+{
+  Assert (index_buckets.size() > 0, ExcInternalError());
+  Assert (index >= ranges.front().begin && index < ranges.back().end,
+          ExcInternalError());
+
+  // the range we look for is between the first ranges of this bucket and
+  // of the next one
+  const size_type bucket = (index - ranges.front().begin) >> index_bucket_shift;
+  Assert (bucket+1 < index_buckets.size(), ExcInternalError());
+  return Utilities::lower_bound (ranges.begin() + index_buckets[bucket],
+                                 ranges.begin() + index_buckets[bucket+1] + 1,
+                                 Range (index+1, index+1),
+                                 Range::end_compare);
+}
+
+
+
+inline
+std::vector<IndexSet::Range>::const_iterator
+IndexSet::find_range_by_nth_index (const size_type n) const
+{
+  Assert (nth_index_buckets.size() > 0, ExcInternalError());
+
+  const size_type bucket = n >> nth_index_bucket_shift;
+  Assert (bucket+1 < nth_index_buckets.size(), ExcInternalError());
+  Range r (n,n+1);
+  r.nth_index_in_set = n;
+  return Utilities::lower_bound (ranges.begin() + nth_index_buckets[bucket],
+                                 ranges.begin() + nth_index_buckets[bucket+1] + 1,
+                                 r,
+                                 Range::nth_index_compare);
+}
+
+
+
 inline
 bool
 IndexSet::is_element (const size_type index) const
@@ -1326,6 +1445,15 @@ IndexSet::is_element (const size_type index) const
           index < ranges[largest_range].end)
         return true;
 
+      // for sets with many ranges, only search the ranges of the bucket
+      // the index falls into
+      if (index_buckets.size() > 0)
+        {
+          if (index < ranges.front().begin || index >= ranges.back().end)
+            return false;
+          return (find_range_by_index (index)->begin <= index);
+        }
+
       // get the element after which we would have to insert a range that
       // consists of all elements from this element to the end of the index
       // range plus one. after this call we know that if p!=end() then
@@ -1443,6 +1571,13 @@ IndexSet::nth_index_in_set (const unsigned int n) const
       n<main_range->nth_index_in_set+(main_range->end-main_range->begin))
     return main_range->begin + (n-main_range->nth_index_in_set);
 
+  if (nth_index_buckets.size() > 0)
+    {
+      const std::vector<Range>::const_iterator p = find_range_by_nth_index (n);
+      Assert (p != ranges.end(), ExcInternalError());
+      return p->begin + (n-p->nth_index_in_set);
+    }
+
   // find out which chunk the local index n belongs to by using a binary
   // search. the comparator is based on the end of the ranges. Use the
   // position relative to main_range to subdivide the ranges
@@ -1487,6 +1622,14 @@ IndexSet::index_within_set (const size_type n) const
   if (n >= main_range->begin && n < main_range->end)
     return (n-main_range->begin) + main_range->nth_index_in_set;
 
+  if (index_buckets.size() > 0)
+    {
+      const std::vector<Range>::const_iterator p = find_range_by_index (n);
+      Assert(p->begin<=n, ExcInternalError());
+      Assert(n<p->end, ExcInternalError());
+      return (n-p->begin) + p->nth_index_in_set;
+    }
+
   Range r(n, n);
   std::vector<Range>::const_iterator range_begin, range_end;
   if (n<main_range->begin)
@@ -1603,6 +1746,19 @@ void
 IndexSet::serialize (Archive &ar, const unsigned int)
 {
   ar &ranges &is_compressed &index_space_size &largest_range;
+
+  // the lookup tables are not stored, so that the format of archives does
+  // not depend on them. rebuild them after loading instead
+  if (Archive::is_loading::value)
+    {
+      if (is_compressed)
+        compute_lookup_tables ();
+      else
+        {
+          index_buckets.clear ();
+          nth_index_buckets.clear ();
+        }
+    }
 }
 
 DEAL_II_NAMESPACE_CLOSE
@@ -20,6 +20,8 @@
 #include <deal.II/base/config.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/subscriptor.h>
+#include <deal.II/base/std_cxx11/array.h>
+#include <deal.II/base/std_cxx11/shared_ptr.h>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -196,6 +198,31 @@ public:
    */
   const std::vector<double> &get_weights () const;
 
+  /**
+   * Return whether this quadrature formula is the tensor product of
+   * one-dimensional formulas. This is the case for all formulas in 1d, for
+   * formulas built by the constructors above that take lower-dimensional
+   * formulas as arguments (which is how QGauss, QGaussLobatto, QIterated and
+   * most other formulas in higher dimensions are constructed), and for
+   * QAnisotropic. The quadrature points of such a formula are ordered
+   * lexicographically with the first coordinate running fastest.
+   *
+   * Functions evaluating the shape functions of tensor product elements can
+   * use this information to only evaluate the one-dimensional polynomials on
+   * the points of the one-dimensional formulas.
+   */
+  bool is_tensor_product () const;
+
+  /**
+   * Return the one-dimensional formulas whose tensor product constitutes the
+   * present formula, with the formula in the <i>d</i>th coordinate direction
+   * in the <i>d</i>th entry.
+   *
+   * @pre This function may only be called if is_tensor_product() returns
+   * true.
+   */
+  std_cxx11::array<Quadrature<1>,dim> get_tensor_basis () const;
+
   /**
    * Determine an estimate for the memory consumption (in bytes) of this
    * object.
@@ -221,6 +248,21 @@ protected:
    * constructors of derived classes.
    */
   std::vector<double>      weights;
+
+  /**
+   * Whether this formula is the tensor product of one-dimensional formulas,
+   * see is_tensor_product(). Derived classes that rearrange the points of a
+   * tensor product formula need to reset this flag.
+   */
+  bool is_tensor_product_flag;
+
+  /**
+   * The one-dimensional formulas this formula is the tensor product of, if
+   * is_tensor_product_flag is set and <tt>dim>1</tt>. The formulas are held
+   * through a pointer because Quadrature<1> is an incomplete type within
+   * its own declaration.
+   */
+  std_cxx11::shared_ptr<std_cxx11::array<Quadrature<1>,dim> > tensor_basis;
 };
 
 
@@ -369,6 +411,16 @@ Quadrature<dim>::get_weights () const
 
 
 
+template <int dim>
+inline
+bool
+Quadrature<dim>::is_tensor_product () const
+{
+  return is_tensor_product_flag;
+}
+
+
+
 template <int dim>
 template <class Archive>
 inline
@@ -380,6 +432,14 @@ Quadrature<dim>::serialize (Archive &ar, const unsigned int)
   ar   &static_cast<Subscriptor &>(*this);
 
   ar &quadrature_points &weights;
+
+  // the one-dimensional formulas are not stored, so a formula read from an
+  // archive is only known to be a tensor product in 1d
+  if (Archive::is_loading::value)
+    {
+      is_tensor_product_flag = (dim == 1);
+      tensor_basis.reset ();
+    }
 }
 
 
@@ -403,6 +463,10 @@ Quadrature<1>::Quadrature (const Quadrature<0> &,
 template <>
 Quadrature<1>::Quadrature (const Quadrature<0> &);
 
+template <>
+std_cxx11::array<Quadrature<1>,1>
+Quadrature<1>::get_tensor_basis () const;
+
 #endif // DOXYGEN
 DEAL_II_NAMESPACE_CLOSE
 
@@ -28,6 +28,9 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+template <int dim> class Quadrature;
+template <int N, typename T> class Table;
+
 /**
  * @addtogroup Polynomials
  * @{
@@ -119,6 +122,28 @@ public:
                 std::vector<Tensor<3,dim> > &third_derivatives,
                 std::vector<Tensor<4,dim> > &fourth_derivatives) const;
 
+  /**
+   * Computes the values and the first, second, and third derivatives of all
+   * tensor product polynomials on all points of @p quadrature, which must be
+   * the tensor product of one-dimensional formulas (see
+   * Quadrature::is_tensor_product()). The first index of the output tables
+   * denotes the polynomial and the second one the quadrature point.
+   *
+   * The tables must either have zero rows or be of size n() times
+   * <tt>quadrature.size()</tt>. In the first case, the function will not
+   * compute these values.
+   *
+   * The result is the same as the one of calling the compute() function
+   * above on each quadrature point, but the one-dimensional polynomials are
+   * only evaluated on the points of the one-dimensional formulas rather than
+   * on every point of the tensor product formula.
+   */
+  void compute (const Quadrature<dim>   &quadrature,
+                Table<2,double>         &values,
+                Table<2,Tensor<1,dim> > &grads,
+                Table<2,Tensor<2,dim> > &grad_grads,
+                Table<2,Tensor<3,dim> > &third_derivatives) const;
+
   /**
    * Computes the value of the <tt>i</tt>th tensor product polynomial at
    * <tt>unit_point</tt>. Here <tt>i</tt> is given in tensor product
@@ -655,6 +655,12 @@ namespace parallel
        * computation on a shared network file system. See the SolutionTransfer
        * class on how to store solution vectors into this file. Additional
        * cell-based data can be saved using register_data_attach().
+       *
+       * The forest and the data attached to its cells, which use the same
+       * number of bytes on every cell, are written collectively by all
+       * processors into a single file. (p4est uses MPI-IO for this purpose
+       * if it has been configured with it.) In addition, the first processor
+       * writes a small file with the ending <tt>.info</tt>.
        */
       void save(const char *filename) const;
 
@@ -668,7 +674,9 @@ namespace parallel
        * of MPI processes than used at the time of saving, the mesh is
        * repartitioned appropriately. Cell-based data that was saved with
        * register_data_attach() can be read in with notify_ready_to_unpack()
-       * after calling load().
+       * after calling load(). Only the first processor reads the
+       * <tt>.info</tt> file written by save() and sends its contents to all
+       * other processors.
        *
        * If you use p4est version > 0.3.4.2 the @p autopartition flag tells
        * p4est to ignore the partitioning that the triangulation had when it
@@ -935,6 +943,15 @@ namespace parallel
       std::vector<unsigned int>
       get_cell_weights();
 
+      /**
+       * Partition the forest between all processors. If functions are
+       * connected to the cell_weight signal, the weights returned by
+       * get_cell_weights() are balanced, otherwise the number of cells.
+       * Called from execute_coarsening_and_refinement() and repartition().
+       */
+      void
+      partition_forest ();
+
       /**
        * Fills a map that, for each vertex, lists all the processors whose
        * subdomains are adjacent to that vertex. Used by
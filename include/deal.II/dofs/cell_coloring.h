@@ -0,0 +1,274 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii__cell_coloring_h
+#define dealii__cell_coloring_h
+
+
+#include <deal.II/base/config.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/types.h>
+#include <deal.II/base/work_stream.h>
+#include <deal.II/lac/constraint_matrix.h>
+
+#include <boost/signals2/connection.hpp>
+
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace DoFTools
+{
+  /**
+   * A coloring of the locally owned active cells of a DoFHandler such that
+   * no two cells of the same color write into the same rows of a global
+   * matrix or vector, together with a function that runs an assembly loop
+   * on these colors.
+   *
+   * Two cells are in conflict if they share a degree of freedom, or if
+   * degrees of freedom of the two cells are constrained to a common degree
+   * of freedom by the ConstraintMatrix given to the constructor. The latter
+   * is necessary because ConstraintMatrix::distribute_local_to_global()
+   * writes the contributions of constrained degrees of freedom into the
+   * rows of the degrees of freedom they are constrained to. The coloring
+   * itself is computed by GraphColoring::make_graph_coloring().
+   *
+   * Since all cells of one color can write their contributions into the
+   * global objects at the same time, the run() function of this class calls
+   * the copier concurrently within each color, using the version of
+   * WorkStream::run() that takes colored iterators. This removes the
+   * serialized copier of the other versions of WorkStream::run(), at the
+   * cost of less parallelism when there are only few cells of one color.
+   *
+   * Computing the coloring takes about as long as one assembly of a simple
+   * matrix, so this class keeps it between calls. It is computed the first
+   * time it is needed and recomputed after the triangulation of the
+   * DoFHandler has changed (for example through refinement), or when the
+   * indices a cell writes into, i.e. its degrees of freedom and the ones
+   * they are constrained to, are no longer the ones the coloring was
+   * computed for. To find out about the latter, the class stores these
+   * indices for all cells and compares them with the current ones every
+   * time the coloring is requested. This costs about as much as one call to
+   * DoFCellAccessor::get_dof_indices() and ConstraintMatrix::resolve_indices()
+   * per cell, and as much memory as the DoF indices of all cells.
+   *
+   * The class only stores pointers to the DoFHandler and the
+   * ConstraintMatrix, so both need to live longer than the object of this
+   * class.
+   */
+  template <typename DoFHandlerType>
+  class CellColoring : public Subscriptor
+  {
+  public:
+    /**
+     * A typedef for the iterators to the cells that are colored.
+     */
+    typedef typename DoFHandlerType::active_cell_iterator active_cell_iterator;
+
+    /**
+     * Constructor. Only the degrees of freedom shared between cells
+     * determine the coloring.
+     */
+    CellColoring (const DoFHandlerType &dof_handler);
+
+    /**
+     * Constructor. The degrees of freedom shared between cells, and the ones
+     * the degrees of freedom of the cells are constrained to by @p
+     * constraints determine the coloring.
+     */
+    CellColoring (const DoFHandlerType   &dof_handler,
+                  const ConstraintMatrix &constraints);
+
+    /**
+     * Copy constructor. The new object computes its own coloring when it is
+     * first needed.
+     */
+    CellColoring (const CellColoring<DoFHandlerType> &coloring);
+
+    /**
+     * Destructor.
+     */
+    ~CellColoring ();
+
+    /**
+     * Make sure the coloring is recomputed the next time it is needed. This
+     * is not necessary after changes of the mesh, the degrees of freedom or
+     * the constraints, since the class detects these itself.
+     */
+    void mark_for_update ();
+
+    /**
+     * Return the colors of the locally owned active cells. Each element of
+     * the returned vector contains the cells of one color.
+     *
+     * The coloring is returned by value, since another thread may recompute
+     * the coloring stored in this object while the caller still uses the
+     * returned one.
+     */
+    std::vector<std::vector<active_cell_iterator> >
+    get_coloring () const;
+
+    /**
+     * Run @p worker on all locally owned active cells and @p copier on the
+     * results, using WorkStream::run() on the colors returned by
+     * get_coloring(). See there for the meaning of the arguments. Cells of
+     * different colors are never worked on at the same time, and within a
+     * color the copier runs concurrently on different cells.
+     */
+    template <typename Worker,
+              typename Copier,
+              typename ScratchData,
+              typename CopyData>
+    void
+    run (Worker             worker,
+         Copier             copier,
+         const ScratchData &sample_scratch_data,
+         const CopyData    &sample_copy_data,
+         const unsigned int queue_length = 2*MultithreadInfo::n_threads(),
+         const unsigned int chunk_size = 8) const;
+
+    /**
+     * Return the DoFHandler whose cells are colored.
+     */
+    const DoFHandlerType &get_dof_handler () const;
+
+    /**
+     * Determine an estimate for the memory consumption (in bytes) of this
+     * object.
+     */
+    std::size_t memory_consumption () const;
+
+  private:
+    /**
+     * Since objects of this class are not copyable, we make the assignment
+     * operator private, and also do not implement it.
+     */
+    CellColoring &operator = (const CellColoring<DoFHandlerType> &);
+
+    /**
+     * Return the indices of the rows the contributions of @p cell are
+     * written into. Used as the conflict function for
+     * GraphColoring::make_graph_coloring().
+     */
+    std::vector<types::global_dof_index>
+    get_conflict_indices (const active_cell_iterator &cell) const;
+
+    /**
+     * Return whether the conflict indices of all active cells are still the
+     * ones stored in #conflict_indices_of_coloring.
+     */
+    bool conflict_indices_are_unchanged () const;
+
+    /**
+     * Store the conflict indices of all active cells in
+     * #conflict_indices_of_coloring.
+     */
+    void store_conflict_indices () const;
+
+    /**
+     * Recompute the coloring if necessary. The caller needs to hold the
+     * lock on #mutex.
+     */
+    void update_coloring () const;
+
+    /**
+     * Connect to the signals of the triangulation of the DoFHandler.
+     */
+    void connect_to_triangulation ();
+
+    /**
+     * The DoFHandler whose cells are colored.
+     */
+    SmartPointer<const DoFHandlerType,CellColoring<DoFHandlerType> > dof_handler;
+
+    /**
+     * The constraints that are taken into account, or a null pointer.
+     */
+    SmartPointer<const ConstraintMatrix,CellColoring<DoFHandlerType> > constraints;
+
+    /**
+     * The connection to the triangulation's signal that is triggered by any
+     * change of the mesh.
+     */
+    boost::signals2::connection tria_listener;
+
+    /**
+     * Whether the coloring needs to be recomputed before it is used.
+     */
+    mutable bool update_needed;
+
+    /**
+     * The conflict indices of all active cells at the time the coloring was
+     * computed, one cell after the other, and the number of these indices
+     * for each cell.
+     */
+    mutable std::vector<types::global_dof_index> conflict_indices_of_coloring;
+    mutable std::vector<unsigned int>            n_conflict_indices_of_coloring;
+
+    /**
+     * The colors of the locally owned active cells.
+     */
+    mutable std::vector<std::vector<active_cell_iterator> > coloring;
+
+    /**
+     * A mutex that guards the lazy computation of the coloring.
+     */
+    mutable Threads::Mutex mutex;
+  };
+
+
+
+  /* ----------------- inline and template functions ----------------- */
+
+
+
+  template <typename DoFHandlerType>
+  inline
+  const DoFHandlerType &
+  CellColoring<DoFHandlerType>::get_dof_handler () const
+  {
+    return *dof_handler;
+  }
+
+
+
+  template <typename DoFHandlerType>
+  template <typename Worker,
+            typename Copier,
+            typename ScratchData,
+            typename CopyData>
+  void
+  CellColoring<DoFHandlerType>::run (Worker             worker,
+                                     Copier             copier,
+                                     const ScratchData &sample_scratch_data,
+                                     const CopyData    &sample_copy_data,
+                                     const unsigned int queue_length,
+                                     const unsigned int chunk_size) const
+  {
+    const std::vector<std::vector<active_cell_iterator> > colors = get_coloring();
+    WorkStream::run (colors,
+                     worker, copier,
+                     sample_scratch_data, sample_copy_data,
+                     queue_length, chunk_size);
+  }
+}
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -2430,6 +2430,13 @@ namespace internal
                            dofs_per_line   = accessor.get_fe().dofs_per_line,
                            dofs_per_cell   = accessor.get_fe().dofs_per_cell;
 
+        // the cache can only be written to in its uncompressed
+        // form. the DoFHandler uncompresses it before it updates the
+        // caches of several cells in parallel, so this does nothing
+        // in that case
+        accessor.dof_handler->levels[accessor.present_level]
+        ->uncompress_cell_dof_indices_cache ();
+
         // make sure the cache is at least
         // as big as we need it when
         // writing to the last element of
@@ -2476,6 +2483,13 @@ namespace internal
                            dofs_per_quad   = accessor.get_fe().dofs_per_quad,
                            dofs_per_cell   = accessor.get_fe().dofs_per_cell;
 
+        // the cache can only be written to in its uncompressed
+        // form. the DoFHandler uncompresses it before it updates the
+        // caches of several cells in parallel, so this does nothing
+        // in that case
+        accessor.dof_handler->levels[accessor.present_level]
+        ->uncompress_cell_dof_indices_cache ();
+
         // make sure the cache is at least
         // as big as we need it when
         // writing to the last element of
@@ -2525,6 +2539,13 @@ namespace internal
                            dofs_per_hex    = accessor.get_fe().dofs_per_hex,
                            dofs_per_cell   = accessor.get_fe().dofs_per_cell;
 
+        // the cache can only be written to in its uncompressed
+        // form. the DoFHandler uncompresses it before it updates the
+        // caches of several cells in parallel, so this does nothing
+        // in that case
+        accessor.dof_handler->levels[accessor.present_level]
+        ->uncompress_cell_dof_indices_cache ();
+
         // make sure the cache is at least
         // as big as we need it when
         // writing to the last element of
@@ -2858,6 +2879,76 @@ namespace internal
 
 
 
+      /**
+       * Add the @p n_dofs values starting at @p local_source_begin to the
+       * elements @p dofs of @p global_destination. The vector classes want a
+       * pointer to the indices. If the cache is compressed, the indices are
+       * therefore copied in chunks into a buffer of fixed size.
+       */
+      template <typename ForwardIterator, class OutputVector>
+      static
+      void
+      add_cell_vector (const internal::DoFHandler::CellDoFIndexIterator &dofs,
+                       const unsigned int                                n_dofs,
+                       ForwardIterator                                   local_source_begin,
+                       OutputVector                                     &global_destination)
+      {
+        if (dofs.uncompressed_indices() != 0)
+          {
+            global_destination.add (n_dofs, dofs.uncompressed_indices(),
+                                    local_source_begin);
+            return;
+          }
+
+        const unsigned int chunk_size = 64;
+        types::global_dof_index indices[chunk_size];
+        for (unsigned int begin=0; begin<n_dofs; begin+=chunk_size)
+          {
+            const unsigned int n = std::min (chunk_size, n_dofs-begin);
+            std::copy (dofs+begin, dofs+begin+n, indices);
+            global_destination.add (n, indices, local_source_begin+begin);
+          }
+      }
+
+
+
+      /**
+       * Add @p local_source to the rows and columns @p dofs of
+       * @p global_destination. As in add_cell_vector(), the column indices
+       * of a compressed cache are copied in chunks into a buffer of fixed
+       * size.
+       */
+      template <typename number, class OutputMatrix>
+      static
+      void
+      add_cell_matrix (const internal::DoFHandler::CellDoFIndexIterator &dofs,
+                       const unsigned int                                n_dofs,
+                       const dealii::FullMatrix<number>                 &local_source,
+                       OutputMatrix                                     &global_destination)
+      {
+        if (dofs.uncompressed_indices() != 0)
+          {
+            const types::global_dof_index *indices = dofs.uncompressed_indices();
+            for (unsigned int i=0; i<n_dofs; ++i)
+              global_destination.add(indices[i], n_dofs, indices,
+                                     &local_source(i,0));
+            return;
+          }
+
+        const unsigned int chunk_size = 64;
+        types::global_dof_index indices[chunk_size];
+        for (unsigned int begin=0; begin<n_dofs; begin+=chunk_size)
+          {
+            const unsigned int n = std::min (chunk_size, n_dofs-begin);
+            std::copy (dofs+begin, dofs+begin+n, indices);
+            for (unsigned int i=0; i<n_dofs; ++i)
+              global_destination.add(dofs[i], n, indices,
+                                     &local_source(i,begin));
+          }
+      }
+
+
+
       template <int dim, int spacedim, bool level_dof_access, typename ForwardIterator, class OutputVector>
       static
       void
@@ -2881,11 +2972,12 @@ namespace internal
 
         const unsigned int n_dofs = local_source_end - local_source_begin;
 
-        types::global_dof_index *dofs = &accessor.dof_handler->levels[accessor.level()]
-                                        ->cell_dof_indices_cache[accessor.present_index * n_dofs];
+        const internal::DoFHandler::CellDoFIndexIterator dofs
+          = accessor.dof_handler->levels[accessor.level()]
+            ->get_cell_cache_start (accessor.present_index, n_dofs);
 
         // distribute cell vector
-        global_destination.add(n_dofs, dofs, local_source_begin);
+        add_cell_vector (dofs, n_dofs, local_source_begin, global_destination);
       }
 
 
@@ -2942,8 +3034,9 @@ namespace internal
 
         const unsigned int n_dofs = local_source_end - local_source_begin;
 
-        types::global_dof_index *dofs = &accessor.dof_handler->levels[accessor.level()]
-                                        ->cell_dof_indices_cache[accessor.present_index * n_dofs];
+        const internal::DoFHandler::CellDoFIndexIterator dofs
+          = accessor.dof_handler->levels[accessor.level()]
+            ->get_cell_cache_start (accessor.present_index, n_dofs);
 
         // distribute cell vector
         constraints.distribute_local_to_global (local_source_begin, local_source_end,
@@ -3008,13 +3101,12 @@ namespace internal
 
         const unsigned int n_dofs = local_source.m();
 
-        types::global_dof_index *dofs = &accessor.dof_handler->levels[accessor.level()]
-                                        ->cell_dof_indices_cache[accessor.present_index * n_dofs];
+        const internal::DoFHandler::CellDoFIndexIterator dofs
+          = accessor.dof_handler->levels[accessor.level()]
+            ->get_cell_cache_start (accessor.present_index, n_dofs);
 
         // distribute cell matrix
-        for (unsigned int i=0; i<n_dofs; ++i)
-          global_destination.add(dofs[i], n_dofs, dofs,
-                                 &local_source(i,0));
+        add_cell_matrix (dofs, n_dofs, local_source, global_destination);
       }
 
 
@@ -3082,15 +3174,15 @@ namespace internal
                 ExcMessage ("Cell must be active."));
 
         const unsigned int n_dofs = accessor.get_fe().dofs_per_cell;
-        types::global_dof_index *dofs = &accessor.dof_handler->levels[accessor.level()]
-                                        ->cell_dof_indices_cache[accessor.present_index *n_dofs];
+
+        const internal::DoFHandler::CellDoFIndexIterator dofs
+          = accessor.dof_handler->levels[accessor.level()]
+            ->get_cell_cache_start (accessor.present_index, n_dofs);
 
         // distribute cell matrices
+        add_cell_matrix (dofs, n_dofs, local_matrix, global_matrix);
         for (unsigned int i=0; i<n_dofs; ++i)
-          {
-            global_matrix.add(dofs[i], n_dofs, dofs, &local_matrix(i,0));
-            global_vector(dofs[i]) += local_vector(i);
-          }
+          global_vector(dofs[i]) += local_vector(i);
       }
 
 
@@ -3303,7 +3395,7 @@ DoFCellAccessor<DoFHandlerType,level_dof_access>::get_dof_indices
           ExcMessage ("Can't ask for DoF indices on artificial cells."));
   AssertDimension (dof_indices.size(), this->get_fe().dofs_per_cell);
 
-  const types::global_dof_index *cache
+  internal::DoFHandler::CellDoFIndexIterator cache
     = this->dof_handler->levels[this->present_level]
       ->get_cell_cache_start (this->present_index, this->get_fe().dofs_per_cell);
   for (unsigned int i=0; i<this->get_fe().dofs_per_cell; ++i, ++cache)
@@ -3379,7 +3471,7 @@ DoFCellAccessor<DoFHandlerType,level_dof_access>::get_dof_values
   Assert (values.size() == this->get_dof_handler().n_dofs(),
           typename DoFCellAccessor::ExcVectorDoesNotMatch());
 
-  const types::global_dof_index *cache
+  const internal::DoFHandler::CellDoFIndexIterator cache
     = this->dof_handler->levels[this->present_level]
       ->get_cell_cache_start (this->present_index, this->get_fe().dofs_per_cell);
 
@@ -3412,11 +3504,11 @@ DoFCellAccessor<DoFHandlerType,level_dof_access>::get_dof_values
           typename DoFCellAccessor::ExcVectorDoesNotMatch());
 
 
-  const types::global_dof_index *cache
+  const internal::DoFHandler::CellDoFIndexIterator cache
     = this->dof_handler->levels[this->present_level]
       ->get_cell_cache_start (this->present_index, this->get_fe().dofs_per_cell);
 
-  constraints.get_dof_values(values, *cache, local_values_begin,
+  constraints.get_dof_values(values, cache, local_values_begin,
                              local_values_end);
 }
 
@@ -3442,7 +3534,7 @@ DoFCellAccessor<DoFHandlerType,level_dof_access>::set_dof_values
           typename DoFCellAccessor::ExcVectorDoesNotMatch());
 
 
-  const types::global_dof_index *cache
+  internal::DoFHandler::CellDoFIndexIterator cache
     = this->dof_handler->levels[this->present_level]
       ->get_cell_cache_start (this->present_index, this->get_fe().dofs_per_cell);
 
@@ -20,7 +20,9 @@
 #include <deal.II/base/config.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/types.h>
 #include <deal.II/dofs/dof_objects.h>
+#include <iterator>
 #include <vector>
 
 
@@ -33,6 +35,105 @@ namespace internal
   {
 
 
+    /**
+     * A random access iterator over the cached DoF indices of a cell, as
+     * returned by DoFLevel::get_cell_cache_start(). The iterator either
+     * points into an array of DoF indices, or into an array of 32-bit
+     * offsets to a given DoF index, as stored by a compressed cache. In both
+     * cases, dereferencing the iterator yields the DoF index, so the
+     * iterator can be passed to functions such as
+     * Vector::extract_subvector_to() that take iterators to indices.
+     */
+    class CellDoFIndexIterator : public std::iterator<std::random_access_iterator_tag,
+      types::global_dof_index, std::ptrdiff_t,
+      const types::global_dof_index *,
+      types::global_dof_index>
+    {
+    public:
+      /**
+       * Constructor for an iterator into an array of DoF indices.
+       */
+      explicit
+      CellDoFIndexIterator (const types::global_dof_index *indices);
+
+      /**
+       * Constructor for an iterator into an array of offsets to @p
+       * index_offset. The value numbers::invalid_unsigned_int in this array
+       * denotes an invalid DoF index.
+       */
+      CellDoFIndexIterator (const unsigned int            *compressed_indices,
+                            const types::global_dof_index  index_offset);
+
+      /**
+       * Return the DoF index the iterator points to.
+       */
+      types::global_dof_index operator * () const;
+
+      /**
+       * Return the DoF index @p n elements after the one the iterator points
+       * to.
+       */
+      types::global_dof_index operator [] (const std::ptrdiff_t n) const;
+
+      /**
+       * Prefix and postfix increment and decrement operators.
+       */
+      CellDoFIndexIterator &operator ++ ();
+      CellDoFIndexIterator operator ++ (int);
+      CellDoFIndexIterator &operator -- ();
+      CellDoFIndexIterator operator -- (int);
+
+      /**
+       * Move the iterator by @p n elements.
+       */
+      CellDoFIndexIterator &operator += (const std::ptrdiff_t n);
+      CellDoFIndexIterator &operator -= (const std::ptrdiff_t n);
+      CellDoFIndexIterator operator + (const std::ptrdiff_t n) const;
+      CellDoFIndexIterator operator - (const std::ptrdiff_t n) const;
+
+      /**
+       * Return the number of elements between @p other and this iterator.
+       */
+      std::ptrdiff_t operator - (const CellDoFIndexIterator &other) const;
+
+      /**
+       * Comparison operators.
+       */
+      bool operator == (const CellDoFIndexIterator &other) const;
+      bool operator != (const CellDoFIndexIterator &other) const;
+      bool operator < (const CellDoFIndexIterator &other) const;
+
+      /**
+       * Return a pointer to the DoF index the iterator points to if the
+       * indices are stored uncompressed, and a null pointer otherwise.
+       */
+      const types::global_dof_index *uncompressed_indices () const;
+
+    private:
+      /**
+       * The start of the array of DoF indices, or a null pointer.
+       */
+      const types::global_dof_index *dof_indices;
+
+      /**
+       * The start of the array of offsets, or a null pointer.
+       */
+      const unsigned int *compressed_dof_indices;
+
+      /**
+       * The DoF index the elements of #compressed_dof_indices are relative
+       * to.
+       */
+      types::global_dof_index offset;
+
+      /**
+       * The position of the iterator relative to the start of the array.
+       */
+      std::ptrdiff_t position;
+    };
+
+
+
     /**
      * Structure for storing degree of freedom information for cells,
      * organized by levels.
@@ -43,6 +144,18 @@ namespace internal
      * DoFCellAccessor::update_cell_dof_indices_cache and are used by
      * DoFCellAccessor::get_dof_indices.
      *
+     * Once all values of the cache are set, compress_cell_dof_indices_cache()
+     * replaces the cache by one that stores the indices as 32-bit offsets to
+     * the smallest index found in it, provided that the difference between
+     * the largest and the smallest index fits into 32 bits. This is only
+     * done if deal.II was configured with 64-bit indices, where the
+     * compressed cache needs half the memory of the uncompressed one. The
+     * range of indices typically fits on the processors of a parallel
+     * computation, since each processor only sees the indices of its
+     * locally owned and ghost cells. Iterators of type CellDoFIndexIterator, as returned
+     * by get_cell_cache_start(), hide the format of the cache from the
+     * accessor classes.
+     *
      * Note that vertices are separate from, and in fact have nothing to do
      * with cells. The indices of degrees of freedom located on vertices
      * therefore are not stored here, but rather in member variables of the
@@ -70,30 +183,68 @@ namespace internal
     class DoFLevel
     {
     public:
+      /**
+       * Constructor.
+       */
+      DoFLevel ();
+
       /**
        * Cache for the DoF indices on cells. The size of this array equals the
        * number of cells on a given level times selected_fe.dofs_per_cell.
+       *
+       * This array is empty while the cache is compressed, see
+       * #compressed_cell_dof_indices_cache.
        */
       std::vector<types::global_dof_index> cell_dof_indices_cache;
 
+      /**
+       * The compressed form of #cell_dof_indices_cache. Each element stores
+       * the difference between a DoF index and
+       * #compressed_cell_dof_indices_offset, or numbers::invalid_unsigned_int
+       * for invalid DoF indices. This array is empty unless the cache is
+       * compressed.
+       */
+      std::vector<unsigned int> compressed_cell_dof_indices_cache;
+
+      /**
+       * The offset that is added to the elements of
+       * #compressed_cell_dof_indices_cache to obtain the DoF indices.
+       */
+      types::global_dof_index compressed_cell_dof_indices_offset;
+
       /**
        * The object containing dof-indices and related access-functions
        */
       DoFObjects<dim> dof_object;
 
       /**
-       * Return a pointer to the beginning of the DoF indices cache for a
+       * Return an iterator to the beginning of the DoF indices cache for a
        * given cell.
        *
        * @param obj_index The number of the cell we are looking at.
        * @param dofs_per_cell The number of DoFs per cell for this cell.
-       * @return A pointer to the first DoF index for the current cell. The
+       * @return An iterator to the first DoF index for the current cell. The
        * next dofs_per_cell indices are for the current cell.
        */
-      const types::global_dof_index *
+      CellDoFIndexIterator
       get_cell_cache_start (const unsigned int obj_index,
                             const unsigned int dofs_per_cell) const;
 
+      /**
+       * Store the DoF indices of the cells in the compressed format described
+       * in the documentation of this class, if deal.II was configured with
+       * 64-bit indices and the range of indices allows this. Otherwise,
+       * leave the cache unchanged.
+       */
+      void compress_cell_dof_indices_cache ();
+
+      /**
+       * Undo compress_cell_dof_indices_cache(), so that the cache can be
+       * written to through #cell_dof_indices_cache again. Does nothing if the
+       * cache is not compressed.
+       */
+      void uncompress_cell_dof_indices_cache ();
+
       /**
        * Determine an estimate for the memory consumption (in bytes) of this
        * object.
@@ -111,18 +262,224 @@ namespace internal
 
 
 
-    template <int dim>
+    inline
+    CellDoFIndexIterator::CellDoFIndexIterator (const types::global_dof_index *indices)
+      :
+      dof_indices (indices),
+      compressed_dof_indices (0),
+      offset (0),
+      position (0)
+    {}
+
+
+
+    inline
+    CellDoFIndexIterator::CellDoFIndexIterator (const unsigned int            *compressed_indices,
+                                                const types::global_dof_index  index_offset)
+      :
+      dof_indices (0),
+      compressed_dof_indices (compressed_indices),
+      offset (index_offset),
+      position (0)
+    {}
+
+
+
+    inline
+    types::global_dof_index
+    CellDoFIndexIterator::operator [] (const std::ptrdiff_t n) const
+    {
+      if (dof_indices != 0)
+        return dof_indices[position+n];
+
+      const unsigned int compressed_index = compressed_dof_indices[position+n];
+      return (compressed_index == numbers::invalid_unsigned_int
+              ?
+              numbers::invalid_dof_index
+              :
+              offset + compressed_index);
+    }
+
+
+
+    inline
+    types::global_dof_index
+    CellDoFIndexIterator::operator * () const
+    {
+      return (*this)[0];
+    }
+
+
+
+    inline
+    CellDoFIndexIterator &
+    CellDoFIndexIterator::operator ++ ()
+    {
+      ++position;
+      return *this;
+    }
+
+
+
+    inline
+    CellDoFIndexIterator
+    CellDoFIndexIterator::operator ++ (int)
+    {
+      const CellDoFIndexIterator old_value = *this;
+      ++position;
+      return old_value;
+    }
+
+
+
+    inline
+    CellDoFIndexIterator &
+    CellDoFIndexIterator::operator -- ()
+    {
+      --position;
+      return *this;
+    }
+
+
+
+    inline
+    CellDoFIndexIterator
+    CellDoFIndexIterator::operator -- (int)
+    {
+      const CellDoFIndexIterator old_value = *this;
+      --position;
+      return old_value;
+    }
+
+
+
+    inline
+    CellDoFIndexIterator &
+    CellDoFIndexIterator::operator += (const std::ptrdiff_t n)
+    {
+      position += n;
+      return *this;
+    }
+
+
+
+    inline
+    CellDoFIndexIterator &
+    CellDoFIndexIterator::operator -= (const std::ptrdiff_t n)
+    {
+      position -= n;
+      return *this;
+    }
+
+
+
+    inline
+    CellDoFIndexIterator
+    CellDoFIndexIterator::operator + (const std::ptrdiff_t n) const
+    {
+      CellDoFIndexIterator new_value = *this;
+      new_value.position += n;
+      return new_value;
+    }
+
+
+
+    inline
+    CellDoFIndexIterator
+    CellDoFIndexIterator::operator - (const std::ptrdiff_t n) const
+    {
+      CellDoFIndexIterator new_value = *this;
+      new_value.position -= n;
+      return new_value;
+    }
+
+
+
+    inline
+    std::ptrdiff_t
+    CellDoFIndexIterator::operator - (const CellDoFIndexIterator &other) const
+    {
+      Assert (dof_indices == other.dof_indices &&
+              compressed_dof_indices == other.compressed_dof_indices,
+              ExcInternalError());
+      return position - other.position;
+    }
+
+
+
+    inline
+    bool
+    CellDoFIndexIterator::operator == (const CellDoFIndexIterator &other) const
+    {
+      return (dof_indices == other.dof_indices &&
+              compressed_dof_indices == other.compressed_dof_indices &&
+              position == other.position);
+    }
+
+
+
+    inline
+    bool
+    CellDoFIndexIterator::operator != (const CellDoFIndexIterator &other) const
+    {
+      return !(*this == other);
+    }
+
+
+
+    inline
+    bool
+    CellDoFIndexIterator::operator < (const CellDoFIndexIterator &other) const
+    {
+      Assert (dof_indices == other.dof_indices &&
+              compressed_dof_indices == other.compressed_dof_indices,
+              ExcInternalError());
+      return position < other.position;
+    }
+
+
+
     inline
     const types::global_dof_index *
+    CellDoFIndexIterator::uncompressed_indices () const
+    {
+      return (dof_indices != 0 ? dof_indices + position : 0);
+    }
+
+
+
+    template <int dim>
+    inline
+    DoFLevel<dim>::DoFLevel ()
+      :
+      compressed_cell_dof_indices_offset (0)
+    {}
+
+
+
+    template <int dim>
+    inline
+    CellDoFIndexIterator
     DoFLevel<dim>::get_cell_cache_start (const unsigned int obj_index,
                                          const unsigned int dofs_per_cell) const
     {
+      if (compressed_cell_dof_indices_cache.size() > 0)
+        {
+          Assert (obj_index*dofs_per_cell+dofs_per_cell
+                  <=
+                  compressed_cell_dof_indices_cache.size(),
+                  ExcInternalError());
+
+          return CellDoFIndexIterator (&compressed_cell_dof_indices_cache[obj_index*dofs_per_cell],
+                                       compressed_cell_dof_indices_offset);
+        }
+
       Assert (obj_index*dofs_per_cell+dofs_per_cell
               <=
               cell_dof_indices_cache.size(),
               ExcInternalError());
 
-      return &cell_dof_indices_cache[obj_index*dofs_per_cell];
+      return CellDoFIndexIterator (&cell_dof_indices_cache[obj_index*dofs_per_cell]);
     }
 
 
@@ -133,6 +490,8 @@ namespace internal
     DoFLevel<dim>::memory_consumption () const
     {
       return (MemoryConsumption::memory_consumption (cell_dof_indices_cache) +
+              MemoryConsumption::memory_consumption (compressed_cell_dof_indices_cache) +
+              MemoryConsumption::memory_consumption (compressed_cell_dof_indices_offset) +
               MemoryConsumption::memory_consumption (dof_object));
     }
 
@@ -144,7 +503,28 @@ namespace internal
     DoFLevel<dim>::serialize (Archive &ar,
                               const unsigned int)
     {
-      ar &cell_dof_indices_cache;
+      // archives always contain the uncompressed cache, so that their
+      // format does not depend on whether the cache could be compressed
+      if (Archive::is_loading::value)
+        {
+          ar &cell_dof_indices_cache;
+          std::vector<unsigned int>().swap (compressed_cell_dof_indices_cache);
+          compressed_cell_dof_indices_offset = 0;
+          compress_cell_dof_indices_cache ();
+        }
+      else if (compressed_cell_dof_indices_cache.size() > 0)
+        {
+          const CellDoFIndexIterator
+          compressed_indices (&compressed_cell_dof_indices_cache[0],
+                              compressed_cell_dof_indices_offset);
+          std::vector<types::global_dof_index>
+          indices (compressed_indices,
+                   compressed_indices + compressed_cell_dof_indices_cache.size());
+          ar &indices;
+        }
+      else
+        ar &cell_dof_indices_cache;
+
       ar &dof_object;
     }
   }
@@ -1888,6 +1888,21 @@ namespace DoFTools
                         const std::vector<unsigned int>  &target_block
                         = std::vector<unsigned int>());
 
+  /**
+   * Return the average over all locally owned active cells of the span of
+   * the indices of the degrees of freedom on a cell, i.e., of the difference
+   * between the largest and the smallest index on the cell plus one. A
+   * span close to the number of degrees of freedom per cell means that the
+   * entries of a vector that belong to a cell are close to each other in
+   * memory, which is what loops over cells profit from. This function can
+   * therefore be used to compare different numberings, for example the one
+   * produced by DoFRenumbering::cell_wise_locality(), with respect to their
+   * memory access patterns.
+   */
+  template <typename DoFHandlerType>
+  double
+  average_cell_dof_index_span (const DoFHandlerType &dof_handler);
+
   /**
    * For each active cell of a DoFHandler or hp::DoFHandler, extract the
    * active finite element index and fill the vector given as second argument.
@@ -296,8 +296,12 @@ private:
    * Initialize the interpolation from functions on refined mesh cells onto
    * the father cell. According to the philosophy of the Nédélec element,
    * this restriction operator preserves the curl of a function weakly.
+   *
+   * The restriction matrices for isotropic refinement are written into
+   * @p matrices, which must have one entry of size #dofs_per_cell times
+   * #dofs_per_cell per child and be zero on input.
    */
-  void initialize_restriction ();
+  void initialize_restriction (std::vector<FullMatrix<double> > &matrices) const;
 
   /**
    * These are the factors multiplied to a function in the
@@ -326,7 +330,7 @@ private:
 
 template <>
 void
-FE_Nedelec<1>::initialize_restriction();
+FE_Nedelec<1>::initialize_restriction(std::vector<FullMatrix<double> > &) const;
 
 #endif // DOXYGEN
 
@@ -19,9 +19,62 @@
 
 #include <deal.II/fe/fe.h>
 #include <deal.II/base/quadrature.h>
+#include <deal.II/base/tensor_product_polynomials.h>
 
 DEAL_II_NAMESPACE_OPEN
 
+
+namespace internal
+{
+  namespace FEPolyImplementation
+  {
+    /**
+     * Evaluate the polynomial space on all points of the given quadrature
+     * formula at once, provided this can be done more efficiently than point
+     * by point. Return whether the tables have been filled. The general
+     * version does nothing, see the overload for TensorProductPolynomials.
+     */
+    template <class PolynomialType, int dim>
+    inline
+    bool
+    compute_on_quadrature (const PolynomialType            &,
+                           const Quadrature<dim>           &,
+                           dealii::Table<2,double>         &,
+                           dealii::Table<2,Tensor<1,dim> > &,
+                           dealii::Table<2,Tensor<2,dim> > &,
+                           dealii::Table<2,Tensor<3,dim> > &)
+    {
+      return false;
+    }
+
+
+
+    /**
+     * Tensor product polynomials on a tensor product quadrature formula only
+     * need to evaluate the one-dimensional polynomials on the points of the
+     * one-dimensional quadrature formulas.
+     */
+    template <int dim, typename PolynomialType>
+    inline
+    bool
+    compute_on_quadrature (const TensorProductPolynomials<dim,PolynomialType> &poly_space,
+                           const Quadrature<dim>           &quadrature,
+                           dealii::Table<2,double>         &values,
+                           dealii::Table<2,Tensor<1,dim> > &grads,
+                           dealii::Table<2,Tensor<2,dim> > &grad_grads,
+                           dealii::Table<2,Tensor<3,dim> > &third_derivatives)
+    {
+      if (quadrature.is_tensor_product() == false)
+        return false;
+
+      poly_space.compute (quadrature, values, grads, grad_grads,
+                          third_derivatives);
+      return true;
+    }
+  }
+}
+
+
 /*!@addtogroup febase */
 /*@{*/
 
@@ -279,6 +332,30 @@ protected:
     // next already fill those fields of which we have information by
     // now. note that the shape gradients are only those on the unit
     // cell, and need to be transformed when visiting an actual cell
+    //
+    // if the polynomial space can be evaluated more efficiently on all
+    // quadrature points at once (tensor product polynomials on a tensor
+    // product quadrature formula), do so. the values go to the same place
+    // as in the loop over the points below
+    Table<2,double> no_values;
+    Table<2,double> &values_destination =
+      ((update_flags & update_values) && (output_data.shape_values.n_rows() > 0))
+      ?
+      (output_data.shape_values.n_cols() == n_q_points ?
+       output_data.shape_values : data->shape_values)
+      :
+      no_values;
+    if ((update_flags & (update_values | update_gradients
+                         | update_hessians | update_3rd_derivatives))
+        &&
+        internal::FEPolyImplementation::compute_on_quadrature (poly_space,
+                                                               quadrature,
+                                                               values_destination,
+                                                               data->shape_gradients,
+                                                               data->shape_hessians,
+                                                               data->shape_3rd_derivatives))
+      return data;
+
     if (update_flags & (update_values | update_gradients
                         | update_hessians | update_3rd_derivatives) )
       for (unsigned int i=0; i<n_q_points; ++i)
@@ -22,6 +22,7 @@
 #include <deal.II/base/polynomial.h>
 #include <deal.II/base/tensor_product_polynomials.h>
 #include <deal.II/base/geometry_info.h>
+#include <deal.II/base/thread_management.h>
 #include <deal.II/fe/fe.h>
 #include <deal.II/fe/fe_poly_tensor.h>
 
@@ -144,6 +145,33 @@ public:
   virtual std::pair<Table<2,bool>, std::vector<unsigned int> >
   get_constant_modes () const;
 
+  /**
+   * Return the matrix interpolating from the given finite element to the
+   * present one on a child cell. Restriction matrices are only available for
+   * isotropic refinement.
+   *
+   * The matrices are computed upon the first request to this function,
+   * rather than in the constructor, because their computation involves
+   * dense projections whose cost grows rapidly with the polynomial degree.
+   * This function is thread-safe.
+   */
+  virtual const FullMatrix<double> &
+  get_restriction_matrix (const unsigned int child,
+                          const RefinementCase<dim> &refinement_case=RefinementCase<dim>::isotropic_refinement) const;
+
+  /**
+   * Embedding matrix between grids. See the documentation of the base class
+   * for the meaning of this matrix.
+   *
+   * As for get_restriction_matrix(), the matrices are computed upon the first
+   * request, separately for each refinement case, so that programs using
+   * only isotropic refinement never compute the matrices for anisotropic
+   * refinement. This function is thread-safe.
+   */
+  virtual const FullMatrix<double> &
+  get_prolongation_matrix (const unsigned int child,
+                           const RefinementCase<dim> &refinement_case=RefinementCase<dim>::isotropic_refinement) const;
+
   virtual std::size_t memory_consumption () const;
   virtual FiniteElement<dim> *clone() const;
 
@@ -169,8 +197,12 @@ private:
    * the father cell. According to the philosophy of the Raviart-Thomas
    * element, this restriction operator preserves the divergence of a function
    * weakly.
+   *
+   * The restriction matrices for isotropic refinement are written into
+   * @p matrices, which must have one entry of size #dofs_per_cell times
+   * #dofs_per_cell per child and be zero on input.
    */
-  void initialize_restriction ();
+  void initialize_restriction (std::vector<FullMatrix<double> > &matrices) const;
 
   /**
    * These are the factors multiplied to a function in the
@@ -192,6 +224,11 @@ private:
    */
   Table<3, double> interior_weights;
 
+  /**
+   * Mutex for protecting initialization of restriction and embedding matrix.
+   */
+  mutable Threads::Mutex mutex;
+
   /**
    * Allow access from other dimensions.
    */
@@ -336,7 +373,7 @@ private:
 
 template <>
 void
-FE_RaviartThomas<1>::initialize_restriction();
+FE_RaviartThomas<1>::initialize_restriction(std::vector<FullMatrix<double> > &) const;
 
 #endif // DOXYGEN
 
@@ -301,6 +301,35 @@ namespace FETools
                                   const bool isotropic_only = false,
                                   const double threshold = 1.e-12);
 
+  /**
+   * Compute the embedding matrices from a coarse cell to its children for a
+   * single refinement case. This is the same computation as done by the
+   * previous function for each of the refinement cases, and is intended for
+   * finite element classes that compute their prolongation matrices upon the
+   * first request for a given RefinementCase, rather than for all of them at
+   * once.
+   *
+   * @param fe The finite element class for which we compute the embedding
+   * matrices.
+   *
+   * @param matrices A vector of
+   * <tt>GeometryInfo<dim>::n_children(refinement_case)</tt> FullMatrix
+   * objects, each of size <tt>fe.dofs_per_cell</tt> times
+   * <tt>fe.dofs_per_cell</tt>. This is the format of
+   * <code>FiniteElement::prolongation[refinement_case-1]</code>.
+   *
+   * @param refinement_case The refinement case for which the embedding
+   * matrices are to be computed. Must not be RefinementCase::no_refinement.
+   *
+   * @param threshold is the gap allowed in the least squares algorithm
+   * computing the embedding.
+   */
+  template <int dim, typename number, int spacedim>
+  void compute_embedding_matrices(const FiniteElement<dim,spacedim> &fe,
+                                  std::vector<FullMatrix<number> > &matrices,
+                                  const RefinementCase<dim> &refinement_case,
+                                  const double threshold = 1.e-12);
+
   /**
    * Compute the embedding matrices on faces needed for constraint matrices.
    *
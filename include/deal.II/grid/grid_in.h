@@ -319,7 +319,9 @@ public:
     /// Use read_tecplot()
     tecplot,
     /// Use read_vtk()
-    vtk
+    vtk,
+    /// Use read_binary()
+    binary
   };
 
   /**
@@ -366,6 +368,22 @@ public:
    */
   void read_ucd (std::istream &in);
 
+  /**
+   * Same as above, but read the data from the file with the given name.
+   *
+   * Rather than extracting the data token by token from a stream, this
+   * function maps the file into memory (or reads it in large blocks),
+   * splits the lists of vertices and cells into lines, and parses these
+   * lines in parallel using a number parser that does not depend on the
+   * locale. This is much faster for large files. The result is the same as
+   * the one of the function above, provided that every vertex and every
+   * cell is given on a line of its own, as is the case for the files
+   * written by all common mesh generators. Otherwise, an exception of type
+   * ExcUnsupportedLineLayout is thrown. read() calls this function for files
+   * in UCD format and falls back to the function above in that case.
+   */
+  void read_ucd (const std::string &filename);
+
   /**
    * Read grid data from an Abaqus file. Numerical and constitutive data is
    * ignored.
@@ -425,6 +443,20 @@ public:
    */
   void read_msh (std::istream &in);
 
+  /**
+   * Same as above, but read the data from the file with the given name.
+   *
+   * As for read_ucd(const std::string&), the file is mapped into memory (or
+   * read in large blocks), and the lists of nodes and elements are split
+   * into lines that are parsed in parallel. The result is the same as the
+   * one of the function above, provided that every node and every element
+   * is given on a line of its own, as is the case for all files written by
+   * Gmsh. Otherwise, an exception of type ExcUnsupportedLineLayout is
+   * thrown. read() calls this function for files in msh format and falls
+   * back to the function above in that case.
+   */
+  void read_msh (const std::string &filename);
+
   /**
    * Read grid data from a NetCDF file. The only data format currently
    * supported is the <tt>TAU grid format</tt>.
@@ -439,6 +471,50 @@ public:
    */
   void read_tecplot (std::istream &in);
 
+  /**
+   * Read a grid in deal.II's binary mesh format as written by
+   * GridOut::write_binary(). All data is stored in contiguous arrays that
+   * are copied into the data structures used to create the triangulation
+   * without any parsing, so reading is limited by the speed of the file
+   * system rather than by the processor.
+   *
+   * A file in this format consists of the following parts, all written in
+   * the byte order of the machine that wrote the file:
+   * <ol>
+   * <li> The 16 characters <tt>deal.II binmesh\\n</tt>.
+   * <li> Nine unsigned 64-bit integers: the version of the format
+   * (currently 1), the dimension, the space dimension, the number
+   * <tt>0x0102030405060708</tt> that is used to detect files with a
+   * different byte order, the number of vertices, the number of cells, the
+   * number of lines and quads for which boundary and manifold ids are
+   * stored, and a flag that is 1 if the cells are known to be consistently
+   * oriented and 0 otherwise.
+   * <li> The coordinates of the vertices as doubles, <tt>spacedim</tt> per
+   * vertex.
+   * <li> The vertex indices of the cells (in the numbering used in deal.II,
+   * see GeometryInfo), the material ids and the manifold ids of the cells,
+   * each as unsigned 32-bit integers.
+   * <li> The vertex indices, boundary ids, and manifold ids of the lines,
+   * followed by the same data for the quads, again as unsigned 32-bit
+   * integers. Lines and quads in the interior of the domain, which are
+   * only stored if they have a manifold id, have the boundary id
+   * numbers::internal_face_boundary_id.
+   * </ol>
+   *
+   * If the file states that its cells are consistently oriented, as is the
+   * case for all files written by GridOut::write_binary(), the cells are
+   * handed to Triangulation::create_triangulation() directly. Otherwise,
+   * they are first brought into a consistent orientation by GridReordering,
+   * as for the other input formats.
+   */
+  void read_binary (std::istream &in);
+
+  /**
+   * Same as above, but read from the given file. Where available, the file
+   * is mapped into memory rather than being read through a stream.
+   */
+  void read_binary (const std::string &filename);
+
   /**
    * Returns the standard suffix for a file in this format.
    */
@@ -533,6 +609,16 @@ public:
 
 
   DeclException0 (ExcGmshNoCellInformation);
+
+  /**
+   * Exception thrown by read_msh(const std::string&) and
+   * read_ucd(const std::string&) if the lists of vertices or elements of a
+   * file cannot be split into one record per line. read() catches this
+   * exception and reads the file with the stream based functions instead.
+   */
+  DeclExceptionMsg (ExcUnsupportedLineLayout,
+                    "The vertices or elements of this file are not given "
+                    "one per line. Read the file from a stream instead.");
 protected:
   /**
    * Store address of the triangulation to be fed with the data read in.
@@ -581,6 +667,14 @@ private:
   static void skip_comment_lines (std::istream    &in,
                                   const char  comment_start);
 
+  /**
+   * Create the triangulation from the @p size bytes of data in deal.II's
+   * binary mesh format starting at @p data. This function does the work for
+   * both read_binary() functions.
+   */
+  void read_binary_data (const char        *data,
+                         const std::size_t  size);
+
   /**
    * This function does the nasty work (due to very lax conventions and
    * different versions of the tecplot format) of extracting the important
@@ -858,7 +858,9 @@ public:
     /// write() calls write_vtk()
     vtk,
     /// write() calls write_vtu()
-    vtu
+    vtu,
+    /// write() calls write_binary()
+    binary
   };
 
   /**
@@ -1079,6 +1081,32 @@ public:
   void write_vtu (const Triangulation<dim,spacedim> &tria,
                   std::ostream                      &out) const;
 
+  /**
+   * Write the active cells of the triangulation in deal.II's binary mesh
+   * format, which can be read back by GridIn::read_binary(). The format is
+   * described in the documentation of that function. It stores the
+   * vertices, the cells with their material and manifold ids, and the faces
+   * (and in 3d the edges) that have a nonzero boundary indicator or a
+   * manifold id other than numbers::flat_manifold_id, all in contiguous
+   * arrays that can be read without any parsing.
+   *
+   * Since the cells of a Triangulation are always consistently oriented,
+   * the file is marked accordingly and GridIn::read_binary() does not need
+   * to reorder the cells when reading it.
+   *
+   * @note As for the other output formats that are meant to be read back in
+   * again, the active cells are written as coarse cells. Consequently, this
+   * only makes sense for meshes without hanging nodes. In 1d, the boundary
+   * indicators of vertices are not stored.
+   *
+   * @note The data is written in the byte order of the machine on which the
+   * program runs. GridIn::read_binary() refuses to read files with a
+   * different byte order.
+   */
+  template <int dim, int spacedim>
+  void write_binary (const Triangulation<dim,spacedim> &tria,
+                     std::ostream                      &out) const;
+
   /**
    * Write grid to @p out according to the given data format. This function
    * simply calls the appropriate <tt>write_*</tt> function.
@@ -343,40 +343,6 @@ namespace internal
       bool operator != (const EdgeOrientation &edge_orientation) const;
     };
 
-    /**
-     * During building the connectivity information we don't need all the
-     * heavy duty information about edges that we will need later. So we can
-     * save memory and time by using a light-weight class for edges. It stores
-     * the two vertices, but no direction, so we make the optimization to
-     * store the vertex number in sorted order to allow for easier comparison
-     * of edge objects.
-     */
-    struct CheapEdge
-    {
-      /**
-       * The first node
-       */
-      const unsigned int node0;
-
-      /**
-       * The second node
-       */
-      const unsigned int node1;
-
-      /**
-       * Constructor. Take the vertex numbers and store them sorted.
-       */
-      CheapEdge (const unsigned int n0,
-                 const unsigned int n1);
-
-      /**
-       * Need a partial ordering for sorting algorithms
-       */
-      bool operator< (const CheapEdge &e2) const;
-    };
-
-
-
     /**
      * A connectivity and orientation aware edge class.
      */
@@ -407,11 +373,6 @@ namespace internal
        * zero.
        */
       unsigned int group;
-
-      /**
-       * Indices of neighboring cubes.
-       */
-      std::vector<unsigned int> neighboring_cubes;
     };
 
     /**
@@ -489,6 +450,20 @@ namespace internal
        */
       std::vector<Cell> cell_list;
 
+      /**
+       * The indices of the cells adjacent to each edge, stored in compressed
+       * form: the cells adjacent to edge <tt>e</tt> are
+       * <tt>neighboring_cubes[neighbor_start[e]]</tt> through
+       * <tt>neighboring_cubes[neighbor_start[e+1]-1]</tt>.
+       */
+      std::vector<unsigned int> neighbor_start;
+
+      /**
+       * The indices of the cells adjacent to the edges. See
+       * <tt>neighbor_start</tt>.
+       */
+      std::vector<unsigned int> neighboring_cubes;
+
       /**
        * Checks whether every cell in the mesh is sensible.
        */
@@ -602,6 +577,14 @@ namespace internal
        */
       void orient_cubes ();
 
+      /**
+       * Rotate the cubes with indices in the range [begin,end) so that their
+       * edges are in standard direction. This function is called in
+       * parallel by orient_cubes().
+       */
+      void orient_cubes_in_range (const unsigned int begin,
+                                  const unsigned int end);
+
       bool get_next_unoriented_cube ();
 
       /**
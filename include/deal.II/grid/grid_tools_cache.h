@@ -0,0 +1,353 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii__grid_tools_cache_h
+#define dealii__grid_tools_cache_h
+
+
+#include <deal.II/base/config.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/thread_management.h>
+#include <deal.II/fe/mapping.h>
+#include <deal.II/fe/mapping_q1.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <boost/signals2/connection.hpp>
+
+#include <vector>
+#include <utility>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace GridTools
+{
+  /**
+   * A class that stores a spatial index of the active cells of a
+   * triangulation and uses it to answer the question which cell surrounds
+   * a given point.
+   *
+   * GridTools::find_active_cell_around_point() starts its search from the
+   * vertex closest to the point it is given. Finding this vertex requires a
+   * loop over all vertices of the triangulation, i.e., each call costs
+   * ${\cal O}(N)$ operations. This is acceptable if only a few points have
+   * to be located, but becomes the dominant cost if many points are
+   * searched for, for example when evaluating a finite element field on a
+   * different mesh via Functions::FEFieldFunction or when tracking particles.
+   *
+   * This class instead builds a tree of axis-aligned bounding boxes of the
+   * active cells (a bounding volume hierarchy) the first time a point is
+   * searched for. Locating a point then only requires descending into those
+   * branches of the tree whose boxes contain the point, i.e., ${\cal
+   * O}(\log N)$ operations for reasonable meshes, followed by a test with
+   * Mapping::transform_real_to_unit_cell() on the few cells whose bounding
+   * boxes contain the point.
+   *
+   * The bounding boxes are computed from the vertices of the cells as
+   * returned by Mapping::get_vertices(), and are slightly enlarged to
+   * account for cells that are curved by a higher order mapping. Points
+   * outside of the union of these boxes, i.e., of the box of the root of
+   * the tree, are rejected right away as not lying in the triangulation.
+   * Should the tree not identify a cell for a point within that box (which
+   * can happen if the point lies in a hole of the domain, or if a cell
+   * bulges out of its enlarged bounding box), the search falls back to
+   * GridTools::find_active_cell_around_point(). If a point lies in several
+   * cells, for example on a face, edge, or vertex shared by them, the most
+   * refined cell is returned, and among cells of the same level the one with
+   * the lowest active_cell_index(). This is the same cell that
+   * GridTools::find_active_cell_around_point() returns as long as all of
+   * these cells are adjacent to the vertex closest to the point.
+   *
+   * The object connects to the Triangulation::Signals::any_change signal of
+   * the triangulation and rebuilds the tree the next time it is used after
+   * the triangulation has been refined, coarsened, or otherwise changed.
+   *
+   * All query functions of this class can be called concurrently from
+   * several threads.
+   *
+   * @ingroup grid
+   */
+  template <int dim, int spacedim=dim>
+  class Cache : public Subscriptor
+  {
+  public:
+    /**
+     * Typedef for the iterators to the active cells of the triangulation.
+     */
+    typedef typename Triangulation<dim,spacedim>::active_cell_iterator active_cell_iterator;
+
+    /**
+     * Constructor. Store a pointer to the triangulation and the mapping to
+     * be used for locating points, and connect to the signals of the
+     * triangulation. The tree itself is only built the first time it is
+     * needed.
+     */
+    Cache (const Triangulation<dim,spacedim> &tria,
+           const Mapping<dim,spacedim>       &mapping = (StaticMappingQ1<dim,spacedim>::mapping));
+
+    /**
+     * Copy constructor. The new object refers to the same triangulation and
+     * mapping as @p cache, but builds its own tree when it is first used.
+     */
+    Cache (const Cache<dim,spacedim> &cache);
+
+    /**
+     * Destructor. Disconnect from the signals of the triangulation.
+     */
+    ~Cache ();
+
+    /**
+     * Mark the tree as outdated. It is rebuilt the next time a point is
+     * searched for. This function is called automatically whenever the
+     * triangulation changes, so there is usually no need to call it
+     * explicitly.
+     */
+    void mark_for_update ();
+
+    /**
+     * Find the active cell that surrounds the point @p p, along with the
+     * coordinates of @p p in the reference coordinate system of that cell.
+     * The semantics of this function are the same as the ones of
+     * GridTools::find_active_cell_around_point() with a mapping argument. In
+     * particular, an exception of type GridTools::ExcPointNotFound is thrown
+     * if the point does not lie in any of the cells of the triangulation.
+     */
+    std::pair<active_cell_iterator, Point<dim> >
+    find_active_cell_around_point (const Point<spacedim> &p) const;
+
+    /**
+     * Same as above, but return an iterator into the given @p mesh, which
+     * must be built on the triangulation of this object. This is useful to
+     * obtain cells of a DoFHandler or hp::DoFHandler.
+     *
+     * @tparam MeshType A type that satisfies the requirements of the
+     * @ref ConceptMeshType "MeshType concept".
+     */
+    template <typename MeshType>
+    std::pair<typename MeshType::active_cell_iterator, Point<dim> >
+    find_active_cell_around_point (const MeshType        &mesh,
+                                   const Point<spacedim> &p) const;
+
+    /**
+     * Find the active cells around all of the given @p points. The tree is
+     * built (if necessary) before the points are distributed to several
+     * threads that search for them concurrently.
+     *
+     * On return, the i-th entry of @p cells contains the cell around the
+     * i-th point and the coordinates of the point in the reference
+     * coordinate system of that cell. Rather than throwing an exception, the
+     * cell iterator of points that do not lie within the triangulation is
+     * set to the end() iterator of the triangulation.
+     */
+    void
+    find_active_cells_around_points (const std::vector<Point<spacedim> >                      &points,
+                                     std::vector<std::pair<active_cell_iterator,Point<dim> > > &cells) const;
+
+    /**
+     * Return a reference to the triangulation stored in this object.
+     */
+    const Triangulation<dim,spacedim> &get_triangulation () const;
+
+    /**
+     * Return a reference to the mapping stored in this object.
+     */
+    const Mapping<dim,spacedim> &get_mapping () const;
+
+    /**
+     * Determine an estimate for the memory consumption (in bytes) of this
+     * object.
+     */
+    std::size_t memory_consumption () const;
+
+  private:
+    /**
+     * Copy operator. Since objects of this class hold a connection to the
+     * signals of a triangulation and a tree built from it, we make it
+     * private, and also do not implement it. Use the copy constructor
+     * instead.
+     */
+    Cache<dim,spacedim> &operator= (const Cache<dim,spacedim> &);
+
+    /**
+     * A node of the tree. Each node stores the bounding box of all cells
+     * below it. Inner nodes store the indices of their two children in
+     * <tt>tree</tt>, leaves store the range of entries of
+     * <tt>cell_indices</tt> that belong to them.
+     */
+    struct Node
+    {
+      Point<spacedim> lower_corner;
+      Point<spacedim> upper_corner;
+      unsigned int    first;
+      unsigned int    second;
+      bool            is_leaf;
+    };
+
+    /**
+     * Build the tree from the current state of the triangulation.
+     */
+    void build_tree () const;
+
+    /**
+     * Build the tree if it has been marked as outdated. This function locks
+     * <tt>mutex</tt> so that only one thread builds the tree.
+     */
+    void update_tree () const;
+
+    /**
+     * Recursively build the part of the tree below the node with index
+     * <tt>node</tt> that holds the cells <tt>cell_indices[begin,end)</tt>.
+     */
+    void build_node (const unsigned int node,
+                     const unsigned int begin,
+                     const unsigned int end) const;
+
+    /**
+     * Search for the point @p p in the tree without falling back to the
+     * slow search. The cell iterator of the returned pair is the end()
+     * iterator of the triangulation if no cell was found.
+     *
+     * If the point lies in more than one cell, for example on a face, edge,
+     * or vertex shared by several cells, the cell with the smallest distance
+     * of the point to the reference cell is returned. Among cells with the
+     * same distance, the most refined one is chosen, and among those the
+     * one with the lowest active_cell_index(). The result therefore does
+     * not depend on the order in which the tree is traversed.
+     */
+    std::pair<active_cell_iterator, Point<dim> >
+    search_tree (const Point<spacedim> &p) const;
+
+    /**
+     * Return whether the point @p p lies within the bounding box of the
+     * root of the tree. If this is not the case, it can not lie in any cell
+     * of the triangulation and there is no need to fall back to the slow
+     * search. The tree needs to be up to date.
+     */
+    bool point_in_root_box (const Point<spacedim> &p) const;
+
+    /**
+     * Search for the points with indices in the range [begin,end) and write
+     * the results into @p cells. This function is called on several threads
+     * by find_active_cells_around_points().
+     */
+    void
+    search_points (const std::vector<Point<spacedim> >                      &points,
+                   std::vector<std::pair<active_cell_iterator,Point<dim> > > &cells,
+                   const unsigned int                                        begin,
+                   const unsigned int                                        end) const;
+
+    /**
+     * The triangulation whose cells we search.
+     */
+    SmartPointer<const Triangulation<dim,spacedim>,Cache<dim,spacedim> > tria;
+
+    /**
+     * The mapping used to determine whether a point lies within a cell.
+     */
+    SmartPointer<const Mapping<dim,spacedim>,Cache<dim,spacedim> > mapping;
+
+    /**
+     * The connection to the Triangulation::Signals::any_change signal of
+     * the triangulation.
+     */
+    boost::signals2::connection tria_listener;
+
+    /**
+     * Whether the tree needs to be rebuilt before it can be used.
+     */
+    mutable bool update_needed;
+
+    /**
+     * The active cells of the triangulation, indexed by their active cell
+     * index.
+     */
+    mutable std::vector<active_cell_iterator> active_cells;
+
+    /**
+     * The lower and upper corners of the (enlarged) bounding boxes of the
+     * active cells, indexed by their active cell index.
+     */
+    mutable std::vector<std::pair<Point<spacedim>,Point<spacedim> > > cell_boxes;
+
+    /**
+     * The active cell indices of all cells, sorted such that the cells of
+     * each leaf of the tree form a contiguous range.
+     */
+    mutable std::vector<unsigned int> cell_indices;
+
+    /**
+     * The nodes of the tree. The first entry is the root.
+     */
+    mutable std::vector<Node> tree;
+
+    /**
+     * A mutex that guards the construction of the tree.
+     */
+    mutable Threads::Mutex mutex;
+  };
+
+
+
+  /* ----------------- inline and template functions ----------------- */
+
+
+
+  template <int dim, int spacedim>
+  inline
+  const Triangulation<dim,spacedim> &
+  Cache<dim,spacedim>::get_triangulation () const
+  {
+    return *tria;
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline
+  const Mapping<dim,spacedim> &
+  Cache<dim,spacedim>::get_mapping () const
+  {
+    return *mapping;
+  }
+
+
+
+  template <int dim, int spacedim>
+  template <typename MeshType>
+  std::pair<typename MeshType::active_cell_iterator, Point<dim> >
+  Cache<dim,spacedim>::find_active_cell_around_point (const MeshType        &mesh,
+                                                      const Point<spacedim> &p) const
+  {
+    Assert (&mesh.get_triangulation() == &*tria,
+            ExcMessage ("The mesh must be built on the triangulation of this object."));
+
+    const std::pair<active_cell_iterator, Point<dim> > tria_cell
+      = find_active_cell_around_point (p);
+
+    return std::make_pair (typename MeshType::active_cell_iterator (&*tria,
+                                                                    tria_cell.first->level(),
+                                                                    tria_cell.first->index(),
+                                                                    &mesh),
+                           tria_cell.second);
+  }
+}
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -204,6 +204,20 @@ namespace Manifolds
  * approximate the limit process, and derived classes should do so.
  *
  *
+ * <h3>Thread safety</h3>
+ *
+ * When a Triangulation is refined, the locations of the new vertices at
+ * the midpoints of the refined lines are computed in parallel, using the
+ * functions of the Threads namespace. Consequently, get_new_point_on_line()
+ * and the functions it calls, in particular get_new_point() and
+ * project_to_manifold(), may be called concurrently on the same object
+ * from several threads. Like all other const member functions of classes
+ * derived from this one, these functions must therefore not modify the
+ * state of the object without protecting it, for example by a
+ * Threads::Mutex. All manifold classes of the library satisfy this
+ * requirement.
+ *
+ *
  * @ingroup manifold
  * @author Luca Heltai, Wolfgang Bangerth, 2014, 2016
  */
@@ -267,6 +281,9 @@ public:
    * can overload Manifold<dim,spacedim>::get_new_point() or
    * Manifold<dim,spacedim>::project_to_manifold(), which is called by the
    * default implementation of Manifold<dim,spacedim>::get_new_point().
+   *
+   * This function may be called concurrently from several threads, see the
+   * section on thread safety in the documentation of this class.
    */
   virtual
   Point<spacedim>
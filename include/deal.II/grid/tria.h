@@ -3524,14 +3524,10 @@ Triangulation<dim,spacedim>::load (Archive &ar,
   ar &anisotropic_refinement;
   ar &number_cache;
 
-  // the levels do not serialize the active_cell_indices because
+  // the levels do not serialize the active cell indices because
   // they are easy enough to rebuild upon re-loading data. do
-  // this here. don't forget to first resize the fields appropriately
-  {
-    for (unsigned int l=0; l<levels.size(); ++l)
-      levels[l]->active_cell_indices.resize (levels[l]->refine_flags.size());
-    reset_active_cell_indices ();
-  }
+  // this here
+  reset_active_cell_indices ();
 
 
   bool my_check_for_distorted_cells;
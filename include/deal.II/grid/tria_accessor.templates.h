@@ -3051,9 +3051,9 @@ CellAccessor<dim,spacedim>::refine_flag_set () const
   // but activity may change when refinement is
   // executed and for some reason the refine
   // flag is not cleared).
-  Assert (this->active() ||  !this->tria->levels[this->present_level]->refine_flags[this->present_index],
+  Assert (this->active() ||  !this->tria->levels[this->present_level]->cell_properties[this->present_index].refine_flag,
           ExcRefineCellNotActive());
-  return RefinementCase<dim>(this->tria->levels[this->present_level]->refine_flags[this->present_index]);
+  return RefinementCase<dim>(this->tria->levels[this->present_level]->cell_properties[this->present_index].refine_flag);
 }
 
 
@@ -3067,7 +3067,7 @@ CellAccessor<dim,spacedim>::set_refine_flag (const RefinementCase<dim> refinemen
   Assert (!coarsen_flag_set(),
           ExcCellFlaggedForCoarsening());
 
-  this->tria->levels[this->present_level]->refine_flags[this->present_index] = refinement_case;
+  this->tria->levels[this->present_level]->cell_properties[this->present_index].refine_flag = refinement_case;
 }
 
 
@@ -3078,7 +3078,7 @@ void
 CellAccessor<dim,spacedim>::clear_refine_flag () const
 {
   Assert (this->used() && this->active(), ExcRefineCellNotActive());
-  this->tria->levels[this->present_level]->refine_flags[this->present_index] =
+  this->tria->levels[this->present_level]->cell_properties[this->present_index].refine_flag =
     RefinementCase<dim>::no_refinement;
 }
 
@@ -3281,9 +3281,9 @@ CellAccessor<dim,spacedim>::coarsen_flag_set () const
   // but activity may change when refinement is
   // executed and for some reason the refine
   // flag is not cleared).
-  Assert (this->active() ||  !this->tria->levels[this->present_level]->coarsen_flags[this->present_index],
+  Assert (this->active() ||  !this->tria->levels[this->present_level]->cell_properties[this->present_index].coarsen_flag,
           ExcRefineCellNotActive());
-  return this->tria->levels[this->present_level]->coarsen_flags[this->present_index];
+  return this->tria->levels[this->present_level]->cell_properties[this->present_index].coarsen_flag;
 }
 
 
@@ -3296,7 +3296,7 @@ CellAccessor<dim,spacedim>::set_coarsen_flag () const
   Assert (this->used() && this->active(), ExcRefineCellNotActive());
   Assert (!refine_flag_set(), ExcCellFlaggedForRefinement());
 
-  this->tria->levels[this->present_level]->coarsen_flags[this->present_index] = true;
+  this->tria->levels[this->present_level]->cell_properties[this->present_index].coarsen_flag = true;
 }
 
 
@@ -3307,7 +3307,7 @@ void
 CellAccessor<dim,spacedim>::clear_coarsen_flag () const
 {
   Assert (this->used() && this->active(), ExcRefineCellNotActive());
-  this->tria->levels[this->present_level]->coarsen_flags[this->present_index] = false;
+  this->tria->levels[this->present_level]->cell_properties[this->present_index].coarsen_flag = false;
 }
 
 
@@ -3460,7 +3460,7 @@ CellAccessor<dim, spacedim>::subdomain_id () const
   Assert (this->used(), TriaAccessorExceptions::ExcCellNotUsed());
   Assert (this->active(),
           ExcMessage("subdomain_id() can only be called on active cells!"));
-  return this->tria->levels[this->present_level]->subdomain_ids[this->present_index];
+  return this->tria->levels[this->present_level]->cell_properties[this->present_index].subdomain_id;
 }
 
 
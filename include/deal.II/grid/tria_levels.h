@@ -31,6 +31,48 @@ namespace internal
 {
   namespace Triangulation
   {
+    /**
+     * The data of a cell that loops over the active cells ask for most
+     * often. TriaLevel stores one object of this type per cell, so that all
+     * of these fields of a cell are found next to each other in memory
+     * rather than in separate arrays.
+     */
+    struct CellProperties
+    {
+      /**
+       * Constructor. Initialize the fields with the values of a newly
+       * created cell.
+       */
+      CellProperties ();
+
+      /**
+       * An integer that, for an active cell, stores the how many-th active
+       * cell this is. For non-active cells, this value is unused and set to
+       * an invalid value.
+       */
+      unsigned int active_cell_index;
+
+      /**
+       * The subdomain the cell belongs to. This field is most often used in
+       * parallel computations, where it denotes which processor shall work
+       * on the cells with a given subdomain number.
+       */
+      types::subdomain_id subdomain_id;
+
+      /**
+       * The @p RefinementCase<dim>::Type flag the cell is to be refined with,
+       * or RefinementCase<dim>::no_refinement.
+       */
+      unsigned char refine_flag;
+
+      /**
+       * Whether the cell must be coarsened.
+       */
+      unsigned char coarsen_flag;
+    };
+
+
+
     /**
      * Store all information which belongs to one level of the multilevel
      * hierarchy.
@@ -55,28 +97,18 @@ namespace internal
     {
     public:
       /**
-       * @p RefinementCase<dim>::Type flags for the cells to be refined with
-       * or not (RefinementCase<dim>::no_refinement). The meaning what a cell
-       * is, is dimension specific, therefore also the length of this vector
-       * depends on the dimension: in one dimension, the length of this vector
-       * equals the length of the @p lines vector, in two dimensions that of
-       * the @p quads vector, etc.
-       */
-      std::vector<unsigned char> refine_flags;
-
-      /**
-       * Same meaning as the one above, but specifies whether a cell must be
-       * coarsened.
-       */
-      std::vector<bool> coarsen_flags;
-
-
-      /**
-       * An integer that, for every active cell, stores the how many-th active
-       * cell this is. For non-active cells, this value is unused and set to
-       * an invalid value.
+       * The active cell index, the subdomain id and the refinement and
+       * coarsening flags of the cells. The meaning what a cell is, is
+       * dimension specific, therefore also the length of this vector depends
+       * on the dimension: in one dimension, the length of this vector equals
+       * the length of the @p lines vector, in two dimensions that of the @p
+       * quads vector, etc.
+       *
+       * These fields are accessed together by most loops over cells, so they
+       * are stored as an array of structures rather than in one array per
+       * field.
        */
-      std::vector<unsigned int> active_cell_indices;
+      std::vector<CellProperties> cell_properties;
 
       /**
        * Levels and indices of the neighbors of the cells. Convention is, that
@@ -113,14 +145,6 @@ namespace internal
        */
       std::vector<std::pair<int,int> > neighbors;
 
-      /**
-       * One integer per cell to store which subdomain it belongs to. This
-       * field is most often used in parallel computations, where it denotes
-       * which processor shall work on the cells with a given subdomain
-       * number.
-       */
-      std::vector<types::subdomain_id> subdomain_ids;
-
       /**
        * for parallel multigrid
        */
@@ -216,11 +240,8 @@ namespace internal
     class TriaLevel<3>
     {
     public:
-      std::vector<unsigned char> refine_flags;
-      std::vector<bool> coarsen_flags;
-      std::vector<unsigned int> active_cell_indices;
+      std::vector<CellProperties> cell_properties;
       std::vector<std::pair<int,int> > neighbors;
-      std::vector<types::subdomain_id> subdomain_ids;
       std::vector<types::subdomain_id> level_subdomain_ids;
       std::vector<int> parents;
 
@@ -268,19 +289,91 @@ namespace internal
 
 
 
+    inline
+    CellProperties::CellProperties ()
+      :
+      active_cell_index (numbers::invalid_unsigned_int),
+      subdomain_id (0),
+      refine_flag (0),
+      coarsen_flag (false)
+    {}
+
+
+
+    /**
+     * Copy the refinement flags, coarsening flags and subdomain ids out of
+     * the given cell properties into one array each. This is the format in
+     * which they are written to archives.
+     */
+    inline
+    void unpack_cell_properties (const std::vector<CellProperties> &cell_properties,
+                                 std::vector<unsigned char>        &refine_flags,
+                                 std::vector<unsigned char>        &coarsen_flags,
+                                 std::vector<types::subdomain_id>  &subdomain_ids)
+    {
+      refine_flags.resize (cell_properties.size());
+      coarsen_flags.resize (cell_properties.size());
+      subdomain_ids.resize (cell_properties.size());
+      for (unsigned int i=0; i<cell_properties.size(); ++i)
+        {
+          refine_flags[i] = cell_properties[i].refine_flag;
+          coarsen_flags[i] = cell_properties[i].coarsen_flag;
+          subdomain_ids[i] = cell_properties[i].subdomain_id;
+        }
+    }
+
+
+
+    /**
+     * The inverse of unpack_cell_properties(). The active cell indices are
+     * set to invalid values.
+     */
+    inline
+    void pack_cell_properties (const std::vector<unsigned char>       &refine_flags,
+                               const std::vector<unsigned char>       &coarsen_flags,
+                               const std::vector<types::subdomain_id> &subdomain_ids,
+                               std::vector<CellProperties>            &cell_properties)
+    {
+      Assert (coarsen_flags.size() == refine_flags.size(),
+              ExcDimensionMismatch (coarsen_flags.size(), refine_flags.size()));
+      Assert (subdomain_ids.size() == refine_flags.size(),
+              ExcDimensionMismatch (subdomain_ids.size(), refine_flags.size()));
+      cell_properties.assign (refine_flags.size(), CellProperties());
+      for (unsigned int i=0; i<cell_properties.size(); ++i)
+        {
+          cell_properties[i].refine_flag = refine_flags[i];
+          cell_properties[i].coarsen_flag = coarsen_flags[i];
+          cell_properties[i].subdomain_id = subdomain_ids[i];
+        }
+    }
+
+
+
     template <int dim>
     template <class Archive>
     void TriaLevel<dim>::serialize(Archive &ar,
                                    const unsigned int)
     {
-      ar &refine_flags &coarsen_flags;
-
-      // do not serialize 'active_cell_indices' here. instead of storing them
-      // to the stream and re-reading them again later, we just rebuild them
-      // in Triangulation::load()
+      // write the fields of the cell properties to the archive one after
+      // the other, as they were stored before they were packed together.
+      // do not serialize the active cell indices here. instead of storing
+      // them to the stream and re-reading them again later, we just rebuild
+      // them in Triangulation::load()
+      std::vector<unsigned char> refine_flags, coarsen_flags;
+      std::vector<types::subdomain_id> subdomain_ids;
+      if (Archive::is_saving::value)
+        unpack_cell_properties (cell_properties,
+                                refine_flags, coarsen_flags, subdomain_ids);
 
+      ar &refine_flags;
+      serialize_flags (ar, coarsen_flags);
       ar &neighbors;
       ar &subdomain_ids;
+
+      if (Archive::is_loading::value)
+        pack_cell_properties (refine_flags, coarsen_flags, subdomain_ids,
+                              cell_properties);
+
       ar &level_subdomain_ids;
       ar &parents;
       ar &direction_flags;
@@ -293,14 +386,26 @@ namespace internal
     void TriaLevel<3>::serialize(Archive &ar,
                                  const unsigned int)
     {
-      ar &refine_flags &coarsen_flags;
-
-      // do not serialize 'active_cell_indices' here. instead of storing them
-      // to the stream and re-reading them again later, we just rebuild them
-      // in Triangulation::load()
+      // write the fields of the cell properties to the archive one after
+      // the other, as they were stored before they were packed together.
+      // do not serialize the active cell indices here. instead of storing
+      // them to the stream and re-reading them again later, we just rebuild
+      // them in Triangulation::load()
+      std::vector<unsigned char> refine_flags, coarsen_flags;
+      std::vector<types::subdomain_id> subdomain_ids;
+      if (Archive::is_saving::value)
+        unpack_cell_properties (cell_properties,
+                                refine_flags, coarsen_flags, subdomain_ids);
 
+      ar &refine_flags;
+      serialize_flags (ar, coarsen_flags);
       ar &neighbors;
       ar &subdomain_ids;
+
+      if (Archive::is_loading::value)
+        pack_cell_properties (refine_flags, coarsen_flags, subdomain_ids,
+                              cell_properties);
+
       ar &level_subdomain_ids;
       ar &parents;
       ar &direction_flags;
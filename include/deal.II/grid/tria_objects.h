@@ -100,19 +100,24 @@ namespace internal
        * element is not needed any more (e.g. after derefinement), it is not
        * deleted from the list, but rather the according @p used flag is set
        * to @p false.
+       *
+       * The flags are stored as one byte per object rather than in a
+       * bit-packed <tt>std::vector@<bool@></tt> since they are queried for
+       * every object an iterator visits, and reading a byte avoids the
+       * masking and shifting needed to extract a single bit.
        */
-      std::vector<bool> used;
+      std::vector<unsigned char> used;
 
       /**
-       * Make available a field for user data, one bit per object. This field
-       * is usually used when an operation runs over all cells and needs
-       * information whether another cell (e.g. a neighbor) has already been
-       * processed.
+       * Make available a field for user data, one byte per object (see the
+       * @p used field for the reason not to use bits). This field is usually
+       * used when an operation runs over all cells and needs information
+       * whether another cell (e.g. a neighbor) has already been processed.
        *
        * You can clear all used flags using
        * dealii::Triangulation::clear_user_flags().
        */
-      std::vector<bool> user_flags;
+      std::vector<unsigned char> user_flags;
 
 
       /**
@@ -715,6 +720,24 @@ namespace internal
 
 
 
+    /**
+     * Serialize a vector of flags stored as bytes. The flags are written to
+     * and read from the archive as a <tt>std::vector@<bool@></tt> so that the
+     * format of archives does not depend on how the flags are stored
+     * internally.
+     */
+    template <class Archive>
+    void serialize_flags (Archive                    &ar,
+                          std::vector<unsigned char> &flags)
+    {
+      std::vector<bool> tmp (flags.begin(), flags.end());
+      ar &tmp;
+      if (Archive::is_loading::value)
+        flags.assign (tmp.begin(), tmp.end());
+    }
+
+
+
     template <typename G>
     template <class Archive>
     void TriaObjects<G>::serialize(Archive &ar,
@@ -722,8 +745,8 @@ namespace internal
     {
       ar &cells &children;
       ar &refinement_cases;
-      ar &used;
-      ar &user_flags;
+      serialize_flags (ar, used);
+      serialize_flags (ar, user_flags);
       ar &boundary_or_material_id;
       ar &manifold_id;
       ar &next_free_single &next_free_pair &reverse_order_next_free_single;
@@ -19,6 +19,7 @@
 
 #include <deal.II/base/config.h>
 #include <deal.II/base/exceptions.h>
+#include <deal.II/dofs/dof_levels.h>
 
 #include <vector>
 
@@ -222,17 +223,17 @@ namespace internal
                            const unsigned int fe_index);
 
       /**
-       * Return a pointer to the beginning of the DoF indices cache for a
+       * Return an iterator to the beginning of the DoF indices cache for a
        * given cell.
        *
        * @param obj_index The number of the cell we are looking at.
        * @param dofs_per_cell The number of DoFs per cell for this cell. This
        * is not used for the hp case but necessary to keep the interface the
        * same as for the non-hp case.
-       * @return A pointer to the first DoF index for the current cell. The
+       * @return An iterator to the first DoF index for the current cell. The
        * next dofs_per_cell indices are for the current cell.
        */
-      const types::global_dof_index *
+      dealii::internal::DoFHandler::CellDoFIndexIterator
       get_cell_cache_start (const unsigned int obj_index,
                             const unsigned int dofs_per_cell) const;
 
@@ -386,7 +387,7 @@ namespace internal
 
 
     inline
-    const types::global_dof_index *
+    dealii::internal::DoFHandler::CellDoFIndexIterator
     DoFLevel::get_cell_cache_start (const unsigned int obj_index,
                                     const unsigned int dofs_per_cell) const
     {
@@ -398,7 +399,8 @@ namespace internal
               cell_dof_indices_cache.size(),
               ExcInternalError());
 
-      return &cell_dof_indices_cache[cell_cache_offsets[obj_index]];
+      return dealii::internal::DoFHandler::CellDoFIndexIterator
+             (&cell_dof_indices_cache[cell_cache_offsets[obj_index]]);
     }
 
     template <class Archive>
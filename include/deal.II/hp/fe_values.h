@@ -43,7 +43,12 @@ namespace internal
      * quadrature object from their corresponding collection objects there is
      * a matching ::FEValues, ::FEFaceValues, or ::FESubfaceValues object. To
      * make things more efficient, however, these FE*Values objects are only
-     * created once requested (lazy allocation).
+     * created once requested (lazy allocation). Alternatively, all of them can
+     * be created up front by calling precalculate_fe_values(), for example
+     * before the object is used as part of the scratch data of
+     * WorkStream::run(), so that the assembly loop does not need to set up
+     * any FE*Values objects (and allocate their memory) when it encounters a
+     * new combination of indices.
      *
      * The first template parameter denotes the space dimension we are in, the
      * second the dimensionality of the object that we integrate on, i.e. for
@@ -77,6 +82,25 @@ namespace internal
                     const dealii::hp::QCollection<q_dim> &q_collection,
                     const UpdateFlags         update_flags);
 
+      /**
+       * Copy constructor. The FE*Values objects of @p other are not shared
+       * with the new object since they are not safe to be used concurrently.
+       * Rather, a new FE*Values object is created for every combination of
+       * indices for which @p other has already created one. This way, copies
+       * of an object on which precalculate_fe_values() has been called (as
+       * done by WorkStream::run() for the scratch data of each thread) are
+       * fully set up as well. The objects are created in parallel.
+       */
+      FEValuesBase (const FEValuesBase<dim,q_dim,FEValuesType> &other);
+
+      /**
+       * Create the FE*Values objects for all combinations of finite element,
+       * mapping, and quadrature indices of the collections that have not been
+       * created yet, rather than creating them lazily on first use in
+       * select_fe_values(). The objects are created in parallel.
+       */
+      void precalculate_fe_values ();
+
       /**
        * Get a reference to the collection of finite element objects used
        * here.
@@ -123,6 +147,24 @@ namespace internal
                         const unsigned int mapping_index,
                         const unsigned int q_index);
 
+    private:
+      /**
+       * Copy operator. Assigning would either share the FE*Values objects of
+       * the right hand side, which are not safe to be used concurrently, or
+       * have to re-create all of them. Since neither is desirable, we make it
+       * private, and also do not implement it. Use the copy constructor
+       * instead.
+       */
+      FEValuesBase &operator= (const FEValuesBase &);
+
+      /**
+       * Create the FEValues object for the given combination of indices and
+       * store it in the fe_values_table. Different objects can be created
+       * concurrently by this function. The index is taken by value so that
+       * tasks started with Threads::new_task() get their own copy of it.
+       */
+      void create_fe_values (const TableIndices<3> index);
+
     protected:
       /**
        * A pointer to the collection of finite elements to be used.
@@ -151,7 +193,8 @@ namespace internal
        * within the q_collection.
        *
        * Initially, all entries have zero pointers, and we will allocate them
-       * lazily as needed in select_fe_values().
+       * lazily as needed in select_fe_values() or all at once in
+       * precalculate_fe_values().
        */
       dealii::Table<3,std_cxx11::shared_ptr<FEValuesType> > fe_values_table;
 
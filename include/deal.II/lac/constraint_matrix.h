@@ -50,15 +50,6 @@ namespace internals
 }
 
 
-//TODO[WB]: We should have a function of the kind
-//   ConstraintMatrix::add_constraint (const size_type constrained_dof,
-//                const std::vector<std::pair<size_type, double> > &entries,
-//                const double inhomogeneity = 0);
-// rather than building up constraints piecemeal through add_line/add_entry
-// etc. This would also eliminate the possibility of accidentally changing
-// existing constraints into something pointless, see the discussion on the
-// mailing list on "Tiny bug in interpolate_boundary_values" in Sept. 2010.
-
 /**
  * This class implements dealing with linear (possibly inhomogeneous)
  * constraints on degrees of freedom. The concept and origin of such
@@ -325,6 +316,25 @@ public:
   void set_inhomogeneity (const size_type line,
                           const double    value);
 
+  /**
+   * Add the complete constraint for the degree of freedom @p line at once:
+   * the entries given as pairs of column indices and values, and the
+   * inhomogeneity. If @p line is already constrained, the existing
+   * constraint is left untouched and the function returns @p false;
+   * otherwise, it returns @p true.
+   *
+   * This function is equivalent to calling add_line(), add_entries() and
+   * set_inhomogeneity() for a line that is not yet constrained, but is
+   * faster since it neither searches the new line for existing entries nor
+   * grows its list of entries piecemeal. Consequently, the column indices
+   * in @p col_val_pairs must be unique. In contrast to building up a
+   * constraint piecemeal, this function can not accidentally change an
+   * existing constraint.
+   */
+  bool add_constraint (const size_type                                  line,
+                       const std::vector<std::pair<size_type,double> > &col_val_pairs,
+                       const double                                     inhomogeneity = 0.);
+
   /**
    * Close the filling of entries. Since the lines of a matrix of this type
    * are usually filled in an arbitrary order and since we do not want to use
@@ -344,6 +354,16 @@ public:
    * \frac{u_3}{2} + \frac{u_2}{4} + \frac{u_4}{4}$. Note, however, that
    * cycles in this graph of constraints are not allowed, i.e. for example
    * $u_4$ may not be constrained, directly or indirectly, to $u_{13}$ again.
+   *
+   * Chains are not resolved by repeatedly sweeping over all lines. Rather,
+   * the lines are first ordered by the length of the longest chain that
+   * starts at them, and each line is then resolved exactly once, using the
+   * already resolved lines of the degrees of freedom it refers to. Lines of
+   * the same chain length do not depend on each other and are resolved and
+   * sorted in parallel. Lines that have been resolved by a previous call to
+   * this function (for example when other constraints are merged into a
+   * closed object) refer to no constrained degrees of freedom any more and
+   * are only checked, not expanded again.
    */
   void close ();
 
@@ -353,7 +373,9 @@ public:
    * be closed (by having their function close() called before). If this
    * object was closed before, then it will be closed afterwards as well.
    * Note, however, that if the other argument is closed, then merging may be
-   * significantly faster.
+   * significantly faster. Closing again after a merge is incremental: only
+   * the newly added lines need to be sorted into the list of lines, and only
+   * lines that refer to newly constrained degrees of freedom are expanded.
    *
    * Using the default value of the second arguments, the constraints in each
    * of the two objects (the old one represented by this object and the
@@ -895,6 +917,38 @@ public:
                               VectorType                    &global_vector,
                               bool                          use_inhomogeneities_for_rhs = false) const;
 
+  /**
+   * Do the same as the previous function, but for the contributions of many
+   * cells at once. The <tt>c</tt>th elements of @p local_matrices, @p
+   * local_vectors and @p local_dof_indices describe the contributions of one
+   * cell, exactly as the first three arguments of the previous function.
+   *
+   * This function is meant for the copier of WorkStream::run(), or any other
+   * place where the contributions of several cells are available at the
+   * same time. It first resolves the constraints for all cells in parallel
+   * without touching the global objects. It then writes the resulting
+   * entries into @p global_matrix and @p global_vector row by row, with
+   * different threads working on different ranges of rows. This second step
+   * is only done in parallel if the matrix is a SparseMatrix or
+   * BlockSparseMatrix and the vector a Vector or BlockVector; for all other
+   * classes, the rows are written by the calling thread.
+   *
+   * The contributions of the cells are added to each global entry in the
+   * order in which the cells are given, so the result is the same as when
+   * calling the previous function for one cell after the other. Unlike in
+   * the previous function, the local contributions are first stored in
+   * temporary arrays, so the memory needed grows with the number of cells in
+   * the batch.
+   */
+  template <typename MatrixType, typename VectorType>
+  void
+  distribute_local_to_global (const std::vector<FullMatrix<typename MatrixType::value_type> > &local_matrices,
+                              const std::vector<Vector<typename VectorType::value_type> >     &local_vectors,
+                              const std::vector<std::vector<size_type> >                      &local_dof_indices,
+                              MatrixType                                                      &global_matrix,
+                              VectorType                                                      &global_vector,
+                              bool                                                             use_inhomogeneities_for_rhs = false) const;
+
   /**
    * Do a similar operation as the distribute_local_to_global() function that
    * distributes writing entries into a matrix for constrained degrees of
@@ -1241,6 +1295,27 @@ private:
    */
   bool sorted;
 
+  /**
+   * A compact copy of the homogeneous parts of all constraint lines, built
+   * by close(). The entries of the line stored at position <tt>i</tt> of
+   * the #lines array are the elements
+   * <tt>closed_entry_offsets[i]</tt> to <tt>closed_entry_offsets[i+1]</tt>
+   * of #closed_entries, i.e., all entries are stored contiguously in the
+   * order of the lines. The loops in distribute() and
+   * distribute_local_to_global() that look up the constraints of many
+   * degrees of freedom read from these two arrays, rather than from the
+   * separately allocated entries of each line.
+   *
+   * Both arrays are empty as long as the object is not closed.
+   */
+  std::vector<size_type> closed_entry_offsets;
+
+  /**
+   * The entries of all constraint lines after close(). See
+   * #closed_entry_offsets.
+   */
+  ConstraintLine::Entries closed_entries;
+
   /**
    * Internal function to calculate the index of line @p line in the vector
    * lines_cache using local_lines.
@@ -1253,6 +1328,53 @@ private:
    */
   static bool check_zero_weight (const std::pair<size_type, double> &p);
 
+  /**
+   * Return the position within the #lines array of the constraint line of
+   * degree of freedom @p index if this degree of freedom is constrained and
+   * its constraint is stored on the current processor, and
+   * numbers::invalid_size_type otherwise. This is the test close() uses to
+   * determine whether an entry of a line is part of a chain of constraints.
+   */
+  size_type find_chained_line (const size_type index) const;
+
+  /**
+   * Do the work of close(). If @p changed_lines is a null pointer, all
+   * lines are resolved. Otherwise, only the lines of the degrees of freedom
+   * listed in @p changed_lines are stripped of zero entries, resolved,
+   * sorted and compressed. All other lines must have been closed before and
+   * must not refer to constrained degrees of freedom. merge() uses this to
+   * close only the lines it added or modified.
+   */
+  void do_close (const std::vector<size_type> *changed_lines);
+
+  /**
+   * Resolve the chains of constraints in the lines whose positions in the
+   * #lines array are given by the elements <tt>begin</tt> to <tt>end</tt> of
+   * @p line_order, and sort, compress and rescale their entries. All lines
+   * these lines refer to must already have been treated. This function is
+   * used by close() on subranges of lines that can be treated in parallel.
+   */
+  void close_lines (const std::vector<size_type> &line_order,
+                    const size_type               begin,
+                    const size_type               end);
+
+  /**
+   * Return a pointer to the first entry of the line stored at position @p
+   * line_position of the #lines array. If the object is closed, the pointer
+   * points into #closed_entries, otherwise into the entries of the line
+   * itself. Together with line_entries_end(), this gives the range of
+   * entries of a line in either state.
+   */
+  const std::pair<size_type,double> *
+  line_entries_begin (const size_type line_position) const;
+
+  /**
+   * Return a pointer past the last entry of the line stored at position @p
+   * line_position of the #lines array. See line_entries_begin().
+   */
+  const std::pair<size_type,double> *
+  line_entries_end (const size_type line_position) const;
+
   /**
    * Dummy table that serves as default argument for function
    * <tt>add_entries_local_to_global()</tt>.
@@ -1377,7 +1499,9 @@ ConstraintMatrix::ConstraintMatrix (const ConstraintMatrix &constraint_matrix)
   lines (constraint_matrix.lines),
   lines_cache (constraint_matrix.lines_cache),
   local_lines (constraint_matrix.local_lines),
-  sorted (constraint_matrix.sorted)
+  sorted (constraint_matrix.sorted),
+  closed_entry_offsets (constraint_matrix.closed_entry_offsets),
+  closed_entries (constraint_matrix.closed_entries)
 {}
 
 
@@ -1553,6 +1677,40 @@ ConstraintMatrix::calculate_line_index (const size_type line) const
 
 
 
+inline
+const std::pair<ConstraintMatrix::size_type,double> *
+ConstraintMatrix::line_entries_begin (const size_type line_position) const
+{
+  AssertIndexRange (line_position, lines.size());
+  if (sorted == true)
+    return (closed_entries.empty() ?
+            0 :
+            &closed_entries[0] + closed_entry_offsets[line_position]);
+  else
+    return (lines[line_position].entries.empty() ?
+            0 :
+            &lines[line_position].entries[0]);
+}
+
+
+
+inline
+const std::pair<ConstraintMatrix::size_type,double> *
+ConstraintMatrix::line_entries_end (const size_type line_position) const
+{
+  AssertIndexRange (line_position, lines.size());
+  if (sorted == true)
+    return (closed_entries.empty() ?
+            0 :
+            &closed_entries[0] + closed_entry_offsets[line_position+1]);
+  else
+    return (lines[line_position].entries.empty() ?
+            0 :
+            &lines[line_position].entries[0] + lines[line_position].entries.size());
+}
+
+
+
 inline bool
 ConstraintMatrix::can_store_line (size_type line_index) const
 {
@@ -1583,11 +1741,14 @@ void ConstraintMatrix::distribute_local_to_global (
     global_vector(index) += value;
   else
     {
-      const ConstraintLine &position =
-        lines[lines_cache[calculate_line_index(index)]];
-      for (size_type j=0; j<position.entries.size(); ++j)
-        global_vector(position.entries[j].first)
-        += value * position.entries[j].second;
+      const size_type position =
+        lines_cache[calculate_line_index(index)];
+      for (const std::pair<size_type,double>
+           *entry = line_entries_begin(position),
+           *end = line_entries_end(position);
+           entry != end; ++entry)
+        global_vector(entry->first)
+        += value * entry->second;
     }
 }
 
@@ -1609,11 +1770,14 @@ void ConstraintMatrix::distribute_local_to_global (
         global_vector(*local_indices_begin) += *local_vector_begin;
       else
         {
-          const ConstraintLine &position =
-            lines[lines_cache[calculate_line_index(*local_indices_begin)]];
-          for (size_type j=0; j<position.entries.size(); ++j)
-            global_vector(position.entries[j].first)
-            += *local_vector_begin * position.entries[j].second;
+          const size_type position =
+            lines_cache[calculate_line_index(*local_indices_begin)];
+          for (const std::pair<size_type,double>
+               *entry = line_entries_begin(position),
+               *end = line_entries_end(position);
+               entry != end; ++entry)
+            global_vector(entry->first)
+            += *local_vector_begin * entry->second;
         }
     }
 }
@@ -1651,12 +1815,15 @@ void ConstraintMatrix::get_dof_values (const VectorType  &global_vector,
         *local_vector_begin = global_vector(*local_indices_begin);
       else
         {
-          const ConstraintLine &position =
-            lines[lines_cache[calculate_line_index(*local_indices_begin)]];
-          typename VectorType::value_type value = position.inhomogeneity;
-          for (size_type j=0; j<position.entries.size(); ++j)
-            value += (global_vector(position.entries[j].first) *
-                      position.entries[j].second);
+          const size_type position =
+            lines_cache[calculate_line_index(*local_indices_begin)];
+          typename VectorType::value_type value = lines[position].inhomogeneity;
+          for (const std::pair<size_type,double>
+               *entry = line_entries_begin(position),
+               *end = line_entries_end(position);
+               entry != end; ++entry)
+            value += (global_vector(entry->first) *
+                      entry->second);
           *local_vector_begin = value;
         }
     }
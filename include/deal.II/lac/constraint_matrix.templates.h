@@ -21,6 +21,9 @@
 #include <deal.II/lac/constraint_matrix.h>
 
 #include <deal.II/base/table.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/std_cxx11/bind.h>
 #include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/sparsity_pattern.h>
 #include <deal.II/lac/sparse_matrix.h>
@@ -647,14 +650,13 @@ distribute_local_to_global (const Vector<LocalType>      &local_vector,
 
         // find the constraint line to the given
         // global dof index
-        const size_type line_index = calculate_line_index (local_dof_indices[i]);
-        const ConstraintLine *position =
-          lines_cache.size() <= line_index ? 0 : &lines[lines_cache[line_index]];
+        const size_type position =
+          lines_cache[calculate_line_index (local_dof_indices[i])];
 
         // Gauss elimination of the matrix columns with the inhomogeneity.
         // Go through them one by one and again check whether they are
         // constrained. If so, distribute the constraint
-        const double val = position->inhomogeneity;
+        const double val = lines[position].inhomogeneity;
         if (val != 0)
           for (size_type j=0; j<n_local_dofs; ++j)
             {
@@ -669,31 +671,37 @@ distribute_local_to_global (const Vector<LocalType>      &local_vector,
               if (matrix_entry == LocalType())
                 continue;
 
-              const ConstraintLine &position_j =
-                lines[lines_cache[calculate_line_index(local_dof_indices[j])]];
+              const size_type position_j =
+                lines_cache[calculate_line_index(local_dof_indices[j])];
 
-              for (size_type q=0; q<position_j.entries.size(); ++q)
+              for (const std::pair<size_type,double>
+                   *entry = line_entries_begin(position_j),
+                   *end = line_entries_end(position_j);
+                   entry != end; ++entry)
                 {
                   Assert (!(!local_lines.size()
-                            || local_lines.is_element(position_j.entries[q].first))
-                          || is_constrained(position_j.entries[q].first) == false,
+                            || local_lines.is_element(entry->first))
+                          || is_constrained(entry->first) == false,
                           ExcMessage ("Tried to distribute to a fixed dof."));
-                  global_vector(position_j.entries[q].first)
-                  -= val * position_j.entries[q].second * matrix_entry;
+                  global_vector(entry->first)
+                  -= val * entry->second * matrix_entry;
                 }
             }
 
         // now distribute the constraint,
         // but make sure we don't touch
         // the entries of fixed dofs
-        for (size_type j=0; j<position->entries.size(); ++j)
+        for (const std::pair<size_type,double>
+             *entry = line_entries_begin(position),
+             *end = line_entries_end(position);
+             entry != end; ++entry)
           {
             Assert (!(!local_lines.size()
-                      || local_lines.is_element(position->entries[j].first))
-                    || is_constrained(position->entries[j].first) == false,
+                      || local_lines.is_element(entry->first))
+                    || is_constrained(entry->first) == false,
                     ExcMessage ("Tried to distribute to a fixed dof."));
-            global_vector(position->entries[j].first)
-            += local_vector(i) * position->entries[j].second;
+            global_vector(entry->first)
+            += local_vector(i) * entry->second;
           }
       }
 }
@@ -838,13 +846,13 @@ ConstraintMatrix::distribute (VectorType &vec) const
       // and finally throw away the ghosted vector. Implement this in the following.
       IndexSet needed_elements = vec_owned_elements;
 
-      typedef std::vector<ConstraintLine>::const_iterator constraint_iterator;
-      for (constraint_iterator it = lines.begin();
-           it != lines.end(); ++it)
-        if (vec_owned_elements.is_element(it->line))
-          for (unsigned int i=0; i<it->entries.size(); ++i)
-            if (!vec_owned_elements.is_element(it->entries[i].first))
-              needed_elements.add_index(it->entries[i].first);
+      for (size_type l=0; l<lines.size(); ++l)
+        if (vec_owned_elements.is_element(lines[l].line))
+          for (const std::pair<size_type,double>
+               *entry = line_entries_begin(l), *end = line_entries_end(l);
+               entry != end; ++entry)
+            if (!vec_owned_elements.is_element(entry->first))
+              needed_elements.add_index(entry->first);
 
       VectorType ghosted_vector;
       internal::import_vector_with_ghost_elements (vec,
@@ -852,18 +860,19 @@ ConstraintMatrix::distribute (VectorType &vec) const
                                                    ghosted_vector,
                                                    internal::bool2type<IsBlockVector<VectorType>::value>());
 
-      for (constraint_iterator it = lines.begin();
-           it != lines.end(); ++it)
-        if (vec_owned_elements.is_element(it->line))
+      for (size_type l=0; l<lines.size(); ++l)
+        if (vec_owned_elements.is_element(lines[l].line))
           {
             typename VectorType::value_type
-            new_value = it->inhomogeneity;
-            for (unsigned int i=0; i<it->entries.size(); ++i)
+            new_value = lines[l].inhomogeneity;
+            for (const std::pair<size_type,double>
+                 *entry = line_entries_begin(l), *end = line_entries_end(l);
+                 entry != end; ++entry)
               new_value += (static_cast<typename VectorType::value_type>
-                            (ghosted_vector(it->entries[i].first)) *
-                            it->entries[i].second);
+                            (ghosted_vector(entry->first)) *
+                            entry->second);
             AssertIsFinite(new_value);
-            vec(it->line) = new_value;
+            vec(lines[l].line) = new_value;
           }
 
       // now compress to communicate the entries that we added to
@@ -878,20 +887,21 @@ ConstraintMatrix::distribute (VectorType &vec) const
     // support anything else or because it's completely stored
     // locally)
     {
-      std::vector<ConstraintLine>::const_iterator next_constraint = lines.begin();
-      for (; next_constraint != lines.end(); ++next_constraint)
+      for (size_type l=0; l<lines.size(); ++l)
         {
-          // fill entry in line
-          // next_constraint.line by adding the
-          // different contributions
+          // fill entry in line lines[l].line by adding the different
+          // contributions, reading the entries of all lines in the order
+          // in which they are stored contiguously
           typename VectorType::value_type
-          new_value = next_constraint->inhomogeneity;
-          for (unsigned int i=0; i<next_constraint->entries.size(); ++i)
+          new_value = lines[l].inhomogeneity;
+          for (const std::pair<size_type,double>
+               *entry = line_entries_begin(l), *end = line_entries_end(l);
+               entry != end; ++entry)
             new_value += (static_cast<typename VectorType::value_type>
-                          (vec(next_constraint->entries[i].first)) *
-                          next_constraint->entries[i].second);
+                          (vec(entry->first)) *
+                          entry->second);
           AssertIsFinite(new_value);
-          vec(next_constraint->line) = new_value;
+          vec(lines[l].line) = new_value;
         }
     }
 }
@@ -2067,14 +2077,17 @@ make_sorted_row_list (const std::vector<size_type>   &local_dof_indices,
       AssertIndexRange(local_row, n_local_dofs);
       const size_type global_row = local_dof_indices[local_row];
       Assert (is_constrained(global_row), ExcInternalError());
-      const ConstraintLine &position =
-        lines[lines_cache[calculate_line_index(global_row)]];
-      if (position.inhomogeneity != 0)
+      const size_type position =
+        lines_cache[calculate_line_index(global_row)];
+      if (lines[position].inhomogeneity != 0)
         global_rows.set_ith_constraint_inhomogeneous (i);
-      for (size_type q=0; q<position.entries.size(); ++q)
-        global_rows.insert_index (position.entries[q].first,
+      for (const std::pair<size_type,double>
+           *entry = line_entries_begin(position),
+           *end = line_entries_end(position);
+           entry != end; ++entry)
+        global_rows.insert_index (entry->first,
                                   local_row,
-                                  position.entries[q].second);
+                                  entry->second);
     }
 }
 
@@ -2111,11 +2124,14 @@ make_sorted_row_list (const std::vector<size_type> &local_dof_indices,
       // remove constrained entry since we are going to resolve it in place
       active_dofs.pop_back();
       const size_type global_row = local_dof_indices[local_row];
-      const ConstraintLine &position =
-        lines[lines_cache[calculate_line_index(global_row)]];
-      for (size_type q=0; q<position.entries.size(); ++q)
+      const size_type position =
+        lines_cache[calculate_line_index(global_row)];
+      for (const std::pair<size_type,double>
+           *entry = line_entries_begin(position),
+           *end = line_entries_end(position);
+           entry != end; ++entry)
         {
-          const size_type new_index = position.entries[q].first;
+          const size_type new_index = entry->first;
           if (active_dofs[active_dofs.size()-i] < new_index)
             active_dofs.insert(active_dofs.end()-i+1,new_index);
 
@@ -2180,6 +2196,33 @@ resolve_vector_entry (const size_type                       i,
 }
 
 
+
+namespace internals
+{
+  // return a pointer to the given matrix if it is a deal.II SparseMatrix
+  // that distribute_local_to_global can write into directly, and a null
+  // pointer for all other matrix types. the overload for SparseMatrix is
+  // more specialized and therefore chosen whenever it matches
+  template <typename MatrixType>
+  inline
+  SparseMatrix<typename MatrixType::value_type> *
+  get_sparse_matrix (MatrixType &)
+  {
+    return 0;
+  }
+
+
+
+  template <typename number>
+  inline
+  SparseMatrix<number> *
+  get_sparse_matrix (SparseMatrix<number> &matrix)
+  {
+    return &matrix;
+  }
+}
+
+
 // internal implementation for distribute_local_to_global for standard
 // (non-block) matrices
 template <typename MatrixType, typename VectorType>
@@ -2231,7 +2274,7 @@ ConstraintMatrix::distribute_local_to_global (
   std::vector<size_type> &cols = scratch_data->columns;
   std::vector<number>     &vals = scratch_data->values;
   SparseMatrix<number> *sparse_matrix
-    = dynamic_cast<SparseMatrix<number> *>(&global_matrix);
+    = internals::get_sparse_matrix (global_matrix);
   if (use_dealii_matrix == false)
     {
       cols.resize (n_actual_dofs);
@@ -2289,6 +2332,294 @@ ConstraintMatrix::distribute_local_to_global (
 
 
 
+namespace internals
+{
+  /**
+   * An object that takes the place of the global matrix when
+   * ConstraintMatrix::distribute_local_to_global() is called for the
+   * contributions of a single cell from the version of that function that
+   * works on many cells at once. It only records the entries written into
+   * it, sorted by row and column afterwards.
+   */
+  template <typename number>
+  class MatrixEntryRecorder
+  {
+  public:
+    typedef number value_type;
+
+    struct Entry
+    {
+      size_type row;
+      size_type column;
+      number    value;
+
+      bool operator < (const Entry &other) const
+      {
+        return (row < other.row
+                ||
+                (row == other.row && column < other.column));
+      }
+    };
+
+    MatrixEntryRecorder ()
+      :
+      n_rows (0)
+    {}
+
+    void reinit (const size_type size)
+    {
+      n_rows = size;
+      entries.clear ();
+    }
+
+    size_type m () const
+    {
+      return n_rows;
+    }
+
+    size_type n () const
+    {
+      return n_rows;
+    }
+
+    void add (const size_type row,
+              const size_type column,
+              const number    value)
+    {
+      const Entry entry = { row, column, value };
+      entries.push_back (entry);
+    }
+
+    void add (const size_type  row,
+              const size_type  n_cols,
+              const size_type *col_indices,
+              const number    *values,
+              const bool       elide_zero_values,
+              const bool       /*col_indices_are_sorted*/)
+    {
+      for (size_type j=0; j<n_cols; ++j)
+        if (elide_zero_values == false || values[j] != number())
+          add (row, col_indices[j], values[j]);
+    }
+
+    size_type          n_rows;
+    std::vector<Entry> entries;
+  };
+
+
+
+  /**
+   * The counterpart of MatrixEntryRecorder for the global vector. Each
+   * access through operator() appends a new entry with value zero and
+   * returns a reference to it, which is all that is needed for the
+   * <tt>global_vector(i) += value</tt> statements in
+   * ConstraintMatrix::distribute_local_to_global().
+   */
+  template <typename number>
+  class VectorEntryRecorder
+  {
+  public:
+    typedef number value_type;
+
+    struct Entry
+    {
+      size_type index;
+      number    value;
+
+      bool operator < (const Entry &other) const
+      {
+        return index < other.index;
+      }
+    };
+
+    VectorEntryRecorder ()
+      :
+      vector_size (0)
+    {}
+
+    void reinit (const size_type size)
+    {
+      vector_size = size;
+      entries.clear ();
+    }
+
+    size_type size () const
+    {
+      return vector_size;
+    }
+
+    number &operator() (const size_type index)
+    {
+      const Entry entry = { index, number() };
+      entries.push_back (entry);
+      return entries.back().value;
+    }
+
+    size_type          vector_size;
+    std::vector<Entry> entries;
+  };
+
+
+
+  // resolve the constraints for the cells begin to end of a batch and record
+  // the resulting matrix and vector entries, sorted by rows
+  template <typename number, typename VectorNumber>
+  void
+  record_local_to_global (const ConstraintMatrix                       &constraints,
+                          const std::vector<FullMatrix<number> >       &local_matrices,
+                          const std::vector<Vector<VectorNumber> >     &local_vectors,
+                          const std::vector<std::vector<size_type> >   &local_dof_indices,
+                          const bool                                    use_inhomogeneities_for_rhs,
+                          std::vector<MatrixEntryRecorder<number> >       &matrix_entries,
+                          std::vector<VectorEntryRecorder<VectorNumber> > &vector_entries,
+                          const size_type                               begin,
+                          const size_type                               end)
+  {
+    for (size_type c=begin; c<end; ++c)
+      {
+        constraints.distribute_local_to_global (local_matrices[c],
+                                                local_vectors[c],
+                                                local_dof_indices[c],
+                                                matrix_entries[c],
+                                                vector_entries[c],
+                                                use_inhomogeneities_for_rhs);
+        std::stable_sort (matrix_entries[c].entries.begin(),
+                          matrix_entries[c].entries.end());
+        std::stable_sort (vector_entries[c].entries.begin(),
+                          vector_entries[c].entries.end());
+      }
+  }
+
+
+
+  // write the recorded entries of all cells that fall into the rows
+  // begin_row to end_row into the global objects. cells are treated in the
+  // order in which they were given, so each global entry receives the
+  // contributions of the cells in the same order as if the cells had been
+  // distributed one after the other
+  template <typename MatrixType, typename VectorType>
+  void
+  write_recorded_entries (const std::vector<MatrixEntryRecorder<typename MatrixType::value_type> > &matrix_entries,
+                          const std::vector<VectorEntryRecorder<typename VectorType::value_type> > &vector_entries,
+                          MatrixType                                   &global_matrix,
+                          VectorType                                   &global_vector,
+                          const size_type                               begin_row,
+                          const size_type                               end_row)
+  {
+    typedef typename MatrixType::value_type number;
+    typedef typename MatrixEntryRecorder<number>::Entry MatrixEntry;
+    typedef typename VectorEntryRecorder<typename VectorType::value_type>::Entry VectorEntry;
+
+    std::vector<size_type> columns;
+    std::vector<number>    values;
+    for (size_type c=0; c<matrix_entries.size(); ++c)
+      {
+        const std::vector<MatrixEntry> &entries = matrix_entries[c].entries;
+        const MatrixEntry first = { begin_row, 0, number() };
+        typename std::vector<MatrixEntry>::const_iterator
+        entry = std::lower_bound (entries.begin(), entries.end(), first);
+        while (entry != entries.end() && entry->row < end_row)
+          {
+            const size_type row = entry->row;
+            columns.clear ();
+            values.clear ();
+            for (; entry != entries.end() && entry->row == row; ++entry)
+              {
+                columns.push_back (entry->column);
+                values.push_back (entry->value);
+              }
+            global_matrix.add (row, columns.size(), &columns[0], &values[0],
+                               false, true);
+          }
+
+        const std::vector<VectorEntry> &vector_values = vector_entries[c].entries;
+        const VectorEntry first_value = { begin_row, typename VectorType::value_type() };
+        for (typename std::vector<VectorEntry>::const_iterator
+             value = std::lower_bound (vector_values.begin(), vector_values.end(),
+                                       first_value);
+             value != vector_values.end() && value->index < end_row; ++value)
+          global_vector(value->index) += value->value;
+      }
+  }
+}
+
+
+
+template <typename MatrixType, typename VectorType>
+void
+ConstraintMatrix::distribute_local_to_global (
+  const std::vector<FullMatrix<typename MatrixType::value_type> > &local_matrices,
+  const std::vector<Vector<typename VectorType::value_type> >     &local_vectors,
+  const std::vector<std::vector<size_type> >                      &local_dof_indices,
+  MatrixType                                                      &global_matrix,
+  VectorType                                                      &global_vector,
+  bool                                                             use_inhomogeneities_for_rhs) const
+{
+  typedef typename MatrixType::value_type number;
+  typedef typename VectorType::value_type vector_number;
+
+  AssertDimension (local_matrices.size(), local_dof_indices.size());
+  AssertDimension (local_vectors.size(), local_dof_indices.size());
+  Assert (global_matrix.m() == global_matrix.n(), ExcNotQuadratic());
+  Assert (lines.empty() || sorted == true, ExcMatrixNotClosed());
+
+  const size_type n_cells = local_dof_indices.size();
+  std::vector<internals::MatrixEntryRecorder<number> > matrix_entries (n_cells);
+  std::vector<internals::VectorEntryRecorder<vector_number> > vector_entries (n_cells);
+  for (size_type c=0; c<n_cells; ++c)
+    {
+      matrix_entries[c].reinit (global_matrix.m());
+      vector_entries[c].reinit (global_vector.size());
+    }
+
+  // first resolve the constraints of all cells independently of each
+  // other. this is the expensive part and does not touch the global objects
+  parallel::apply_to_subranges (size_type(0), n_cells,
+                                std_cxx11::bind (&internals::record_local_to_global<number,vector_number>,
+                                                 std_cxx11::cref(*this),
+                                                 std_cxx11::cref(local_matrices),
+                                                 std_cxx11::cref(local_vectors),
+                                                 std_cxx11::cref(local_dof_indices),
+                                                 use_inhomogeneities_for_rhs,
+                                                 std_cxx11::ref(matrix_entries),
+                                                 std_cxx11::ref(vector_entries),
+                                                 std_cxx11::_1,
+                                                 std_cxx11::_2),
+                                8);
+
+  // then write the entries into the global objects. different threads work
+  // on different ranges of rows, which is only safe for matrix and vector
+  // classes that allow writing into different rows at the same time. for
+  // all others, write all rows at once
+  const bool write_rows_in_parallel =
+    ((types_are_equal<MatrixType,SparseMatrix<number> >::value
+      ||
+      types_are_equal<MatrixType,BlockSparseMatrix<number> >::value)
+     &&
+     (types_are_equal<VectorType,Vector<vector_number> >::value
+      ||
+      types_are_equal<VectorType,BlockVector<vector_number> >::value));
+
+  const size_type n_rows = global_matrix.m();
+  if (write_rows_in_parallel == true)
+    parallel::apply_to_subranges (size_type(0), n_rows,
+                                  std_cxx11::bind (&internals::write_recorded_entries<MatrixType,VectorType>,
+                                                   std_cxx11::cref(matrix_entries),
+                                                   std_cxx11::cref(vector_entries),
+                                                   std_cxx11::ref(global_matrix),
+                                                   std_cxx11::ref(global_vector),
+                                                   std_cxx11::_1,
+                                                   std_cxx11::_2),
+                                  std::max (n_rows / (4*MultithreadInfo::n_threads()),
+                                            size_type(1)));
+  else
+    internals::write_recorded_entries (matrix_entries, vector_entries,
+                                       global_matrix, global_vector,
+                                       size_type(0), n_rows);
+}
+
+
+
 template <typename MatrixType>
 void
 ConstraintMatrix::distribute_local_to_global (
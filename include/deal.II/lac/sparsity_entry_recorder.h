@@ -0,0 +1,214 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii__sparsity_entry_recorder_h
+#define dealii__sparsity_entry_recorder_h
+
+
+#include <deal.II/base/config.h>
+#include <deal.II/base/types.h>
+
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internals
+{
+  /**
+   * A class that offers the part of the interface of a sparsity pattern
+   * that ConstraintMatrix::add_entries_local_to_global() uses, but only
+   * records the entries added to it. The recorded entries can later be
+   * written into an actual sparsity pattern by replay(), in the same order
+   * in which they were added.
+   *
+   * This allows computing the entries of several cells concurrently, each
+   * into its own object of this class, and writing them into a sparsity
+   * pattern that does not support concurrent additions one cell after the
+   * other.
+   */
+  class SparsityEntryRecorder
+  {
+  public:
+    /**
+     * Declare type for container size.
+     */
+    typedef types::global_dof_index size_type;
+
+    /**
+     * Constructor. The sizes are the ones reported by n_rows() and n_cols(),
+     * which should match those of the sparsity pattern into which the
+     * entries will be written.
+     */
+    SparsityEntryRecorder (const size_type n_rows = 0,
+                           const size_type n_cols = 0);
+
+    /**
+     * Remove all recorded entries, but keep the sizes and the memory
+     * allocated so far.
+     */
+    void clear ();
+
+    /**
+     * Return the number of rows of the pattern this object stands for.
+     */
+    size_type n_rows () const;
+
+    /**
+     * Return the number of columns of the pattern this object stands for.
+     */
+    size_type n_cols () const;
+
+    /**
+     * Record the entry (@p i, @p j).
+     */
+    void add (const size_type i,
+              const size_type j);
+
+    /**
+     * Record the entries in the given row at the columns given by the range
+     * [@p begin, @p end).
+     */
+    template <typename ForwardIterator>
+    void add_entries (const size_type row,
+                      ForwardIterator begin,
+                      ForwardIterator end,
+                      const bool      indices_are_sorted = false);
+
+    /**
+     * Add all recorded entries to @p sparsity, in the order in which they
+     * were recorded.
+     */
+    template <typename SparsityPatternType>
+    void replay (SparsityPatternType &sparsity) const;
+
+  private:
+    /**
+     * The sizes of the pattern this object stands for.
+     */
+    size_type rows;
+    size_type cols;
+
+    /**
+     * The row of each recorded call to add() or add_entries(), the end of
+     * its column indices in #columns, and whether these were sorted.
+     */
+    std::vector<size_type> run_rows;
+    std::vector<size_type> run_ends;
+    std::vector<bool>      run_is_sorted;
+
+    /**
+     * The column indices of all recorded entries.
+     */
+    std::vector<size_type> columns;
+  };
+
+
+
+  inline
+  SparsityEntryRecorder::SparsityEntryRecorder (const size_type n_rows,
+                                                const size_type n_cols)
+    :
+    rows (n_rows),
+    cols (n_cols)
+  {}
+
+
+
+  inline
+  void
+  SparsityEntryRecorder::clear ()
+  {
+    run_rows.clear ();
+    run_ends.clear ();
+    run_is_sorted.clear ();
+    columns.clear ();
+  }
+
+
+
+  inline
+  SparsityEntryRecorder::size_type
+  SparsityEntryRecorder::n_rows () const
+  {
+    return rows;
+  }
+
+
+
+  inline
+  SparsityEntryRecorder::size_type
+  SparsityEntryRecorder::n_cols () const
+  {
+    return cols;
+  }
+
+
+
+  inline
+  void
+  SparsityEntryRecorder::add (const size_type i,
+                              const size_type j)
+  {
+    columns.push_back (j);
+    run_rows.push_back (i);
+    run_ends.push_back (columns.size());
+    run_is_sorted.push_back (true);
+  }
+
+
+
+  template <typename ForwardIterator>
+  inline
+  void
+  SparsityEntryRecorder::add_entries (const size_type row,
+                                      ForwardIterator begin,
+                                      ForwardIterator end,
+                                      const bool      indices_are_sorted)
+  {
+    if (begin == end)
+      return;
+    columns.insert (columns.end(), begin, end);
+    run_rows.push_back (row);
+    run_ends.push_back (columns.size());
+    run_is_sorted.push_back (indices_are_sorted);
+  }
+
+
+
+  template <typename SparsityPatternType>
+  inline
+  void
+  SparsityEntryRecorder::replay (SparsityPatternType &sparsity) const
+  {
+    size_type run_begin = 0;
+    for (size_type run=0; run<run_rows.size(); ++run)
+      {
+        const size_type *begin = &columns[run_begin];
+        if (run_ends[run] == run_begin+1)
+          sparsity.add (run_rows[run], *begin);
+        else
+          sparsity.add_entries (run_rows[run],
+                                begin,
+                                begin + (run_ends[run] - run_begin),
+                                run_is_sorted[run]);
+        run_begin = run_ends[run];
+      }
+  }
+}
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
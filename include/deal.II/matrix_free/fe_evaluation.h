@@ -432,6 +432,27 @@ public:
   Tensor<1,n_components_,Tensor<2,dim,VectorizedArray<Number> > >
   get_hessian (const unsigned int q_point) const;
 
+  /**
+   * Write a contribution that is tested by the Hessian (second derivatives)
+   * of the basis functions to the field containing the values on quadrature
+   * points with component @p q_point. If applied before the function @p
+   * integrate(...,...,true) is called, this specifies what is tested by all
+   * basis function Hessians on the current cell and integrated over. Only
+   * the symmetric part of @p hessian_in enters the integral.
+   *
+   * On cells with a non-constant Jacobian, the second derivatives in real
+   * space also involve the gradients on the unit cell, multiplied by the
+   * derivatives of the Jacobian stored in MappingInfo. This contribution is
+   * added to the gradient part in integrate(), which therefore needs the
+   * update flag update_second_derivatives in MatrixFree::AdditionalData as
+   * for evaluate(...,...,true).
+   *
+   * Note that the derived class FEEvaluationAccess overloads this operation
+   * with specializations for the scalar case (n_components == 1).
+   */
+  void submit_hessian (const Tensor<1,n_components_,Tensor<2,dim,VectorizedArray<Number> > > hessian_in,
+                       const unsigned int q_point);
+
   /**
    * Returns the diagonal of the Hessian of a finite element function at
    * quadrature point number @p q_point after a call to @p evaluate(...,true).
@@ -851,18 +872,37 @@ protected:
 
   /**
    * Debug information to track whether values on quadrature points have been
-   * submitted for integration before the integration is actually stared. Used
-   * to control exceptions when uninitialized data is used.
+   * submitted for integration before the integration is actually started.
+   * Used to control exceptions when uninitialized data is used.
    */
   bool values_quad_submitted;
 
   /**
    * Debug information to track whether gradients on quadrature points have
-   * been submitted for integration before the integration is actually stared.
+   * been submitted for integration before the integration is actually started.
    * Used to control exceptions when uninitialized data is used.
    */
   bool gradients_quad_submitted;
 
+  /**
+   * Debug information to track whether Hessians on quadrature points have
+   * been submitted for integration before the integration is actually
+   * started. Used to control exceptions when uninitialized data is used.
+   */
+  bool hessians_quad_submitted;
+
+  /**
+   * Transforms the Hessians submitted through submit_hessian(), which are
+   * stored in real coordinates, to the contributions tested by the second
+   * derivatives on the unit cell. On cells with a general Jacobian, the
+   * contributions tested by the gradients on the unit cell are written into
+   * the gradient field: if @p add_into_gradients is true they are added to
+   * the values submitted through submit_gradient(), otherwise they overwrite
+   * the gradient field. Returns whether the gradient field has been written
+   * to.
+   */
+  bool transform_hessians_for_integration (const bool add_into_gradients);
+
   /**
    * Geometry data that can be generated FEValues on the fly with the
    * respective constructor.
@@ -1031,6 +1071,16 @@ public:
   Tensor<2,dim,VectorizedArray<Number> >
   get_hessian (unsigned int q_point) const;
 
+  /**
+   * Write a contribution that is tested by the Hessian of the basis
+   * functions to the field containing the values on quadrature points with
+   * component @p q_point. If applied before the function @p
+   * integrate(...,...,true) is called, this specifies what is tested by all
+   * basis function Hessians on the current cell and integrated over.
+   */
+  void submit_hessian (const Tensor<2,dim,VectorizedArray<Number> > hessian_in,
+                       const unsigned int q_point);
+
   /**
    * Returns the diagonal of the Hessian of a finite element function at
    * quadrature point number @p q_point after a call to @p evaluate(...,true).
@@ -1317,6 +1367,16 @@ public:
   Tensor<2,1,VectorizedArray<Number> >
   get_hessian (unsigned int q_point) const;
 
+  /**
+   * Write a contribution that is tested by the Hessian of the basis
+   * functions to the field containing the values on quadrature points with
+   * component @p q_point. If applied before the function @p
+   * integrate(...,...,true) is called, this specifies what is tested by all
+   * basis function Hessians on the current cell and integrated over.
+   */
+  void submit_hessian (const Tensor<2,1,VectorizedArray<Number> > hessian_in,
+                       const unsigned int q_point);
+
   /**
    * Returns the diagonal of the Hessian of a finite element function at
    * quadrature point number @p q_point after a call to @p evaluate(...,true).
@@ -1627,14 +1687,16 @@ public:
                  const bool evaluate_hess = false);
 
   /**
-   * This function takes the values and/or gradients that are stored on
-   * quadrature points, tests them by all the basis functions/gradients on the
-   * cell and performs the cell integration. The two function arguments @p
-   * integrate_val and @p integrate_grad are used to enable/disable some of
-   * values or gradients.
+   * This function takes the values, gradients, and/or Hessians that are
+   * stored on quadrature points, tests them by all the basis
+   * functions/gradients/Hessians on the cell and performs the cell
+   * integration. The three function arguments @p integrate_val, @p
+   * integrate_grad and @p integrate_hess are used to enable/disable some of
+   * values, gradients or Hessians.
    */
   void integrate (const bool integrate_val,
-                  const bool integrate_grad);
+                  const bool integrate_grad,
+                  const bool integrate_hess = false);
 
   /**
    * Returns the q-th quadrature point stored in MappingInfo.
@@ -1685,8 +1747,10 @@ private:
                           VectorizedArray<Number> *values_dofs_actual[],
                           VectorizedArray<Number> *values_quad[],
                           VectorizedArray<Number> *gradients_quad[][dim],
+                          VectorizedArray<Number> *hessians_quad[][(dim*(dim+1))/2],
                           const bool               evaluate_val,
-                          const bool               evaluate_grad);
+                          const bool               evaluate_grad,
+                          const bool               evaluate_hess);
 };
 
 
@@ -1983,6 +2047,7 @@ FEEvaluationBase<dim,n_components_,Number>::reinit (const unsigned int cell_in)
   values_quad_initialized     = false;
   gradients_quad_initialized  = false;
   hessians_quad_initialized   = false;
+  hessians_quad_submitted     = false;
 #endif
 }
 
@@ -3468,6 +3533,146 @@ FEEvaluationBase<dim,n_components_,Number>
 
 
 
+template <int dim, int n_components_, typename Number>
+inline
+void
+FEEvaluationBase<dim,n_components_,Number>
+::submit_hessian (const Tensor<1,n_components_,Tensor<2,dim,VectorizedArray<Number> > > hessian_in,
+                  const unsigned int q_point)
+{
+#ifdef DEBUG
+  Assert (this->cell != numbers::invalid_unsigned_int, ExcNotInitialized());
+  AssertIndexRange (q_point, this->data->n_q_points);
+  this->hessians_quad_submitted = true;
+#endif
+
+  // store the symmetric part of the Hessian times JxW in real
+  // coordinates. The transformation to the unit cell is done in
+  // transform_hessians_for_integration() because on general cells it also
+  // involves the gradient field, which might not have been submitted yet
+  const VectorizedArray<Number> JxW =
+    this->cell_type == internal::MatrixFreeFunctions::general ?
+    J_value[q_point] : J_value[0] * quadrature_weights[q_point];
+  const VectorizedArray<Number> half_JxW = make_vectorized_array<Number>(0.5) * JxW;
+  for (unsigned int comp=0; comp<n_components; ++comp)
+    {
+      for (unsigned int d=0; d<dim; ++d)
+        this->hessians_quad[comp][d][q_point] = hessian_in[comp][d][d] * JxW;
+      for (unsigned int d=0, count=dim; d<dim; ++d)
+        for (unsigned int e=d+1; e<dim; ++e, ++count)
+          this->hessians_quad[comp][count][q_point] =
+            (hessian_in[comp][d][e] + hessian_in[comp][e][d]) * half_JxW;
+    }
+}
+
+
+
+template <int dim, int n_components_, typename Number>
+inline
+bool
+FEEvaluationBase<dim,n_components_,Number>
+::transform_hessians_for_integration (const bool add_into_gradients)
+{
+  const unsigned int n_q_points = this->data->n_q_points;
+
+  // Cartesian cell: the Jacobian is diagonal, so the off-diagonal entries
+  // only need to be counted twice for the two symmetric second derivatives
+  if (this->cell_type == internal::MatrixFreeFunctions::cartesian)
+    {
+      const Tensor<1,dim,VectorizedArray<Number> > &jac = cartesian_data[0];
+      VectorizedArray<Number> factors[(dim*(dim+1))/2];
+      for (unsigned int d=0; d<dim; ++d)
+        factors[d] = jac[d] * jac[d];
+      for (unsigned int d=0, count=dim; d<dim; ++d)
+        for (unsigned int e=d+1; e<dim; ++e, ++count)
+          factors[count] = make_vectorized_array<Number>(2.) * jac[d] * jac[e];
+      for (unsigned int comp=0; comp<n_components; ++comp)
+        for (unsigned int d=0; d<(dim*(dim+1))/2; ++d)
+          for (unsigned int q=0; q<n_q_points; ++q)
+            this->hessians_quad[comp][d][q] *= factors[d];
+      return false;
+    }
+
+  const bool general_cell =
+    this->cell_type == internal::MatrixFreeFunctions::general;
+  Assert (general_cell == false ||
+          this->mapping_info->second_derivatives_initialized == true,
+          ExcNotInitialized());
+
+  for (unsigned int q=0; q<n_q_points; ++q)
+    {
+      const Tensor<2,dim,VectorizedArray<Number> > &jac =
+        general_cell ? jacobian[q] : jacobian[0];
+      for (unsigned int comp=0; comp<n_components; ++comp)
+        {
+          // read the symmetric tensor in real coordinates before overwriting
+          // the field
+          VectorizedArray<Number> hess_real[dim][dim];
+          for (unsigned int d=0; d<dim; ++d)
+            hess_real[d][d] = this->hessians_quad[comp][d][q];
+          for (unsigned int d=0, count=dim; d<dim; ++d)
+            for (unsigned int e=d+1; e<dim; ++e, ++count)
+              hess_real[d][e] = hess_real[e][d] = this->hessians_quad[comp][count][q];
+
+          // compute J^T * hess_real * J, which is what is tested by the
+          // second derivatives on the unit cell. the off-diagonal entries are
+          // tested by both mixed derivatives, so count them twice
+          VectorizedArray<Number> tmp[dim][dim];
+          for (unsigned int d=0; d<dim; ++d)
+            for (unsigned int e=0; e<dim; ++e)
+              {
+                tmp[d][e] = hess_real[d][0] * jac[0][e];
+                for (unsigned int f=1; f<dim; ++f)
+                  tmp[d][e] += hess_real[d][f] * jac[f][e];
+              }
+          for (unsigned int d=0; d<dim; ++d)
+            {
+              VectorizedArray<Number> sum = jac[0][d] * tmp[0][d];
+              for (unsigned int f=1; f<dim; ++f)
+                sum += jac[f][d] * tmp[f][d];
+              this->hessians_quad[comp][d][q] = sum;
+            }
+          for (unsigned int d=0, count=dim; d<dim; ++d)
+            for (unsigned int e=d+1; e<dim; ++e, ++count)
+              {
+                VectorizedArray<Number> sum = jac[0][d] * tmp[0][e];
+                for (unsigned int f=1; f<dim; ++f)
+                  sum += jac[f][d] * tmp[f][e];
+                this->hessians_quad[comp][count][q] =
+                  make_vectorized_array<Number>(2.) * sum;
+              }
+
+          // on general cells, the derivative of the Jacobian times the
+          // gradient on the unit cell is part of the real-space Hessian, so
+          // the transpose of that term is tested by the unit cell gradients
+          if (general_cell)
+            {
+              const Tensor<2,dim,VectorizedArray<Number> > &jac_grad = jacobian_grad[q];
+              const Tensor<1,(dim>1?dim*(dim-1)/2:1),
+                    Tensor<1,dim,VectorizedArray<Number> > >
+                    & jac_grad_UT = jacobian_grad_upper[q];
+              for (unsigned int f=0; f<dim; ++f)
+                {
+                  VectorizedArray<Number> grad = hess_real[0][0] * jac_grad[0][f];
+                  for (unsigned int d=1; d<dim; ++d)
+                    grad += hess_real[d][d] * jac_grad[d][f];
+                  for (unsigned int d=0, count=0; d<dim; ++d)
+                    for (unsigned int e=d+1; e<dim; ++e, ++count)
+                      grad += make_vectorized_array<Number>(2.) * hess_real[d][e] *
+                              jac_grad_UT[count][f];
+                  if (add_into_gradients)
+                    this->gradients_quad[comp][f][q] += grad;
+                  else
+                    this->gradients_quad[comp][f][q] = grad;
+                }
+            }
+        }
+    }
+  return general_cell;
+}
+
+
+
 template <int dim, int n_components_, typename Number>
 inline
 Tensor<1,n_components_,Tensor<1,dim,VectorizedArray<Number> > >
@@ -3847,6 +4052,20 @@ FEEvaluationAccess<dim,1,Number>
 
 
 
+template <int dim, typename Number>
+inline
+void
+FEEvaluationAccess<dim,1,Number>
+::submit_hessian (const Tensor<2,dim,VectorizedArray<Number> > hessian_in,
+                  const unsigned int q_point)
+{
+  Tensor<1,1,Tensor<2,dim,VectorizedArray<Number> > > hessian;
+  hessian[0] = hessian_in;
+  BaseClass::submit_hessian(hessian, q_point);
+}
+
+
+
 template <int dim, typename Number>
 inline
 Tensor<1,dim,VectorizedArray<Number> >
@@ -4441,6 +4660,20 @@ FEEvaluationAccess<1,1,Number>
 
 
 
+template <typename Number>
+inline
+void
+FEEvaluationAccess<1,1,Number>
+::submit_hessian (const Tensor<2,1,VectorizedArray<Number> > hessian_in,
+                  const unsigned int q_point)
+{
+  Tensor<1,1,Tensor<2,1,VectorizedArray<Number> > > hessian;
+  hessian[0] = hessian_in;
+  BaseClass::submit_hessian(hessian, q_point);
+}
+
+
+
 template <typename Number>
 inline
 Tensor<1,1,VectorizedArray<Number> >
@@ -5705,8 +5938,10 @@ namespace internal
                     VectorizedArray<Number> *values_dofs_actual[],
                     VectorizedArray<Number> *values_quad[],
                     VectorizedArray<Number> *gradients_quad[][dim],
+                    VectorizedArray<Number> *hessians_quad[][(dim*(dim+1))/2],
                     const bool               evaluate_val,
-                    const bool               evaluate_grad);
+                    const bool               evaluate_grad,
+                    const bool               evaluate_hess);
   };
 
 
@@ -5925,8 +6160,10 @@ namespace internal
                VectorizedArray<Number> *values_dofs_actual[],
                VectorizedArray<Number> *values_quad[],
                VectorizedArray<Number> *gradients_quad[][dim],
+               VectorizedArray<Number> *hessians_quad[][(dim*(dim+1))/2],
                const bool               integrate_val,
-               const bool               integrate_grad)
+               const bool               integrate_grad,
+               const bool               integrate_hess)
   {
     const EvaluatorVariant variant =
       EvaluatorSelector<type,(fe_degree+n_q_points_1d>4)>::variant;
@@ -5961,6 +6198,13 @@ namespace internal
     // gradients_quad[2] only for dim==3.
     const unsigned int d1 = dim>1?1:0;
     const unsigned int d2 = dim>2?2:0;
+    const unsigned int d3 = dim>2?3:0;
+    const unsigned int d4 = dim>2?4:0;
+    const unsigned int d5 = dim>2?5:0;
+
+    // whether the Hessian contributions need to be added to the output
+    // written by the values or gradients
+    const bool add_hessians = integrate_val || integrate_grad;
 
     switch (dim)
       {
@@ -5976,6 +6220,13 @@ namespace internal
                 else
                   eval.template gradients<0,false,false> (gradients_quad[c][0], values_dofs[c]);
               }
+            if (integrate_hess == true)
+              {
+                if (add_hessians == true)
+                  eval.template hessians<0,false,true> (hessians_quad[c][0], values_dofs[c]);
+                else
+                  eval.template hessians<0,false,false> (hessians_quad[c][0], values_dofs[c]);
+              }
           }
         break;
 
@@ -6005,6 +6256,23 @@ namespace internal
                 else
                   eval.template gradients<1,false,true>(temp1, values_dofs[c]);
               }
+            if (integrate_hess == true)
+              {
+                // grad xx
+                eval.template hessians<0,false,false> (hessians_quad[c][0], temp1);
+                if (add_hessians == true)
+                  eval.template values<1,false,true> (temp1, values_dofs[c]);
+                else
+                  eval.template values<1,false,false> (temp1, values_dofs[c]);
+
+                // grad yy
+                eval.template values<0,false,false> (hessians_quad[c][d1], temp1);
+                eval.template hessians<1,false,true> (temp1, values_dofs[c]);
+
+                // grad xy
+                eval.template gradients<0,false,false> (hessians_quad[c][d1+d1], temp1);
+                eval.template gradients<1,false,true> (temp1, values_dofs[c]);
+              }
           }
         break;
 
@@ -6041,6 +6309,35 @@ namespace internal
                 eval.template values<1,false,false> (temp1, temp2);
                 eval.template gradients<2,false,true> (temp2, values_dofs[c]);
               }
+            if (integrate_hess == true)
+              {
+                // grad xx
+                eval.template hessians<0,false,false> (hessians_quad[c][0], temp1);
+                eval.template values<1,false,false> (temp1, temp2);
+                // grad xy: can sum to temporary x value in temp2
+                eval.template gradients<0,false,false> (hessians_quad[c][d3], temp1);
+                eval.template gradients<1,false,true> (temp1, temp2);
+                // grad yy: can sum to temporary x value in temp2
+                eval.template values<0,false,false> (hessians_quad[c][d1], temp1);
+                eval.template hessians<1,false,true> (temp1, temp2);
+                if (add_hessians == true)
+                  eval.template values<2,false,true> (temp2, values_dofs[c]);
+                else
+                  eval.template values<2,false,false> (temp2, values_dofs[c]);
+
+                // grad zz
+                eval.template values<0,false,false> (hessians_quad[c][d2], temp1);
+                eval.template values<1,false,false> (temp1, temp2);
+                eval.template hessians<2,false,true> (temp2, values_dofs[c]);
+
+                // grad yz
+                eval.template values<0,false,false> (hessians_quad[c][d5], temp1);
+                eval.template gradients<1,false,false> (temp1, temp2);
+                // grad xz: can sum to temporary z value in temp2
+                eval.template gradients<0,false,false> (hessians_quad[c][d4], temp1);
+                eval.template values<1,false,true> (temp1, temp2);
+                eval.template gradients<2,false,true> (temp2, values_dofs[c]);
+              }
           }
         break;
 
@@ -6104,8 +6401,10 @@ namespace internal
                     VectorizedArray<Number> *values_dofs[],
                     VectorizedArray<Number> *values_quad[],
                     VectorizedArray<Number> *gradients_quad[][dim],
+                    VectorizedArray<Number> *hessians_quad[][(dim*(dim+1))/2],
                     const bool               integrate_val,
-                    const bool               integrate_grad);
+                    const bool               integrate_grad,
+                    const bool               integrate_hess);
   };
 
   template <int dim, int fe_degree, int n_q_points_1d, int n_components, typename Number>
@@ -6244,8 +6543,10 @@ namespace internal
                                 VectorizedArray<Number> *values_dofs[],
                                 VectorizedArray<Number> *values_quad[],
                                 VectorizedArray<Number> *gradients_quad[][dim],
+                                VectorizedArray<Number> *hessians_quad[][(dim*(dim+1))/2],
                                 const bool               integrate_val,
-                                const bool               integrate_grad)
+                                const bool               integrate_grad,
+                                const bool               integrate_hess)
   {
     typedef EvaluatorTensorProduct<evaluate_evenodd, dim, fe_degree, fe_degree+1,
             VectorizedArray<Number> > Eval;
@@ -6324,6 +6625,46 @@ namespace internal
       default:
         AssertThrow(false, ExcNotImplemented());
       }
+
+    // the values operation is the identity for Gauss-Lobatto elements, so
+    // the pure second derivatives act on the quadrature data directly and
+    // only the mixed derivatives need a temporary array
+    if (integrate_hess == true)
+      {
+        const bool add_hessians = integrate_val || integrate_grad;
+        VectorizedArray<Number> temp[Eval::dofs_per_cell];
+        for (unsigned int comp=0; comp<n_components; comp++)
+          {
+            if (add_hessians == true)
+              eval.template hessians<0, false, true> (hessians_quad[comp][0],
+                                                      values_dofs[comp]);
+            else
+              eval.template hessians<0, false, false> (hessians_quad[comp][0],
+                                                       values_dofs[comp]);
+            if (dim > 1)
+              {
+                eval.template hessians<1, false, true> (hessians_quad[comp][d1],
+                                                        values_dofs[comp]);
+                // mixed derivative xy
+                eval.template gradients<0, false, false> (hessians_quad[comp][d1+d1+(dim>2?1:0)],
+                                                          temp);
+                eval.template gradients<1, false, true> (temp, values_dofs[comp]);
+              }
+            if (dim > 2)
+              {
+                eval.template hessians<2, false, true> (hessians_quad[comp][d2],
+                                                        values_dofs[comp]);
+                // mixed derivative xz
+                eval.template gradients<0, false, false> (hessians_quad[comp][d2+d2],
+                                                          temp);
+                eval.template gradients<2, false, true> (temp, values_dofs[comp]);
+                // mixed derivative yz
+                eval.template gradients<1, false, false> (hessians_quad[comp][d2+d2+d1],
+                                                          temp);
+                eval.template gradients<2, false, true> (temp, values_dofs[comp]);
+              }
+          }
+      }
   }
 
 } // end of namespace internal
@@ -6726,7 +7067,9 @@ template <int dim, int fe_degree,  int n_q_points_1d, int n_components_,
 inline
 void
 FEEvaluation<dim,fe_degree,n_q_points_1d,n_components_,Number>
-::integrate (bool integrate_val,bool integrate_grad)
+::integrate (bool integrate_val,
+             bool integrate_grad,
+             bool integrate_hess)
 {
   if (integrate_val == true)
     Assert (this->values_quad_submitted == true,
@@ -6734,13 +7077,23 @@ FEEvaluation<dim,fe_degree,n_q_points_1d,n_components_,Number>
   if (integrate_grad == true)
     Assert (this->gradients_quad_submitted == true,
             internal::ExcAccessToUninitializedField());
+  if (integrate_hess == true)
+    Assert (this->hessians_quad_submitted == true,
+            internal::ExcAccessToUninitializedField());
   Assert(this->matrix_info != 0 ||
          this->mapped_geometry->is_initialized(), ExcNotInitialized());
 
+  // transform the Hessians to the unit cell. On general cells, this also
+  // creates contributions that are tested by the gradients
+  if (integrate_hess == true &&
+      this->transform_hessians_for_integration(integrate_grad) == true)
+    integrate_grad = true;
+
   // Select algorithm matching the element type at run time (the function
   // pointer is easy to predict, so negligible in cost)
   integrate_funct (*this->data, this->values_dofs, this->values_quad,
-                   this->gradients_quad, integrate_val, integrate_grad);
+                   this->gradients_quad, this->hessians_quad,
+                   integrate_val, integrate_grad, integrate_hess);
 
 #ifdef DEBUG
   this->dof_values_initialized = true;
@@ -19,7 +19,9 @@
 #include <deal.II/base/function.h>
 #include <deal.II/dofs/dof_handler.h>
 #include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/fe/fe_update_flags.h>
 #include <deal.II/fe/mapping_q1.h>
+#include <deal.II/grid/grid_tools_cache.h>
 #include <deal.II/base/function.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/tensor.h>
@@ -111,6 +113,20 @@ namespace Functions
    * tell where your points are, you will save a lot of computational time by
    * letting this class know.
    *
+   * Points that do not lie in the cell given by the hint are located with a
+   * GridTools::Cache object that this class builds on the triangulation of
+   * the DoF handler. Locating a point therefore only takes ${\cal O}(\log N)$
+   * operations in the number $N$ of cells, once the spatial index of the
+   * cache has been built at the first search.
+   *
+   * The <tt>*_list</tt> functions evaluating the function at many points at
+   * once locate the points in parallel, group them by the cells they lie in,
+   * and then evaluate each group with a single FEValues object that uses the
+   * points of the group as quadrature points, again in parallel. Each thread
+   * keeps its own cell hint. These functions are therefore much faster than
+   * evaluating the function point by point, for example when interpolating
+   * a finite element field onto the quadrature points of another mesh.
+   *
    *
    * <h3>Using FEFieldFunction with parallel::distributed::Triangulation</h3>
    *
@@ -403,9 +419,14 @@ namespace Functions
      * points, the second is a list of quadrature points matching each cell of
      * the first list, and the third contains the index of the given
      * quadrature points, i.e., @p points[maps[3][4]] ends up as the 5th
-     * quadrature point in the 4th cell. This is where optimization would
-     * help. This function returns the number of cells that contain the given
-     * set of points.
+     * quadrature point in the 4th cell. This function returns the number of
+     * cells that contain the given set of points.
+     *
+     * The points are located in parallel, with each thread starting its
+     * search from its own cell hint and resorting to the GridTools::Cache
+     * object of this class for points outside the hint. The cells are listed
+     * in the order in which they are first encountered in @p points, and
+     * the points of each cell are sorted by their index in @p points.
      */
     unsigned int
     compute_point_locations
@@ -447,6 +468,12 @@ namespace Functions
      */
     mutable cell_hint_t cell_hint;
 
+    /**
+     * A spatial index of the cells of the triangulation, used to find the
+     * cells around points that do not lie in the cell given by the hint.
+     */
+    const GridTools::Cache<dim> cache;
+
     /**
      * Store the number of components of this function.
      */
@@ -460,6 +487,39 @@ namespace Functions
     boost::optional<Point<dim> >
     get_reference_coordinates (const typename DoFHandlerType::active_cell_iterator &cell,
                                const Point<dim>                                    &point) const;
+
+    /**
+     * Find the cells around the points with indices in the range
+     * [begin,end) of @p points, along with the reference coordinates of the
+     * points in these cells. Points that cannot be found are marked by the
+     * end() iterator of the DoF handler. This function is called on several
+     * threads by compute_point_locations().
+     */
+    void
+    locate_points (const std::vector<Point<dim> >                                                   &points,
+                   std::vector<std::pair<typename DoFHandlerType::active_cell_iterator,Point<dim> > > &cell_points,
+                   const unsigned int                                                                begin,
+                   const unsigned int                                                                end) const;
+
+    /**
+     * Evaluate the function on the cells with indices in the range
+     * [begin,end) of the output arguments of compute_point_locations(). Each
+     * cell is evaluated with a single FEValues object that uses the points
+     * in the cell as quadrature points. Depending on @p update_flags, the
+     * values (update_values) or Laplacians (update_hessians) are written to
+     * @p values, or the gradients (update_gradients) to @p gradients. This
+     * function is called on several threads by the <tt>*_list</tt>
+     * functions.
+     */
+    void
+    evaluate_on_cells (const std::vector<typename DoFHandlerType::active_cell_iterator > &cells,
+                       const std::vector<std::vector<Point<dim> > >                      &qpoints,
+                       const std::vector<std::vector<unsigned int> >                     &maps,
+                       const UpdateFlags                                                  update_flags,
+                       std::vector<Vector<typename VectorType::value_type> >             *values,
+                       std::vector<std::vector<Tensor<1,dim,typename VectorType::value_type> > > *gradients,
+                       const unsigned int                                                 begin,
+                       const unsigned int                                                 end) const;
   };
 }
 
@@ -16,6 +16,8 @@
 
 #include <deal.II/base/utilities.h>
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/std_cxx11/bind.h>
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/hp/fe_collection.h>
 #include <deal.II/hp/fe_values.h>
@@ -42,6 +44,7 @@ namespace Functions
     data_vector(myv),
     mapping(mymapping),
     cell_hint(dh->end()),
+    cache(mydh.get_triangulation(), mymapping),
     n_components(mydh.get_fe().n_components())
   {
   }
@@ -73,7 +76,7 @@ namespace Functions
     if (!qp)
       {
         const std::pair<typename dealii::internal::ActiveCellIterator<dim, dim, DoFHandlerType>::type, Point<dim> > my_pair
-          = GridTools::find_active_cell_around_point (mapping, *dh, p);
+          = cache.find_active_cell_around_point (*dh, p);
         AssertThrow (my_pair.first->is_locally_owned(),
                      VectorTools::ExcPointNotAvailableHere());
 
@@ -126,7 +129,7 @@ namespace Functions
     if (!qp)
       {
         const std::pair<typename dealii::internal::ActiveCellIterator<dim, dim, DoFHandlerType>::type, Point<dim> > my_pair
-          = GridTools::find_active_cell_around_point (mapping, *dh, p);
+          = cache.find_active_cell_around_point (*dh, p);
         AssertThrow (my_pair.first->is_locally_owned(),
                      VectorTools::ExcPointNotAvailableHere());
 
@@ -194,7 +197,7 @@ namespace Functions
     if (!qp)
       {
         const std::pair<typename dealii::internal::ActiveCellIterator<dim, dim, DoFHandlerType>::type, Point<dim> > my_pair
-          = GridTools::find_active_cell_around_point (mapping, *dh, p);
+          = cache.find_active_cell_around_point (*dh, p);
         AssertThrow (my_pair.first->is_locally_owned(),
                      VectorTools::ExcPointNotAvailableHere());
 
@@ -244,33 +247,23 @@ namespace Functions
     std::vector<std::vector<Point<dim> > > qpoints;
     std::vector<std::vector<unsigned int> > maps;
 
-    unsigned int ncells = compute_point_locations(points, cells, qpoints, maps);
-    hp::MappingCollection<dim> mapping_collection (mapping);
-    hp::FECollection<dim> fe_collection (dh->get_fe ());
-    hp::QCollection<dim> quadrature_collection;
-    // Create quadrature collection
-    for (unsigned int i=0; i<ncells; ++i)
-      {
-        // Number of quadrature points on this cell
-        unsigned int nq = qpoints[i].size();
-        // Construct a quadrature formula
-        std::vector< double > ww(nq, 1./((double) nq));
-
-        quadrature_collection.push_back (Quadrature<dim> (qpoints[i], ww));
-      }
-    // Get a function value object
-    hp::FEValues<dim> fe_v(mapping_collection, fe_collection, quadrature_collection,
-                           update_values);
-    // Now gather all the informations we need
-    for (unsigned int i=0; i<ncells; ++i)
-      {
-        fe_v.reinit(cells[i], i, 0);
-        const unsigned int nq = qpoints[i].size();
-        std::vector< Vector<typename VectorType::value_type> > vvalues (nq, Vector<typename VectorType::value_type>(n_components));
-        fe_v.get_present_fe_values ().get_function_values(data_vector, vvalues);
-        for (unsigned int q=0; q<nq; ++q)
-          values[maps[i][q]] = vvalues[q];
-      }
+    const unsigned int ncells = compute_point_locations(points, cells, qpoints, maps);
+
+    // evaluate the function on the cells in parallel. each point belongs to
+    // exactly one cell, so the threads write to different entries of the
+    // output array
+    parallel::apply_to_subranges (0U, ncells,
+                                  std_cxx11::bind (&FEFieldFunction<dim,DoFHandlerType,VectorType>::evaluate_on_cells,
+                                                   this,
+                                                   std_cxx11::cref(cells),
+                                                   std_cxx11::cref(qpoints),
+                                                   std_cxx11::cref(maps),
+                                                   update_values,
+                                                   &values,
+                                                   static_cast<std::vector<std::vector<Tensor<1,dim,typename VectorType::value_type> > > *>(0),
+                                                   std_cxx11::_1,
+                                                   std_cxx11::_2),
+                                  4);
   }
 
 
@@ -305,39 +298,20 @@ namespace Functions
     std::vector<std::vector<Point<dim> > > qpoints;
     std::vector<std::vector<unsigned int> > maps;
 
-    unsigned int ncells = compute_point_locations(points, cells, qpoints, maps);
-    hp::MappingCollection<dim> mapping_collection (mapping);
-    hp::FECollection<dim> fe_collection (dh->get_fe ());
-    hp::QCollection<dim> quadrature_collection;
-    // Create quadrature collection
-    for (unsigned int i=0; i<ncells; ++i)
-      {
-        // Number of quadrature points on this cell
-        unsigned int nq = qpoints[i].size();
-        // Construct a quadrature formula
-        std::vector< double > ww(nq, 1./((double) nq));
-
-        quadrature_collection.push_back (Quadrature<dim> (qpoints[i], ww));
-      }
-    // Get a function value object
-    hp::FEValues<dim> fe_v(mapping_collection, fe_collection, quadrature_collection,
-                           update_gradients);
-    // Now gather all the informations we need
-    for (unsigned int i=0; i<ncells; ++i)
-      {
-        fe_v.reinit(cells[i], i, 0);
-        const unsigned int nq = qpoints[i].size();
-        std::vector< std::vector<Tensor<1,dim,typename VectorType::value_type> > >
-        vgrads (nq, std::vector<Tensor<1,dim,typename VectorType::value_type> >(n_components));
-        fe_v.get_present_fe_values ().get_function_gradients(data_vector, vgrads);
-        for (unsigned int q=0; q<nq; ++q)
-          {
-            const unsigned int s = vgrads[q].size();
-            values[maps[i][q]].resize(s);
-            for (unsigned int l=0; l<s; l++)
-              values[maps[i][q]][l] = vgrads[q][l];
-          }
-      }
+    const unsigned int ncells = compute_point_locations(points, cells, qpoints, maps);
+
+    parallel::apply_to_subranges (0U, ncells,
+                                  std_cxx11::bind (&FEFieldFunction<dim,DoFHandlerType,VectorType>::evaluate_on_cells,
+                                                   this,
+                                                   std_cxx11::cref(cells),
+                                                   std_cxx11::cref(qpoints),
+                                                   std_cxx11::cref(maps),
+                                                   update_gradients,
+                                                   static_cast<std::vector<Vector<typename VectorType::value_type> > *>(0),
+                                                   &values,
+                                                   std_cxx11::_1,
+                                                   std_cxx11::_2),
+                                  4);
   }
 
   template <int dim, typename DoFHandlerType, typename VectorType>
@@ -370,33 +344,20 @@ namespace Functions
     std::vector<std::vector<Point<dim> > > qpoints;
     std::vector<std::vector<unsigned int> > maps;
 
-    unsigned int ncells = compute_point_locations(points, cells, qpoints, maps);
-    hp::MappingCollection<dim> mapping_collection (mapping);
-    hp::FECollection<dim> fe_collection (dh->get_fe ());
-    hp::QCollection<dim> quadrature_collection;
-    // Create quadrature collection
-    for (unsigned int i=0; i<ncells; ++i)
-      {
-        // Number of quadrature points on this cell
-        unsigned int nq = qpoints[i].size();
-        // Construct a quadrature formula
-        std::vector< double > ww(nq, 1./((double) nq));
-
-        quadrature_collection.push_back (Quadrature<dim> (qpoints[i], ww));
-      }
-    // Get a function value object
-    hp::FEValues<dim> fe_v(mapping_collection, fe_collection, quadrature_collection,
-                           update_hessians);
-    // Now gather all the informations we need
-    for (unsigned int i=0; i<ncells; ++i)
-      {
-        fe_v.reinit(cells[i], i, 0);
-        const unsigned int nq = qpoints[i].size();
-        std::vector< Vector<typename VectorType::value_type> > vvalues (nq, Vector<typename VectorType::value_type>(n_components));
-        fe_v.get_present_fe_values ().get_function_laplacians(data_vector, vvalues);
-        for (unsigned int q=0; q<nq; ++q)
-          values[maps[i][q]] = vvalues[q];
-      }
+    const unsigned int ncells = compute_point_locations(points, cells, qpoints, maps);
+
+    parallel::apply_to_subranges (0U, ncells,
+                                  std_cxx11::bind (&FEFieldFunction<dim,DoFHandlerType,VectorType>::evaluate_on_cells,
+                                                   this,
+                                                   std_cxx11::cref(cells),
+                                                   std_cxx11::cref(qpoints),
+                                                   std_cxx11::cref(maps),
+                                                   update_hessians,
+                                                   &values,
+                                                   static_cast<std::vector<std::vector<Tensor<1,dim,typename VectorType::value_type> > > *>(0),
+                                                   std_cxx11::_1,
+                                                   std_cxx11::_2),
+                                  4);
   }
 
   template <int dim, typename DoFHandlerType, typename VectorType>
@@ -435,147 +396,140 @@ namespace Functions
     // Now the easy case.
     if (np==0) return 0;
 
-    // Keep track of the points we
-    // found
-    std::vector<bool> point_flags(np, false);
-
-    // Set this to true until all
-    // points have been classified
-    bool left_over = true;
+    // find the cells around all points in parallel. each thread starts
+    // from its own cell hint
+    std::vector<std::pair<typename DoFHandlerType::active_cell_iterator, Point<dim> > >
+    cell_points (np);
+    parallel::apply_to_subranges (0U, np,
+                                  std_cxx11::bind (&FEFieldFunction<dim,DoFHandlerType,VectorType>::locate_points,
+                                                   this,
+                                                   std_cxx11::cref(points),
+                                                   std_cxx11::ref(cell_points),
+                                                   std_cxx11::_1,
+                                                   std_cxx11::_2),
+                                  64);
+
+    // then group the points by the cells they lie in. the cells are
+    // numbered in the order in which we first encounter them, and the
+    // points of each cell are sorted by their index
+    std::vector<unsigned int> cell_numbers (dh->get_triangulation().n_active_cells(),
+                                            numbers::invalid_unsigned_int);
+    for (unsigned int p=0; p<np; ++p)
+      {
+        AssertThrow (cell_points[p].first.state() == IteratorState::valid,
+                     GridTools::ExcPointNotFound<dim>(points[p]));
+        AssertThrow (cell_points[p].first->is_locally_owned(),
+                     VectorTools::ExcPointNotAvailableHere());
 
-    // Current quadrature point
-    typename DoFHandlerType::active_cell_iterator cell = cell_hint.get();
-    if (cell == dh->end())
-      cell = dh->begin_active();
+        unsigned int &cell_number = cell_numbers[cell_points[p].first->active_cell_index()];
+        if (cell_number == numbers::invalid_unsigned_int)
+          {
+            cell_number = cells.size();
+            cells.push_back (cell_points[p].first);
+            qpoints.push_back (std::vector<Point<dim> >());
+            maps.push_back (std::vector<unsigned int>());
+          }
+        qpoints[cell_number].push_back (cell_points[p].second);
+        maps[cell_number].push_back (p);
+      }
 
-    {
-      // see if the point is
-      // inside the
-      // cell. there are two
-      // ways that
-      // transform_real_to_unit_cell
-      // can indicate that a
-      // point is outside: by
-      // returning
-      // coordinates that lie
-      // outside the
-      // reference cell, or
-      // by throwing an
-      // exception. handle
-      // both
-      boost::optional<Point<dim> >
-      qp = get_reference_coordinates (cell, points[0]);
-      if (!qp)
-        {
-          const std::pair<typename dealii::internal::ActiveCellIterator<dim, dim, DoFHandlerType>::type, Point<dim> >
-          my_pair  = GridTools::find_active_cell_around_point
-                     (mapping, *dh, points[0]);
-          AssertThrow (my_pair.first->is_locally_owned(),
-                       VectorTools::ExcPointNotAvailableHere());
-
-          cell = my_pair.first;
-          qp = my_pair.second;
-          point_flags[0] = true;
-        }
-
-      // Put in the first point.
-      cells.push_back(cell);
-      qpoints.push_back(std::vector<Point<dim> >(1, qp.get()));
-      maps.push_back(std::vector<unsigned int> (1, 0));
-    }
-
-
-    // Check if we need to do anything else
-    if (points.size() > 1)
-      left_over = true;
-    else
-      left_over = false;
+    return cells.size();
+  }
 
 
-    // This is the first index of a non processed point
-    unsigned int first_outside = 1;
 
-    // And this is the index of the current cell
-    unsigned int c = 0;
+  template <int dim, typename DoFHandlerType, typename VectorType>
+  void
+  FEFieldFunction<dim, DoFHandlerType, VectorType>::
+  locate_points (const std::vector<Point<dim> >                                                   &points,
+                 std::vector<std::pair<typename DoFHandlerType::active_cell_iterator,Point<dim> > > &cell_points,
+                 const unsigned int                                                                begin,
+                 const unsigned int                                                                end) const
+  {
+    typename DoFHandlerType::active_cell_iterator &cell = cell_hint.get();
+    if (cell == dh->end())
+      cell = dh->begin_active();
 
-    while (left_over == true)
+    for (unsigned int p=begin; p<end; ++p)
       {
-        // Assume this is the last one
-        left_over = false;
-        Assert(first_outside < np,
-               ExcIndexRange(first_outside, 0, np));
-
-        // If we found one in this cell, keep looking in the same cell
-        for (unsigned int p=first_outside; p<np; ++p)
-          if (point_flags[p] == false)
-            {
-              // same logic as above
-              const boost::optional<Point<dim> >
-              qp = get_reference_coordinates (cells[c], points[p]);
-              if (qp)
-                {
-                  point_flags[p] = true;
-                  qpoints[c].push_back(qp.get());
-                  maps[c].push_back(p);
-                }
-              else
-                {
-                  // Set things up for next round
-                  if (left_over == false)
-                    first_outside = p;
-                  left_over = true;
-                }
-            }
-        // If we got here and there is
-        // no left over, we are
-        // done. Else we need to find
-        // the next cell
-        if (left_over == true)
+        // points that are close to each other usually lie in the same
+        // cell, so first try the last cell we found
+        const boost::optional<Point<dim> >
+        qp = get_reference_coordinates (cell, points[p]);
+        if (qp)
+          {
+            cell_points[p] = std::make_pair (cell, qp.get());
+            continue;
+          }
+
+        // otherwise ask the spatial index. rather than letting an exception
+        // escape from a thread, mark points that could not be found with
+        // the end iterator and let the caller deal with them
+        try
+          {
+            cell_points[p] = cache.find_active_cell_around_point (*dh, points[p]);
+            cell = cell_points[p].first;
+          }
+        catch (const GridTools::ExcPointNotFound<dim> &)
           {
-            const std::pair<typename dealii::internal::ActiveCellIterator<dim, dim, DoFHandlerType>::type, Point<dim> > my_pair
-              = GridTools::find_active_cell_around_point (mapping, *dh, points[first_outside]);
-            AssertThrow (my_pair.first->is_locally_owned(),
-                         VectorTools::ExcPointNotAvailableHere());
-
-            cells.push_back(my_pair.first);
-            qpoints.push_back(std::vector<Point<dim> >(1, my_pair.second));
-            maps.push_back(std::vector<unsigned int>(1, first_outside));
-            c++;
-            point_flags[first_outside] = true;
-            // And check if we can exit the loop now
-            if (first_outside == np-1)
-              left_over = false;
+            cell_points[p] = std::make_pair (typename DoFHandlerType::active_cell_iterator (dh->end()),
+                                             Point<dim>());
           }
       }
+  }
 
-    // Augment of one the number of cells
-    ++c;
-    // Debug Checking
-    Assert(c == cells.size(), ExcInternalError());
 
-    Assert(c == maps.size(),
-           ExcDimensionMismatch(c, maps.size()));
 
-    Assert(c == qpoints.size(),
-           ExcDimensionMismatch(c, qpoints.size()));
+  template <int dim, typename DoFHandlerType, typename VectorType>
+  void
+  FEFieldFunction<dim, DoFHandlerType, VectorType>::
+  evaluate_on_cells (const std::vector<typename DoFHandlerType::active_cell_iterator > &cells,
+                     const std::vector<std::vector<Point<dim> > >                      &qpoints,
+                     const std::vector<std::vector<unsigned int> >                     &maps,
+                     const UpdateFlags                                                  update_flags,
+                     std::vector<Vector<typename VectorType::value_type> >             *values,
+                     std::vector<std::vector<Tensor<1,dim,typename VectorType::value_type> > > *gradients,
+                     const unsigned int                                                 begin,
+                     const unsigned int                                                 end) const
+  {
+    typedef typename VectorType::value_type number;
 
-#ifdef DEBUG
-    unsigned int qps = 0;
-    // The number of points in all
-    // the cells must be the same as
-    // the number of points we
-    // started off from.
-    for (unsigned int n=0; n<c; ++n)
+    for (unsigned int i=begin; i<end; ++i)
       {
-        Assert(qpoints[n].size() == maps[n].size(),
-               ExcDimensionMismatch(qpoints[n].size(), maps[n].size()));
-        qps += qpoints[n].size();
-      }
-    Assert(qps == np,
-           ExcDimensionMismatch(qps, np));
-#endif
+        // Number of quadrature points on this cell
+        const unsigned int nq = qpoints[i].size();
+        // Construct a quadrature formula
+        const std::vector<double> ww(nq, 1./((double) nq));
+
+        FEValues<dim> fe_v(mapping, cells[i]->get_fe(),
+                           Quadrature<dim> (qpoints[i], ww),
+                           update_flags);
+        fe_v.reinit(cells[i]);
 
-    return c;
+        if (update_flags & update_gradients)
+          {
+            std::vector< std::vector<Tensor<1,dim,number> > >
+            vgrads (nq, std::vector<Tensor<1,dim,number> >(n_components));
+            fe_v.get_function_gradients(data_vector, vgrads);
+            for (unsigned int q=0; q<nq; ++q)
+              {
+                const unsigned int s = vgrads[q].size();
+                (*gradients)[maps[i][q]].resize(s);
+                for (unsigned int l=0; l<s; l++)
+                  (*gradients)[maps[i][q]][l] = vgrads[q][l];
+              }
+          }
+        else
+          {
+            std::vector< Vector<number> > vvalues (nq, Vector<number>(n_components));
+            if (update_flags & update_hessians)
+              fe_v.get_function_laplacians(data_vector, vvalues);
+            else
+              fe_v.get_function_values(data_vector, vvalues);
+            for (unsigned int q=0; q<nq; ++q)
+              (*values)[maps[i][q]] = vvalues[q];
+          }
+      }
   }
 
 
@@ -44,6 +44,10 @@ namespace hp
 {
   template <int dim> class QCollection;
 }
+namespace GridTools
+{
+  template <int dim, int spacedim> class Cache;
+}
 class ConstraintMatrix;
 
 
@@ -2145,6 +2149,44 @@ namespace VectorTools
                const VectorType                          &fe_function,
                const Point<spacedim>                     &point);
 
+  /**
+   * Evaluate a possibly vector-valued finite element function defined by the
+   * given DoFHandler and nodal vector at the given point, and return the
+   * (vector) value of this function through the last argument.
+   *
+   * Compared with the other functions of the same name, this function finds
+   * the cell around the point with the spatial index stored in the given
+   * GridTools::Cache object, which must be built on the triangulation of the
+   * DoFHandler, and uses the mapping stored in that object. Since the cell
+   * is found in ${\cal O}(\log N)$ rather than ${\cal O}(N)$ operations once
+   * the index has been built, this is the function to use when evaluating a
+   * finite element function at many points.
+   *
+   * @note If the cell in which the point is found is not locally owned, an
+   * exception of type VectorTools::ExcPointNotAvailableHere is thrown.
+   */
+  template <int dim, typename VectorType, int spacedim>
+  void
+  point_value (const GridTools::Cache<dim,spacedim> &cache,
+               const DoFHandler<dim,spacedim>       &dof,
+               const VectorType                     &fe_function,
+               const Point<spacedim>                &point,
+               Vector<typename VectorType::value_type> &value);
+
+  /**
+   * Same as above for a scalar finite element function, whose value at the
+   * given point is returned.
+   *
+   * @note If the cell in which the point is found is not locally owned, an
+   * exception of type VectorTools::ExcPointNotAvailableHere is thrown.
+   */
+  template <int dim, typename VectorType, int spacedim>
+  typename VectorType::value_type
+  point_value (const GridTools::Cache<dim,spacedim> &cache,
+               const DoFHandler<dim,spacedim>       &dof,
+               const VectorType                     &fe_function,
+               const Point<spacedim>                &point);
+
   /**
    * Evaluate a possibly vector-valued finite element function defined by the
    * given DoFHandler and nodal vector at the given point, and return the
@@ -39,6 +39,7 @@
 #include <deal.II/grid/tria_accessor.h>
 #include <deal.II/grid/tria_boundary.h>
 #include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
 #include <deal.II/grid/intergrid_map.h>
 #include <deal.II/dofs/dof_accessor.h>
 #include <deal.II/dofs/dof_handler.h>
@@ -6893,6 +6894,63 @@ namespace VectorTools
   }
 
 
+  template <int dim, typename VectorType, int spacedim>
+  void
+  point_value (const GridTools::Cache<dim,spacedim> &cache,
+               const DoFHandler<dim,spacedim>       &dof,
+               const VectorType                     &fe_function,
+               const Point<spacedim>                &point,
+               Vector<typename VectorType::value_type> &value)
+  {
+    typedef typename VectorType::value_type Number;
+    const FiniteElement<dim> &fe = dof.get_fe();
+
+    Assert(value.size() == fe.n_components(),
+           ExcDimensionMismatch(value.size(), fe.n_components()));
+
+    // first find the cell in which this point
+    // is, initialize a quadrature rule with
+    // it, and then a FEValues object
+    const std::pair<typename DoFHandler<dim,spacedim>::active_cell_iterator, Point<dim> >
+    cell_point = cache.find_active_cell_around_point (dof, point);
+
+    AssertThrow(cell_point.first->is_locally_owned(),
+                ExcPointNotAvailableHere());
+    Assert(GeometryInfo<dim>::distance_to_unit_cell(cell_point.second) < 1e-10,
+           ExcInternalError());
+
+    const Quadrature<dim>
+    quadrature (GeometryInfo<dim>::project_to_unit_cell(cell_point.second));
+
+    FEValues<dim,spacedim> fe_values(cache.get_mapping(), fe, quadrature, update_values);
+    fe_values.reinit(cell_point.first);
+
+    // then use this to get at the values of
+    // the given fe_function at this point
+    std::vector<Vector<Number> > u_value(1, Vector<Number> (fe.n_components()));
+    fe_values.get_function_values(fe_function, u_value);
+
+    value = u_value[0];
+  }
+
+
+  template <int dim, typename VectorType, int spacedim>
+  typename VectorType::value_type
+  point_value (const GridTools::Cache<dim,spacedim> &cache,
+               const DoFHandler<dim,spacedim>       &dof,
+               const VectorType                     &fe_function,
+               const Point<spacedim>                &point)
+  {
+    Assert(dof.get_fe().n_components() == 1,
+           ExcMessage ("Finite element is not scalar as is necessary for this function"));
+
+    Vector<typename VectorType::value_type> value(1);
+    point_value(cache, dof, fe_function, point, value);
+
+    return value(0);
+  }
+
+
 
   template <int dim, typename VectorType, int spacedim>
   void
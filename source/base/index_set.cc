@@ -40,7 +40,9 @@ IndexSet::IndexSet (const Epetra_Map &map)
   :
   is_compressed (true),
   index_space_size (map.NumGlobalElements64()),
-  largest_range (numbers::invalid_unsigned_int)
+  largest_range (numbers::invalid_unsigned_int),
+  index_bucket_shift (0),
+  nth_index_bucket_shift (0)
 {
   // For a contiguous map, we do not need to go through the whole data...
   if (map.LinearMap())
@@ -62,7 +64,9 @@ IndexSet::IndexSet (const Epetra_Map &map)
   :
   is_compressed (true),
   index_space_size (map.NumGlobalElements()),
-  largest_range (numbers::invalid_unsigned_int)
+  largest_range (numbers::invalid_unsigned_int),
+  index_bucket_shift (0),
+  nth_index_bucket_shift (0)
 {
   // For a contiguous map, we do not need to go through the whole data...
   if (map.LinearMap())
@@ -167,6 +171,7 @@ IndexSet::do_compress () const
           largest_range = i - ranges.begin();
         }
     }
+  compute_lookup_tables ();
   is_compressed = true;
 
   // check that next_index is correct. needs to be after the previous
@@ -176,6 +181,61 @@ IndexSet::do_compress () const
 
 
 
+void
+IndexSet::compute_lookup_tables () const
+{
+  index_buckets.clear ();
+  nth_index_buckets.clear ();
+  index_bucket_shift = 0;
+  nth_index_bucket_shift = 0;
+  if (ranges.size() < n_ranges_for_lookup_tables)
+    return;
+
+  const size_type n_ranges = ranges.size();
+
+  // choose the size of the buckets as the smallest power of two for which
+  // there are no more buckets than ranges, i.e., about one range per bucket
+  // if the ranges are evenly distributed
+  const size_type last_index = ranges.back().end - 1 - ranges.front().begin;
+  while ((last_index >> index_bucket_shift) >= n_ranges)
+    ++index_bucket_shift;
+
+  const size_type n_buckets = (last_index >> index_bucket_shift) + 1;
+  index_buckets.resize (n_buckets + 1);
+  unsigned int range = 0;
+  for (size_type bucket=0; bucket<n_buckets; ++bucket)
+    {
+      const size_type first_index_in_bucket
+        = ranges.front().begin + (bucket << index_bucket_shift);
+      while (ranges[range].end <= first_index_in_bucket)
+        ++range;
+      index_buckets[bucket] = range;
+    }
+  index_buckets[n_buckets] = n_ranges-1;
+
+  // same for the numbers of the elements within the set
+  const Range &last_range = ranges.back();
+  const size_type last_element = last_range.nth_index_in_set +
+                                 (last_range.end - last_range.begin) - 1;
+  while ((last_element >> nth_index_bucket_shift) >= n_ranges)
+    ++nth_index_bucket_shift;
+
+  const size_type n_nth_buckets = (last_element >> nth_index_bucket_shift) + 1;
+  nth_index_buckets.resize (n_nth_buckets + 1);
+  range = 0;
+  for (size_type bucket=0; bucket<n_nth_buckets; ++bucket)
+    {
+      const size_type first_element_in_bucket = bucket << nth_index_bucket_shift;
+      while (ranges[range].nth_index_in_set + (ranges[range].end - ranges[range].begin)
+             <= first_element_in_bucket)
+        ++range;
+      nth_index_buckets[bucket] = range;
+    }
+  nth_index_buckets[n_nth_buckets] = n_ranges-1;
+}
+
+
+
 IndexSet
 IndexSet::operator & (const IndexSet &is) const
 {
@@ -554,7 +614,9 @@ IndexSet::memory_consumption () const
 {
   return (MemoryConsumption::memory_consumption (ranges) +
           MemoryConsumption::memory_consumption (is_compressed) +
-          MemoryConsumption::memory_consumption (index_space_size));
+          MemoryConsumption::memory_consumption (index_space_size) +
+          MemoryConsumption::memory_consumption (index_buckets) +
+          MemoryConsumption::memory_consumption (nth_index_buckets));
 }
 
 
@@ -30,7 +30,8 @@ template <>
 Quadrature<0>::Quadrature (const unsigned int n_q)
   :
   quadrature_points (n_q),
-  weights (n_q, 0)
+  weights (n_q, 0),
+  is_tensor_product_flag (false)
 {}
 
 
@@ -45,7 +46,8 @@ template <int dim>
 Quadrature<dim>::Quadrature (const unsigned int n_q)
   :
   quadrature_points (n_q, Point<dim>()),
-  weights (n_q, 0)
+  weights (n_q, 0),
+  is_tensor_product_flag (dim == 1)
 {}
 
 
@@ -58,6 +60,8 @@ Quadrature<dim>::initialize (const std::vector<Point<dim> > &p,
   AssertDimension (w.size(), p.size());
   quadrature_points = p;
   weights = w;
+  is_tensor_product_flag = (dim == 1);
+  tensor_basis.reset ();
 }
 
 
@@ -67,7 +71,8 @@ Quadrature<dim>::Quadrature (const std::vector<Point<dim> > &points,
                              const std::vector<double>      &weights)
   :
   quadrature_points(points),
-  weights(weights)
+  weights(weights),
+  is_tensor_product_flag (dim == 1)
 {
   Assert (weights.size() == points.size(),
           ExcDimensionMismatch(weights.size(), points.size()));
@@ -79,7 +84,8 @@ template <int dim>
 Quadrature<dim>::Quadrature (const std::vector<Point<dim> > &points)
   :
   quadrature_points(points),
-  weights(points.size(), std::atof("Inf"))
+  weights(points.size(), std::atof("Inf")),
+  is_tensor_product_flag (dim == 1)
 {
   Assert(weights.size() == points.size(),
          ExcDimensionMismatch(weights.size(), points.size()));
@@ -91,7 +97,8 @@ template <int dim>
 Quadrature<dim>::Quadrature (const Point<dim> &point)
   :
   quadrature_points(std::vector<Point<dim> > (1, point)),
-  weights(std::vector<double> (1, 1.))
+  weights(std::vector<double> (1, 1.)),
+  is_tensor_product_flag (dim == 1)
 {}
 
 
@@ -109,7 +116,8 @@ Quadrature<dim>::Quadrature (const SubQuadrature &q1,
                              const Quadrature<1> &q2)
   :
   quadrature_points (q1.size() * q2.size()),
-  weights (q1.size() * q2.size())
+  weights (q1.size() * q2.size()),
+  is_tensor_product_flag (q1.is_tensor_product())
 {
   unsigned int present_index = 0;
   for (unsigned int i2=0; i2<q2.size(); ++i2)
@@ -129,6 +137,15 @@ Quadrature<dim>::Quadrature (const SubQuadrature &q1,
         ++present_index;
       };
 
+  if (is_tensor_product_flag)
+    {
+      tensor_basis.reset (new std_cxx11::array<Quadrature<1>,dim>());
+      const std_cxx11::array<Quadrature<1>,dim-1> q1_basis = q1.get_tensor_basis();
+      for (unsigned int d=0; d<dim-1; ++d)
+        (*tensor_basis)[d] = q1_basis[d];
+      (*tensor_basis)[dim-1] = q2;
+    }
+
 #ifdef DEBUG
   if (size() > 0)
     {
@@ -150,7 +167,8 @@ Quadrature<1>::Quadrature (const SubQuadrature &,
                            const Quadrature<1> &q2)
   :
   quadrature_points (q2.size()),
-  weights (q2.size())
+  weights (q2.size()),
+  is_tensor_product_flag (true)
 {
   unsigned int present_index = 0;
   for (unsigned int i2=0; i2<q2.size(); ++i2)
@@ -187,14 +205,16 @@ Quadrature<0>::Quadrature (const Quadrature<1> &)
   :
   Subscriptor(),
 //              quadrature_points(1),
-  weights(1,1.)
+  weights(1,1.),
+  is_tensor_product_flag (false)
 {}
 
 
 template <>
 Quadrature<1>::Quadrature (const Quadrature<0> &)
   :
-  Subscriptor()
+  Subscriptor(),
+  is_tensor_product_flag (true)
 {
   // this function should never be
   // called -- this should be the
@@ -209,7 +229,8 @@ Quadrature<dim>::Quadrature (const Quadrature<dim != 1 ? 1 : 0> &q)
 :
 Subscriptor(),
             quadrature_points (Utilities::fixed_power<dim>(q.size())),
-            weights (Utilities::fixed_power<dim>(q.size()))
+            weights (Utilities::fixed_power<dim>(q.size())),
+            is_tensor_product_flag (true)
 {
   Assert (dim <= 3, ExcNotImplemented());
 
@@ -234,6 +255,10 @@ Subscriptor(),
             weights[k] *= q.weight(i2);
           ++k;
         }
+
+  tensor_basis.reset (new std_cxx11::array<Quadrature<1>,dim>());
+  for (unsigned int d=0; d<dim; ++d)
+    (*tensor_basis)[d] = q;
 }
 
 
@@ -243,7 +268,9 @@ Quadrature<dim>::Quadrature (const Quadrature<dim> &q)
   :
   Subscriptor(),
   quadrature_points (q.quadrature_points),
-  weights (q.weights)
+  weights (q.weights),
+  is_tensor_product_flag (q.is_tensor_product_flag),
+  tensor_basis (q.tensor_basis)
 {}
 
 
@@ -253,6 +280,8 @@ Quadrature<dim>::operator= (const Quadrature<dim> &q)
 {
   weights = q.weights;
   quadrature_points = q.quadrature_points;
+  is_tensor_product_flag = q.is_tensor_product_flag;
+  tensor_basis = q.tensor_basis;
   return *this;
 }
 
@@ -275,12 +304,45 @@ Quadrature<dim>::~Quadrature ()
 
 
 
+template <int dim>
+std_cxx11::array<Quadrature<1>,dim>
+Quadrature<dim>::get_tensor_basis () const
+{
+  Assert (is_tensor_product_flag == true,
+          ExcMessage ("This function only makes sense if "
+                      "this object represents a tensor product!"));
+  Assert (tensor_basis, ExcInternalError());
+
+  return *tensor_basis;
+}
+
+
+
+template <>
+std_cxx11::array<Quadrature<1>,1>
+Quadrature<1>::get_tensor_basis () const
+{
+  Assert (is_tensor_product_flag == true,
+          ExcMessage ("This function only makes sense if "
+                      "this object represents a tensor product!"));
+
+  std_cxx11::array<Quadrature<1>,1> q_array;
+  q_array[0] = *this;
+  return q_array;
+}
+
+
+
 template <int dim>
 std::size_t
 Quadrature<dim>::memory_consumption () const
 {
-  return (MemoryConsumption::memory_consumption (quadrature_points) +
-          MemoryConsumption::memory_consumption (weights));
+  std::size_t memory = (MemoryConsumption::memory_consumption (quadrature_points) +
+                        MemoryConsumption::memory_consumption (weights));
+  if (tensor_basis)
+    for (unsigned int d=0; d<tensor_basis->size(); ++d)
+      memory += (*tensor_basis)[d].memory_consumption();
+  return memory;
 }
 
 
@@ -317,6 +379,11 @@ QAnisotropic<dim>::QAnisotropic(const Quadrature<1> &qx,
         this->weights[k++] = qx.weight(k1) * qy.weight(k2);
       }
   Assert (k==this->size(), ExcInternalError());
+
+  this->is_tensor_product_flag = true;
+  this->tensor_basis.reset (new std_cxx11::array<Quadrature<1>,dim>());
+  (*this->tensor_basis)[0] = qx;
+  (*this->tensor_basis)[dim>1 ? 1 : 0] = qy;
 }
 
 
@@ -341,6 +408,12 @@ QAnisotropic<dim>::QAnisotropic(const Quadrature<1> &qx,
           this->weights[k++] = qx.weight(k1) * qy.weight(k2) * qz.weight(k3);
         }
   Assert (k==this->size(), ExcInternalError());
+
+  this->is_tensor_product_flag = true;
+  this->tensor_basis.reset (new std_cxx11::array<Quadrature<1>,dim>());
+  (*this->tensor_basis)[0] = qx;
+  (*this->tensor_basis)[dim>1 ? 1 : 0] = qy;
+  (*this->tensor_basis)[dim>2 ? 2 : 0] = qz;
 }
 
 
@@ -17,6 +17,7 @@
 #include <deal.II/base/polynomials_piecewise.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/table.h>
+#include <deal.II/base/quadrature.h>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -378,6 +379,154 @@ compute (const Point<dim>            &p,
 
 
 
+template <int dim, typename PolynomialType>
+void
+TensorProductPolynomials<dim,PolynomialType>::
+compute (const Quadrature<dim>   &quadrature,
+         Table<2,double>         &values,
+         Table<2,Tensor<1,dim> > &grads,
+         Table<2,Tensor<2,dim> > &grad_grads,
+         Table<2,Tensor<3,dim> > &third_derivatives) const
+{
+  Assert (dim <= 3, ExcNotImplemented());
+  Assert (quadrature.is_tensor_product(),
+          ExcMessage ("This function can only be called with a quadrature "
+                      "formula that is the tensor product of one-dimensional "
+                      "formulas."));
+
+  const unsigned int n_q_points = quadrature.size();
+  Assert (values.n_rows()==0 ||
+          (values.n_rows()==n_tensor_pols && values.n_cols()==n_q_points),
+          ExcDimensionMismatch2(values.n_rows(), n_tensor_pols, 0));
+  Assert (grads.n_rows()==0 ||
+          (grads.n_rows()==n_tensor_pols && grads.n_cols()==n_q_points),
+          ExcDimensionMismatch2(grads.n_rows(), n_tensor_pols, 0));
+  Assert (grad_grads.n_rows()==0 ||
+          (grad_grads.n_rows()==n_tensor_pols && grad_grads.n_cols()==n_q_points),
+          ExcDimensionMismatch2(grad_grads.n_rows(), n_tensor_pols, 0));
+  Assert (third_derivatives.n_rows()==0 ||
+          (third_derivatives.n_rows()==n_tensor_pols &&
+           third_derivatives.n_cols()==n_q_points),
+          ExcDimensionMismatch2(third_derivatives.n_rows(), n_tensor_pols, 0));
+
+  const bool update_values          = (values.n_rows() == n_tensor_pols),
+             update_grads           = (grads.n_rows() == n_tensor_pols),
+             update_grad_grads      = (grad_grads.n_rows() == n_tensor_pols),
+             update_3rd_derivatives = (third_derivatives.n_rows() == n_tensor_pols);
+
+  unsigned int n_values_and_derivatives = 0;
+  if (update_values)
+    n_values_and_derivatives = 1;
+  if (update_grads)
+    n_values_and_derivatives = 2;
+  if (update_grad_grads)
+    n_values_and_derivatives = 3;
+  if (update_3rd_derivatives)
+    n_values_and_derivatives = 4;
+
+  if (n_values_and_derivatives == 0)
+    return;
+
+  // evaluate the one-dimensional polynomials (and their derivatives, if
+  // necessary) on the points of the one-dimensional quadrature formulas. the
+  // number of points in the directions beyond dim is set to one to get a
+  // single loop structure for all dimensions
+  const std_cxx11::array<Quadrature<1>,dim> quadrature_1d =
+    quadrature.get_tensor_basis();
+  unsigned int n_q_points_1d[3] = {1, 1, 1};
+  std::vector<Table<2,Tensor<1,4> > > v(dim);
+  {
+    std::vector<double> tmp (n_values_and_derivatives);
+    for (unsigned int d=0; d<dim; ++d)
+      {
+        n_q_points_1d[d] = quadrature_1d[d].size();
+        v[d].reinit (polynomials.size(), n_q_points_1d[d]);
+        for (unsigned int i=0; i<polynomials.size(); ++i)
+          for (unsigned int q=0; q<n_q_points_1d[d]; ++q)
+            {
+              polynomials[i].value(quadrature_1d[d].point(q)(0), tmp);
+              for (unsigned int e=0; e<n_values_and_derivatives; ++e)
+                v[d](i,q)[e] = tmp[e];
+            }
+      }
+  }
+  AssertDimension (n_q_points_1d[0]*n_q_points_1d[1]*n_q_points_1d[2],
+                   n_q_points);
+
+  // then combine the one-dimensional values in the same way as in the
+  // pointwise compute() function above, using that the points of a tensor
+  // product quadrature formula are numbered with x running fastest
+  for (unsigned int i=0; i<n_tensor_pols; ++i)
+    {
+      unsigned int indices[dim];
+      compute_index (i, indices);
+
+      unsigned int q = 0;
+      for (unsigned int q2=0; q2<n_q_points_1d[2]; ++q2)
+        for (unsigned int q1=0; q1<n_q_points_1d[1]; ++q1)
+          for (unsigned int q0=0; q0<n_q_points_1d[0]; ++q0, ++q)
+            {
+              const unsigned int q_1d[3] = {q0, q1, q2};
+              const Tensor<1,4> *v_q[dim];
+              for (unsigned int x=0; x<dim; ++x)
+                v_q[x] = &v[x](indices[x], q_1d[x]);
+
+              if (update_values)
+                {
+                  double value = 1.;
+                  for (unsigned int x=0; x<dim; ++x)
+                    value *= (*v_q[x])[0];
+                  values(i,q) = value;
+                }
+
+              if (update_grads)
+                for (unsigned int d=0; d<dim; ++d)
+                  {
+                    double grad = 1.;
+                    for (unsigned int x=0; x<dim; ++x)
+                      grad *= (*v_q[x])[d==x];
+                    grads(i,q)[d] = grad;
+                  }
+
+              if (update_grad_grads)
+                for (unsigned int d1=0; d1<dim; ++d1)
+                  for (unsigned int d2=0; d2<dim; ++d2)
+                    {
+                      double grad_grad = 1.;
+                      for (unsigned int x=0; x<dim; ++x)
+                        {
+                          unsigned int derivative=0;
+                          if (d1==x) ++derivative;
+                          if (d2==x) ++derivative;
+
+                          grad_grad *= (*v_q[x])[derivative];
+                        }
+                      grad_grads(i,q)[d1][d2] = grad_grad;
+                    }
+
+              if (update_3rd_derivatives)
+                for (unsigned int d1=0; d1<dim; ++d1)
+                  for (unsigned int d2=0; d2<dim; ++d2)
+                    for (unsigned int d3=0; d3<dim; ++d3)
+                      {
+                        double third_derivative = 1.;
+                        for (unsigned int x=0; x<dim; ++x)
+                          {
+                            unsigned int derivative=0;
+                            if (d1==x) ++derivative;
+                            if (d2==x) ++derivative;
+                            if (d3==x) ++derivative;
+
+                            third_derivative *= (*v_q[x])[derivative];
+                          }
+                        third_derivatives(i,q)[d1][d2][d3] = third_derivative;
+                      }
+            }
+    }
+}
+
+
+
 
 /* ------------------- AnisotropicPolynomials -------------- */
 
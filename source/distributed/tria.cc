@@ -1546,19 +1546,30 @@ namespace
                                 const typename Triangulation<dim,spacedim>::cell_iterator &dealii_cell,
                                 const typename internal::p4est::types<dim>::quadrant &p4est_cell,
                                 const typename Triangulation<dim,spacedim>::Signals &signals,
+                                unsigned int &next_quadrant,
                                 std::vector<unsigned int> &weight)
   {
-    const int idx = sc_array_bsearch(const_cast<sc_array_t *>(&tree.quadrants),
-                                     &p4est_cell,
-                                     internal::p4est::functions<dim>::quadrant_compare);
+    // the recursion visits the cells in the same (Morton) order in which
+    // p4est stores the locally owned quadrants of the tree. instead of
+    // searching for each cell in the array of quadrants, we therefore only
+    // need to compare with the next quadrant we have not yet encountered
+    if (next_quadrant >= tree.quadrants.elem_count)
+      return; // This quadrant and none of its children belongs to us.
 
-    if (idx == -1 && (internal::p4est::functions<dim>::
-                      quadrant_overlaps_tree (const_cast<typename internal::p4est::types<dim>::tree *>(&tree),
-                                              &p4est_cell)
-                      == false))
+    const typename internal::p4est::types<dim>::quadrant *next
+      = static_cast<const typename internal::p4est::types<dim>::quadrant *>
+        (sc_array_index (const_cast<sc_array_t *>(&tree.quadrants), next_quadrant));
+
+    const bool p4est_has_children
+      = (internal::p4est::functions<dim>::quadrant_is_equal (&p4est_cell, next) == 0);
+
+    if (p4est_has_children
+        &&
+        (internal::p4est::functions<dim>::quadrant_is_ancestor (&p4est_cell, next) == 0))
       return; // This quadrant and none of its children belongs to us.
 
-    const bool p4est_has_children = (idx == -1);
+    if (p4est_has_children == false)
+      ++next_quadrant;
 
     if (p4est_has_children && dealii_cell->has_children())
       {
@@ -1588,6 +1599,7 @@ namespace
                                                         dealii_cell->child(c),
                                                         p4est_child[c],
                                                         signals,
+                                                        next_quadrant,
                                                         weight);
           }
       }
@@ -1610,6 +1622,7 @@ namespace
             // We assign the weight of the parent cell equally to all children
             weight.push_back(parent_weight);
           }
+        next_quadrant += GeometryInfo<dim>::max_children_per_cell;
       }
     else
       {
@@ -2714,14 +2727,25 @@ namespace parallel
       dealii::internal::p4est::functions<dim>::connectivity_destroy (connectivity);
       connectivity = 0;
 
-      unsigned int version, numcpus, attached_size, attached_count, n_coarse_cells;
-      {
-        std::string fname=std::string(filename)+".info";
-        std::ifstream f(fname.c_str());
-        std::string firstline;
-        getline(f, firstline); //skip first line
-        f >> version >> numcpus >> attached_size >> attached_count >> n_coarse_cells;
-      }
+      // only let the first processor read the .info file and send its
+      // contents to all others, rather than having every processor open the
+      // same small file, which puts a lot of load on the file system for
+      // large numbers of processors
+      unsigned int info[5] = { 0, 0, 0, 0, 0 };
+      if (this->my_subdomain == 0)
+        {
+          std::string fname=std::string(filename)+".info";
+          std::ifstream f(fname.c_str());
+          std::string firstline;
+          getline(f, firstline); //skip first line
+          f >> info[0] >> info[1] >> info[2] >> info[3] >> info[4];
+        }
+      MPI_Bcast (&info[0], 5, MPI_UNSIGNED, 0, this->mpi_communicator);
+      const unsigned int version        = info[0];
+      const unsigned int numcpus        = info[1];
+      const unsigned int attached_size  = info[2];
+      const unsigned int attached_count = info[3];
+      const unsigned int n_coarse_cells = info[4];
 
       Assert(version == 2, ExcMessage("Incompatible version found in .info file."));
       Assert(this->n_cells(0) == n_coarse_cells, ExcMessage("Number of coarse cells differ!"));
@@ -3838,34 +3862,8 @@ namespace parallel
 
       if (!(settings & no_automatic_repartitioning))
         {
-          // partition the new mesh between all processors. If cell weights have
-          // not been given balance the number of cells.
-          if (this->signals.cell_weight.num_slots() == 0)
-            dealii::internal::p4est::functions<dim>::
-            partition (parallel_forest,
-                       /* prepare coarsening */ 1,
-                       /* weight_callback */ NULL);
-          else
-            {
-              // get cell weights for a weighted repartitioning.
-              const std::vector<unsigned int> cell_weights = get_cell_weights();
-
-              PartitionWeights<dim,spacedim> partition_weights (cell_weights);
-
-              // attach (temporarily) a pointer to the cell weights through p4est's
-              // user_pointer object
-              Assert (parallel_forest->user_pointer == this,
-                      ExcInternalError());
-              parallel_forest->user_pointer = &partition_weights;
-
-              dealii::internal::p4est::functions<dim>::
-              partition (parallel_forest,
-                         /* prepare coarsening */ 1,
-                         /* weight_callback */ &PartitionWeights<dim,spacedim>::cell_weight);
-
-              // reset the user pointer to its previous state
-              parallel_forest->user_pointer = this;
-            }
+          // partition the new mesh between all processors
+          partition_forest ();
         }
 
       // finally copy back from local part of tree to deal.II
@@ -3898,29 +3896,12 @@ namespace parallel
 
     template <int dim, int spacedim>
     void
-    Triangulation<dim,spacedim>::repartition ()
+    Triangulation<dim,spacedim>::partition_forest ()
     {
-
-#ifdef DEBUG
-      for (typename Triangulation<dim,spacedim>::active_cell_iterator
-           cell = this->begin_active();
-           cell != this->end(); ++cell)
-        if (cell->is_locally_owned())
-          Assert (
-            !cell->refine_flag_set() && !cell->coarsen_flag_set(),
-            ExcMessage ("Error: There shouldn't be any cells flagged for coarsening/refinement when calling repartition()."));
-#endif
-
-      refinement_in_progress = true;
-
-      // before repartitioning the mesh let others attach mesh related info
-      // (such as SolutionTransfer data) to the p4est
-      attach_mesh_data();
-
       if (this->signals.cell_weight.num_slots() == 0)
         {
           // no cell weights given -- call p4est's 'partition' without a
-          // callback for cell weights
+          // callback for cell weights, i.e., balance the number of cells
           dealii::internal::p4est::functions<dim>::
           partition (parallel_forest,
                      /* prepare coarsening */ 1,
@@ -3947,6 +3928,32 @@ namespace parallel
           // reset the user pointer to its previous state
           parallel_forest->user_pointer = this;
         }
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim,spacedim>::repartition ()
+    {
+
+#ifdef DEBUG
+      for (typename Triangulation<dim,spacedim>::active_cell_iterator
+           cell = this->begin_active();
+           cell != this->end(); ++cell)
+        if (cell->is_locally_owned())
+          Assert (
+            !cell->refine_flag_set() && !cell->coarsen_flag_set(),
+            ExcMessage ("Error: There shouldn't be any cells flagged for coarsening/refinement when calling repartition()."));
+#endif
+
+      refinement_in_progress = true;
+
+      // before repartitioning the mesh let others attach mesh related info
+      // (such as SolutionTransfer data) to the p4est
+      attach_mesh_data();
+
+      partition_forest ();
 
       try
         {
@@ -5054,10 +5061,12 @@ namespace parallel
           const typename dealii::internal::p4est::types<dim>::tree *tree =
             init_tree(coarse_cell_index);
 
+          unsigned int next_quadrant = 0;
           get_cell_weights_recursively<dim,spacedim>(*tree,
                                                      dealii_coarse_cell,
                                                      p4est_coarse_cell,
                                                      this->signals,
+                                                     next_quadrant,
                                                      weights);
         }
 
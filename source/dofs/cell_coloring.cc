@@ -0,0 +1,242 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/graph_coloring.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/std_cxx11/bind.h>
+#include <deal.II/dofs/cell_coloring.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/hp/dof_handler.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <algorithm>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace DoFTools
+{
+  template <typename DoFHandlerType>
+  CellColoring<DoFHandlerType>::CellColoring (const DoFHandlerType &dof_handler)
+    :
+    dof_handler (&dof_handler, typeid(*this).name()),
+    update_needed (true)
+  {
+    connect_to_triangulation ();
+  }
+
+
+
+  template <typename DoFHandlerType>
+  CellColoring<DoFHandlerType>::CellColoring (const DoFHandlerType   &dof_handler,
+                                              const ConstraintMatrix &constraints)
+    :
+    dof_handler (&dof_handler, typeid(*this).name()),
+    constraints (&constraints, typeid(*this).name()),
+    update_needed (true)
+  {
+    connect_to_triangulation ();
+  }
+
+
+
+  template <typename DoFHandlerType>
+  CellColoring<DoFHandlerType>::CellColoring (const CellColoring<DoFHandlerType> &coloring)
+    :
+    Subscriptor (),
+    dof_handler (coloring.dof_handler, typeid(*this).name()),
+    constraints (coloring.constraints, typeid(*this).name()),
+    update_needed (true)
+  {
+    connect_to_triangulation ();
+  }
+
+
+
+  template <typename DoFHandlerType>
+  CellColoring<DoFHandlerType>::~CellColoring ()
+  {
+    tria_listener.disconnect ();
+  }
+
+
+
+  template <typename DoFHandlerType>
+  void
+  CellColoring<DoFHandlerType>::connect_to_triangulation ()
+  {
+    tria_listener =
+      dof_handler->get_triangulation().signals.any_change.connect
+      (std_cxx11::bind (&CellColoring<DoFHandlerType>::mark_for_update,
+                        std_cxx11::ref(*this)));
+  }
+
+
+
+  template <typename DoFHandlerType>
+  void
+  CellColoring<DoFHandlerType>::mark_for_update ()
+  {
+    Threads::Mutex::ScopedLock lock (mutex);
+    update_needed = true;
+  }
+
+
+
+  template <typename DoFHandlerType>
+  std::vector<std::vector<typename CellColoring<DoFHandlerType>::active_cell_iterator> >
+  CellColoring<DoFHandlerType>::get_coloring () const
+  {
+    Threads::Mutex::ScopedLock lock (mutex);
+    update_coloring ();
+    return coloring;
+  }
+
+
+
+  template <typename DoFHandlerType>
+  std::vector<types::global_dof_index>
+  CellColoring<DoFHandlerType>::get_conflict_indices (const active_cell_iterator &cell) const
+  {
+    // cells that are not locally owned are removed from the coloring
+    // afterwards, so they do not conflict with anything
+    std::vector<types::global_dof_index> indices;
+    if (cell->is_locally_owned() == false)
+      return indices;
+
+    indices.resize (cell->get_fe().dofs_per_cell);
+    cell->get_dof_indices (indices);
+
+    // distribute_local_to_global() writes the contributions of constrained
+    // dofs into the rows of the dofs they are constrained to, so these are
+    // conflicts as well
+    if (constraints != 0)
+      constraints->resolve_indices (indices);
+    return indices;
+  }
+
+
+
+  template <typename DoFHandlerType>
+  bool
+  CellColoring<DoFHandlerType>::conflict_indices_are_unchanged () const
+  {
+    std::size_t position = 0;
+    unsigned int index = 0;
+    for (active_cell_iterator cell=dof_handler->begin_active();
+         cell!=dof_handler->end(); ++cell, ++index)
+      {
+        if (index == n_conflict_indices_of_coloring.size())
+          return false;
+
+        const std::vector<types::global_dof_index> indices
+          = get_conflict_indices (cell);
+        if (indices.size() != n_conflict_indices_of_coloring[index]
+            ||
+            std::equal (indices.begin(), indices.end(),
+                        conflict_indices_of_coloring.begin()+position) == false)
+          return false;
+        position += indices.size();
+      }
+    return (index == n_conflict_indices_of_coloring.size());
+  }
+
+
+
+  template <typename DoFHandlerType>
+  void
+  CellColoring<DoFHandlerType>::store_conflict_indices () const
+  {
+    conflict_indices_of_coloring.clear ();
+    n_conflict_indices_of_coloring.clear ();
+    for (active_cell_iterator cell=dof_handler->begin_active();
+         cell!=dof_handler->end(); ++cell)
+      {
+        const std::vector<types::global_dof_index> indices
+          = get_conflict_indices (cell);
+        conflict_indices_of_coloring.insert (conflict_indices_of_coloring.end(),
+                                             indices.begin(), indices.end());
+        n_conflict_indices_of_coloring.push_back (indices.size());
+      }
+  }
+
+
+
+  template <typename DoFHandlerType>
+  void
+  CellColoring<DoFHandlerType>::update_coloring () const
+  {
+    // the cells the coloring refers to are only valid as long as the
+    // triangulation is unchanged. otherwise, the coloring is still valid if
+    // every cell writes into the same rows as before
+    if (update_needed == false
+        &&
+        conflict_indices_are_unchanged () == true)
+      return;
+
+    const active_cell_iterator begin = dof_handler->begin_active();
+    const active_cell_iterator end = dof_handler->end();
+    std::vector<std::vector<active_cell_iterator> > new_coloring =
+      GraphColoring::make_graph_coloring
+      (begin, end,
+       static_cast<std_cxx11::function<std::vector<types::global_dof_index> (const active_cell_iterator &)> >
+       (std_cxx11::bind (&CellColoring<DoFHandlerType>::get_conflict_indices,
+                         std_cxx11::cref(*this),
+                         std_cxx11::_1)));
+
+    // remove the cells that are not locally owned, and the colors that
+    // become empty by that
+    coloring.clear ();
+    for (unsigned int color=0; color<new_coloring.size(); ++color)
+      {
+        std::vector<active_cell_iterator> cells;
+        cells.reserve (new_coloring[color].size());
+        for (unsigned int i=0; i<new_coloring[color].size(); ++i)
+          if (new_coloring[color][i]->is_locally_owned())
+            cells.push_back (new_coloring[color][i]);
+        if (cells.size() > 0)
+          {
+            coloring.push_back (std::vector<active_cell_iterator>());
+            coloring.back().swap (cells);
+          }
+      }
+
+    store_conflict_indices ();
+    update_needed = false;
+  }
+
+
+
+  template <typename DoFHandlerType>
+  std::size_t
+  CellColoring<DoFHandlerType>::memory_consumption () const
+  {
+    std::size_t mem = sizeof(*this) +
+                      coloring.capacity() * sizeof(std::vector<active_cell_iterator>);
+    for (unsigned int color=0; color<coloring.size(); ++color)
+      mem += coloring[color].capacity() * sizeof(active_cell_iterator);
+    mem += MemoryConsumption::memory_consumption (conflict_indices_of_coloring);
+    mem += MemoryConsumption::memory_consumption (n_conflict_indices_of_coloring);
+    return mem;
+  }
+}
+
+
+// explicit instantiations
+#include "cell_coloring.inst"
+
+DEAL_II_NAMESPACE_CLOSE
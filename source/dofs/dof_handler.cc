@@ -371,6 +371,31 @@ namespace internal
           }
       }
 
+      /**
+       * Store the caches of DoF indices of the cells on all levels in
+       * compressed form, see
+       * internal::DoFHandler::DoFLevel::compress_cell_dof_indices_cache().
+       */
+      template <int dim, int spacedim>
+      static
+      void compress_cell_dof_indices_caches (DoFHandler<dim,spacedim> &dof_handler)
+      {
+        for (unsigned int i=0; i<dof_handler.levels.size(); ++i)
+          dof_handler.levels[i]->compress_cell_dof_indices_cache ();
+      }
+
+      /**
+       * Undo compress_cell_dof_indices_caches() before the caches are
+       * updated.
+       */
+      template <int dim, int spacedim>
+      static
+      void uncompress_cell_dof_indices_caches (DoFHandler<dim,spacedim> &dof_handler)
+      {
+        for (unsigned int i=0; i<dof_handler.levels.size(); ++i)
+          dof_handler.levels[i]->uncompress_cell_dof_indices_cache ();
+      }
+
       template<int spacedim>
       static
       void reserve_space_mg (DoFHandler<1, spacedim> &dof_handler)
@@ -1242,6 +1267,12 @@ void DoFHandler<dim,spacedim>::distribute_dofs (const FiniteElement<dim,spacedim
   // hand things off to the policy
   policy->distribute_dofs (*this,number_cache);
 
+  // all dof indices are known now, so store the cell caches in
+  // their compact form
+#ifdef DEAL_II_WITH_64BIT_INDICES
+  internal::DoFHandler::Implementation::compress_cell_dof_indices_caches (*this);
+#endif
+
   // initialize the block info object
   // only if this is a sequential
   // triangulation. it doesn't work
@@ -1359,7 +1390,15 @@ DoFHandler<dim,spacedim>::renumber_dofs (const std::vector<types::global_dof_ind
               ExcMessage ("New DoF index is not less than the total number of dofs."));
 #endif
 
+  // the policy rewrites the cell caches, possibly in parallel, which
+  // requires them to be in their uncompressed form
+#ifdef DEAL_II_WITH_64BIT_INDICES
+  internal::DoFHandler::Implementation::uncompress_cell_dof_indices_caches (*this);
+#endif
   policy->renumber_dofs (new_numbers, *this,number_cache);
+#ifdef DEAL_II_WITH_64BIT_INDICES
+  internal::DoFHandler::Implementation::compress_cell_dof_indices_caches (*this);
+#endif
 }
 
 
@@ -19,6 +19,8 @@
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/utilities.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/std_cxx11/bind.h>
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/tria_iterator.h>
 #include <deal.II/dofs/dof_handler.h>
@@ -217,11 +219,317 @@ namespace internal
         }
 
 
+        /**
+         * A range of cells on one level of the triangulation, used to split
+         * loops over all cells into pieces that can be worked on in
+         * parallel. For distribute_dofs(), the object also stores the
+         * vertices, lines, and quads the active cells of the range touch,
+         * and the range of DoF indices that are assigned to these cells.
+         *
+         * The ranges are determined by the triangulation alone, not by the
+         * number of threads, so that the results of the functions using
+         * them do not depend on the number of threads either.
+         */
+        struct CellChunk
+        {
+          unsigned int level;
+          unsigned int begin;
+          unsigned int end;
+
+          /**
+           * The sorted indices of the vertices (entry 0), lines (entry 1),
+           * and quads (entry 2) that carry degrees of freedom and that
+           * belong to the active cells of this range, excluding the
+           * cells themselves.
+           */
+          std::vector<unsigned int> objects[3];
+
+          unsigned int            n_active_cells;
+          types::global_dof_index first_dof;
+        };
+
+
+        /**
+         * Split the cells of all levels of the given triangulation into
+         * ranges of at most a few thousand cells.
+         */
+        template <int dim, int spacedim>
+        static
+        std::vector<CellChunk>
+        make_cell_chunks (const dealii::Triangulation<dim,spacedim> &tria)
+        {
+          const unsigned int cells_per_chunk = 2048;
+
+          std::vector<CellChunk> chunks;
+          for (unsigned int level=0; level<tria.n_levels(); ++level)
+            for (unsigned int begin=0; begin<tria.n_raw_cells(level);
+                 begin+=cells_per_chunk)
+              {
+                CellChunk chunk;
+                chunk.level = level;
+                chunk.begin = begin;
+                chunk.end = std::min (begin+cells_per_chunk,
+                                      tria.n_raw_cells(level));
+                chunk.n_active_cells = 0;
+                chunk.first_dof = 0;
+                chunks.push_back (chunk);
+              }
+          return chunks;
+        }
+
+
+        /**
+         * Return a pointer to the array that stores the indices of the
+         * degrees of freedom on lines (for <tt>structdim==1</tt>) or quads
+         * (for <tt>structdim==2</tt>) that are not cells, or a null pointer
+         * if there are no such objects in the current space dimension.
+         */
+        template <int spacedim>
+        static
+        std::vector<types::global_dof_index> *
+        face_dof_storage (DoFHandler<1,spacedim> &,
+                          const unsigned int)
+        {
+          return 0;
+        }
+
+
+        template <int spacedim>
+        static
+        std::vector<types::global_dof_index> *
+        face_dof_storage (DoFHandler<2,spacedim> &dof_handler,
+                          const unsigned int      structdim)
+        {
+          return (structdim == 1 ? &dof_handler.faces->lines.dofs : 0);
+        }
+
+
+        template <int spacedim>
+        static
+        std::vector<types::global_dof_index> *
+        face_dof_storage (DoFHandler<3,spacedim> &dof_handler,
+                          const unsigned int      structdim)
+        {
+          return (structdim == 1 ? &dof_handler.faces->lines.dofs :
+                  &dof_handler.faces->quads.dofs);
+        }
+
+
+        /**
+         * For the given active cell, write the indices of its vertices,
+         * lines (if <tt>dim&gt;1</tt>) and quads (if <tt>dim&gt;2</tt>) into
+         * the three arrays of @p objects and return the number of entries
+         * in each array. Objects of a kind with no degrees of freedom are
+         * omitted. The order of the objects is the one in which
+         * distribute_dofs_on_cell() visits them.
+         */
+        template <int dim, int spacedim>
+        static
+        void
+        get_cell_objects (const TriaRawIterator<dealii::CellAccessor<dim,spacedim> > &cell,
+                          const FiniteElement<dim,spacedim>                  &fe,
+                          unsigned int (&objects)[3][GeometryInfo<3>::lines_per_cell],
+                          unsigned int (&n_objects)[3])
+        {
+          n_objects[0] = n_objects[1] = n_objects[2] = 0;
+
+          if (fe.dofs_per_vertex > 0)
+            for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+              objects[0][n_objects[0]++] = cell->vertex_index(v);
+
+          if (dim > 1 && fe.dofs_per_line > 0)
+            for (unsigned int l=0; l<GeometryInfo<dim>::lines_per_cell; ++l)
+              objects[1][n_objects[1]++] = cell->line_index(l);
+
+          if (dim > 2 && fe.dofs_per_quad > 0)
+            for (unsigned int q=0; q<GeometryInfo<dim>::quads_per_cell; ++q)
+              objects[2][n_objects[2]++] = cell->quad_index(q);
+        }
+
+
+        /**
+         * Collect the vertices, lines and quads touched by the active cells
+         * of the chunks with indices in the range [begin,end), and count
+         * these cells.
+         */
+        template <int dim, int spacedim>
+        static
+        void
+        collect_chunk_objects (const DoFHandler<dim,spacedim> &dof_handler,
+                               const types::subdomain_id       subdomain_id,
+                               std::vector<CellChunk>         &chunks,
+                               const unsigned int              begin,
+                               const unsigned int              end)
+        {
+          const dealii::Triangulation<dim,spacedim> &tria
+            = dof_handler.get_triangulation();
+
+          // no cell has more vertices, lines, or quads than a hexahedron
+          // has lines
+          unsigned int objects[3][GeometryInfo<3>::lines_per_cell];
+          unsigned int n_objects[3];
+
+          for (unsigned int c=begin; c<end; ++c)
+            {
+              CellChunk &chunk = chunks[c];
+              for (unsigned int index=chunk.begin; index<chunk.end; ++index)
+                {
+                  const TriaRawIterator<dealii::CellAccessor<dim,spacedim> >
+                  cell (&tria, chunk.level, index);
+                  if (!cell->used() || cell->has_children() ||
+                      ((subdomain_id != numbers::invalid_subdomain_id)
+                       &&
+                       (cell->subdomain_id() != subdomain_id)))
+                    continue;
+
+                  ++chunk.n_active_cells;
+                  get_cell_objects (cell, dof_handler.get_fe(), objects, n_objects);
+                  for (unsigned int k=0; k<3; ++k)
+                    chunk.objects[k].insert (chunk.objects[k].end(),
+                                             &objects[k][0],
+                                             &objects[k][0] + n_objects[k]);
+                }
+
+              for (unsigned int k=0; k<3; ++k)
+                {
+                  std::sort (chunk.objects[k].begin(), chunk.objects[k].end());
+                  chunk.objects[k].erase (std::unique (chunk.objects[k].begin(),
+                                                       chunk.objects[k].end()),
+                                          chunk.objects[k].end());
+                }
+            }
+        }
+
+
+        /**
+         * Number the degrees of freedom of the active cells of the chunks
+         * with indices in the range [begin,end). The degrees of freedom on a
+         * vertex, line or quad are numbered by the chunk given in
+         * @p object_owners, i.e., by the first chunk that touches the object.
+         */
+        template <int dim, int spacedim>
+        static
+        void
+        number_chunk_dofs (DoFHandler<dim,spacedim>                      &dof_handler,
+                           const types::subdomain_id                      subdomain_id,
+                           const std::vector<CellChunk>                  &chunks,
+                           const std::vector<std::vector<unsigned int> > &object_owners,
+                           const unsigned int                             begin,
+                           const unsigned int                             end)
+        {
+          const dealii::Triangulation<dim,spacedim> &tria
+            = dof_handler.get_triangulation();
+          const FiniteElement<dim,spacedim> &fe = dof_handler.get_fe();
+
+          std::vector<types::global_dof_index> *const storage[3]
+            = { &dof_handler.vertex_dofs,
+                face_dof_storage (dof_handler, 1),
+                face_dof_storage (dof_handler, 2)
+              };
+          const unsigned int dofs_per_object[3]
+            = { fe.dofs_per_vertex, fe.dofs_per_line, fe.dofs_per_quad };
+          const unsigned int dofs_per_cell_interior
+            = fe.template n_dofs_per_object<dim>();
+
+          unsigned int objects[3][GeometryInfo<3>::lines_per_cell];
+          unsigned int n_objects[3];
+
+          for (unsigned int c=begin; c<end; ++c)
+            {
+              const CellChunk &chunk = chunks[c];
+              types::global_dof_index next_free_dof = chunk.first_dof;
+              std::vector<types::global_dof_index> &cell_dofs
+                = dof_handler.levels[chunk.level]->dof_object.dofs;
+
+              for (unsigned int index=chunk.begin; index<chunk.end; ++index)
+                {
+                  const TriaRawIterator<dealii::CellAccessor<dim,spacedim> >
+                  cell (&tria, chunk.level, index);
+                  if (!cell->used() || cell->has_children() ||
+                      ((subdomain_id != numbers::invalid_subdomain_id)
+                       &&
+                       (cell->subdomain_id() != subdomain_id)))
+                    continue;
+
+                  // number the dofs on vertices, lines, and quads this chunk
+                  // owns, unless an earlier cell of the chunk already did
+                  get_cell_objects (cell, fe, objects, n_objects);
+                  for (unsigned int k=0; k<3; ++k)
+                    for (unsigned int i=0; i<n_objects[k]; ++i)
+                      {
+                        const unsigned int object = objects[k][i];
+                        types::global_dof_index *dofs
+                          = &(*storage[k])[object * dofs_per_object[k]];
+                        if (object_owners[k][object] == c
+                            &&
+                            dofs[0] == DoFHandler<dim,spacedim>::invalid_dof_index)
+                          for (unsigned int d=0; d<dofs_per_object[k]; ++d)
+                            dofs[d] = next_free_dof++;
+                      }
+
+                  // then the ones in the interior of the cell
+                  for (unsigned int d=0; d<dofs_per_cell_interior; ++d)
+                    cell_dofs[index * dofs_per_cell_interior + d] = next_free_dof++;
+                }
+
+              Assert ((c+1 == chunks.size())
+                      ||
+                      (next_free_dof == chunks[c+1].first_dof),
+                      ExcInternalError());
+            }
+        }
+
+
+        /**
+         * Update the cache of dof indices of the cells of the chunks with
+         * indices in the range [begin,end). If @p active_only is true, only
+         * the caches of active cells that are not artificial are updated,
+         * otherwise the ones of all cells.
+         */
+        template <int dim, int spacedim>
+        static
+        void
+        update_chunk_dof_indices_caches (const DoFHandler<dim,spacedim> &dof_handler,
+                                         const std::vector<CellChunk>   &chunks,
+                                         const bool                      active_only,
+                                         const unsigned int              begin,
+                                         const unsigned int              end)
+        {
+          const dealii::Triangulation<dim,spacedim> &tria
+            = dof_handler.get_triangulation();
+
+          for (unsigned int c=begin; c<end; ++c)
+            for (unsigned int index=chunks[c].begin; index<chunks[c].end; ++index)
+              {
+                const TriaRawIterator<dealii::CellAccessor<dim,spacedim> >
+                tria_cell (&tria, chunks[c].level, index);
+                if (!tria_cell->used() ||
+                    (active_only && (tria_cell->has_children() ||
+                                     tria_cell->is_artificial())))
+                  continue;
+
+                const typename DoFHandler<dim,spacedim>::level_cell_iterator
+                cell (&tria, chunks[c].level, index, &dof_handler);
+                cell->update_cell_dof_indices_cache ();
+              }
+        }
+
+
         /**
          * Distribute degrees of freedom on all cells, or on cells with the
          * correct subdomain_id if the corresponding argument is not equal to
          * numbers::invalid_subdomain_id. Return the total number of dofs
          * distributed.
+         *
+         * The numbering is the one obtained by walking over the active cells
+         * in their usual order and numbering the degrees of freedom on each
+         * vertex, line, quad and cell the first time they are encountered
+         * (see distribute_dofs_on_cell()). In order to compute it in
+         * parallel, the cells are split into chunks: first, each chunk
+         * collects the objects its cells touch, then each object is assigned
+         * to the first chunk that touches it, which allows to compute how
+         * many dofs each chunk numbers and where its range of indices
+         * starts. Finally, all chunks number their dofs concurrently.
          */
         template <int dim, int spacedim>
         static
@@ -234,35 +542,73 @@ namespace internal
             = dof_handler.get_triangulation();
           Assert (tria.n_levels() > 0, ExcMessage("Empty triangulation"));
 
-          // Clear user flags because we will need them. But first we save
-          // them and make sure that we restore them later such that at the
-          // end of this function the Triangulation will be in the same state
-          // as it was at the beginning of this function.
-          std::vector<bool> user_flags;
-          tria.save_user_flags(user_flags);
-          const_cast<dealii::Triangulation<dim,spacedim> &>(tria).clear_user_flags ();
+          const FiniteElement<dim,spacedim> &fe = dof_handler.get_fe();
+
+          std::vector<CellChunk> chunks = make_cell_chunks (tria);
+          parallel::apply_to_subranges (0U, chunks.size(),
+                                        std_cxx11::bind (&Implementation::collect_chunk_objects<dim,spacedim>,
+                                                         std_cxx11::cref(dof_handler),
+                                                         subdomain_id,
+                                                         std_cxx11::ref(chunks),
+                                                         std_cxx11::_1,
+                                                         std_cxx11::_2),
+                                        1);
+
+          // assign each object to the first chunk that touches it, and
+          // compute the first index of each chunk from the number of dofs
+          // on the objects it owns and on its cells
+          const unsigned int n_objects[3]
+            = { tria.n_vertices(),
+                (dim > 1 ? tria.n_raw_lines() : 0),
+                (dim > 2 ? tria.n_raw_quads() : 0)
+              };
+          const unsigned int dofs_per_object[3]
+            = { fe.dofs_per_vertex, fe.dofs_per_line, fe.dofs_per_quad };
+
+          std::vector<std::vector<unsigned int> > object_owners (3);
+          for (unsigned int k=0; k<3; ++k)
+            object_owners[k].resize (n_objects[k], numbers::invalid_unsigned_int);
 
           types::global_dof_index next_free_dof = offset;
-          typename DoFHandler<dim,spacedim>::active_cell_iterator
-          cell = dof_handler.begin_active(),
-          endc = dof_handler.end();
+          for (unsigned int c=0; c<chunks.size(); ++c)
+            {
+              chunks[c].first_dof = next_free_dof;
+              for (unsigned int k=0; k<3; ++k)
+                {
+                  for (unsigned int i=0; i<chunks[c].objects[k].size(); ++i)
+                    {
+                      unsigned int &owner = object_owners[k][chunks[c].objects[k][i]];
+                      if (owner == numbers::invalid_unsigned_int)
+                        {
+                          owner = c;
+                          next_free_dof += dofs_per_object[k];
+                        }
+                    }
+                  std::vector<unsigned int>().swap (chunks[c].objects[k]);
+                }
+              next_free_dof += static_cast<types::global_dof_index>(chunks[c].n_active_cells)
+                               * fe.template n_dofs_per_object<dim>();
+            }
 
-          for (; cell != endc; ++cell)
-            if ((subdomain_id == numbers::invalid_subdomain_id)
-                ||
-                (cell->subdomain_id() == subdomain_id))
-              next_free_dof
-                = Implementation::distribute_dofs_on_cell (dof_handler,
-                                                           cell,
-                                                           next_free_dof);
+          parallel::apply_to_subranges (0U, chunks.size(),
+                                        std_cxx11::bind (&Implementation::number_chunk_dofs<dim,spacedim>,
+                                                         std_cxx11::ref(dof_handler),
+                                                         subdomain_id,
+                                                         std_cxx11::cref(chunks),
+                                                         std_cxx11::cref(object_owners),
+                                                         std_cxx11::_1,
+                                                         std_cxx11::_2),
+                                        1);
 
           // update the cache used for cell dof indices
-          for (cell = dof_handler.begin_active(); cell != endc; ++cell)
-            if (!cell->is_artificial())
-              cell->update_cell_dof_indices_cache ();
-
-          // finally restore the user flags
-          const_cast<dealii::Triangulation<dim,spacedim> &>(tria).load_user_flags(user_flags);
+          parallel::apply_to_subranges (0U, chunks.size(),
+                                        std_cxx11::bind (&Implementation::update_chunk_dof_indices_caches<dim,spacedim>,
+                                                         std_cxx11::cref(dof_handler),
+                                                         std_cxx11::cref(chunks),
+                                                         true,
+                                                         std_cxx11::_1,
+                                                         std_cxx11::_2),
+                                        1);
 
           return next_free_dof;
         }
@@ -514,6 +860,71 @@ namespace internal
         /* --------------------- renumber_dofs functionality ---------------- */
 
 
+        /**
+         * Replace the valid dof indices with indices in the range [begin,end)
+         * of @p dofs by their new numbers. See renumber_dofs() for the
+         * meaning of @p indices.
+         */
+        static
+        void
+        renumber_dof_range (const std::vector<types::global_dof_index> &new_numbers,
+                            const IndexSet                             &indices,
+                            std::vector<types::global_dof_index>       &dofs,
+                            const std::size_t                           begin,
+                            const std::size_t                           end)
+        {
+          for (std::size_t i=begin; i<end; ++i)
+            if (dofs[i] != numbers::invalid_dof_index)
+              dofs[i] = ((indices.n_elements() == 0) ?
+                         new_numbers[dofs[i]] :
+                         new_numbers[indices.index_within_set(dofs[i])]);
+        }
+
+
+        /**
+         * Replace the valid dof indices stored in @p dofs by their new
+         * numbers, working on several parts of the array in parallel.
+         */
+        static
+        void
+        renumber_dof_array (const std::vector<types::global_dof_index> &new_numbers,
+                            const IndexSet                             &indices,
+                            std::vector<types::global_dof_index>       &dofs)
+        {
+          parallel::apply_to_subranges (std::size_t(0), dofs.size(),
+                                        std_cxx11::bind (&Implementation::renumber_dof_range,
+                                                         std_cxx11::cref(new_numbers),
+                                                         std_cxx11::cref(indices),
+                                                         std_cxx11::ref(dofs),
+                                                         std_cxx11::_1,
+                                                         std_cxx11::_2),
+                                        4096);
+        }
+
+
+        /**
+         * Update the cache of dof indices of all cells, working on several
+         * parts of the triangulation in parallel.
+         */
+        template <int dim, int spacedim>
+        static
+        void
+        update_all_cell_dof_indices_caches (const DoFHandler<dim,spacedim> &dof_handler)
+        {
+          const std::vector<CellChunk> chunks
+            = make_cell_chunks (dof_handler.get_triangulation());
+          parallel::apply_to_subranges (0U, chunks.size(),
+                                        std_cxx11::bind (&Implementation::update_chunk_dof_indices_caches<dim,spacedim>,
+                                                         std_cxx11::cref(dof_handler),
+                                                         std_cxx11::cref(chunks),
+                                                         false,
+                                                         std_cxx11::_1,
+                                                         std_cxx11::_2),
+                                        1);
+        }
+
+
+
         /**
          * Implementation of the
          * general template of same
@@ -548,36 +959,30 @@ namespace internal
           // numbers may be invalid_dof_index,
           // namely when the appropriate
           // vertex/line/etc is unused
-          for (std::vector<types::global_dof_index>::iterator
-               i=dof_handler.vertex_dofs.begin();
-               i!=dof_handler.vertex_dofs.end(); ++i)
-            if (*i != DoFHandler<1,spacedim>::invalid_dof_index)
-              *i = new_numbers[*i];
-            else if (check_validity)
-              // if index is
-              // invalid_dof_index:
-              // check if this one
-              // really is unused
-              Assert (dof_handler.get_triangulation()
-                      .vertex_used((i-dof_handler.vertex_dofs.begin()) /
-                                   dof_handler.selected_fe->dofs_per_vertex)
-                      == false,
-                      ExcInternalError ());
+          renumber_dof_array (new_numbers, IndexSet(0), dof_handler.vertex_dofs);
+#ifdef DEBUG
+          if (check_validity)
+            for (unsigned int i=0; i<dof_handler.vertex_dofs.size(); ++i)
+              // if index is invalid_dof_index:
+              // check if this one really is
+              // unused
+              if (dof_handler.vertex_dofs[i] == DoFHandler<1,spacedim>::invalid_dof_index)
+                Assert (dof_handler.get_triangulation()
+                        .vertex_used(i / dof_handler.selected_fe->dofs_per_vertex)
+                        == false,
+                        ExcInternalError ());
+#else
+          (void)check_validity;
+#endif
 
           for (unsigned int level=0; level<dof_handler.levels.size(); ++level)
-            for (std::vector<types::global_dof_index>::iterator
-                 i=dof_handler.levels[level]->dof_object.dofs.begin();
-                 i!=dof_handler.levels[level]->dof_object.dofs.end(); ++i)
-              if (*i != DoFHandler<1,spacedim>::invalid_dof_index)
-                *i = new_numbers[*i];
+            renumber_dof_array (new_numbers, IndexSet(0),
+                                dof_handler.levels[level]->dof_object.dofs);
 
           // update the cache
           // used for cell dof
           // indices
-          for (typename DoFHandler<1,spacedim>::level_cell_iterator
-               cell = dof_handler.begin();
-               cell != dof_handler.end(); ++cell)
-            cell->update_cell_dof_indices_cache ();
+          update_all_cell_dof_indices_caches (dof_handler);
         }
 
         template <int spacedim>
@@ -645,49 +1050,32 @@ namespace internal
           // numbers may be invalid_dof_index,
           // namely when the appropriate
           // vertex/line/etc is unused
-          for (std::vector<types::global_dof_index>::iterator
-               i=dof_handler.vertex_dofs.begin();
-               i!=dof_handler.vertex_dofs.end(); ++i)
-            if (*i != DoFHandler<2,spacedim>::invalid_dof_index)
-              *i = (indices.n_elements() == 0)?
-                   (new_numbers[*i]) :
-                   (new_numbers[indices.index_within_set(*i)]);
-            else if (check_validity)
+          renumber_dof_array (new_numbers, indices, dof_handler.vertex_dofs);
+#ifdef DEBUG
+          if (check_validity)
+            for (unsigned int i=0; i<dof_handler.vertex_dofs.size(); ++i)
               // if index is invalid_dof_index:
               // check if this one really is
               // unused
-              Assert (dof_handler.get_triangulation()
-                      .vertex_used((i-dof_handler.vertex_dofs.begin()) /
-                                   dof_handler.selected_fe->dofs_per_vertex)
-                      == false,
-                      ExcInternalError ());
+              if (dof_handler.vertex_dofs[i] == DoFHandler<2,spacedim>::invalid_dof_index)
+                Assert (dof_handler.get_triangulation()
+                        .vertex_used(i / dof_handler.selected_fe->dofs_per_vertex)
+                        == false,
+                        ExcInternalError ());
+#else
+          (void)check_validity;
+#endif
 
-          for (std::vector<types::global_dof_index>::iterator
-               i=dof_handler.faces->lines.dofs.begin();
-               i!=dof_handler.faces->lines.dofs.end(); ++i)
-            if (*i != DoFHandler<2,spacedim>::invalid_dof_index)
-              *i = ((indices.n_elements() == 0) ?
-                    new_numbers[*i] :
-                    new_numbers[indices.index_within_set(*i)]);
+          renumber_dof_array (new_numbers, indices, dof_handler.faces->lines.dofs);
 
           for (unsigned int level=0; level<dof_handler.levels.size(); ++level)
-            {
-              for (std::vector<types::global_dof_index>::iterator
-                   i=dof_handler.levels[level]->dof_object.dofs.begin();
-                   i!=dof_handler.levels[level]->dof_object.dofs.end(); ++i)
-                if (*i != DoFHandler<2,spacedim>::invalid_dof_index)
-                  *i = ((indices.n_elements() == 0) ?
-                        new_numbers[*i] :
-                        new_numbers[indices.index_within_set(*i)]);
-            }
+            renumber_dof_array (new_numbers, indices,
+                                dof_handler.levels[level]->dof_object.dofs);
 
           // update the cache
           // used for cell dof
           // indices
-          for (typename DoFHandler<2,spacedim>::level_cell_iterator
-               cell = dof_handler.begin();
-               cell != dof_handler.end(); ++cell)
-            cell->update_cell_dof_indices_cache ();
+          update_all_cell_dof_indices_caches (dof_handler);
         }
 
         template <int spacedim>
@@ -790,56 +1178,33 @@ namespace internal
           // numbers may be invalid_dof_index,
           // namely when the appropriate
           // vertex/line/etc is unused
-          for (std::vector<types::global_dof_index>::iterator
-               i=dof_handler.vertex_dofs.begin();
-               i!=dof_handler.vertex_dofs.end(); ++i)
-            if (*i != DoFHandler<3,spacedim>::invalid_dof_index)
-              *i = ((indices.n_elements() == 0) ?
-                    new_numbers[*i] :
-                    new_numbers[indices.index_within_set(*i)]);
-            else if (check_validity)
+          renumber_dof_array (new_numbers, indices, dof_handler.vertex_dofs);
+#ifdef DEBUG
+          if (check_validity)
+            for (unsigned int i=0; i<dof_handler.vertex_dofs.size(); ++i)
               // if index is invalid_dof_index:
               // check if this one really is
               // unused
-              Assert (dof_handler.get_triangulation()
-                      .vertex_used((i-dof_handler.vertex_dofs.begin()) /
-                                   dof_handler.selected_fe->dofs_per_vertex)
-                      == false,
-                      ExcInternalError ());
+              if (dof_handler.vertex_dofs[i] == DoFHandler<3,spacedim>::invalid_dof_index)
+                Assert (dof_handler.get_triangulation()
+                        .vertex_used(i / dof_handler.selected_fe->dofs_per_vertex)
+                        == false,
+                        ExcInternalError ());
+#else
+          (void)check_validity;
+#endif
 
-          for (std::vector<types::global_dof_index>::iterator
-               i=dof_handler.faces->lines.dofs.begin();
-               i!=dof_handler.faces->lines.dofs.end(); ++i)
-            if (*i != DoFHandler<3,spacedim>::invalid_dof_index)
-              *i = ((indices.n_elements() == 0) ?
-                    new_numbers[*i] :
-                    new_numbers[indices.index_within_set(*i)]);
-          for (std::vector<types::global_dof_index>::iterator
-               i=dof_handler.faces->quads.dofs.begin();
-               i!=dof_handler.faces->quads.dofs.end(); ++i)
-            if (*i != DoFHandler<3,spacedim>::invalid_dof_index)
-              *i = ((indices.n_elements() == 0) ?
-                    new_numbers[*i] :
-                    new_numbers[indices.index_within_set(*i)]);
+          renumber_dof_array (new_numbers, indices, dof_handler.faces->lines.dofs);
+          renumber_dof_array (new_numbers, indices, dof_handler.faces->quads.dofs);
 
           for (unsigned int level=0; level<dof_handler.levels.size(); ++level)
-            {
-              for (std::vector<types::global_dof_index>::iterator
-                   i=dof_handler.levels[level]->dof_object.dofs.begin();
-                   i!=dof_handler.levels[level]->dof_object.dofs.end(); ++i)
-                if (*i != DoFHandler<3,spacedim>::invalid_dof_index)
-                  *i = ((indices.n_elements() == 0) ?
-                        new_numbers[*i] :
-                        new_numbers[indices.index_within_set(*i)]);
-            }
+            renumber_dof_array (new_numbers, indices,
+                                dof_handler.levels[level]->dof_object.dofs);
 
           // update the cache
           // used for cell dof
           // indices
-          for (typename DoFHandler<3,spacedim>::level_cell_iterator
-               cell = dof_handler.begin();
-               cell != dof_handler.end(); ++cell)
-            cell->update_cell_dof_indices_cache ();
+          update_all_cell_dof_indices_caches (dof_handler);
         }
 
         template <int spacedim>
@@ -0,0 +1,102 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/dofs/dof_levels.h>
+
+#include <algorithm>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace DoFHandler
+  {
+    template <int dim>
+    void
+    DoFLevel<dim>::compress_cell_dof_indices_cache ()
+    {
+      // with 32-bit indices, the compressed cache would need as much
+      // memory as the uncompressed one
+#ifdef DEAL_II_WITH_64BIT_INDICES
+      if (cell_dof_indices_cache.size() == 0)
+        return;
+
+      // find the range of valid indices in the cache. the cache may
+      // not contain any valid index at all, for example on levels
+      // without active cells
+      types::global_dof_index min_index = numbers::invalid_dof_index,
+                              max_index = 0;
+      for (std::vector<types::global_dof_index>::const_iterator
+           p = cell_dof_indices_cache.begin();
+           p != cell_dof_indices_cache.end(); ++p)
+        if (*p != numbers::invalid_dof_index)
+          {
+            min_index = std::min (min_index, *p);
+            max_index = std::max (max_index, *p);
+          }
+      if (min_index == numbers::invalid_dof_index)
+        min_index = max_index = 0;
+
+      // invalid_unsigned_int marks invalid indices, so the differences
+      // need to be strictly smaller than that
+      if (max_index - min_index >= numbers::invalid_unsigned_int)
+        return;
+
+      compressed_cell_dof_indices_offset = min_index;
+      compressed_cell_dof_indices_cache.resize (cell_dof_indices_cache.size());
+      for (std::size_t i=0; i<cell_dof_indices_cache.size(); ++i)
+        compressed_cell_dof_indices_cache[i]
+          = (cell_dof_indices_cache[i] == numbers::invalid_dof_index
+             ?
+             numbers::invalid_unsigned_int
+             :
+             static_cast<unsigned int>(cell_dof_indices_cache[i] - min_index));
+
+      // release the memory of the uncompressed cache
+      std::vector<types::global_dof_index>().swap (cell_dof_indices_cache);
+#endif
+    }
+
+
+
+    template <int dim>
+    void
+    DoFLevel<dim>::uncompress_cell_dof_indices_cache ()
+    {
+      if (compressed_cell_dof_indices_cache.size() == 0)
+        return;
+
+      const CellDoFIndexIterator
+      compressed_indices (&compressed_cell_dof_indices_cache[0],
+                          compressed_cell_dof_indices_offset);
+      cell_dof_indices_cache.resize (compressed_cell_dof_indices_cache.size());
+      for (std::size_t i=0; i<cell_dof_indices_cache.size(); ++i)
+        cell_dof_indices_cache[i] = compressed_indices[i];
+
+      std::vector<unsigned int>().swap (compressed_cell_dof_indices_cache);
+      compressed_cell_dof_indices_offset = 0;
+    }
+
+
+
+    template class DoFLevel<1>;
+    template class DoFLevel<2>;
+    template class DoFLevel<3>;
+  }
+}
+
+DEAL_II_NAMESPACE_CLOSE
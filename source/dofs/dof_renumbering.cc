@@ -1511,6 +1511,117 @@ namespace DoFRenumbering
 
 
 
+  namespace
+  {
+    // return the position of the point p along the Morton (Z-order) curve
+    // through the box [lower, upper]. each coordinate is scaled to an
+    // integer with 21 bits, and the bits of the coordinates are interleaved,
+    // starting with the most significant ones
+    template <int spacedim>
+    unsigned long long
+    morton_key (const Point<spacedim> &p,
+                const Point<spacedim> &lower,
+                const Point<spacedim> &upper)
+    {
+      const unsigned int n_bits = 21;
+      const unsigned long long max_coordinate = (1ULL << n_bits) - 1;
+
+      unsigned long long coordinates[spacedim];
+      for (unsigned int d=0; d<spacedim; ++d)
+        {
+          const double extent = upper[d] - lower[d];
+          const double scaled = (extent > 0 ? (p[d] - lower[d]) / extent : 0.);
+          coordinates[d] = static_cast<unsigned long long>
+                           (std::max(0., std::min(1., scaled)) * max_coordinate);
+        }
+
+      unsigned long long key = 0;
+      for (int bit=n_bits-1; bit>=0; --bit)
+        for (unsigned int d=0; d<spacedim; ++d)
+          key = (key << 1) | ((coordinates[d] >> bit) & 1ULL);
+      return key;
+    }
+
+
+
+    // compare two (key, cell) pairs only by their key, so that
+    // std::stable_sort keeps cells with the same key in their original order
+    template <typename Iterator>
+    bool
+    compare_morton_keys (const std::pair<unsigned long long,Iterator> &a,
+                         const std::pair<unsigned long long,Iterator> &b)
+    {
+      return a.first < b.first;
+    }
+  }
+
+
+
+  template <typename DoFHandlerType>
+  void
+  cell_wise_locality (DoFHandlerType &dof_handler)
+  {
+    std::vector<types::global_dof_index> renumbering(dof_handler.n_dofs());
+    compute_cell_wise_locality(renumbering, dof_handler);
+
+    dof_handler.renumber_dofs(renumbering);
+  }
+
+
+
+  template <typename DoFHandlerType>
+  void
+  compute_cell_wise_locality (std::vector<types::global_dof_index> &new_indices,
+                              const DoFHandlerType                 &dof_handler)
+  {
+    const unsigned int spacedim = DoFHandlerType::space_dimension;
+    typedef typename DoFHandlerType::active_cell_iterator active_cell_iterator;
+
+    // find a box around all vertices of the triangulation
+    const std::vector<Point<spacedim> > &vertices
+      = dof_handler.get_triangulation().get_vertices();
+    const std::vector<bool> &used_vertices
+      = dof_handler.get_triangulation().get_used_vertices();
+    Point<spacedim> lower, upper;
+    bool first_vertex = true;
+    for (unsigned int v=0; v<vertices.size(); ++v)
+      if (used_vertices[v])
+        {
+          if (first_vertex)
+            {
+              lower = upper = vertices[v];
+              first_vertex = false;
+            }
+          else
+            for (unsigned int d=0; d<spacedim; ++d)
+              {
+                lower[d] = std::min(lower[d], vertices[v][d]);
+                upper[d] = std::max(upper[d], vertices[v][d]);
+              }
+        }
+
+    // sort the cells by the position of their centers along the curve
+    std::vector<std::pair<unsigned long long,active_cell_iterator> > keyed_cells;
+    keyed_cells.reserve(dof_handler.get_triangulation().n_active_cells());
+    for (active_cell_iterator cell = dof_handler.begin_active();
+         cell != dof_handler.end(); ++cell)
+      keyed_cells.push_back(std::make_pair(morton_key(cell->center(), lower, upper),
+                                           cell));
+    std::stable_sort(keyed_cells.begin(), keyed_cells.end(),
+                     &compare_morton_keys<active_cell_iterator>);
+
+    std::vector<active_cell_iterator> ordered_cells;
+    ordered_cells.reserve(keyed_cells.size());
+    for (unsigned int i=0; i<keyed_cells.size(); ++i)
+      ordered_cells.push_back(keyed_cells[i].second);
+
+    std::vector<types::global_dof_index> reverse(new_indices.size());
+    compute_cell_wise(new_indices, reverse, dof_handler, ordered_cells);
+  }
+
+
+
+
 
 
 
@@ -549,6 +549,260 @@ namespace DoFTools
             }
       }
 
+
+
+      /**
+       * The constraints that the interpolation matrix of a subface of a
+       * refined face implies for the degrees of freedom on the subface,
+       * expressed in local indices on the face. They are computed once
+       * from the subface interpolation matrix and then applied to each
+       * refined face by mapping the local indices to the global ones. The
+       * filtering is the same as in filter_constraints().
+       */
+      struct FaceConstraintTemplate
+      {
+        /**
+         * For each degree of freedom on the subface, the degrees of freedom
+         * on the mother face it is constrained to, and the weights.
+         */
+        std::vector<std::vector<std::pair<unsigned int,double> > > entries;
+
+        /**
+         * For each degree of freedom on the subface, the degrees of freedom
+         * on the mother face for which the interpolation matrix has an
+         * entry one. If the global index of one of them is the same as the
+         * one of the subface degree of freedom, the constraint is already
+         * satisfied by the unification of the indices.
+         */
+        std::vector<std::vector<unsigned int> > unit_entries;
+      };
+
+
+
+      /**
+       * Compute the template of the constraints on a subface from the
+       * subface interpolation matrix, see filter_constraints() for the
+       * meaning of the filtering.
+       */
+      void
+      make_face_constraint_template (const FullMatrix<double> &face_constraints,
+                                     FaceConstraintTemplate   &face_template)
+      {
+        const unsigned int n_master_dofs = face_constraints.n ();
+        const unsigned int n_slave_dofs = face_constraints.m ();
+
+        face_template.entries.resize (n_slave_dofs);
+        face_template.unit_entries.resize (n_slave_dofs);
+        for (unsigned int row=0; row!=n_slave_dofs; ++row)
+          {
+            double abs_sum = 0;
+            for (unsigned int i=0; i<n_master_dofs; ++i)
+              abs_sum += std::abs (face_constraints(row,i));
+
+            for (unsigned int i=0; i<n_master_dofs; ++i)
+              {
+                if (face_constraints (row,i) == 1.0)
+                  face_template.unit_entries[row].push_back (i);
+                if ((face_constraints(row,i) != 0)
+                    &&
+                    (std::fabs(face_constraints(row,i)) >= 1e-14*abs_sum))
+                  face_template.entries[row].push_back
+                  (std::make_pair (i, face_constraints(row,i)));
+              }
+          }
+      }
+
+
+
+      /**
+       * Scratch data for record_hanging_node_constraints().
+       */
+      struct HangingNodeScratchData
+      {
+        std::vector<types::global_dof_index> master_dofs;
+        std::vector<types::global_dof_index> slave_dofs;
+      };
+
+
+
+      /**
+       * The constraints found on the faces of one cell, in the order in
+       * which they were found. Only the first @p n_lines elements of the
+       * arrays are in use, the others are kept to reuse their memory.
+       */
+      struct HangingNodeCopyData
+      {
+        HangingNodeCopyData ()
+          :
+          n_lines (0)
+        {}
+
+        unsigned int                                                          n_lines;
+        std::vector<types::global_dof_index>                                  lines;
+        std::vector<std::vector<std::pair<types::global_dof_index,double> > > entries;
+      };
+
+
+
+      /**
+       * Record the constraints for the degrees of freedom on all subfaces
+       * of the refined faces of @p cell, for a DoFHandler with only one
+       * finite element, using the constraint templates of the subfaces.
+       * The constraints are written into the ConstraintMatrix by
+       * copy_hanging_node_constraints().
+       */
+      template <typename DoFHandlerType>
+      void
+      record_hanging_node_constraints (const typename DoFHandlerType::active_cell_iterator &cell,
+                                       HangingNodeScratchData                              &scratch,
+                                       HangingNodeCopyData                                 &copy_data,
+                                       const std::vector<FaceConstraintTemplate>           &face_templates)
+      {
+        const unsigned int dim = DoFHandlerType::dimension;
+
+        copy_data.n_lines = 0;
+
+        // artificial cells can at best neighbor ghost cells, but we're not
+        // interested in these interfaces
+        if (cell->is_artificial ())
+          return;
+
+        for (unsigned int face=0; face<GeometryInfo<dim>::faces_per_cell; ++face)
+          if (cell->face(face)->has_children())
+            {
+              Assert(cell->face(face)->refinement_case()==RefinementCase<dim-1>::isotropic_refinement,
+                     ExcNotImplemented());
+
+              std::vector<types::global_dof_index> &master_dofs = scratch.master_dofs;
+              std::vector<types::global_dof_index> &slave_dofs = scratch.slave_dofs;
+              master_dofs.resize (cell->get_fe().dofs_per_face);
+              cell->face(face)->get_dof_indices (master_dofs,
+                                                 cell->active_fe_index ());
+              for (unsigned int i=0; i<master_dofs.size(); ++i)
+                Assert (master_dofs[i] != numbers::invalid_dof_index,
+                        ExcInternalError());
+
+              // ignore all interfaces with artificial cells because we can
+              // only get to such interfaces if the current cell is a ghost
+              // cell
+              for (unsigned int c=0; c<cell->face(face)->n_children(); ++c)
+                {
+                  if (cell->neighbor_child_on_subface (face, c)->is_artificial())
+                    continue;
+
+                  const typename DoFHandlerType::active_face_iterator
+                  subface = cell->face(face)->child(c);
+                  const unsigned int subface_fe_index = subface->nth_active_fe_index(0);
+                  slave_dofs.resize (subface->get_fe(subface_fe_index).dofs_per_face);
+                  subface->get_dof_indices (slave_dofs, subface_fe_index);
+
+                  const FaceConstraintTemplate &face_template = face_templates[c];
+                  AssertDimension (face_template.entries.size(), slave_dofs.size());
+                  for (unsigned int row=0; row<slave_dofs.size(); ++row)
+                    {
+                      Assert (slave_dofs[row] != numbers::invalid_dof_index,
+                              ExcInternalError());
+
+                      // check if we have an identity constraint, which is
+                      // already satisfied by unification of the
+                      // corresponding global dof indices
+                      bool constraint_already_satisfied = false;
+                      for (unsigned int i=0; i<face_template.unit_entries[row].size(); ++i)
+                        if (master_dofs[face_template.unit_entries[row][i]] == slave_dofs[row])
+                          {
+                            constraint_already_satisfied = true;
+                            break;
+                          }
+                      if (constraint_already_satisfied == true)
+                        continue;
+
+                      if (copy_data.n_lines == copy_data.lines.size())
+                        {
+                          copy_data.lines.push_back (numbers::invalid_dof_index);
+                          copy_data.entries.push_back
+                          (std::vector<std::pair<types::global_dof_index,double> >());
+                        }
+                      copy_data.lines[copy_data.n_lines] = slave_dofs[row];
+                      std::vector<std::pair<types::global_dof_index,double> > &entries
+                        = copy_data.entries[copy_data.n_lines];
+                      entries.clear ();
+                      for (unsigned int i=0; i<face_template.entries[row].size(); ++i)
+                        entries.push_back (std::make_pair (master_dofs[face_template.entries[row][i].first],
+                                                           face_template.entries[row][i].second));
+                      ++copy_data.n_lines;
+                    }
+                }
+            }
+      }
+
+
+
+      /**
+       * Add the constraints recorded for one cell to the ConstraintMatrix.
+       * As in filter_constraints(), degrees of freedom that are already
+       * constrained keep their constraint. Since WorkStream calls this
+       * function for one cell after the other in the order of the cells,
+       * the result is the same as the one of a serial loop over all cells.
+       */
+      void
+      copy_hanging_node_constraints (const HangingNodeCopyData &copy_data,
+                                     ConstraintMatrix          &constraints)
+      {
+        for (unsigned int i=0; i<copy_data.n_lines; ++i)
+          constraints.add_constraint (copy_data.lines[i],
+                                      copy_data.entries[i]);
+      }
+
+
+
+      /**
+       * Compute the hanging node constraints for a DoFHandler with only one
+       * finite element: compute the constraint templates for each subface
+       * once, and then apply them to the cells in parallel.
+       */
+      template <typename DoFHandlerType>
+      void
+      make_single_fe_hanging_node_constraints (const DoFHandlerType &dof_handler,
+                                               ConstraintMatrix     &constraints)
+      {
+        const unsigned int dim = DoFHandlerType::dimension;
+        const unsigned int spacedim = DoFHandlerType::space_dimension;
+
+        const dealii::hp::FECollection<dim,spacedim> fe_collection (dof_handler.get_fe());
+        Assert (fe_collection.size() == 1, ExcInternalError());
+        const FiniteElement<dim,spacedim> &fe = fe_collection[0];
+
+        // there are no constraints if there are no dofs on faces, or if the
+        // element does not require continuity across faces
+        if ((fe.dofs_per_face == 0)
+            ||
+            (fe.compare_for_face_domination (fe) == FiniteElementDomination::no_requirements))
+          return;
+
+        std::vector<FaceConstraintTemplate>
+        face_templates (GeometryInfo<dim>::max_children_per_face);
+        FullMatrix<double> subface_interpolation_matrix (fe.dofs_per_face,
+                                                         fe.dofs_per_face);
+        for (unsigned int c=0; c<GeometryInfo<dim>::max_children_per_face; ++c)
+          {
+            fe.get_subface_interpolation_matrix (fe, c, subface_interpolation_matrix);
+            make_face_constraint_template (subface_interpolation_matrix,
+                                           face_templates[c]);
+          }
+
+        WorkStream::run (dof_handler.begin_active(), dof_handler.end(),
+                         std_cxx11::bind (&record_hanging_node_constraints<DoFHandlerType>,
+                                          std_cxx11::_1,
+                                          std_cxx11::_2,
+                                          std_cxx11::_3,
+                                          std_cxx11::cref(face_templates)),
+                         std_cxx11::bind (&copy_hanging_node_constraints,
+                                          std_cxx11::_1,
+                                          std_cxx11::ref(constraints)),
+                         HangingNodeScratchData(),
+                         HangingNodeCopyData());
+      }
+
     }
 
 
@@ -1055,6 +1309,15 @@ namespace DoFTools
       // laid out there, so go read the paper before you try to understand
       // what is going on here
 
+      // without hp, only the simple case below can happen, and all faces
+      // share the same constraint templates, so they can be treated in
+      // parallel
+      if (DoFHandlerSupportsDifferentFEs<DoFHandlerType>::value == false)
+        {
+          make_single_fe_hanging_node_constraints (dof_handler, constraints);
+          return;
+        }
+
       const unsigned int dim = DoFHandlerType::dimension;
 
       const unsigned int spacedim = DoFHandlerType::space_dimension;
@@ -14,16 +14,22 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/thread_management.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/utilities.h>
+#include <deal.II/base/work_stream.h>
+#include <deal.II/base/std_cxx11/bind.h>
+#include <deal.II/base/std_cxx11/shared_ptr.h>
 #include <deal.II/lac/sparsity_pattern.h>
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/trilinos_sparsity_pattern.h>
 #include <deal.II/lac/block_sparsity_pattern.h>
 #include <deal.II/lac/vector.h>
 #include <deal.II/lac/constraint_matrix.h>
+#include <deal.II/lac/sparsity_entry_recorder.h>
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/tria_iterator.h>
 #include <deal.II/grid/intergrid_map.h>
@@ -49,6 +55,501 @@ DEAL_II_NAMESPACE_OPEN
 
 namespace DoFTools
 {
+  namespace internal
+  {
+    namespace
+    {
+      /**
+       * Scratch data for the functions below that compute the entries of the
+       * sparsity pattern on one cell.
+       */
+      struct SparsityScratchData
+      {
+        std::vector<types::global_dof_index> dofs_on_this_cell;
+        std::vector<types::global_dof_index> dofs_on_other_cell;
+      };
+
+
+
+      /**
+       * Return whether the entries of @p cell need to be added to the
+       * sparsity pattern, given the subdomain the caller asked for.
+       */
+      template <typename CellIterator>
+      bool
+      cell_is_selected (const CellIterator        &cell,
+                        const types::subdomain_id  subdomain_id)
+      {
+        // In case we work with a distributed sparsity pattern of Trilinos
+        // type, we only have to do the work if the current cell is owned by
+        // the calling processor. Otherwise, just continue.
+        return (((subdomain_id == numbers::invalid_subdomain_id)
+                 ||
+                 (subdomain_id == cell->subdomain_id()))
+                &&
+                cell->is_locally_owned());
+      }
+
+
+
+      /**
+       * Record the entries that couple the degrees of freedom on @p cell
+       * with each other. Several cells are worked on concurrently, so the
+       * entries are only recorded and written into the sparsity pattern by
+       * add_cell_entries().
+       */
+      template <typename DoFHandlerType>
+      void
+      record_cell_sparsity (const typename DoFHandlerType::active_cell_iterator &cell,
+                            SparsityScratchData                                 &scratch,
+                            internals::SparsityEntryRecorder                    &entries,
+                            const ConstraintMatrix                              &constraints,
+                            const bool                                           keep_constrained_dofs,
+                            const types::subdomain_id                            subdomain_id,
+                            const std::vector<Table<2,bool> >                   &dof_mask)
+      {
+        entries.clear ();
+        if (cell_is_selected (cell, subdomain_id) == false)
+          return;
+
+        scratch.dofs_on_this_cell.resize (cell->get_fe().dofs_per_cell);
+        cell->get_dof_indices (scratch.dofs_on_this_cell);
+
+        // make sparsity pattern for this cell. if no constraints pattern
+        // was given, then the following call acts as if simply no
+        // constraints existed
+        constraints.add_entries_local_to_global (scratch.dofs_on_this_cell,
+                                                 entries,
+                                                 keep_constrained_dofs,
+                                                 dof_mask[cell->active_fe_index()]);
+      }
+
+
+
+      /**
+       * Write the entries recorded for one cell into the sparsity pattern.
+       * WorkStream calls this function for one cell after the other, in the
+       * order of the cells, so the sparsity pattern gets the same entries in
+       * the same order as in a loop over all cells.
+       */
+      template <typename SparsityPatternType>
+      void
+      copy_sparsity_entries (const internals::SparsityEntryRecorder &entries,
+                             SparsityPatternType                    &sparsity)
+      {
+        entries.replay (sparsity);
+      }
+
+
+
+      /**
+       * A collection of objects that record sparsity entries, one for each
+       * block of consecutive rows. Objects of this type offer the interface
+       * of a sparsity pattern that SparsityEntryRecorder::replay() needs and
+       * sort the entries they are given into the bucket of their row.
+       */
+      class RowBuckets
+      {
+      public:
+        typedef types::global_dof_index size_type;
+
+        RowBuckets (const size_type    n_rows,
+                    const size_type    n_cols,
+                    const unsigned int n_buckets)
+          :
+          rows_per_bucket (std::max<size_type> ((n_rows + n_buckets - 1) / n_buckets,
+                                                1)),
+          buckets (n_buckets,
+                   internals::SparsityEntryRecorder (n_rows, n_cols))
+        {}
+
+        void add (const size_type i,
+                  const size_type j)
+        {
+          buckets[i / rows_per_bucket].add (i, j);
+        }
+
+        template <typename ForwardIterator>
+        void add_entries (const size_type row,
+                          ForwardIterator begin,
+                          ForwardIterator end,
+                          const bool      indices_are_sorted)
+        {
+          buckets[row / rows_per_bucket].add_entries (row, begin, end,
+                                                       indices_are_sorted);
+        }
+
+        const internals::SparsityEntryRecorder &
+        bucket (const unsigned int b) const
+        {
+          return buckets[b];
+        }
+
+        void clear ()
+        {
+          for (unsigned int b=0; b<buckets.size(); ++b)
+            buckets[b].clear ();
+        }
+
+      private:
+        const size_type rows_per_bucket;
+        std::vector<internals::SparsityEntryRecorder> buckets;
+      };
+
+
+
+      /**
+       * An object through which entries of different rows can be added to a
+       * BlockDynamicSparsityPattern from several threads at the same time.
+       * BlockDynamicSparsityPattern::add_entries() itself sorts the columns
+       * into blocks using scratch arrays that are members of the block
+       * sparsity pattern, so we instead add each entry directly to the
+       * block it belongs to.
+       */
+      class BlockRowAdder
+      {
+      public:
+        typedef types::global_dof_index size_type;
+
+        BlockRowAdder (BlockDynamicSparsityPattern &sparsity)
+          :
+          sparsity (sparsity)
+        {}
+
+        void add (const size_type i,
+                  const size_type j)
+        {
+          const std::pair<unsigned int,size_type>
+          row_index = sparsity.get_row_indices().global_to_local (i),
+          col_index = sparsity.get_column_indices().global_to_local (j);
+          sparsity.block (row_index.first, col_index.first).add (row_index.second,
+                                                                  col_index.second);
+        }
+
+        template <typename ForwardIterator>
+        void add_entries (const size_type row,
+                          ForwardIterator begin,
+                          ForwardIterator end,
+                          const bool)
+        {
+          for (; begin != end; ++begin)
+            add (row, *begin);
+        }
+
+      private:
+        BlockDynamicSparsityPattern &sparsity;
+      };
+
+
+
+      /**
+       * Record the entries of the cells <tt>cells[begin,end)</tt> with
+       * @p record_cell and sort them into @p row_buckets.
+       */
+      template <typename CellIterator, typename RecordCell>
+      void
+      record_cell_range (const std::vector<CellIterator> &cells,
+                         const unsigned int               begin,
+                         const unsigned int               end,
+                         const RecordCell                &record_cell,
+                         RowBuckets                      &row_buckets)
+      {
+        SparsityScratchData              scratch;
+        internals::SparsityEntryRecorder cell_entries;
+        for (unsigned int c=begin; c<end; ++c)
+          {
+            record_cell (cells[c], scratch, cell_entries);
+            cell_entries.replay (row_buckets);
+          }
+      }
+
+
+
+      /**
+       * Add the entries that the tasks of add_cell_entries_concurrently()
+       * have recorded for the row blocks <tt>[begin,end)</tt> to the
+       * sparsity pattern, using @p row_adder.
+       */
+      template <typename RowAdderType>
+      void
+      add_row_buckets (const std::vector<std_cxx11::shared_ptr<RowBuckets> > &task_buckets,
+                       RowAdderType                                         &row_adder,
+                       const unsigned int                                    begin,
+                       const unsigned int                                    end)
+      {
+        for (unsigned int b=begin; b<end; ++b)
+          for (unsigned int t=0; t<task_buckets.size(); ++t)
+            task_buckets[t]->bucket(b).replay (row_adder);
+      }
+
+
+
+      /**
+       * Compute the entries of all cells of @p dof with @p record_cell and
+       * add them to a sparsity pattern that allows entries of different rows
+       * to be added concurrently through @p row_adder.
+       *
+       * The cells are worked on in chunks of a bounded number of cells, so
+       * that the memory used for the recorded entries does not grow with the
+       * size of the mesh. Every chunk is split into one contiguous range per
+       * task. Each task records the entries of its cells and sorts them into
+       * buckets of consecutive rows. Then the buckets are merged in
+       * parallel: every row block is handled by one task, which adds the
+       * entries of all tasks for these rows. Since the rows of a dynamic
+       * sparsity pattern are sets, the result does not depend on the order
+       * in which this happens.
+       */
+      template <typename DoFHandlerType, typename RowAdderType, typename RecordCell>
+      void
+      add_cell_entries_concurrently (const DoFHandlerType &dof,
+                                     const types::global_dof_index n_rows,
+                                     const types::global_dof_index n_cols,
+                                     RowAdderType         &row_adder,
+                                     const RecordCell     &record_cell)
+      {
+        typedef typename DoFHandlerType::active_cell_iterator active_cell_iterator;
+
+        // the number of cells whose entries a task records before they are
+        // merged into the sparsity pattern
+        const unsigned int cells_per_task = 256;
+
+        const unsigned int n_tasks = 4*MultithreadInfo::n_threads();
+        const unsigned int n_row_blocks = 4*MultithreadInfo::n_threads();
+
+        std::vector<std_cxx11::shared_ptr<RowBuckets> > task_buckets (n_tasks);
+        for (unsigned int t=0; t<n_tasks; ++t)
+          task_buckets[t].reset (new RowBuckets (n_rows, n_cols, n_row_blocks));
+
+        std::vector<active_cell_iterator> cells;
+        cells.reserve (n_tasks * cells_per_task);
+
+        active_cell_iterator cell = dof.begin_active();
+        while (cell != dof.end())
+          {
+            cells.clear ();
+            for (; (cell != dof.end()) && (cells.size() < n_tasks * cells_per_task);
+                 ++cell)
+              cells.push_back (cell);
+
+            const unsigned int n_cells = cells.size();
+            Threads::TaskGroup<> tasks;
+            for (unsigned int t=0; t<n_tasks; ++t)
+              {
+                task_buckets[t]->clear ();
+                const unsigned int begin = (n_cells * t) / n_tasks,
+                                   end   = (n_cells * (t+1)) / n_tasks;
+                if (begin < end)
+                  tasks += Threads::new_task (&record_cell_range<active_cell_iterator,RecordCell>,
+                                              cells, begin, end, record_cell,
+                                              *task_buckets[t]);
+              }
+            tasks.join_all ();
+
+            parallel::apply_to_subranges (0U, n_row_blocks,
+                                          std_cxx11::bind (&add_row_buckets<RowAdderType>,
+                                                           std_cxx11::cref(task_buckets),
+                                                           std_cxx11::ref(row_adder),
+                                                           std_cxx11::_1,
+                                                           std_cxx11::_2),
+                                          1);
+          }
+      }
+
+
+
+      /**
+       * Compute the entries of all cells of @p dof with @p record_cell and
+       * add them to @p sparsity. For general sparsity pattern types, which do
+       * not allow adding entries from several threads, the entries are
+       * computed in parallel by WorkStream and written into the sparsity
+       * pattern one cell after the other. The overloads below instead also
+       * write into the sparsity pattern in parallel.
+       */
+      template <typename DoFHandlerType, typename SparsityPatternType, typename RecordCell>
+      void
+      add_cell_entries (const DoFHandlerType &dof,
+                        SparsityPatternType  &sparsity,
+                        const RecordCell     &record_cell)
+      {
+        WorkStream::run (dof.begin_active(), dof.end(),
+                         record_cell,
+                         std_cxx11::bind (&copy_sparsity_entries<SparsityPatternType>,
+                                          std_cxx11::_1,
+                                          std_cxx11::ref(sparsity)),
+                         SparsityScratchData(),
+                         internals::SparsityEntryRecorder (sparsity.n_rows(),
+                                                           sparsity.n_cols()));
+      }
+
+
+
+      template <typename DoFHandlerType, typename RecordCell>
+      void
+      add_cell_entries (const DoFHandlerType   &dof,
+                        DynamicSparsityPattern &sparsity,
+                        const RecordCell       &record_cell)
+      {
+        add_cell_entries_concurrently (dof, sparsity.n_rows(), sparsity.n_cols(),
+                                       sparsity, record_cell);
+      }
+
+
+
+      template <typename DoFHandlerType, typename RecordCell>
+      void
+      add_cell_entries (const DoFHandlerType        &dof,
+                        BlockDynamicSparsityPattern &sparsity,
+                        const RecordCell            &record_cell)
+      {
+        BlockRowAdder row_adder (sparsity);
+        add_cell_entries_concurrently (dof, sparsity.n_rows(), sparsity.n_cols(),
+                                       row_adder, record_cell);
+      }
+
+
+
+      /**
+       * Record the entries of the flux sparsity pattern for @p cell: those
+       * that couple the degrees of freedom on the cell with each other, and
+       * with the ones on its neighbors. See record_cell_sparsity().
+       */
+      template <typename DoFHandlerType>
+      void
+      record_cell_flux_sparsity (const typename DoFHandlerType::active_cell_iterator &cell,
+                                 SparsityScratchData                                 &scratch,
+                                 internals::SparsityEntryRecorder                    &entries,
+                                 const ConstraintMatrix                              &constraints,
+                                 const bool                                           keep_constrained_dofs,
+                                 const types::subdomain_id                            subdomain_id)
+      {
+        entries.clear ();
+        if (cell_is_selected (cell, subdomain_id) == false)
+          return;
+
+        scratch.dofs_on_this_cell.resize (cell->get_fe().dofs_per_cell);
+        cell->get_dof_indices (scratch.dofs_on_this_cell);
+
+        // make sparsity pattern for this cell. if no constraints pattern
+        // was given, then the following call acts as if simply no
+        // constraints existed
+        constraints.add_entries_local_to_global (scratch.dofs_on_this_cell,
+                                                 entries,
+                                                 keep_constrained_dofs);
+
+        for (unsigned int face = 0;
+             face < GeometryInfo<DoFHandlerType::dimension>::faces_per_cell;
+             ++face)
+          {
+            typename DoFHandlerType::face_iterator cell_face = cell->face(face);
+            if (! cell->at_boundary(face) )
+              {
+                typename DoFHandlerType::level_cell_iterator neighbor = cell->neighbor(face);
+
+                // in 1d, we do not need to worry whether the neighbor
+                // might have children and then loop over those children.
+                // rather, we may as well go straight to to cell behind
+                // this particular cell's most terminal child
+                if (DoFHandlerType::dimension==1)
+                  while (neighbor->has_children())
+                    neighbor = neighbor->child(face==0 ? 1 : 0);
+
+                if (neighbor->has_children())
+                  {
+                    for (unsigned int sub_nr = 0;
+                         sub_nr != cell_face->number_of_children();
+                         ++sub_nr)
+                      {
+                        const typename DoFHandlerType::level_cell_iterator
+                        sub_neighbor
+                          = cell->neighbor_child_on_subface (face, sub_nr);
+
+                        const unsigned int n_dofs_on_neighbor
+                          = sub_neighbor->get_fe().dofs_per_cell;
+                        scratch.dofs_on_other_cell.resize (n_dofs_on_neighbor);
+                        sub_neighbor->get_dof_indices (scratch.dofs_on_other_cell);
+
+                        constraints.add_entries_local_to_global
+                        (scratch.dofs_on_this_cell, scratch.dofs_on_other_cell,
+                         entries, keep_constrained_dofs);
+                        constraints.add_entries_local_to_global
+                        (scratch.dofs_on_other_cell, scratch.dofs_on_this_cell,
+                         entries, keep_constrained_dofs);
+                        // only need to add this when the neighbor is not
+                        // owned by the current processor, otherwise we add
+                        // the entries for the neighbor there
+                        if (sub_neighbor->subdomain_id() != cell->subdomain_id())
+                          constraints.add_entries_local_to_global
+                          (scratch.dofs_on_other_cell, entries, keep_constrained_dofs);
+                      }
+                  }
+                else
+                  {
+                    // Refinement edges are taken care of by coarser
+                    // cells
+                    if (cell->neighbor_is_coarser(face) &&
+                        neighbor->subdomain_id() == cell->subdomain_id())
+                      continue;
+
+                    const unsigned int n_dofs_on_neighbor
+                      = neighbor->get_fe().dofs_per_cell;
+                    scratch.dofs_on_other_cell.resize (n_dofs_on_neighbor);
+
+                    neighbor->get_dof_indices (scratch.dofs_on_other_cell);
+
+                    constraints.add_entries_local_to_global
+                    (scratch.dofs_on_this_cell, scratch.dofs_on_other_cell,
+                     entries, keep_constrained_dofs);
+
+                    // only need to add these in case the neighbor cell
+                    // is not locally owned - otherwise, we touch each
+                    // face twice and hence put the indices the other way
+                    // around
+                    if (!cell->neighbor(face)->active()
+                        ||
+                        (neighbor->subdomain_id() != cell->subdomain_id()))
+                      {
+                        constraints.add_entries_local_to_global
+                        (scratch.dofs_on_other_cell, scratch.dofs_on_this_cell,
+                         entries, keep_constrained_dofs);
+                        if (neighbor->subdomain_id() != cell->subdomain_id())
+                          constraints.add_entries_local_to_global
+                          (scratch.dofs_on_other_cell, entries, keep_constrained_dofs);
+                      }
+                  }
+              }
+          }
+      }
+
+
+
+      /**
+       * Implementation of the make_sparsity_pattern() functions for a single
+       * DoFHandler. The entries of each cell are computed in parallel, see
+       * add_cell_entries().
+       */
+      template <typename DoFHandlerType, typename SparsityPatternType>
+      void
+      make_sparsity_pattern_on_cells (const DoFHandlerType              &dof,
+                                      SparsityPatternType               &sparsity,
+                                      const ConstraintMatrix            &constraints,
+                                      const bool                         keep_constrained_dofs,
+                                      const types::subdomain_id          subdomain_id,
+                                      const std::vector<Table<2,bool> > &dof_mask)
+      {
+        add_cell_entries (dof, sparsity,
+                          std_cxx11::bind (&record_cell_sparsity<DoFHandlerType>,
+                                           std_cxx11::_1,
+                                           std_cxx11::_2,
+                                           std_cxx11::_3,
+                                           std_cxx11::cref(constraints),
+                                           keep_constrained_dofs,
+                                           subdomain_id,
+                                           std_cxx11::cref(dof_mask)));
+      }
+    }
+  }
+
+
 
   template <typename DoFHandlerType, typename SparsityPatternType>
   void
@@ -79,32 +580,13 @@ namespace DoFTools
                   "associated DoF handler objects, asking for any subdomain other "
                   "than the locally owned one does not make sense."));
 
-    std::vector<types::global_dof_index> dofs_on_this_cell;
-    dofs_on_this_cell.reserve (max_dofs_per_cell(dof));
-    typename DoFHandlerType::active_cell_iterator cell = dof.begin_active(),
-                                                  endc = dof.end();
-
-    // In case we work with a distributed sparsity pattern of Trilinos
-    // type, we only have to do the work if the current cell is owned by
-    // the calling processor. Otherwise, just continue.
-    for (; cell!=endc; ++cell)
-      if (((subdomain_id == numbers::invalid_subdomain_id)
-           ||
-           (subdomain_id == cell->subdomain_id()))
-          &&
-          cell->is_locally_owned())
-        {
-          const unsigned int dofs_per_cell = cell->get_fe().dofs_per_cell;
-          dofs_on_this_cell.resize (dofs_per_cell);
-          cell->get_dof_indices (dofs_on_this_cell);
-
-          // make sparsity pattern for this cell. if no constraints pattern
-          // was given, then the following call acts as if simply no
-          // constraints existed
-          constraints.add_entries_local_to_global (dofs_on_this_cell,
-                                                   sparsity,
-                                                   keep_constrained_dofs);
-        }
+    // an empty mask for each element means that all dofs on a cell couple
+    const std::vector<Table<2,bool> >
+    dof_mask (hp::FECollection<DoFHandlerType::dimension,DoFHandlerType::space_dimension>
+              (dof.get_fe()).size());
+    internal::make_sparsity_pattern_on_cells (dof, sparsity, constraints,
+                                              keep_constrained_dofs,
+                                              subdomain_id, dof_mask);
   }
 
 
@@ -191,35 +673,9 @@ namespace DoFTools
         }
 
 
-    std::vector<types::global_dof_index> dofs_on_this_cell(fe_collection.max_dofs_per_cell());
-    typename DoFHandlerType::active_cell_iterator cell = dof.begin_active(),
-                                                  endc = dof.end();
-
-    // In case we work with a distributed sparsity pattern of Trilinos
-    // type, we only have to do the work if the current cell is owned by
-    // the calling processor. Otherwise, just continue.
-    for (; cell!=endc; ++cell)
-      if (((subdomain_id == numbers::invalid_subdomain_id)
-           ||
-           (subdomain_id == cell->subdomain_id()))
-          &&
-          cell->is_locally_owned())
-        {
-          const unsigned int fe_index = cell->active_fe_index();
-          const unsigned int dofs_per_cell =fe_collection[fe_index].dofs_per_cell;
-
-          dofs_on_this_cell.resize (dofs_per_cell);
-          cell->get_dof_indices (dofs_on_this_cell);
-
-
-          // make sparsity pattern for this cell. if no constraints pattern
-          // was given, then the following call acts as if simply no
-          // constraints existed
-          constraints.add_entries_local_to_global (dofs_on_this_cell,
-                                                   sparsity,
-                                                   keep_constrained_dofs,
-                                                   dof_mask[fe_index]);
-        }
+    internal::make_sparsity_pattern_on_cells (dof, sparsity, constraints,
+                                              keep_constrained_dofs,
+                                              subdomain_id, dof_mask);
   }
 
 
@@ -492,9 +948,6 @@ namespace DoFTools
                               const ConstraintMatrix    &constraints,
                               const bool                 keep_constrained_dofs,
                               const types::subdomain_id  subdomain_id)
-
-  // TODO: QA: reduce the indentation level of this method..., Maier 2012
-
   {
     const types::global_dof_index n_dofs = dof.n_dofs();
     (void)n_dofs;
@@ -515,122 +968,18 @@ namespace DoFTools
                   "associated DoF handler objects, asking for any subdomain other "
                   "than the locally owned one does not make sense."));
 
-    std::vector<types::global_dof_index> dofs_on_this_cell;
-    std::vector<types::global_dof_index> dofs_on_other_cell;
-    dofs_on_this_cell.reserve (max_dofs_per_cell(dof));
-    dofs_on_other_cell.reserve (max_dofs_per_cell(dof));
-    typename DoFHandlerType::active_cell_iterator cell = dof.begin_active(),
-                                                  endc = dof.end();
-
     // TODO: in an old implementation, we used user flags before to tag
     // faces that were already touched. this way, we could reduce the work
     // a little bit. now, we instead add only data from one side. this
     // should be OK, but we need to actually verify it.
-
-    // In case we work with a distributed sparsity pattern of Trilinos
-    // type, we only have to do the work if the current cell is owned by
-    // the calling processor. Otherwise, just continue.
-    for (; cell!=endc; ++cell)
-      if (((subdomain_id == numbers::invalid_subdomain_id)
-           ||
-           (subdomain_id == cell->subdomain_id()))
-          &&
-          cell->is_locally_owned())
-        {
-          const unsigned int n_dofs_on_this_cell = cell->get_fe().dofs_per_cell;
-          dofs_on_this_cell.resize (n_dofs_on_this_cell);
-          cell->get_dof_indices (dofs_on_this_cell);
-
-          // make sparsity pattern for this cell. if no constraints pattern
-          // was given, then the following call acts as if simply no
-          // constraints existed
-          constraints.add_entries_local_to_global (dofs_on_this_cell,
-                                                   sparsity,
-                                                   keep_constrained_dofs);
-
-          for (unsigned int face = 0;
-               face < GeometryInfo<DoFHandlerType::dimension>::faces_per_cell;
-               ++face)
-            {
-              typename DoFHandlerType::face_iterator cell_face = cell->face(face);
-              if (! cell->at_boundary(face) )
-                {
-                  typename DoFHandlerType::level_cell_iterator neighbor = cell->neighbor(face);
-
-                  // in 1d, we do not need to worry whether the neighbor
-                  // might have children and then loop over those children.
-                  // rather, we may as well go straight to to cell behind
-                  // this particular cell's most terminal child
-                  if (DoFHandlerType::dimension==1)
-                    while (neighbor->has_children())
-                      neighbor = neighbor->child(face==0 ? 1 : 0);
-
-                  if (neighbor->has_children())
-                    {
-                      for (unsigned int sub_nr = 0;
-                           sub_nr != cell_face->number_of_children();
-                           ++sub_nr)
-                        {
-                          const typename DoFHandlerType::level_cell_iterator
-                          sub_neighbor
-                            = cell->neighbor_child_on_subface (face, sub_nr);
-
-                          const unsigned int n_dofs_on_neighbor
-                            = sub_neighbor->get_fe().dofs_per_cell;
-                          dofs_on_other_cell.resize (n_dofs_on_neighbor);
-                          sub_neighbor->get_dof_indices (dofs_on_other_cell);
-
-                          constraints.add_entries_local_to_global
-                          (dofs_on_this_cell, dofs_on_other_cell,
-                           sparsity, keep_constrained_dofs);
-                          constraints.add_entries_local_to_global
-                          (dofs_on_other_cell, dofs_on_this_cell,
-                           sparsity, keep_constrained_dofs);
-                          // only need to add this when the neighbor is not
-                          // owned by the current processor, otherwise we add
-                          // the entries for the neighbor there
-                          if (sub_neighbor->subdomain_id() != cell->subdomain_id())
-                            constraints.add_entries_local_to_global
-                            (dofs_on_other_cell, sparsity, keep_constrained_dofs);
-                        }
-                    }
-                  else
-                    {
-                      // Refinement edges are taken care of by coarser
-                      // cells
-                      if (cell->neighbor_is_coarser(face) &&
-                          neighbor->subdomain_id() == cell->subdomain_id())
-                        continue;
-
-                      const unsigned int n_dofs_on_neighbor
-                        = neighbor->get_fe().dofs_per_cell;
-                      dofs_on_other_cell.resize (n_dofs_on_neighbor);
-
-                      neighbor->get_dof_indices (dofs_on_other_cell);
-
-                      constraints.add_entries_local_to_global
-                      (dofs_on_this_cell, dofs_on_other_cell,
-                       sparsity, keep_constrained_dofs);
-
-                      // only need to add these in case the neighbor cell
-                      // is not locally owned - otherwise, we touch each
-                      // face twice and hence put the indices the other way
-                      // around
-                      if (!cell->neighbor(face)->active()
-                          ||
-                          (neighbor->subdomain_id() != cell->subdomain_id()))
-                        {
-                          constraints.add_entries_local_to_global
-                          (dofs_on_other_cell, dofs_on_this_cell,
-                           sparsity, keep_constrained_dofs);
-                          if (neighbor->subdomain_id() != cell->subdomain_id())
-                            constraints.add_entries_local_to_global
-                            (dofs_on_other_cell, sparsity, keep_constrained_dofs);
-                        }
-                    }
-                }
-            }
-        }
+    internal::add_cell_entries (dof, sparsity,
+                                std_cxx11::bind (&internal::record_cell_flux_sparsity<DoFHandlerType>,
+                                                 std_cxx11::_1,
+                                                 std_cxx11::_2,
+                                                 std_cxx11::_3,
+                                                 std_cxx11::cref(constraints),
+                                                 keep_constrained_dofs,
+                                                 subdomain_id));
   }
 
 
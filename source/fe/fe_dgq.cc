@@ -515,21 +515,17 @@ FE_DGQ<dim,spacedim>
         }
       else
         {
-          // must compute both restriction and prolongation matrices because
-          // we only check for their size and the reinit call initializes them
-          // all
-          this_nonconst.reinit_restriction_and_prolongation_matrices();
+          // only compute the matrices of the anisotropic refinement case
+          // asked for
+          std::vector<FullMatrix<double> >
+          matrices (GeometryInfo<dim>::n_children(RefinementCase<dim>(refinement_case)),
+                    FullMatrix<double>(this->dofs_per_cell, this->dofs_per_cell));
           if (dim == spacedim)
-            {
-              FETools::compute_embedding_matrices (*this, this_nonconst.prolongation);
-              FETools::compute_projection_matrices (*this, this_nonconst.restriction);
-            }
+            FETools::compute_embedding_matrices (*this, matrices, refinement_case);
           else
-            {
-              FE_DGQ<dim> tmp(this->degree);
-              FETools::compute_embedding_matrices (tmp, this_nonconst.prolongation);
-              FETools::compute_projection_matrices (tmp, this_nonconst.restriction);
-            }
+            FETools::compute_embedding_matrices (FE_DGQ<dim>(this->degree),
+                                                 matrices, refinement_case);
+          this_nonconst.prolongation[refinement_case-1].swap(matrices);
         }
     }
 
@@ -581,21 +577,25 @@ FE_DGQ<dim,spacedim>
         }
       else
         {
-          // must compute both restriction and prolongation matrices because
-          // we only check for their size and the reinit call initializes them
-          // all
-          this_nonconst.reinit_restriction_and_prolongation_matrices();
+          // the projection matrices are computed for all refinement cases at
+          // once. only fill the ones not yet set, in order not to touch
+          // matrices that other threads may already be reading
+          std::vector<std::vector<FullMatrix<double> > >
+          matrices(RefinementCase<dim>::isotropic_refinement);
+          for (unsigned int ref_case=RefinementCase<dim>::cut_x;
+               ref_case <= RefinementCase<dim>::isotropic_refinement; ++ref_case)
+            matrices[ref_case-1].resize (GeometryInfo<dim>::n_children(RefinementCase<dim>(ref_case)),
+                                         FullMatrix<double>(this->dofs_per_cell,
+                                                            this->dofs_per_cell));
           if (dim == spacedim)
-            {
-              FETools::compute_embedding_matrices (*this, this_nonconst.prolongation);
-              FETools::compute_projection_matrices (*this, this_nonconst.restriction);
-            }
+            FETools::compute_projection_matrices (*this, matrices);
           else
-            {
-              FE_DGQ<dim> tmp(this->degree);
-              FETools::compute_embedding_matrices (tmp, this_nonconst.prolongation);
-              FETools::compute_projection_matrices (tmp, this_nonconst.restriction);
-            }
+            FETools::compute_projection_matrices (FE_DGQ<dim>(this->degree),
+                                                  matrices);
+          for (unsigned int ref_case=RefinementCase<dim>::cut_x;
+               ref_case <= RefinementCase<dim>::isotropic_refinement; ++ref_case)
+            if (this->restriction[ref_case-1][0].n() == 0)
+              this_nonconst.restriction[ref_case-1].swap(matrices[ref_case-1]);
         }
     }
 
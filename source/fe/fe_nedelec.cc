@@ -503,12 +503,12 @@ FE_Nedelec<3>::initialize_support_points (const unsigned int degree)
 // Set the restriction matrices.
 template <>
 void
-FE_Nedelec<1>::initialize_restriction ()
+FE_Nedelec<1>::initialize_restriction (std::vector<FullMatrix<double> > &matrices) const
 {
   // there is only one refinement case in 1d,
   // which is the isotropic one
   for (unsigned int i = 0; i < GeometryInfo<1>::max_children_per_cell; ++i)
-    this->restriction[0][i].reinit(0, 0);
+    matrices[i].reinit(0, 0);
 }
 
 
@@ -516,7 +516,7 @@ FE_Nedelec<1>::initialize_restriction ()
 // Restriction operator
 template <int dim>
 void
-FE_Nedelec<dim>::initialize_restriction ()
+FE_Nedelec<dim>::initialize_restriction (std::vector<FullMatrix<double> > &matrices) const
 {
   // This function does the same as the
   // function interpolate further below.
@@ -529,8 +529,6 @@ FE_Nedelec<dim>::initialize_restriction ()
     = edge_quadrature.get_points ();
   const unsigned int &
   n_edge_quadrature_points = edge_quadrature.size ();
-  const unsigned int
-  index = RefinementCase<dim>::isotropic_refinement - 1;
 
   switch (dim)
     {
@@ -551,24 +549,24 @@ FE_Nedelec<dim>::initialize_restriction ()
                 Point<dim> quadrature_point (0.0,
                                              2.0 * edge_quadrature_points[q_point] (0));
 
-                this->restriction[index][0] (0, dof) += weight
+                matrices[0] (0, dof) += weight
                                                         * this->shape_value_component
                                                         (dof,
                                                          quadrature_point,
                                                          1);
                 quadrature_point (0) = 1.0;
-                this->restriction[index][1] (this->degree, dof)
+                matrices[1] (this->degree, dof)
                 += weight * this->shape_value_component (dof,
                                                          quadrature_point,
                                                          1);
                 quadrature_point (0) = quadrature_point (1);
                 quadrature_point (1) = 0.0;
-                this->restriction[index][0] (2 * this->degree, dof)
+                matrices[0] (2 * this->degree, dof)
                 += weight * this->shape_value_component (dof,
                                                          quadrature_point,
                                                          0);
                 quadrature_point (1) = 1.0;
-                this->restriction[index][2] (3 * this->degree, dof)
+                matrices[2] (3 * this->degree, dof)
                 += weight * this->shape_value_component (dof,
                                                          quadrature_point,
                                                          0);
@@ -580,24 +578,24 @@ FE_Nedelec<dim>::initialize_restriction ()
                                              2.0 * edge_quadrature_points[q_point] (0)
                                              - 1.0);
 
-                this->restriction[index][2] (0, dof) += weight
+                matrices[2] (0, dof) += weight
                                                         * this->shape_value_component
                                                         (dof,
                                                          quadrature_point,
                                                          1);
                 quadrature_point (0) = 1.0;
-                this->restriction[index][3] (this->degree, dof)
+                matrices[3] (this->degree, dof)
                 += weight * this->shape_value_component (dof,
                                                          quadrature_point,
                                                          1);
                 quadrature_point (0) = quadrature_point (1);
                 quadrature_point (1) = 0.0;
-                this->restriction[index][1] (2 * this->degree, dof)
+                matrices[1] (2 * this->degree, dof)
                 += weight * this->shape_value_component (dof,
                                                          quadrature_point,
                                                          0);
                 quadrature_point (1) = 1.0;
-                this->restriction[index][3] (3 * this->degree, dof)
+                matrices[3] (3 * this->degree, dof)
                 += weight * this->shape_value_component (dof,
                                                          quadrature_point,
                                                          0);
@@ -666,13 +664,13 @@ FE_Nedelec<dim>::initialize_restriction ()
                         tmp (0) = weight
                                   * (2.0 * this->shape_value_component
                                      (dof, quadrature_point_2, 1)
-                                     - this->restriction[index][i]
+                                     - matrices[i]
                                      (i * this->degree, dof)
                                      * this->shape_value_component
                                      (i * this->degree,
                                       quadrature_point_0, 1));
                         tmp (1) = -1.0 * weight
-                                  * this->restriction[index][i + 2]
+                                  * matrices[i + 2]
                                   (i * this->degree, dof)
                                   * this->shape_value_component
                                   (i * this->degree,
@@ -683,13 +681,13 @@ FE_Nedelec<dim>::initialize_restriction ()
                         tmp (2) = weight
                                   * (2.0 * this->shape_value_component
                                      (dof, quadrature_point_2, 0)
-                                     - this->restriction[index][2 * i]
+                                     - matrices[2 * i]
                                      ((i + 2) * this->degree, dof)
                                      * this->shape_value_component
                                      ((i + 2) * this->degree,
                                       quadrature_point_1, 0));
                         tmp (3) = -1.0 * weight
-                                  * this->restriction[index][2 * i + 1]
+                                  * matrices[2 * i + 1]
                                   ((i + 2) * this->degree, dof)
                                   * this->shape_value_component
                                   ((i + 2) * this->degree,
@@ -699,7 +697,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                     else
                       {
                         tmp (0) = -1.0 * weight
-                                  * this->restriction[index][i]
+                                  * matrices[i]
                                   (i * this->degree, dof)
                                   * this->shape_value_component
                                   (i * this->degree,
@@ -712,13 +710,13 @@ FE_Nedelec<dim>::initialize_restriction ()
                         tmp (1) = weight
                                   * (2.0 * this->shape_value_component
                                      (dof, quadrature_point_2, 1)
-                                     - this->restriction[index][i + 2]
+                                     - matrices[i + 2]
                                      (i * this->degree, dof)
                                      * this->shape_value_component
                                      (i * this->degree,
                                       quadrature_point_0, 1));
                         tmp (2) = -1.0 * weight
-                                  * this->restriction[index][2 * i]
+                                  * matrices[2 * i]
                                   ((i + 2) * this->degree, dof)
                                   * this->shape_value_component
                                   ((i + 2) * this->degree,
@@ -729,7 +727,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                         tmp (3) = weight
                                   * (2.0 * this->shape_value_component
                                      (dof, quadrature_point_2, 0)
-                                     - this->restriction[index][2 * i + 1]
+                                     - matrices[2 * i + 1]
                                      ((i + 2) * this->degree, dof)
                                      * this->shape_value_component
                                      ((i + 2) * this->degree,
@@ -753,12 +751,12 @@ FE_Nedelec<dim>::initialize_restriction ()
                   for (unsigned int k = 0; k < 2; ++k)
                     {
                       if (std::abs (solution (j, k)) > 1e-14)
-                        this->restriction[index][i + 2 * k]
+                        matrices[i + 2 * k]
                         (i * this->degree + j + 1, dof)
                           = solution (j, k);
 
                       if (std::abs (solution (j, k + 2)) > 1e-14)
-                        this->restriction[index][2 * i + k]
+                        matrices[2 * i + k]
                         ((i + 2) * this->degree + j + 1, dof)
                           = solution (j, k + 2);
                     }
@@ -877,23 +875,23 @@ FE_Nedelec<dim>::initialize_restriction ()
                   for (unsigned int i = 0; i < 2; ++i)
                     for (unsigned int j = 0; j < this->degree; ++j)
                       {
-                        tmp (2 * i) -= this->restriction[index][i]
+                        tmp (2 * i) -= matrices[i]
                                        (j + 2 * this->degree, dof)
                                        * this->shape_value_component
                                        (j + 2 * this->degree,
                                         quadrature_points[q_point], 0);
-                        tmp (2 * i + 1) -= this->restriction[index][i]
+                        tmp (2 * i + 1) -= matrices[i]
                                            (i * this->degree + j, dof)
                                            * this->shape_value_component
                                            (i * this->degree + j,
                                             quadrature_points[q_point], 1);
-                        tmp (2 * (i + 2)) -= this->restriction[index][i + 2]
+                        tmp (2 * (i + 2)) -= matrices[i + 2]
                                              (j + 3 * this->degree, dof)
                                              * this->shape_value_component
                                              (j + 3 * this->degree,
                                               quadrature_points[q_point],
                                               0);
-                        tmp (2 * i + 5) -= this->restriction[index][i + 2]
+                        tmp (2 * i + 5) -= matrices[i + 2]
                                            (i * this->degree + j, dof)
                                            * this->shape_value_component
                                            (i * this->degree + j,
@@ -939,13 +937,13 @@ FE_Nedelec<dim>::initialize_restriction ()
                     {
                       if (std::abs (solution (i * (this->degree-1) + j, 2 * k))
                           > 1e-14)
-                        this->restriction[index][k]
+                        matrices[k]
                         (i * (this->degree-1) + j + n_boundary_dofs, dof)
                           = solution (i * (this->degree-1) + j, 2 * k);
 
                       if (std::abs (solution (i * (this->degree-1) + j, 2 * k + 1))
                           > 1e-14)
-                        this->restriction[index][k]
+                        matrices[k]
                         (i + (this->degree-1 + j) * this->degree + n_boundary_dofs,
                          dof)
                           = solution (i * (this->degree-1) + j, 2 * k + 1);
@@ -976,7 +974,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                                                  2.0 * edge_quadrature_points[q_point] (0),
                                                  j);
 
-                    this->restriction[index][i + 4 * j]
+                    matrices[i + 4 * j]
                     ((i + 4 * j) * this->degree, dof)
                     += weight * this->shape_value_component (dof,
                                                              quadrature_point,
@@ -984,14 +982,14 @@ FE_Nedelec<dim>::initialize_restriction ()
                     quadrature_point
                       = Point<dim> (2.0 * edge_quadrature_points[q_point] (0),
                                     i, j);
-                    this->restriction[index][2 * (i + 2 * j)]
+                    matrices[2 * (i + 2 * j)]
                     ((i + 4 * j + 2) * this->degree, dof)
                     += weight * this->shape_value_component (dof,
                                                              quadrature_point,
                                                              0);
                     quadrature_point = Point<dim> (i, j,
                                                    2.0 * edge_quadrature_points[q_point] (0));
-                    this->restriction[index][i + 2 * j]
+                    matrices[i + 2 * j]
                     ((i + 2 * (j + 4)) * this->degree, dof)
                     += weight * this->shape_value_component (dof,
                                                              quadrature_point,
@@ -1006,7 +1004,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                                                  2.0 * edge_quadrature_points[q_point] (0)
                                                  - 1.0, j);
 
-                    this->restriction[index][i + 4 * j + 2]
+                    matrices[i + 4 * j + 2]
                     ((i + 4 * j) * this->degree, dof)
                     += weight * this->shape_value_component (dof,
                                                              quadrature_point,
@@ -1014,7 +1012,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                     quadrature_point
                       = Point<dim> (2.0 * edge_quadrature_points[q_point] (0)
                                     - 1.0, i, j);
-                    this->restriction[index][2 * (i + 2 * j) + 1]
+                    matrices[2 * (i + 2 * j) + 1]
                     ((i + 4 * j + 2) * this->degree, dof)
                     += weight * this->shape_value_component (dof,
                                                              quadrature_point,
@@ -1022,7 +1020,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                     quadrature_point = Point<dim> (i, j,
                                                    2.0 * edge_quadrature_points[q_point] (0)
                                                    - 1.0);
-                    this->restriction[index][i + 2 * (j + 2)]
+                    matrices[i + 2 * (j + 2)]
                     ((i + 2 * (j + 4)) * this->degree, dof)
                     += weight * this->shape_value_component (dof,
                                                              quadrature_point,
@@ -1097,14 +1095,14 @@ FE_Nedelec<dim>::initialize_restriction ()
                           tmp (0) = weight
                                     * (2.0 * this->shape_value_component
                                        (dof, quadrature_point_3, 1)
-                                       - this->restriction[index][i + 4 * j]
+                                       - matrices[i + 4 * j]
                                        ((i + 4 * j) * this->degree,
                                         dof)
                                        * this->shape_value_component
                                        ((i + 4 * j) * this->degree,
                                         quadrature_point_0, 1));
                           tmp (1) = -1.0 * weight
-                                    * this->restriction[index][i + 4 * j + 2]
+                                    * matrices[i + 4 * j + 2]
                                     ((i + 4 * j) * this->degree,
                                      dof)
                                     * this->shape_value_component
@@ -1116,14 +1114,14 @@ FE_Nedelec<dim>::initialize_restriction ()
                           tmp (2) = weight
                                     * (2.0 * this->shape_value_component
                                        (dof, quadrature_point_3, 0)
-                                       - this->restriction[index][2 * (i + 2 * j)]
+                                       - matrices[2 * (i + 2 * j)]
                                        ((i + 4 * j + 2) * this->degree,
                                         dof)
                                        * this->shape_value_component
                                        ((i + 4 * j + 2) * this->degree,
                                         quadrature_point_1, 0));
                           tmp (3) = -1.0 * weight
-                                    * this->restriction[index][2 * (i + 2 * j) + 1]
+                                    * matrices[2 * (i + 2 * j) + 1]
                                     ((i + 4 * j + 2) * this->degree,
                                      dof)
                                     * this->shape_value_component
@@ -1134,14 +1132,14 @@ FE_Nedelec<dim>::initialize_restriction ()
                           tmp (4) = weight
                                     * (2.0 * this->shape_value_component
                                        (dof, quadrature_point_3, 2)
-                                       - this->restriction[index][i + 2 * j]
+                                       - matrices[i + 2 * j]
                                        ((i + 2 * (j + 4)) * this->degree,
                                         dof)
                                        * this->shape_value_component
                                        ((i + 2 * (j + 4)) * this->degree,
                                         quadrature_point_2, 2));
                           tmp (5) = -1.0 * weight
-                                    * this->restriction[index][i + 2 * (j + 2)]
+                                    * matrices[i + 2 * (j + 2)]
                                     ((i + 2 * (j + 4)) * this->degree,
                                      dof)
                                     * this->shape_value_component
@@ -1152,7 +1150,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                       else
                         {
                           tmp (0) = -1.0 * weight
-                                    * this->restriction[index][i + 4 * j]
+                                    * matrices[i + 4 * j]
                                     ((i + 4 * j) * this->degree,
                                      dof)
                                     * this->shape_value_component
@@ -1166,14 +1164,14 @@ FE_Nedelec<dim>::initialize_restriction ()
                           tmp (1) = weight
                                     * (2.0 * this->shape_value_component
                                        (dof, quadrature_point_3, 1)
-                                       - this->restriction[index][i + 4 * j + 2]
+                                       - matrices[i + 4 * j + 2]
                                        ((i + 4 * j) * this->degree,
                                         dof)
                                        * this->shape_value_component
                                        ((i + 4 * j) * this->degree,
                                         quadrature_point_0, 1));
                           tmp (2) = -1.0 * weight
-                                    * this->restriction[index][2 * (i + 2 * j)]
+                                    * matrices[2 * (i + 2 * j)]
                                     ((i + 4 * j + 2) * this->degree,
                                      dof)
                                     * this->shape_value_component
@@ -1185,14 +1183,14 @@ FE_Nedelec<dim>::initialize_restriction ()
                           tmp (3) = weight
                                     * (2.0 * this->shape_value_component
                                        (dof, quadrature_point_3, 0)
-                                       - this->restriction[index][2 * (i + 2 * j) + 1]
+                                       - matrices[2 * (i + 2 * j) + 1]
                                        ((i + 4 * j + 2) * this->degree,
                                         dof)
                                        * this->shape_value_component
                                        ((i + 4 * j + 2) * this->degree,
                                         quadrature_point_1, 0));
                           tmp (4) = -1.0 * weight
-                                    * this->restriction[index][i + 2 * j]
+                                    * matrices[i + 2 * j]
                                     ((i + 2 * (j + 4)) * this->degree,
                                      dof)
                                     * this->shape_value_component
@@ -1204,7 +1202,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                           tmp (5) = weight
                                     * (2.0 * this->shape_value_component
                                        (dof, quadrature_point_3, 2)
-                                       - this->restriction[index][i + 2 * (j + 2)]
+                                       - matrices[i + 2 * (j + 2)]
                                        ((i + 2 * (j + 4)) * this->degree,
                                         dof)
                                        * this->shape_value_component
@@ -1229,17 +1227,17 @@ FE_Nedelec<dim>::initialize_restriction ()
                     for (unsigned int l = 0; l < deg; ++l)
                       {
                         if (std::abs (solution (l, k)) > 1e-14)
-                          this->restriction[index][i + 2 * (2 * j + k)]
+                          matrices[i + 2 * (2 * j + k)]
                           ((i + 4 * j) * this->degree + l + 1, dof)
                             = solution (l, k);
 
                         if (std::abs (solution (l, k + 2)) > 1e-14)
-                          this->restriction[index][2 * (i + 2 * j) + k]
+                          matrices[2 * (i + 2 * j) + k]
                           ((i + 4 * j + 2) * this->degree + l + 1, dof)
                             = solution (l, k + 2);
 
                         if (std::abs (solution (l, k + 4)) > 1e-14)
-                          this->restriction[index][i + 2 * (j + 2 * k)]
+                          matrices[i + 2 * (j + 2 * k)]
                           ((i + 2 * (j + 4)) * this->degree + l + 1,
                            dof)
                             = solution (l, k + 4);
@@ -1446,41 +1444,41 @@ FE_Nedelec<dim>::initialize_restriction ()
                         for (unsigned int l = 0; l <= deg; ++l)
                           {
                             tmp (2 * (j + 2 * k))
-                            -= this->restriction[index][i + 2 * (2 * j + k)]
+                            -= matrices[i + 2 * (2 * j + k)]
                                ((i + 4 * j) * this->degree + l, dof)
                                * this->shape_value_component
                                ((i + 4 * j) * this->degree + l,
                                 quadrature_point_0, 1);
                             tmp (2 * (j + 2 * k) + 1)
-                            -= this->restriction[index][i + 2 * (2 * j + k)]
+                            -= matrices[i + 2 * (2 * j + k)]
                                ((i + 2 * (k + 4)) * this->degree + l,
                                 dof)
                                * this->shape_value_component
                                ((i + 2 * (k + 4)) * this->degree + l,
                                 quadrature_point_0, 2);
                             tmp (2 * (j + 2 * (k + 2)))
-                            -= this->restriction[index][2 * (i + 2 * j) + k]
+                            -= matrices[2 * (i + 2 * j) + k]
                                ((2 * (i + 4) + k) * this->degree + l,
                                 dof)
                                * this->shape_value_component
                                ((2 * (i + 4) + k) * this->degree + l,
                                 quadrature_point_1, 2);
                             tmp (2 * (j + 2 * k) + 9)
-                            -= this->restriction[index][2 * (i + 2 * j) + k]
+                            -= matrices[2 * (i + 2 * j) + k]
                                ((i + 4 * j + 2) * this->degree + l,
                                 dof)
                                * this->shape_value_component
                                ((i + 4 * j + 2) * this->degree + l,
                                 quadrature_point_1, 0);
                             tmp (2 * (j + 2 * (k + 4)))
-                            -= this->restriction[index][2 * (2 * i + j) + k]
+                            -= matrices[2 * (2 * i + j) + k]
                                ((4 * i + j + 2) * this->degree + l,
                                 dof)
                                * this->shape_value_component
                                ((4 * i + j + 2) * this->degree + l,
                                 quadrature_point_2, 0);
                             tmp (2 * (j + 2 * k) + 17)
-                            -= this->restriction[index][2 * (2 * i + j) + k]
+                            -= matrices[2 * (2 * i + j) + k]
                                ((4 * i + k) * this->degree + l, dof)
                                * this->shape_value_component
                                ((4 * i + k) * this->degree + l,
@@ -1536,7 +1534,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                           if (std::abs (solution (l * deg + m,
                                                   2 * (j + 2 * k)))
                               > 1e-14)
-                            this->restriction[index][i + 2 * (2 * j + k)]
+                            matrices[i + 2 * (2 * j + k)]
                             ((2 * i * this->degree + l) * deg + m
                              + n_edge_dofs,
                              dof) = solution (l * deg + m,
@@ -1545,7 +1543,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                           if (std::abs (solution (l * deg + m,
                                                   2 * (j + 2 * k) + 1))
                               > 1e-14)
-                            this->restriction[index][i + 2 * (2 * j + k)]
+                            matrices[i + 2 * (2 * j + k)]
                             (((2 * i + 1) * deg + m) * this->degree + l
                              + n_edge_dofs, dof)
                               = solution (l * deg + m,
@@ -1554,7 +1552,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                           if (std::abs (solution (l * deg + m,
                                                   2 * (j + 2 * (k + 2))))
                               > 1e-14)
-                            this->restriction[index][2 * (i + 2 * j) + k]
+                            matrices[2 * (i + 2 * j) + k]
                             ((2 * (i + 2) * this->degree + l) * deg + m
                              + n_edge_dofs,
                              dof) = solution (l * deg + m,
@@ -1563,7 +1561,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                           if (std::abs (solution (l * deg + m,
                                                   2 * (j + 2 * k) + 9))
                               > 1e-14)
-                            this->restriction[index][2 * (i + 2 * j) + k]
+                            matrices[2 * (i + 2 * j) + k]
                             (((2 * i + 5) * deg + m) * this->degree + l
                              + n_edge_dofs, dof)
                               = solution (l * deg + m,
@@ -1572,7 +1570,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                           if (std::abs (solution (l * deg + m,
                                                   2 * (j + 2 * (k + 4))))
                               > 1e-14)
-                            this->restriction[index][2 * (2 * i + j) + k]
+                            matrices[2 * (2 * i + j) + k]
                             ((2 * (i + 4) * this->degree + l) * deg + m
                              + n_edge_dofs,
                              dof) = solution (l * deg + m,
@@ -1581,7 +1579,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                           if (std::abs (solution (l * deg + m,
                                                   2 * (j + 2 * k) + 17))
                               > 1e-14)
-                            this->restriction[index][2 * (2 * i + j) + k]
+                            matrices[2 * (2 * i + j) + k]
                             (((2 * i + 9) * deg + m) * this->degree + l
                              + n_edge_dofs, dof)
                               = solution (l * deg + m,
@@ -1798,19 +1796,19 @@ FE_Nedelec<dim>::initialize_restriction ()
                         for (unsigned int l = 0; l <= deg; ++l)
                           {
                             tmp (3 * (i + 2 * (j + 2 * k)))
-                            -= this->restriction[index][2 * (2 * i + j) + k]
+                            -= matrices[2 * (2 * i + j) + k]
                                ((4 * i + j + 2) * this->degree + l, dof)
                                * this->shape_value_component
                                ((4 * i + j + 2) * this->degree + l,
                                 quadrature_points[q_point], 0);
                             tmp (3 * (i + 2 * (j + 2 * k)) + 1)
-                            -= this->restriction[index][2 * (2 * i + j) + k]
+                            -= matrices[2 * (2 * i + j) + k]
                                ((4 * i + k) * this->degree + l, dof)
                                * this->shape_value_component
                                ((4 * i + k) * this->degree + l,
                                 quadrature_points[q_point], 1);
                             tmp (3 * (i + 2 * (j + 2 * k)) + 2)
-                            -= this->restriction[index][2 * (2 * i + j) + k]
+                            -= matrices[2 * (2 * i + j) + k]
                                ((2 * (j + 4) + k) * this->degree + l,
                                 dof)
                                * this->shape_value_component
@@ -1820,7 +1818,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                             for (unsigned int m = 0; m < deg; ++m)
                               {
                                 tmp (3 * (i + 2 * (j + 2 * k)))
-                                -= this->restriction[index][2 * (2 * i + j) + k]
+                                -= matrices[2 * (2 * i + j) + k]
                                    (((2 * j + 5) * deg + m)
                                     * this->degree + l + n_edge_dofs,
                                     dof)
@@ -1829,7 +1827,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                                     * this->degree + l + n_edge_dofs,
                                     quadrature_points[q_point], 0);
                                 tmp (3 * (i + 2 * (j + 2 * k)))
-                                -= this->restriction[index][2 * (2 * i + j) + k]
+                                -= matrices[2 * (2 * i + j) + k]
                                    ((2 * (i + 4) * this->degree + l)
                                     * deg + m + n_edge_dofs, dof)
                                    * this->shape_value_component
@@ -1837,7 +1835,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                                     * deg + m + n_edge_dofs,
                                     quadrature_points[q_point], 0);
                                 tmp (3 * (i + 2 * (j + 2 * k)) + 1)
-                                -= this->restriction[index][2 * (2 * i + j) + k]
+                                -= matrices[2 * (2 * i + j) + k]
                                    ((2 * k * this->degree + l) * deg + m
                                     + n_edge_dofs,
                                     dof)
@@ -1846,7 +1844,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                                     + n_edge_dofs,
                                     quadrature_points[q_point], 1);
                                 tmp (3 * (i + 2 * (j + 2 * k)) + 1)
-                                -= this->restriction[index][2 * (2 * i + j) + k]
+                                -= matrices[2 * (2 * i + j) + k]
                                    (((2 * i + 9) * deg + m)
                                     * this->degree + l + n_edge_dofs,
                                     dof)
@@ -1855,7 +1853,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                                     * this->degree + l + n_edge_dofs,
                                     quadrature_points[q_point], 1);
                                 tmp (3 * (i + 2 * (j + 2 * k)) + 2)
-                                -= this->restriction[index][2 * (2 * i + j) + k]
+                                -= matrices[2 * (2 * i + j) + k]
                                    (((2 * k + 1) * deg + m)
                                     * this->degree + l + n_edge_dofs,
                                     dof)
@@ -1864,7 +1862,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                                     * this->degree + l + n_edge_dofs,
                                     quadrature_points[q_point], 2);
                                 tmp (3 * (i + 2 * (j + 2 * k)) + 2)
-                                -= this->restriction[index][2 * (2 * i + j) + k]
+                                -= matrices[2 * (2 * i + j) + k]
                                    ((2 * (j + 2) * this->degree + l)
                                     * deg + m + n_edge_dofs, dof)
                                    * this->shape_value_component
@@ -1942,7 +1940,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                                           ((l * deg + m) * deg + n,
                                            3 * (i + 2 * (j + 2 * k))))
                                 > 1e-14)
-                              this->restriction[index][2 * (2 * i + j) + k]
+                              matrices[2 * (2 * i + j) + k]
                               ((l * deg + m) * deg + n + n_boundary_dofs,
                                dof) = solution ((l * deg + m) * deg + n,
                                                 3 * (i + 2 * (j + 2 * k)));
@@ -1951,7 +1949,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                                           ((l * deg + m) * deg + n,
                                            3 * (i + 2 * (j + 2 * k)) + 1))
                                 > 1e-14)
-                              this->restriction[index][2 * (2 * i + j) + k]
+                              matrices[2 * (2 * i + j) + k]
                               ((l + (m + deg) * this->degree) * deg + n
                                + n_boundary_dofs,
                                dof) = solution ((l * deg + m) * deg + n,
@@ -1961,7 +1959,7 @@ FE_Nedelec<dim>::initialize_restriction ()
                                           ((l * deg + m) * deg + n,
                                            3 * (i + 2 * (j + 2 * k)) + 2))
                                 > 1e-14)
-                              this->restriction[index][2 * (2 * i + j) + k]
+                              matrices[2 * (2 * i + j) + k]
                               (l + ((m + 2 * deg) * deg + n) * this->degree
                                + n_boundary_dofs, dof)
                                 = solution ((l * deg + m) * deg + n,
@@ -3006,26 +3004,24 @@ FE_Nedelec<dim>
           this->dofs_per_cell)
         return this->prolongation[refinement_case-1][child];
 
-      // now do the work. need to get a non-const version of data in order to
-      // be able to modify them inside a const function
+      // now do the work, but only for the refinement case asked for. need to
+      // get a non-const version of data in order to be able to modify them
+      // inside a const function
       FE_Nedelec<dim> &this_nonconst = const_cast<FE_Nedelec<dim>& >(*this);
 
-      // Reinit the vectors of
-      // restriction and prolongation
-      // matrices to the right sizes.
-      // Restriction only for isotropic
-      // refinement
 #ifdef DEBUG_NEDELEC
       deallog << "Embedding" << std::endl;
 #endif
-      this_nonconst.reinit_restriction_and_prolongation_matrices ();
-      // Fill prolongation matrices with embedding operators
-      FETools::compute_embedding_matrices (this_nonconst, this_nonconst.prolongation, true,
-                                           internal::get_embedding_computation_tolerance(this->degree));
-#ifdef DEBUG_NEDELEC
-      deallog << "Restriction" << std::endl;
-#endif
-      this_nonconst.initialize_restriction ();
+      // as for the restriction, embedding matrices are only computed for
+      // isotropic refinement. for all other refinement cases, the matrices
+      // are left at zero
+      std::vector<FullMatrix<double> >
+      matrices (GeometryInfo<dim>::n_children(refinement_case),
+                FullMatrix<double> (this->dofs_per_cell, this->dofs_per_cell));
+      if (refinement_case == RefinementCase<dim>::isotropic_refinement)
+        FETools::compute_embedding_matrices (*this, matrices, refinement_case,
+                                             internal::get_embedding_computation_tolerance(this->degree));
+      this_nonconst.prolongation[refinement_case-1].swap (matrices);
     }
 
   // we use refinement_case-1 here. the -1 takes care of the origin of the
@@ -3057,26 +3053,27 @@ FE_Nedelec<dim>
           this->dofs_per_cell)
         return this->restriction[refinement_case-1][child];
 
-      // now do the work. need to get a non-const version of data in order to
-      // be able to modify them inside a const function
-      FE_Nedelec<dim> &this_nonconst = const_cast<FE_Nedelec<dim>& >(*this);
-
-      // Reinit the vectors of
-      // restriction and prolongation
-      // matrices to the right sizes.
-      // Restriction only for isotropic
-      // refinement
-#ifdef DEBUG_NEDELEC
-      deallog << "Embedding" << std::endl;
-#endif
-      this_nonconst.reinit_restriction_and_prolongation_matrices ();
-      // Fill prolongation matrices with embedding operators
-      FETools::compute_embedding_matrices (this_nonconst, this_nonconst.prolongation, true,
-                                           internal::get_embedding_computation_tolerance(this->degree));
+      // restriction matrices are only implemented for isotropic
+      // refinement. for the other refinement cases, we only set the sizes of
+      // the matrices, without computing the embedding matrices that are not
+      // needed here. the matrices are computed in a separate object and only
+      // swapped in once they are complete, since other threads may check
+      // their size above without acquiring the lock
+      std::vector<FullMatrix<double> >
+      matrices (GeometryInfo<dim>::n_children(refinement_case),
+                FullMatrix<double> (this->dofs_per_cell, this->dofs_per_cell));
+      if (refinement_case == RefinementCase<dim>::isotropic_refinement)
+        {
 #ifdef DEBUG_NEDELEC
-      deallog << "Restriction" << std::endl;
+          deallog << "Restriction" << std::endl;
 #endif
-      this_nonconst.initialize_restriction ();
+          initialize_restriction (matrices);
+        }
+
+      // need to get a non-const version of data in order to be able to
+      // modify them inside a const function
+      FE_Nedelec<dim> &this_nonconst = const_cast<FE_Nedelec<dim>& >(*this);
+      this_nonconst.restriction[refinement_case-1].swap (matrices);
     }
 
   // we use refinement_case-1 here. the -1 takes care of the origin of the
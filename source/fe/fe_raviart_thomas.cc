@@ -77,15 +77,9 @@ FE_RaviartThomas<dim>::FE_RaviartThomas (const unsigned int deg)
   // will be the correct ones, not
   // the raw shape functions anymore.
 
-  // Reinit the vectors of
-  // restriction and prolongation
-  // matrices to the right sizes.
-  // Restriction only for isotropic
-  // refinement
-  this->reinit_restriction_and_prolongation_matrices(true);
-  // Fill prolongation matrices with embedding operators
-  FETools::compute_embedding_matrices (*this, this->prolongation);
-  initialize_restriction();
+  // do not initialize embedding and restriction here. these matrices are
+  // initialized on demand in get_restriction_matrix and
+  // get_prolongation_matrix
 
   // TODO[TL]: for anisotropic refinement we will probably need a table of submatrices with an array for each refine case
   FullMatrix<double> face_embeddings[GeometryInfo<dim>::max_children_per_face];
@@ -136,6 +130,98 @@ FE_RaviartThomas<dim>::clone() const
 }
 
 
+template <int dim>
+const FullMatrix<double> &
+FE_RaviartThomas<dim>
+::get_prolongation_matrix (const unsigned int child,
+                           const RefinementCase<dim> &refinement_case) const
+{
+  Assert (refinement_case<RefinementCase<dim>::isotropic_refinement+1,
+          ExcIndexRange(refinement_case,0,RefinementCase<dim>::isotropic_refinement+1));
+  Assert (refinement_case!=RefinementCase<dim>::no_refinement,
+          ExcMessage("Prolongation matrices are only available for refined cells!"));
+  Assert (child<GeometryInfo<dim>::n_children(refinement_case),
+          ExcIndexRange(child,0,GeometryInfo<dim>::n_children(refinement_case)));
+
+  // initialization upon first request
+  if (this->prolongation[refinement_case-1][child].n() == 0)
+    {
+      Threads::Mutex::ScopedLock lock(this->mutex);
+
+      // if matrix got updated while waiting for the lock
+      if (this->prolongation[refinement_case-1][child].n() ==
+          this->dofs_per_cell)
+        return this->prolongation[refinement_case-1][child];
+
+      // compute the embedding matrices for the refinement case asked for
+      // only. the ones for other refinement cases are computed if they are
+      // ever requested
+      std::vector<FullMatrix<double> >
+      matrices (GeometryInfo<dim>::n_children(refinement_case),
+                FullMatrix<double> (this->dofs_per_cell, this->dofs_per_cell));
+      FETools::compute_embedding_matrices (*this, matrices, refinement_case);
+
+      // need to get a non-const version of data in order to be able to
+      // modify them inside a const function
+      FE_RaviartThomas<dim> &this_nonconst = const_cast<FE_RaviartThomas<dim>& >(*this);
+      this_nonconst.prolongation[refinement_case-1].swap (matrices);
+    }
+
+  // we use refinement_case-1 here. the -1 takes care of the origin of the
+  // vector, as for RefinementCase<dim>::no_refinement (=0) there is no data
+  // available and so the vector indices are shifted
+  return this->prolongation[refinement_case-1][child];
+}
+
+
+
+template <int dim>
+const FullMatrix<double> &
+FE_RaviartThomas<dim>
+::get_restriction_matrix (const unsigned int child,
+                          const RefinementCase<dim> &refinement_case) const
+{
+  Assert (refinement_case<RefinementCase<dim>::isotropic_refinement+1,
+          ExcIndexRange(refinement_case,0,RefinementCase<dim>::isotropic_refinement+1));
+  Assert (refinement_case!=RefinementCase<dim>::no_refinement,
+          ExcMessage("Restriction matrices are only available for refined cells!"));
+  Assert (child<GeometryInfo<dim>::n_children(RefinementCase<dim>(refinement_case)),
+          ExcIndexRange(child,0,GeometryInfo<dim>::n_children(RefinementCase<dim>(refinement_case))));
+
+  // restriction matrices are only computed for isotropic refinement. let the
+  // base class deal with the other cases
+  if (refinement_case != RefinementCase<dim>::isotropic_refinement)
+    return FiniteElement<dim>::get_restriction_matrix (child, refinement_case);
+
+  // initialization upon first request
+  if (this->restriction[refinement_case-1][child].n() == 0)
+    {
+      Threads::Mutex::ScopedLock lock(this->mutex);
+
+      // if matrix got updated while waiting for the lock...
+      if (this->restriction[refinement_case-1][child].n() ==
+          this->dofs_per_cell)
+        return this->restriction[refinement_case-1][child];
+
+      // compute the matrices in a separate object and only swap them in
+      // once they are complete, since other threads may check the size of
+      // the matrices above without acquiring the lock
+      std::vector<FullMatrix<double> >
+      matrices (GeometryInfo<dim>::n_children(refinement_case),
+                FullMatrix<double> (this->dofs_per_cell, this->dofs_per_cell));
+      initialize_restriction (matrices);
+
+      // need to get a non-const version of data in order to be able to
+      // modify them inside a const function
+      FE_RaviartThomas<dim> &this_nonconst = const_cast<FE_RaviartThomas<dim>& >(*this);
+      this_nonconst.restriction[refinement_case-1].swap (matrices);
+    }
+
+  return this->restriction[refinement_case-1][child];
+}
+
+
+
 //---------------------------------------------------------------------------
 // Auxiliary and internal functions
 //---------------------------------------------------------------------------
@@ -234,13 +320,12 @@ FE_RaviartThomas<dim>::initialize_support_points (const unsigned int deg)
 
 template <>
 void
-FE_RaviartThomas<1>::initialize_restriction()
+FE_RaviartThomas<1>::initialize_restriction(std::vector<FullMatrix<double> > &matrices) const
 {
   // there is only one refinement case in 1d,
-  // which is the isotropic one (first index of
-  // the matrix array has to be 0)
+  // which is the isotropic one
   for (unsigned int i=0; i<GeometryInfo<1>::max_children_per_cell; ++i)
-    this->restriction[0][i].reinit(0,0);
+    matrices[i].reinit(0,0);
 }
 
 
@@ -257,10 +342,8 @@ FE_RaviartThomas<1>::initialize_restriction()
 
 template <int dim>
 void
-FE_RaviartThomas<dim>::initialize_restriction()
+FE_RaviartThomas<dim>::initialize_restriction(std::vector<FullMatrix<double> > &matrices) const
 {
-  const unsigned int iso=RefinementCase<dim>::isotropic_refinement-1;
-
   QGauss<dim-1> q_base (this->degree);
   const unsigned int n_face_points = q_base.size();
   // First, compute interpolation on
@@ -316,8 +399,8 @@ FE_RaviartThomas<dim>::initialize_restriction()
                   // subcell are NOT
                   // transformed, so we
                   // have to do it here.
-                  this->restriction[iso][child](face*this->dofs_per_face+i_face,
-                                                i_child)
+                  matrices[child](face*this->dofs_per_face+i_face,
+                                  i_child)
                   += Utilities::fixed_power<dim-1>(.5) * q_sub.weight(k)
                      * cached_values(i_child, k)
                      * this->shape_value_component(face*this->dofs_per_face+i_face,
@@ -365,8 +448,8 @@ FE_RaviartThomas<dim>::initialize_restriction()
           for (unsigned int d=0; d<dim; ++d)
             for (unsigned int i_weight=0; i_weight<polynomials[d]->n(); ++i_weight)
               {
-                this->restriction[iso][child](start_cell_dofs+i_weight*dim+d,
-                                              i_child)
+                matrices[child](start_cell_dofs+i_weight*dim+d,
+                                i_child)
                 += q_sub.weight(k)
                    * cached_values(i_child, k, d)
                    * polynomials[d]->compute_value(i_weight, q_sub.point(k));
@@ -910,6 +910,24 @@ namespace FETools
 
 
 
+  template <int dim, typename number, int spacedim>
+  void
+  compute_embedding_matrices(const FiniteElement<dim,spacedim> &fe,
+                             std::vector<FullMatrix<number> > &matrices,
+                             const RefinementCase<dim> &refinement_case,
+                             const double threshold)
+  {
+    Assert (refinement_case != RefinementCase<dim>::no_refinement,
+            ExcMessage ("Embedding matrices are only available for refined cells!"));
+    AssertDimension (matrices.size(),
+                     GeometryInfo<dim>::n_children(refinement_case));
+
+    compute_embedding_matrices_for_refinement_case<dim, number, spacedim>
+    (fe, matrices, refinement_case, threshold);
+  }
+
+
+
   template <int dim, typename number, int spacedim>
   void
   compute_face_embedding_matrices(const FiniteElement<dim,spacedim> &fe,
@@ -17,6 +17,8 @@
 #include <deal.II/base/path_search.h>
 #include <deal.II/base/utilities.h>
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/std_cxx11/bind.h>
 
 #include <deal.II/grid/grid_in.h>
 #include <deal.II/grid/tria.h>
@@ -28,12 +30,25 @@
 #include <fstream>
 #include <functional>
 #include <cctype>
+#include <cstring>
+#include <cstdlib>
+#include <limits>
+
+// we use uint32_t and uint64_t below, which are declared here:
+#include <stdint.h>
 
 
 #ifdef DEAL_II_WITH_NETCDF
 #include <netcdfcpp.h>
 #endif
 
+#ifdef DEAL_II_HAVE_MMAP
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -78,6 +93,159 @@ namespace
     // vertices except in 1d
     Assert (dim != 1, ExcInternalError());
   }
+
+
+
+  /**
+   * The contents of a file. Where possible, the file is mapped into memory,
+   * which lets the operating system page in the data as it is needed.
+   * Otherwise, the file is read into a buffer in large blocks.
+   */
+  class FileContents
+  {
+  public:
+    /**
+     * Map or read the file with the given name.
+     */
+    FileContents (const std::string &filename);
+
+    /**
+     * Destructor. Unmap the file if it has been mapped.
+     */
+    ~FileContents ();
+
+    /**
+     * Pointer to the first byte of the file.
+     */
+    const char *begin () const;
+
+    /**
+     * Pointer past the last byte of the file.
+     */
+    const char *end () const;
+
+    /**
+     * Size of the file in bytes.
+     */
+    std::size_t size () const;
+
+  private:
+    /**
+     * The contents of the file, either mapped or pointing into
+     * <tt>buffer</tt>.
+     */
+    const char *data;
+
+    /**
+     * The size of the file in bytes.
+     */
+    std::size_t n_bytes;
+
+    /**
+     * Whether <tt>data</tt> has been obtained through mmap.
+     */
+    bool is_mapped;
+
+    /**
+     * Buffer holding the contents of the file if it could not be mapped.
+     */
+    std::vector<char> buffer;
+
+    /**
+     * Copying is not allowed, since the destructor unmaps the file.
+     */
+    FileContents (const FileContents &);
+    FileContents &operator= (const FileContents &);
+  };
+
+
+
+  FileContents::FileContents (const std::string &filename)
+    :
+    data (0),
+    n_bytes (0),
+    is_mapped (false)
+  {
+#ifdef DEAL_II_HAVE_MMAP
+    const int fd = open (filename.c_str(), O_RDONLY);
+    AssertThrow (fd != -1, ExcIO());
+
+    struct stat file_status;
+    if (fstat (fd, &file_status) != 0)
+      {
+        close (fd);
+        AssertThrow (false, ExcIO());
+      }
+
+    if (file_status.st_size > 0)
+      {
+        void *mapped = mmap (0, file_status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED)
+          {
+            data = static_cast<const char *>(mapped);
+            n_bytes = file_status.st_size;
+            is_mapped = true;
+          }
+      }
+    close (fd);
+
+    if (is_mapped)
+      return;
+#endif
+
+    // read the file in blocks of 64 MB
+    std::ifstream in (filename.c_str(), std::ios::binary);
+    AssertThrow (in, ExcIO());
+
+    const std::size_t block_size = 1 << 26;
+    while (in)
+      {
+        buffer.resize (n_bytes + block_size);
+        in.read (&buffer[n_bytes], block_size);
+        n_bytes += in.gcount();
+      }
+    AssertThrow (!in.bad(), ExcIO());
+
+    buffer.resize (n_bytes);
+    data = (n_bytes > 0 ? &buffer[0] : 0);
+  }
+
+
+
+  FileContents::~FileContents ()
+  {
+#ifdef DEAL_II_HAVE_MMAP
+    if (is_mapped)
+      munmap (const_cast<char *>(data), n_bytes);
+#endif
+  }
+
+
+
+  inline
+  const char *
+  FileContents::begin () const
+  {
+    return data;
+  }
+
+
+
+  inline
+  const char *
+  FileContents::end () const
+  {
+    return data + n_bytes;
+  }
+
+
+
+  inline
+  std::size_t
+  FileContents::size () const
+  {
+    return n_bytes;
+  }
 }
 
 template <int dim, int spacedim>
@@ -1563,6 +1731,910 @@ void GridIn<dim, spacedim>::read_msh (std::istream &in)
 }
 
 
+namespace
+{
+  /**
+   * Functions for the fast input of text based mesh formats. Rather than
+   * reading from a stream token by token, the whole file is made available
+   * in memory and split into lines, which are then parsed independently of
+   * each other and therefore in parallel. Numbers are converted without the
+   * help of locales.
+   */
+  namespace FastTextInput
+  {
+    inline
+    bool is_space (const char c)
+    {
+      return (c == ' ' || c == '\t' || c == '\n' || c == '\r' ||
+              c == '\v' || c == '\f');
+    }
+
+
+
+    inline
+    const char *skip_spaces (const char *p,
+                             const char *end)
+    {
+      while (p != end && is_space(*p))
+        ++p;
+      return p;
+    }
+
+
+
+    /**
+     * Return the next whitespace-separated token and move @p p past it.
+     */
+    std::string next_token (const char *&p,
+                            const char *end)
+    {
+      p = skip_spaces (p, end);
+      const char *token_begin = p;
+      while (p != end && !is_space(*p))
+        ++p;
+      return std::string (token_begin, p);
+    }
+
+
+
+    /**
+     * Skip lines that start with the character @p comment_start, as well as
+     * empty lines.
+     */
+    const char *skip_comment_lines (const char *p,
+                                    const char *end,
+                                    const char  comment_start)
+    {
+      p = skip_spaces (p, end);
+      while (p != end && *p == comment_start)
+        {
+          const char *line_end = static_cast<const char *>(std::memchr (p, '\n', end-p));
+          p = skip_spaces ((line_end != 0 ? line_end : end), end);
+        }
+      return p;
+    }
+
+
+
+    /**
+     * Read a (possibly signed) integer starting at @p p and move @p p past
+     * it. Return false if there is no integer, or if it is not followed by
+     * whitespace.
+     */
+    inline
+    bool parse_integer (const char *&p,
+                        const char *end,
+                        long int   &value)
+    {
+      p = skip_spaces (p, end);
+      bool negative = false;
+      if (p != end && (*p == '-' || *p == '+'))
+        {
+          negative = (*p == '-');
+          ++p;
+        }
+
+      if (p == end || *p < '0' || *p > '9')
+        return false;
+
+      unsigned long int v = 0;
+      for (; p != end && *p >= '0' && *p <= '9'; ++p)
+        {
+          v = 10*v + (*p - '0');
+          if (v > static_cast<unsigned long int>(std::numeric_limits<int>::max()))
+            return false;
+        }
+      value = (negative ? -static_cast<long int>(v) : static_cast<long int>(v));
+
+      return (p == end || is_space(*p));
+    }
+
+
+
+    /**
+     * Read a floating point number starting at @p p and move @p p past it.
+     * Return false if there is no number, or if it is not followed by
+     * whitespace.
+     *
+     * Numbers whose decimal significand has at most 19 digits and fits into
+     * the 53 bits of a double, and whose decimal exponent is at most 22 in
+     * absolute value, are converted by a single floating point
+     * multiplication or division of two exactly representable numbers,
+     * which yields the correctly rounded result. All other numbers are
+     * handed to std::strtod(). The result is therefore the same as the one
+     * of reading the number from a stream.
+     */
+    bool parse_double (const char *&p,
+                       const char *end,
+                       double     &value)
+    {
+      static const double powers_of_ten[] =
+      {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+      };
+
+      p = skip_spaces (p, end);
+      const char *token_begin = p;
+
+      bool negative = false;
+      if (p != end && (*p == '-' || *p == '+'))
+        {
+          negative = (*p == '-');
+          ++p;
+        }
+
+      uint64_t significand = 0;
+      unsigned int n_significant_digits = 0;
+      unsigned int n_digits = 0;
+      int exponent = 0;
+      bool is_exact = true;
+      for (; p != end && *p >= '0' && *p <= '9'; ++p, ++n_digits)
+        {
+          if (n_significant_digits < 19)
+            {
+              significand = 10*significand + (*p - '0');
+              if (significand != 0)
+                ++n_significant_digits;
+            }
+          else
+            {
+              ++exponent;
+              is_exact = false;
+            }
+        }
+
+      if (p != end && *p == '.')
+        {
+          for (++p; p != end && *p >= '0' && *p <= '9'; ++p, ++n_digits)
+            {
+              if (n_significant_digits < 19)
+                {
+                  significand = 10*significand + (*p - '0');
+                  if (significand != 0)
+                    ++n_significant_digits;
+                  --exponent;
+                }
+              else
+                is_exact = false;
+            }
+        }
+
+      if (n_digits == 0)
+        return false;
+
+      if (p != end && (*p == 'e' || *p == 'E'))
+        {
+          ++p;
+          bool negative_exponent = false;
+          if (p != end && (*p == '-' || *p == '+'))
+            {
+              negative_exponent = (*p == '-');
+              ++p;
+            }
+          if (p == end || *p < '0' || *p > '9')
+            return false;
+          int e = 0;
+          for (; p != end && *p >= '0' && *p <= '9'; ++p)
+            if (e < 10000)
+              e = 10*e + (*p - '0');
+          exponent += (negative_exponent ? -e : e);
+        }
+
+      if (p != end && !is_space(*p))
+        return false;
+
+      if (is_exact &&
+          significand <= (static_cast<uint64_t>(1) << 53) &&
+          exponent >= -22 && exponent <= 22)
+        {
+          value = (exponent < 0 ?
+                   static_cast<double>(significand) / powers_of_ten[-exponent] :
+                   static_cast<double>(significand) * powers_of_ten[exponent]);
+          if (negative)
+            value = -value;
+          return true;
+        }
+
+      // slow path: let the C library do the conversion. the data is not
+      // necessarily null-terminated, so copy the token first
+      const std::string token (token_begin, p);
+      char *token_end;
+      value = std::strtod (token.c_str(), &token_end);
+      return (token_end == token.c_str() + token.size());
+    }
+
+
+
+    /**
+     * Find the next @p n_lines non-empty lines, starting with the line after
+     * the one @p p points into, and store pointers to their beginning and
+     * end in @p lines. @p p is moved to the end of the last of these lines,
+     * so that a subsequent call starts with the line after it. Return false
+     * if the data ends before that many lines were found.
+     */
+    bool find_lines (const char                                           *&p,
+                     const char                                            *end,
+                     const std::size_t                                      n_lines,
+                     std::vector<std::pair<const char *, const char *> >   &lines)
+    {
+      lines.resize (n_lines);
+      if (n_lines == 0)
+        return true;
+
+      const char *line_end = static_cast<const char *>(std::memchr (p, '\n', end-p));
+      p = (line_end != 0 ? line_end+1 : end);
+
+      for (std::size_t l=0; l<n_lines; )
+        {
+          if (p == end)
+            return false;
+
+          line_end = static_cast<const char *>(std::memchr (p, '\n', end-p));
+          if (line_end == 0)
+            line_end = end;
+
+          if (skip_spaces (p, line_end) != line_end)
+            {
+              lines[l].first = p;
+              lines[l].second = line_end;
+              ++l;
+            }
+          p = (line_end != end ? line_end+1 : end);
+        }
+      p = lines[n_lines-1].second;
+      return true;
+    }
+
+
+
+    /**
+     * Read the vertices on lines [begin,end), each of which consists of
+     * the number of the vertex followed by three coordinates. If a line
+     * cannot be parsed, the corresponding entry of @p line_is_valid is set
+     * to zero.
+     */
+    template <int spacedim>
+    void parse_vertex_lines (const std::vector<std::pair<const char *, const char *> > &lines,
+                             std::vector<int>                                         &vertex_numbers,
+                             std::vector<Point<spacedim> >                            &vertices,
+                             std::vector<unsigned char>                               &line_is_valid,
+                             const unsigned int                                        begin,
+                             const unsigned int                                        end)
+    {
+      for (unsigned int l=begin; l<end; ++l)
+        {
+          const char *p = lines[l].first;
+          const char *line_end = lines[l].second;
+
+          long int vertex_number;
+          double x[3];
+          line_is_valid[l] = (parse_integer (p, line_end, vertex_number) &&
+                              parse_double (p, line_end, x[0]) &&
+                              parse_double (p, line_end, x[1]) &&
+                              parse_double (p, line_end, x[2]));
+          if (line_is_valid[l])
+            {
+              vertex_numbers[l] = vertex_number;
+              for (unsigned int d=0; d<spacedim; ++d)
+                vertices[l](d) = x[d];
+            }
+        }
+    }
+
+
+
+    /**
+     * The data of one element (i.e., a cell, a face, or a point) of a mesh
+     * file. The element type is given in the numbering used by Gmsh.
+     */
+    struct ElementData
+    {
+      int          type;
+      unsigned int tag;
+      unsigned int n_declared_vertices;
+      unsigned int n_vertices;
+      int          vertices[8];
+    };
+
+
+
+    /**
+     * Read the vertex numbers at the end of an element line into @p
+     * element.
+     */
+    inline
+    bool parse_element_vertices (const char  *p,
+                                 const char  *line_end,
+                                 ElementData &element)
+    {
+      element.n_vertices = 0;
+      long int vertex;
+      while (skip_spaces (p, line_end) != line_end)
+        {
+          if (!parse_integer (p, line_end, vertex))
+            return false;
+          if (element.n_vertices < 8)
+            element.vertices[element.n_vertices] = vertex;
+          ++element.n_vertices;
+        }
+      return true;
+    }
+
+
+
+    /**
+     * Read the elements on lines [begin,end) of a file in Gmsh format
+     * version @p gmsh_file_format.
+     */
+    void parse_msh_element_lines (const std::vector<std::pair<const char *, const char *> > &lines,
+                                  const unsigned int                                        gmsh_file_format,
+                                  std::vector<ElementData>                                 &elements,
+                                  std::vector<unsigned char>                               &line_is_valid,
+                                  const unsigned int                                        begin,
+                                  const unsigned int                                        end)
+    {
+      for (unsigned int l=begin; l<end; ++l)
+        {
+          const char *p = lines[l].first;
+          const char *line_end = lines[l].second;
+          ElementData &element = elements[l];
+
+          long int number, type, tag = 0, dummy, n_entries;
+          bool valid = (parse_integer (p, line_end, number) &&
+                        parse_integer (p, line_end, type));
+          element.type = type;
+
+          if (gmsh_file_format == 1)
+            {
+              // REG-PHYS REG-ELM NUMBER-OF-NODES
+              valid = valid && (parse_integer (p, line_end, tag) &&
+                                parse_integer (p, line_end, dummy) &&
+                                parse_integer (p, line_end, n_entries));
+              element.n_declared_vertices = n_entries;
+            }
+          else
+            {
+              // NUMBER-OF-TAGS TAG...; the first tag is the material or
+              // boundary id
+              valid = valid && parse_integer (p, line_end, n_entries);
+              for (long int t=0; valid && t<n_entries; ++t)
+                valid = parse_integer (p, line_end, (t == 0 ? tag : dummy));
+              element.n_declared_vertices = numbers::invalid_unsigned_int;
+            }
+          element.tag = tag;
+
+          line_is_valid[l] = (valid && tag >= 0 &&
+                              parse_element_vertices (p, line_end, element));
+        }
+    }
+
+
+
+    /**
+     * Translate the name of a cell type in UCD format to the element type
+     * numbering used by Gmsh. Return -1 for unknown names.
+     */
+    inline
+    int ucd_element_type (const char *p,
+                          const char *token_end)
+    {
+      const std::size_t length = token_end - p;
+      if (length == 4 && std::strncmp (p, "line", 4) == 0)
+        return 1;
+      if (length == 4 && std::strncmp (p, "quad", 4) == 0)
+        return 3;
+      if (length == 3 && std::strncmp (p, "hex", 3) == 0)
+        return 5;
+      return -1;
+    }
+
+
+
+    /**
+     * Read the elements on lines [begin,end) of a file in UCD format.
+     */
+    void parse_ucd_element_lines (const std::vector<std::pair<const char *, const char *> > &lines,
+                                  std::vector<ElementData>                                 &elements,
+                                  std::vector<unsigned char>                               &line_is_valid,
+                                  const unsigned int                                        begin,
+                                  const unsigned int                                        end)
+    {
+      for (unsigned int l=begin; l<end; ++l)
+        {
+          const char *p = lines[l].first;
+          const char *line_end = lines[l].second;
+          ElementData &element = elements[l];
+
+          long int number, material_id;
+          bool valid = (parse_integer (p, line_end, number) &&
+                        parse_integer (p, line_end, material_id) &&
+                        material_id >= 0);
+          element.tag = material_id;
+          element.n_declared_vertices = numbers::invalid_unsigned_int;
+
+          p = skip_spaces (p, line_end);
+          const char *type_begin = p;
+          while (p != line_end && !is_space(*p))
+            ++p;
+          element.type = ucd_element_type (type_begin, p);
+
+          line_is_valid[l] = (valid && parse_element_vertices (p, line_end, element));
+        }
+    }
+
+
+
+    /**
+     * A map from the vertex numbers used in a file to the indices of the
+     * vertices in the order in which they were read. If the numbers are
+     * reasonably dense, which is the case for all common mesh generators, a
+     * vector is used for the lookup and a std::map otherwise.
+     */
+    class VertexNumbering
+    {
+    public:
+      VertexNumbering (const std::vector<int> &vertex_numbers);
+
+      /**
+       * Return the index of the vertex with the given number, or
+       * numbers::invalid_unsigned_int if there is no such vertex.
+       */
+      unsigned int index (const int vertex_number) const;
+
+    private:
+      /**
+       * Return the difference between the given vertex number, which must
+       * not be smaller than #min_number, and #min_number. The difference is
+       * computed in unsigned arithmetic since it may not be representable
+       * as an int.
+       */
+      unsigned int offset (const int vertex_number) const;
+
+      int                         min_number;
+      std::vector<unsigned int>   dense_indices;
+      std::map<int,unsigned int>  sparse_indices;
+    };
+
+
+
+    inline
+    unsigned int
+    VertexNumbering::offset (const int vertex_number) const
+    {
+      return (static_cast<unsigned int>(vertex_number) -
+              static_cast<unsigned int>(min_number));
+    }
+
+
+
+    VertexNumbering::VertexNumbering (const std::vector<int> &vertex_numbers)
+      :
+      min_number (0)
+    {
+      if (vertex_numbers.size() == 0)
+        return;
+
+      min_number = *std::min_element (vertex_numbers.begin(), vertex_numbers.end());
+      const int max_number = *std::max_element (vertex_numbers.begin(), vertex_numbers.end());
+
+      // as in the other readers, a later vertex with the same number
+      // overwrites an earlier one
+      if (offset (max_number) < 4*vertex_numbers.size() + 1024)
+        {
+          dense_indices.resize (static_cast<std::size_t>(offset (max_number)) + 1,
+                                numbers::invalid_unsigned_int);
+          for (unsigned int v=0; v<vertex_numbers.size(); ++v)
+            dense_indices[offset (vertex_numbers[v])] = v;
+        }
+      else
+        for (unsigned int v=0; v<vertex_numbers.size(); ++v)
+          sparse_indices[vertex_numbers[v]] = v;
+    }
+
+
+
+    inline
+    unsigned int
+    VertexNumbering::index (const int vertex_number) const
+    {
+      if (dense_indices.size() > 0)
+        return ((vertex_number >= min_number &&
+                 offset (vertex_number) < dense_indices.size()) ?
+                dense_indices[offset (vertex_number)] :
+                numbers::invalid_unsigned_int);
+
+      const std::map<int,unsigned int>::const_iterator p = sparse_indices.find (vertex_number);
+      return (p != sparse_indices.end() ? p->second : numbers::invalid_unsigned_int);
+    }
+
+
+
+    /**
+     * Translate the vertex numbers of an element to vertex indices and store
+     * them in @p object, together with the given id.
+     */
+    template <int structdim>
+    void translate_element (const ElementData     &element,
+                            const unsigned int     element_index,
+                            const VertexNumbering &vertex_numbering,
+                            CellData<structdim>   &object)
+    {
+      AssertThrow (element.n_vertices == GeometryInfo<structdim>::vertices_per_cell,
+                   ExcMessage ("Number of nodes does not coincide with the "
+                               "number required for this object"));
+      for (unsigned int v=0; v<GeometryInfo<structdim>::vertices_per_cell; ++v)
+        {
+          object.vertices[v] = vertex_numbering.index (element.vertices[v]);
+          AssertThrow (object.vertices[v] != numbers::invalid_unsigned_int,
+                       typename GridIn<structdim>::ExcInvalidVertexIndex (element_index,
+                           element.vertices[v]));
+        }
+    }
+
+
+
+    /**
+     * Sort the elements read from a file into cells, boundary lines and
+     * quads, and (in 1d) boundary indicators of vertices. The element types
+     * must have been checked to be valid for the given dimension before.
+     */
+    template <int dim>
+    void create_cell_data (const std::vector<ElementData>             &elements,
+                           const VertexNumbering                      &vertex_numbering,
+                           std::vector<CellData<dim> >                &cells,
+                           SubCellData                                &subcelldata,
+                           std::map<unsigned int, types::boundary_id> &boundary_ids_1d)
+    {
+      unsigned int n_cells = 0, n_lines = 0, n_quads = 0;
+      for (unsigned int e=0; e<elements.size(); ++e)
+        if (elements[e].type == (dim == 1 ? 1 : (dim == 2 ? 3 : 5)))
+          ++n_cells;
+        else if (elements[e].type == 1)
+          ++n_lines;
+        else if (elements[e].type == 3)
+          ++n_quads;
+      cells.reserve (n_cells);
+      subcelldata.boundary_lines.reserve (n_lines);
+      subcelldata.boundary_quads.reserve (n_quads);
+
+      for (unsigned int e=0; e<elements.size(); ++e)
+        {
+          const ElementData &element = elements[e];
+          if (element.type == (dim == 1 ? 1 : (dim == 2 ? 3 : 5)))
+            {
+              AssertThrow (element.n_declared_vertices == numbers::invalid_unsigned_int ||
+                           element.n_declared_vertices == GeometryInfo<dim>::vertices_per_cell,
+                           ExcMessage ("Number of nodes does not coincide with the "
+                                       "number required for this object"));
+
+              // we use only material_ids in the range from 0 to
+              // numbers::invalid_material_id-1
+              Assert(element.tag < numbers::invalid_material_id,
+                     ExcIndexRange(element.tag,0,numbers::invalid_material_id));
+
+              cells.push_back (CellData<dim>());
+              translate_element (element, e, vertex_numbering, cells.back());
+              cells.back().material_id = static_cast<types::material_id>(element.tag);
+            }
+          else if (element.type == 1)
+            {
+              // we use only boundary_ids in the range from 0 to
+              // numbers::internal_face_boundary_id-1
+              Assert(element.tag < numbers::internal_face_boundary_id,
+                     ExcIndexRange(element.tag,0,numbers::internal_face_boundary_id));
+
+              subcelldata.boundary_lines.push_back (CellData<1>());
+              translate_element (element, e, vertex_numbering,
+                                 subcelldata.boundary_lines.back());
+              subcelldata.boundary_lines.back().boundary_id
+                = static_cast<types::boundary_id>(element.tag);
+            }
+          else if (element.type == 3)
+            {
+              Assert(element.tag < numbers::internal_face_boundary_id,
+                     ExcIndexRange(element.tag,0,numbers::internal_face_boundary_id));
+
+              subcelldata.boundary_quads.push_back (CellData<2>());
+              translate_element (element, e, vertex_numbering,
+                                 subcelldata.boundary_quads.back());
+              subcelldata.boundary_quads.back().boundary_id
+                = static_cast<types::boundary_id>(element.tag);
+            }
+          else if (element.type == 15)
+            {
+              // we only care about boundary indicators assigned to
+              // individual vertices in 1d (because otherwise the vertices
+              // are not faces). in format version 1, several nodes may be
+              // given, of which we use the last one like read_msh() does
+              AssertThrow (element.n_vertices > 0, ExcIO());
+              if (dim == 1)
+                {
+                  const unsigned int vertex
+                    = vertex_numbering.index (element.vertices[std::min (element.n_vertices, 8U) - 1]);
+                  AssertThrow (vertex != numbers::invalid_unsigned_int,
+                               typename GridIn<dim>::ExcInvalidVertexIndex (e, element.vertices[0]));
+                  boundary_ids_1d[vertex] = element.tag;
+                }
+            }
+          else
+            Assert (false, ExcInternalError());
+        }
+    }
+  }
+}
+
+
+
+template <int dim, int spacedim>
+void GridIn<dim, spacedim>::read_msh (const std::string &filename)
+{
+  using namespace FastTextInput;
+
+  Assert (tria != 0, ExcNoTriangulationSelected());
+
+  const FileContents contents (filename);
+  const char *p = contents.begin();
+  const char *const end = contents.end();
+
+  std::string line = next_token (p, end);
+
+  // first determine file format
+  unsigned int gmsh_file_format = 0;
+  if (line == "$NOD")
+    gmsh_file_format = 1;
+  else if (line == "$MeshFormat")
+    gmsh_file_format = 2;
+  else
+    AssertThrow (false, ExcInvalidGMSHInput(line));
+
+  // if file format is 2 or greater then we also have to read the rest of
+  // the header
+  if (gmsh_file_format == 2)
+    {
+      double version;
+      long int file_type, data_size;
+      AssertThrow (parse_double (p, end, version) &&
+                   parse_integer (p, end, file_type) &&
+                   parse_integer (p, end, data_size),
+                   ExcIO());
+
+      Assert ( (version >= 2.0) &&
+               (version <= 2.2), ExcNotImplemented());
+      Assert (file_type == 0, ExcNotImplemented());
+      Assert (data_size == sizeof(double), ExcNotImplemented());
+
+      line = next_token (p, end);
+      AssertThrow (line == "$EndMeshFormat",
+                   ExcInvalidGMSHInput(line));
+
+      // if the next block is of kind $PhysicalNames, ignore it
+      line = next_token (p, end);
+      if (line == "$PhysicalNames")
+        {
+          do
+            {
+              line = next_token (p, end);
+              AssertThrow (line != "", ExcInvalidGMSHInput(line));
+            }
+          while (line != "$EndPhysicalNames");
+          line = next_token (p, end);
+        }
+
+      // but the next thing should, in any case, be the list of nodes
+      AssertThrow (line == "$Nodes",
+                   ExcInvalidGMSHInput(line));
+    }
+
+  // now read the nodes list. we first find the lines of the nodes section
+  // and then parse them in parallel
+  long int n_vertices;
+  AssertThrow (parse_integer (p, end, n_vertices) && n_vertices >= 0, ExcIO());
+
+  std::vector<std::pair<const char *, const char *> > lines;
+  AssertThrow (find_lines (p, end, n_vertices, lines), ExcUnsupportedLineLayout());
+
+  std::vector<Point<spacedim> > vertices (n_vertices);
+  std::vector<int>              vertex_numbers (n_vertices);
+  std::vector<unsigned char>    line_is_valid (n_vertices);
+  parallel::apply_to_subranges (0U, static_cast<unsigned int>(n_vertices),
+                                std_cxx11::bind (&parse_vertex_lines<spacedim>,
+                                                 std_cxx11::cref(lines),
+                                                 std_cxx11::ref(vertex_numbers),
+                                                 std_cxx11::ref(vertices),
+                                                 std_cxx11::ref(line_is_valid),
+                                                 std_cxx11::_1, std_cxx11::_2),
+                                1000);
+  AssertThrow (std::find (line_is_valid.begin(), line_is_valid.end(), 0) ==
+               line_is_valid.end(),
+               ExcUnsupportedLineLayout());
+
+  // set up mapping between numbering in msh-file and in the vertices vector
+  const VertexNumbering vertex_numbering (vertex_numbers);
+
+  // Assert we reached the end of the block
+  line = next_token (p, end);
+  static const std::string end_nodes_marker[] = {"$ENDNOD", "$EndNodes" };
+  AssertThrow (line==end_nodes_marker[gmsh_file_format-1],
+               ExcInvalidGMSHInput(line));
+
+  // Now read in next bit
+  line = next_token (p, end);
+  static const std::string begin_elements_marker[] = {"$ELM", "$Elements" };
+  AssertThrow (line==begin_elements_marker[gmsh_file_format-1],
+               ExcInvalidGMSHInput(line));
+
+  long int n_elements;
+  AssertThrow (parse_integer (p, end, n_elements) && n_elements >= 0, ExcIO());
+  AssertThrow (find_lines (p, end, n_elements, lines), ExcUnsupportedLineLayout());
+
+  std::vector<ElementData> elements (n_elements);
+  line_is_valid.resize (n_elements);
+  parallel::apply_to_subranges (0U, static_cast<unsigned int>(n_elements),
+                                std_cxx11::bind (&parse_msh_element_lines,
+                                                 std_cxx11::cref(lines),
+                                                 gmsh_file_format,
+                                                 std_cxx11::ref(elements),
+                                                 std_cxx11::ref(line_is_valid),
+                                                 std_cxx11::_1, std_cxx11::_2),
+                                1000);
+
+  for (unsigned int e=0; e<elements.size(); ++e)
+    {
+      AssertThrow (line_is_valid[e], ExcUnsupportedLineLayout());
+
+      const int cell_type = elements[e].type;
+      if (!((cell_type == 1) ||
+            ((cell_type == 3) && (dim >= 2)) ||
+            ((cell_type == 5) && (dim == 3)) ||
+            (cell_type == 15)))
+        {
+          // cannot read this, so throw an exception. treat triangles and
+          // tetrahedra specially since this deserves a more explicit error
+          // message
+          AssertThrow (cell_type != 2,
+                       ExcMessage("Found triangles while reading a file "
+                                  "in gmsh format. deal.II does not "
+                                  "support triangles"));
+          AssertThrow (cell_type != 11,
+                       ExcMessage("Found tetrahedra while reading a file "
+                                  "in gmsh format. deal.II does not "
+                                  "support tetrahedra"));
+
+          AssertThrow (false, ExcGmshUnsupportedGeometry(cell_type));
+        }
+    }
+
+  // Assert we reached the end of the block
+  line = next_token (p, end);
+  static const std::string end_elements_marker[] = {"$ENDELM", "$EndElements" };
+  AssertThrow (line==end_elements_marker[gmsh_file_format-1],
+               ExcInvalidGMSHInput(line));
+
+  // set up array of cells and subcells (faces). In 1d, boundary indicators
+  // are attached to individual vertices via the boundary_ids_1d array
+  std::vector<CellData<dim> >                cells;
+  SubCellData                                subcelldata;
+  std::map<unsigned int, types::boundary_id> boundary_ids_1d;
+  create_cell_data (elements, vertex_numbering, cells, subcelldata, boundary_ids_1d);
+
+  // check that no forbidden arrays are used
+  Assert (subcelldata.check_consistency(dim), ExcInternalError());
+
+  // check that we actually read some cells.
+  AssertThrow(cells.size() > 0, ExcGmshNoCellInformation());
+
+  // do some clean-up on vertices...
+  GridTools::delete_unused_vertices (vertices, cells, subcelldata);
+  // ... and cells
+  if (dim==spacedim)
+    GridReordering<dim,spacedim>::invert_all_cells_of_negative_grid (vertices, cells);
+  GridReordering<dim,spacedim>::reorder_cells (cells);
+  tria->create_triangulation_compatibility (vertices, cells, subcelldata);
+
+  // in 1d, we also have to attach boundary ids to vertices, which does not
+  // currently work through the call above
+  if (dim == 1)
+    assign_1d_boundary_ids (boundary_ids_1d, *tria);
+}
+
+
+
+template <int dim, int spacedim>
+void GridIn<dim, spacedim>::read_ucd (const std::string &filename)
+{
+  using namespace FastTextInput;
+
+  Assert (tria != 0, ExcNoTriangulationSelected());
+
+  const FileContents contents (filename);
+  const char *p = contents.begin();
+  const char *const end = contents.end();
+
+  // skip comments at start of file
+  p = FastTextInput::skip_comment_lines (p, end, '#');
+
+  long int n_vertices, n_cells, dummy;
+  AssertThrow (parse_integer (p, end, n_vertices) &&
+               parse_integer (p, end, n_cells) &&
+               parse_integer (p, end, dummy) &&   // number of data vectors
+               parse_integer (p, end, dummy) &&   // cell data
+               parse_integer (p, end, dummy) &&   // model data
+               n_vertices >= 0 && n_cells >= 0,
+               ExcIO());
+
+  // find the lines with the vertices and parse them in parallel
+  std::vector<std::pair<const char *, const char *> > lines;
+  AssertThrow (find_lines (p, end, n_vertices, lines), ExcUnsupportedLineLayout());
+
+  std::vector<Point<spacedim> > vertices (n_vertices);
+  std::vector<int>              vertex_numbers (n_vertices);
+  std::vector<unsigned char>    line_is_valid (n_vertices);
+  parallel::apply_to_subranges (0U, static_cast<unsigned int>(n_vertices),
+                                std_cxx11::bind (&parse_vertex_lines<spacedim>,
+                                                 std_cxx11::cref(lines),
+                                                 std_cxx11::ref(vertex_numbers),
+                                                 std_cxx11::ref(vertices),
+                                                 std_cxx11::ref(line_is_valid),
+                                                 std_cxx11::_1, std_cxx11::_2),
+                                1000);
+  AssertThrow (std::find (line_is_valid.begin(), line_is_valid.end(), 0) ==
+               line_is_valid.end(),
+               ExcUnsupportedLineLayout());
+
+  // set up mapping between numbering in ucd-file and in the vertices vector
+  const VertexNumbering vertex_numbering (vertex_numbers);
+
+  // then do the same for the cells
+  AssertThrow (find_lines (p, end, n_cells, lines), ExcUnsupportedLineLayout());
+
+  std::vector<ElementData> elements (n_cells);
+  line_is_valid.resize (n_cells);
+  parallel::apply_to_subranges (0U, static_cast<unsigned int>(n_cells),
+                                std_cxx11::bind (&parse_ucd_element_lines,
+                                                 std_cxx11::cref(lines),
+                                                 std_cxx11::ref(elements),
+                                                 std_cxx11::ref(line_is_valid),
+                                                 std_cxx11::_1, std_cxx11::_2),
+                                1000);
+
+  for (unsigned int e=0; e<elements.size(); ++e)
+    {
+      AssertThrow (line_is_valid[e], ExcUnsupportedLineLayout());
+
+      const int cell_type = elements[e].type;
+      if (!((cell_type == 1) ||
+            ((cell_type == 3) && (dim >= 2)) ||
+            ((cell_type == 5) && (dim == 3))))
+        {
+          // cannot read this. extract the name of the cell type again for
+          // the error message
+          const char *q = lines[e].first;
+          next_token (q, lines[e].second);
+          next_token (q, lines[e].second);
+          AssertThrow (false, ExcUnknownIdentifier(next_token (q, lines[e].second)));
+        }
+    }
+
+  std::vector<CellData<dim> >                cells;
+  SubCellData                                subcelldata;
+  std::map<unsigned int, types::boundary_id> boundary_ids_1d;
+  create_cell_data (elements, vertex_numbering, cells, subcelldata, boundary_ids_1d);
+
+  // check that no forbidden arrays are used
+  Assert (subcelldata.check_consistency(dim), ExcInternalError());
+
+  // do some clean-up on vertices...
+  GridTools::delete_unused_vertices (vertices, cells, subcelldata);
+  // ... and cells
+  if (dim==spacedim)
+    GridReordering<dim,spacedim>::invert_all_cells_of_negative_grid (vertices, cells);
+  GridReordering<dim,spacedim>::reorder_cells (cells);
+  tria->create_triangulation_compatibility (vertices, cells, subcelldata);
+}
+
+
+
 template <>
 void GridIn<1>::read_netcdf (const std::string &)
 {
@@ -2712,6 +3784,293 @@ GridIn<3>::debug_output_grid (const std::vector<CellData<3> > &cells,
 
 
 
+namespace
+{
+  /**
+   * Fill @p destination with objects of type @p T from the binary data at
+   * position @p offset and advance @p offset. We copy rather than cast since
+   * the data need not be aligned.
+   */
+  template <typename T>
+  void read_binary_array (const char        *data,
+                          const std::size_t  size,
+                          std::size_t       &offset,
+                          std::vector<T>    &destination)
+  {
+    const std::size_t n_bytes = destination.size() * sizeof(T);
+    AssertThrow (offset + n_bytes <= size,
+                 ExcMessage ("The binary mesh data ends prematurely."));
+    if (destination.empty() == false)
+      std::memcpy (&destination[0], data + offset, n_bytes);
+    offset += n_bytes;
+  }
+
+
+
+  /**
+   * Read @p n_objects objects of dimension @p structdim, given by their
+   * vertex indices, boundary ids and manifold ids, from the binary data and
+   * append them to @p objects.
+   */
+  template <int structdim>
+  void read_binary_subcell_data (const char                     *data,
+                                 const std::size_t               size,
+                                 std::size_t                    &offset,
+                                 const std::size_t               n_objects,
+                                 std::vector<CellData<structdim> > &objects)
+  {
+    const unsigned int vertices_per_object = GeometryInfo<structdim>::vertices_per_cell;
+    std::vector<uint32_t> vertices (n_objects * vertices_per_object);
+    std::vector<uint32_t> boundary_ids (n_objects), manifold_ids (n_objects);
+    read_binary_array (data, size, offset, vertices);
+    read_binary_array (data, size, offset, boundary_ids);
+    read_binary_array (data, size, offset, manifold_ids);
+
+    objects.resize (n_objects);
+    for (unsigned int i=0; i<n_objects; ++i)
+      {
+        for (unsigned int v=0; v<vertices_per_object; ++v)
+          objects[i].vertices[v] = vertices[i*vertices_per_object+v];
+        objects[i].boundary_id = static_cast<types::boundary_id>(boundary_ids[i]);
+        objects[i].manifold_id = manifold_ids[i];
+      }
+  }
+
+
+
+  /**
+   * Move the objects of @p objects that are not at the boundary, i.e., the
+   * ones with boundary id numbers::internal_face_boundary_id, to the end of
+   * @p interior_objects.
+   */
+  template <int structdim>
+  void split_interior_objects (std::vector<CellData<structdim> > &objects,
+                               std::vector<CellData<structdim> > &interior_objects)
+  {
+    unsigned int n_boundary_objects = 0;
+    for (unsigned int i=0; i<objects.size(); ++i)
+      if (objects[i].boundary_id == numbers::internal_face_boundary_id)
+        interior_objects.push_back (objects[i]);
+      else
+        objects[n_boundary_objects++] = objects[i];
+    objects.resize (n_boundary_objects);
+  }
+
+
+
+  /**
+   * Return a map from the sorted vertex indices of the given objects to
+   * their manifold ids.
+   */
+  template <int structdim>
+  std::map<std::vector<unsigned int>, types::manifold_id>
+  make_manifold_id_map (const std::vector<CellData<structdim> > &objects)
+  {
+    std::map<std::vector<unsigned int>, types::manifold_id> manifold_ids;
+    std::vector<unsigned int> vertices (GeometryInfo<structdim>::vertices_per_cell);
+    for (unsigned int i=0; i<objects.size(); ++i)
+      {
+        for (unsigned int v=0; v<vertices.size(); ++v)
+          vertices[v] = objects[i].vertices[v];
+        std::sort (vertices.begin(), vertices.end());
+        manifold_ids[vertices] = objects[i].manifold_id;
+      }
+    return manifold_ids;
+  }
+
+
+
+  /**
+   * Set the manifold id of @p object if its vertices are listed in
+   * @p manifold_ids.
+   */
+  template <typename Iterator>
+  void set_listed_manifold_id (const Iterator                                                &object,
+                               const std::map<std::vector<unsigned int>, types::manifold_id> &manifold_ids)
+  {
+    if (manifold_ids.size() == 0)
+      return;
+
+    std::vector<unsigned int> vertices (GeometryInfo<Iterator::AccessorType::structure_dimension>::vertices_per_cell);
+    for (unsigned int v=0; v<vertices.size(); ++v)
+      vertices[v] = object->vertex_index(v);
+    std::sort (vertices.begin(), vertices.end());
+    const std::map<std::vector<unsigned int>, types::manifold_id>::const_iterator
+    p = manifold_ids.find (vertices);
+    if (p != manifold_ids.end())
+      object->set_manifold_id (p->second);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void set_interior_manifold_ids (const SubCellData &,
+                                  Triangulation<dim,spacedim> &)
+  {}
+
+
+
+  template <int spacedim>
+  void set_interior_manifold_ids (const SubCellData          &interior_objects,
+                                  Triangulation<3,spacedim> &tria)
+  {
+    if (interior_objects.boundary_lines.size() == 0 &&
+        interior_objects.boundary_quads.size() == 0)
+      return;
+
+    const std::map<std::vector<unsigned int>, types::manifold_id>
+    line_manifold_ids = make_manifold_id_map (interior_objects.boundary_lines),
+    quad_manifold_ids = make_manifold_id_map (interior_objects.boundary_quads);
+    for (typename Triangulation<3,spacedim>::cell_iterator
+         cell = tria.begin(); cell != tria.end(); ++cell)
+      {
+        for (unsigned int l=0; l<GeometryInfo<3>::lines_per_cell; ++l)
+          set_listed_manifold_id (cell->line(l), line_manifold_ids);
+        for (unsigned int q=0; q<GeometryInfo<3>::quads_per_cell; ++q)
+          set_listed_manifold_id (cell->quad(q), quad_manifold_ids);
+      }
+  }
+}
+
+
+
+template <int dim, int spacedim>
+void GridIn<dim, spacedim>::read_binary (std::istream &in)
+{
+  AssertThrow (in, ExcIO());
+
+  std::vector<char> data ((std::istreambuf_iterator<char>(in)),
+                          std::istreambuf_iterator<char>());
+  read_binary_data (data.size() > 0 ? &data[0] : 0, data.size());
+}
+
+
+
+template <int dim, int spacedim>
+void GridIn<dim, spacedim>::read_binary (const std::string &filename)
+{
+  const FileContents contents (filename);
+  read_binary_data (contents.begin(), contents.size());
+}
+
+
+
+template <int dim, int spacedim>
+void GridIn<dim, spacedim>::read_binary_data (const char        *data,
+                                              const std::size_t  size)
+{
+  Assert (tria != 0, ExcNoTriangulationSelected());
+
+  // check the header, see the documentation of read_binary() for a
+  // description of the format
+  static const char magic[] = "deal.II binmesh\n";
+  AssertThrow (size >= 16 && std::memcmp (data, magic, 16) == 0,
+               ExcMessage ("The data is not in deal.II's binary mesh format."));
+  std::size_t offset = 16;
+
+  std::vector<uint64_t> header (9);
+  read_binary_array (data, size, offset, header);
+  AssertThrow (header[3] == ((static_cast<uint64_t>(0x01020304) << 32) | 0x05060708),
+               ExcMessage ("The binary mesh was written on a machine with a "
+                           "different byte order."));
+  AssertThrow (header[0] == 1,
+               ExcMessage ("Unknown version of the binary mesh format."));
+  AssertThrow (header[1] == dim, ExcDimensionMismatch (header[1], dim));
+  AssertThrow (header[2] == spacedim, ExcDimensionMismatch (header[2], spacedim));
+
+  const std::size_t n_vertices = header[4];
+  const std::size_t n_cells = header[5];
+  const std::size_t n_lines = header[6];
+  const std::size_t n_quads = header[7];
+  const bool cells_are_oriented = (header[8] == 1);
+
+  AssertThrow (n_cells > 0, ExcMessage ("The binary mesh contains no cells."));
+  AssertThrow (dim > 1 || n_lines == 0, ExcInternalError());
+  AssertThrow (dim > 2 || n_quads == 0, ExcInternalError());
+
+  std::vector<Point<spacedim> > vertices (n_vertices);
+  {
+    std::vector<double> coordinates (n_vertices * spacedim);
+    read_binary_array (data, size, offset, coordinates);
+    for (unsigned int v=0; v<n_vertices; ++v)
+      for (unsigned int d=0; d<spacedim; ++d)
+        vertices[v][d] = coordinates[v*spacedim+d];
+  }
+
+  std::vector<CellData<dim> > cells (n_cells);
+  {
+    std::vector<uint32_t> cell_vertices (n_cells * GeometryInfo<dim>::vertices_per_cell);
+    std::vector<uint32_t> material_ids (n_cells), manifold_ids (n_cells);
+    read_binary_array (data, size, offset, cell_vertices);
+    read_binary_array (data, size, offset, material_ids);
+    read_binary_array (data, size, offset, manifold_ids);
+    for (unsigned int c=0; c<n_cells; ++c)
+      {
+        for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+          {
+            cells[c].vertices[v] = cell_vertices[c*GeometryInfo<dim>::vertices_per_cell+v];
+            AssertThrow (cells[c].vertices[v] < n_vertices,
+                         ExcInvalidVertexIndex (c, cells[c].vertices[v]));
+          }
+        cells[c].material_id = static_cast<types::material_id>(material_ids[c]);
+        cells[c].manifold_id = manifold_ids[c];
+      }
+  }
+
+  SubCellData subcelldata;
+  read_binary_subcell_data (data, size, offset, n_lines, subcelldata.boundary_lines);
+  read_binary_subcell_data (data, size, offset, n_quads, subcelldata.boundary_quads);
+
+  AssertThrow (offset == size,
+               ExcMessage ("The binary mesh data contains more data than "
+                           "announced in its header."));
+
+  // the cells are known to be in the vertex numbering and orientation
+  // used by deal.II, so we can create the triangulation right away.
+  // otherwise go through the same steps as the other input functions
+  if (cells_are_oriented == false)
+    {
+      // since these work on the old-style (ucd) vertex numbering, convert
+      // the cells and faces to that numbering first
+      for (unsigned int c=0; c<cells.size(); ++c)
+        {
+          const CellData<dim> cell = cells[c];
+          for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+            cells[c].vertices[v] = cell.vertices[GeometryInfo<dim>::ucd_to_deal[v]];
+        }
+      for (unsigned int q=0; q<subcelldata.boundary_quads.size(); ++q)
+        {
+          const CellData<2> quad = subcelldata.boundary_quads[q];
+          for (unsigned int v=0; v<GeometryInfo<2>::vertices_per_cell; ++v)
+            subcelldata.boundary_quads[q].vertices[v] = quad.vertices[GeometryInfo<2>::ucd_to_deal[v]];
+        }
+
+      GridTools::delete_unused_vertices (vertices, cells, subcelldata);
+      if (dim==spacedim)
+        GridReordering<dim,spacedim>::invert_all_cells_of_negative_grid (vertices, cells);
+      GridReordering<dim,spacedim>::reorder_cells (cells);
+    }
+
+  // interior lines and quads can only be given to the triangulation in 2d
+  SubCellData interior_objects;
+  if (dim == 3)
+    {
+      split_interior_objects (subcelldata.boundary_lines,
+                              interior_objects.boundary_lines);
+      split_interior_objects (subcelldata.boundary_quads,
+                              interior_objects.boundary_quads);
+    }
+
+  if (cells_are_oriented)
+    tria->create_triangulation (vertices, cells, subcelldata);
+  else
+    tria->create_triangulation_compatibility (vertices, cells, subcelldata);
+
+  set_interior_manifold_ids (interior_objects, *tria);
+}
+
+
+
 template <int dim, int spacedim>
 void GridIn<dim, spacedim>::read (const std::string &filename,
                                   Format format)
@@ -2740,6 +4099,27 @@ void GridIn<dim, spacedim>::read (const std::string &filename,
     }
   if (format == netcdf)
     read_netcdf(filename);
+  else if (format == binary)
+    read_binary(name);
+  else if (format == msh || format == ucd)
+    {
+      // the readers that take a file name parse the file in parallel, but
+      // they require every vertex and element record to be on a line of its
+      // own. if that is not the case, fall back to the stream based readers
+      // that accept any line layout (and that produce the same error
+      // messages as before for files that are really invalid)
+      try
+        {
+          if (format == msh)
+            read_msh(name);
+          else
+            read_ucd(name);
+        }
+      catch (const ExcUnsupportedLineLayout &)
+        {
+          read(in, format);
+        }
+    }
   else
     read(in, format);
 }
@@ -2792,6 +4172,10 @@ void GridIn<dim, spacedim>::read (std::istream &in,
       read_tecplot (in);
       return;
 
+    case binary:
+      read_binary (in);
+      return;
+
     case Default:
       break;
     }
@@ -2824,6 +4208,8 @@ GridIn<dim, spacedim>::default_suffix (const Format format)
       return ".nc";
     case tecplot:
       return ".dat";
+    case binary:
+      return ".dmesh";
     default:
       Assert (false, ExcNotImplemented());
       return ".unknown_format";
@@ -2870,6 +4256,12 @@ GridIn<dim, spacedim>::parse_format (const std::string &format_name)
   if (format_name == "dat")
     return tecplot;
 
+  if (format_name == "binary")
+    return binary;
+
+  if (format_name == "dmesh")
+    return binary;
+
   if (format_name == "plt")
     // Actually, this is the extension for the
     // tecplot binary format, which we do not
@@ -2892,7 +4284,7 @@ GridIn<dim, spacedim>::parse_format (const std::string &format_name)
 template <int dim, int spacedim>
 std::string GridIn<dim, spacedim>::get_format_names ()
 {
-  return "dbmesh|msh|unv|vtk|ucd|abaqus|xda|netcdf|tecplot";
+  return "dbmesh|msh|unv|vtk|ucd|abaqus|xda|netcdf|tecplot|binary";
 }
 
 namespace
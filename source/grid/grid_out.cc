@@ -32,6 +32,9 @@
 #include <ctime>
 #include <cmath>
 
+// we use uint32_t and uint64_t below, which are declared here:
+#include <stdint.h>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -504,6 +507,8 @@ GridOut::default_suffix (const OutputFormat output_format)
       return ".vtk";
     case vtu:
       return ".vtu";
+    case binary:
+      return ".dmesh";
     default:
       Assert (false, ExcNotImplemented());
       return "";
@@ -556,6 +561,9 @@ GridOut::parse_output_format (const std::string &format_name)
   if (format_name == "vtu")
     return vtu;
 
+  if (format_name == "binary")
+    return binary;
+
   AssertThrow (false, ExcInvalidState ());
   // return something weird
   return OutputFormat(-1);
@@ -565,7 +573,7 @@ GridOut::parse_output_format (const std::string &format_name)
 
 std::string GridOut::get_output_format_names ()
 {
-  return "none|dx|gnuplot|eps|ucd|xfig|msh|svg|mathgl|vtk|vtu";
+  return "none|dx|gnuplot|eps|ucd|xfig|msh|svg|mathgl|vtk|vtu|binary";
 }
 
 
@@ -2526,6 +2534,215 @@ void GridOut::write_vtu (const Triangulation<dim,spacedim> &tria,
 
 
 
+namespace
+{
+  /**
+   * Write the given array to the stream in binary form.
+   */
+  template <typename T>
+  void write_binary_array (const std::vector<T> &data,
+                           std::ostream         &out)
+  {
+    if (data.size() > 0)
+      out.write (reinterpret_cast<const char *>(&data[0]),
+                 data.size() * sizeof(T));
+  }
+
+
+
+  /**
+   * Append the vertices, the boundary and the manifold id of the given
+   * object of dimension @p structdim to the given arrays if the object
+   * needs to be stored in a binary mesh file, i.e., if it lies at the
+   * boundary and has a nonzero boundary indicator or if its manifold id is
+   * not the flat one. As in SubCellData, interior objects are stored with
+   * the boundary id numbers::internal_face_boundary_id.
+   */
+  template <int structdim, typename Iterator>
+  void add_binary_subcell_object (const Iterator                  &object,
+                                  const std::vector<unsigned int> &new_vertex_numbers,
+                                  std::vector<uint32_t>           &vertices,
+                                  std::vector<uint32_t>           &boundary_ids,
+                                  std::vector<uint32_t>           &manifold_ids)
+  {
+    const bool at_boundary = object->at_boundary();
+    if ((at_boundary == false || object->boundary_id() == 0) &&
+        object->manifold_id() == numbers::flat_manifold_id)
+      return;
+
+    for (unsigned int v=0; v<GeometryInfo<structdim>::vertices_per_cell; ++v)
+      vertices.push_back (new_vertex_numbers[object->vertex_index(v)]);
+    boundary_ids.push_back (at_boundary ?
+                            object->boundary_id() :
+                            numbers::internal_face_boundary_id);
+    manifold_ids.push_back (object->manifold_id());
+  }
+
+
+
+  /**
+   * Collect the lines and quads of the active cells of the triangulation
+   * that need to be stored in a binary mesh file. In 1d, there is nothing to
+   * do.
+   */
+  template <int spacedim>
+  void collect_binary_subcell_data (const Triangulation<1,spacedim> &,
+                                    const std::vector<unsigned int> &,
+                                    std::vector<uint32_t> &,
+                                    std::vector<uint32_t> &,
+                                    std::vector<uint32_t> &,
+                                    std::vector<uint32_t> &,
+                                    std::vector<uint32_t> &,
+                                    std::vector<uint32_t> &)
+  {}
+
+
+
+  template <int spacedim>
+  void collect_binary_subcell_data (const Triangulation<2,spacedim> &tria,
+                                    const std::vector<unsigned int> &new_vertex_numbers,
+                                    std::vector<uint32_t>           &line_vertices,
+                                    std::vector<uint32_t>           &line_boundary_ids,
+                                    std::vector<uint32_t>           &line_manifold_ids,
+                                    std::vector<uint32_t>           &,
+                                    std::vector<uint32_t>           &,
+                                    std::vector<uint32_t>           &)
+  {
+    std::vector<bool> line_visited (tria.n_raw_lines(), false);
+    for (typename Triangulation<2,spacedim>::active_cell_iterator
+         cell = tria.begin_active(); cell != tria.end(); ++cell)
+      for (unsigned int l=0; l<GeometryInfo<2>::lines_per_cell; ++l)
+        if (line_visited[cell->line(l)->index()] == false)
+          {
+            line_visited[cell->line(l)->index()] = true;
+            add_binary_subcell_object<1> (cell->line(l), new_vertex_numbers,
+                                          line_vertices, line_boundary_ids,
+                                          line_manifold_ids);
+          }
+  }
+
+
+
+  template <int spacedim>
+  void collect_binary_subcell_data (const Triangulation<3,spacedim> &tria,
+                                    const std::vector<unsigned int> &new_vertex_numbers,
+                                    std::vector<uint32_t>           &line_vertices,
+                                    std::vector<uint32_t>           &line_boundary_ids,
+                                    std::vector<uint32_t>           &line_manifold_ids,
+                                    std::vector<uint32_t>           &quad_vertices,
+                                    std::vector<uint32_t>           &quad_boundary_ids,
+                                    std::vector<uint32_t>           &quad_manifold_ids)
+  {
+    std::vector<bool> line_visited (tria.n_raw_lines(), false);
+    std::vector<bool> quad_visited (tria.n_raw_quads(), false);
+    for (typename Triangulation<3,spacedim>::active_cell_iterator
+         cell = tria.begin_active(); cell != tria.end(); ++cell)
+      {
+        for (unsigned int l=0; l<GeometryInfo<3>::lines_per_cell; ++l)
+          if (line_visited[cell->line(l)->index()] == false)
+            {
+              line_visited[cell->line(l)->index()] = true;
+              add_binary_subcell_object<1> (cell->line(l), new_vertex_numbers,
+                                            line_vertices, line_boundary_ids,
+                                            line_manifold_ids);
+            }
+        for (unsigned int q=0; q<GeometryInfo<3>::quads_per_cell; ++q)
+          if (quad_visited[cell->quad(q)->index()] == false)
+            {
+              quad_visited[cell->quad(q)->index()] = true;
+              add_binary_subcell_object<2> (cell->quad(q), new_vertex_numbers,
+                                            quad_vertices, quad_boundary_ids,
+                                            quad_manifold_ids);
+            }
+      }
+  }
+}
+
+
+
+template <int dim, int spacedim>
+void GridOut::write_binary (const Triangulation<dim,spacedim> &tria,
+                            std::ostream                      &out) const
+{
+  AssertThrow (out, ExcIO ());
+
+  // number the used vertices consecutively
+  const std::vector<Point<spacedim> > &vertices = tria.get_vertices();
+  const std::vector<bool> &vertex_used = tria.get_used_vertices();
+  std::vector<unsigned int> new_vertex_numbers (vertices.size(),
+                                                numbers::invalid_unsigned_int);
+  std::vector<double> coordinates;
+  coordinates.reserve (tria.n_used_vertices() * spacedim);
+  unsigned int n_vertices = 0;
+  for (unsigned int v=0; v<vertices.size(); ++v)
+    if (vertex_used[v])
+      {
+        new_vertex_numbers[v] = n_vertices++;
+        for (unsigned int d=0; d<spacedim; ++d)
+          coordinates.push_back (vertices[v][d]);
+      }
+
+  // collect the cells, and the faces and edges that carry information that
+  // would otherwise be lost
+  const unsigned int n_cells = tria.n_active_cells();
+  std::vector<uint32_t> cell_vertices;
+  cell_vertices.reserve (n_cells * GeometryInfo<dim>::vertices_per_cell);
+  std::vector<uint32_t> material_ids, cell_manifold_ids;
+  material_ids.reserve (n_cells);
+  cell_manifold_ids.reserve (n_cells);
+
+  for (typename Triangulation<dim,spacedim>::active_cell_iterator
+       cell = tria.begin_active(); cell != tria.end(); ++cell)
+    {
+      for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+        cell_vertices.push_back (new_vertex_numbers[cell->vertex_index(v)]);
+      material_ids.push_back (cell->material_id());
+      cell_manifold_ids.push_back (cell->manifold_id());
+    }
+
+  std::vector<uint32_t> line_vertices, line_boundary_ids, line_manifold_ids;
+  std::vector<uint32_t> quad_vertices, quad_boundary_ids, quad_manifold_ids;
+  collect_binary_subcell_data (tria, new_vertex_numbers,
+                               line_vertices, line_boundary_ids, line_manifold_ids,
+                               quad_vertices, quad_boundary_ids, quad_manifold_ids);
+
+  // write the header, see GridIn::read_binary() for a description of the
+  // format
+  static const char magic[] = "deal.II binmesh\n";
+  out.write (magic, 16);
+
+  const uint64_t header[] =
+  {
+    1,                                 // version
+    dim,
+    spacedim,
+    (static_cast<uint64_t>(0x01020304) << 32) | 0x05060708, // byte order mark
+    n_vertices,
+    n_cells,
+    line_boundary_ids.size(),
+    quad_boundary_ids.size(),
+    1                                  // cells are consistently oriented
+  };
+  out.write (reinterpret_cast<const char *>(&header[0]), sizeof(header));
+
+  write_binary_array (coordinates, out);
+  write_binary_array (cell_vertices, out);
+  write_binary_array (material_ids, out);
+  write_binary_array (cell_manifold_ids, out);
+  write_binary_array (line_vertices, out);
+  write_binary_array (line_boundary_ids, out);
+  write_binary_array (line_manifold_ids, out);
+  write_binary_array (quad_vertices, out);
+  write_binary_array (quad_boundary_ids, out);
+  write_binary_array (quad_manifold_ids, out);
+
+  out.flush ();
+
+  AssertThrow (out, ExcIO ());
+}
+
+
+
 unsigned int GridOut::n_boundary_faces (const Triangulation<1> &) const
 {
   return 0;
@@ -3955,6 +4172,10 @@ void GridOut::write (const Triangulation<dim, spacedim> &tria,
     case vtu:
       write_vtu (tria, out);
       return;
+
+    case binary:
+      write_binary (tria, out);
+      return;
     }
 
   Assert (false, ExcInternalError());
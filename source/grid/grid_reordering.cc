@@ -18,14 +18,17 @@
 #include <deal.II/grid/grid_reordering_internal.h>
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/base/utilities.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/std_cxx11/bind.h>
 
 #include <algorithm>
-#include <set>
 #include <iostream>
 #include <fstream>
 #include <functional>
 
+// we use uint64_t below, which is declared here:
+#include <stdint.h>
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -101,68 +104,75 @@ namespace internal
 
 
     /**
-     * Simple data structure denoting
-     * an edge, i.e. the ordered pair
-     * of its vertices. This is only
-     * used in the is_consistent
-     * function.
+     * Return a key for the edge between the vertices @p v0 and @p v1 that
+     * does not depend on the direction of the edge, with the lowest bit
+     * indicating the direction. Sorting these keys brings all occurrences of
+     * an edge next to each other.
      */
-    struct Edge
+    inline
+    uint64_t
+    directed_edge_key (const unsigned int v0,
+                       const unsigned int v1)
     {
-      Edge (const unsigned int v0,
-            const unsigned int v1)
-        :
-        v0(v0), v1(v1)
-      {}
+      Assert ((v0 < (1U << 31)) && (v1 < (1U << 31)),
+              ExcMessage ("Vertex indices are too large."));
+      return ((v0 < v1)
+              ?
+              ((static_cast<uint64_t>(v0) << 33) | (static_cast<uint64_t>(v1) << 1))
+              :
+              ((static_cast<uint64_t>(v1) << 33) | (static_cast<uint64_t>(v0) << 1) | 1));
+    }
+
+
+
+    /**
+     * Compute the keys of the four edges, in the directions used by the
+     * classic numbering of vertices, of the cells with indices in the range
+     * [begin,end).
+     */
+    void
+    compute_edge_keys (const std::vector<CellData<2> > &cells,
+                       std::vector<uint64_t>           &edge_keys,
+                       const unsigned int               begin,
+                       const unsigned int               end)
+    {
+      for (unsigned int c=begin; c<end; ++c)
+        {
+          const unsigned int *v = cells[c].vertices;
+          edge_keys[4*c]   = directed_edge_key (v[0], v[1]);
+          edge_keys[4*c+1] = directed_edge_key (v[1], v[2]);
+          edge_keys[4*c+2] = directed_edge_key (v[3], v[2]);
+          edge_keys[4*c+3] = directed_edge_key (v[0], v[3]);
+        }
+    }
 
-      const unsigned int v0, v1;
-      bool operator < (const Edge &e) const
-      {
-        return ((v0 < e.v0) || ((v0 == e.v0) && (v1 < e.v1)));
-      }
-    };
 
 
+    /**
+     * Return whether the cells are already consistently oriented, i.e.,
+     * whether every edge has the same direction in all cells it belongs
+     * to. Rather than storing the edges in a set, we compute a compact key
+     * for each edge of each cell in parallel, sort the keys, and check
+     * whether two cells use the same edge in different directions.
+     */
     bool
     is_consistent  (const std::vector<CellData<2> > &cells)
     {
-      std::set<Edge> edges;
+      std::vector<uint64_t> edge_keys (4*cells.size());
+      parallel::apply_to_subranges (0U, static_cast<unsigned int>(cells.size()),
+                                    std_cxx11::bind (&compute_edge_keys,
+                                                     std_cxx11::cref(cells),
+                                                     std_cxx11::ref(edge_keys),
+                                                     std_cxx11::_1, std_cxx11::_2),
+                                    4096);
+      std::sort (edge_keys.begin(), edge_keys.end());
+
+      // the two occurrences of an edge in different directions differ only
+      // in the lowest bit
+      for (unsigned int i=1; i<edge_keys.size(); ++i)
+        if ((edge_keys[i] ^ edge_keys[i-1]) == 1)
+          return false;
 
-      std::vector<CellData<2> >::const_iterator c = cells.begin();
-      for (; c != cells.end(); ++c)
-        {
-          // construct the four edges
-          // in reverse order
-          const Edge reverse_edges[4] = { Edge (c->vertices[1],
-                                                c->vertices[0]),
-                                          Edge (c->vertices[2],
-                                                c->vertices[1]),
-                                          Edge (c->vertices[2],
-                                                c->vertices[3]),
-                                          Edge (c->vertices[3],
-                                                c->vertices[0])
-                                        };
-          // for each of them, check
-          // whether they are already
-          // in the set
-          if ((edges.find (reverse_edges[0]) != edges.end()) ||
-              (edges.find (reverse_edges[1]) != edges.end()) ||
-              (edges.find (reverse_edges[2]) != edges.end()) ||
-              (edges.find (reverse_edges[3]) != edges.end()))
-            return false;
-          // ok, not. insert them
-          // in the order in which
-          // we want them
-          // (std::set eliminates
-          // duplicated by itself)
-          for (unsigned int i = 0; i<4; ++i)
-            {
-              const Edge e(reverse_edges[i].v1, reverse_edges[i].v0);
-              edges.insert (e);
-            }
-          // then go on with next
-          // cell
-        }
       // no conflicts found, so
       // return true
       return true;
@@ -888,28 +898,6 @@ namespace internal
     }
 
 
-    CheapEdge::CheapEdge (const unsigned int n0,
-                          const unsigned int n1)
-      :
-      // sort the
-      // entries so
-      // that
-      // node0<node1
-      node0(std::min (n0, n1)),
-      node1(std::max (n0, n1))
-    {}
-
-
-
-    bool CheapEdge::operator< (const CheapEdge &e2) const
-    {
-      if (node0 < e2.node0) return true;
-      if (node0 > e2.node0) return false;
-      if (node1 < e2.node1) return true;
-      return false;
-    }
-
-
     Edge::Edge (const unsigned int n0,
                 const unsigned int n1)
       :
@@ -943,6 +931,7 @@ namespace internal
       // copy the cells into our own
       // internal data format.
       const unsigned int numelems = incubes.size();
+      cell_list.reserve (numelems);
       for (unsigned int i=0; i<numelems; ++i)
         {
           Cell the_cell;
@@ -1018,6 +1007,165 @@ namespace internal
 
 
 
+    namespace
+    {
+      /**
+       * A hash table that maps edges, given as a compact integer key made
+       * up of the two vertex indices of the edge, to edge numbers. Collisions
+       * are resolved by linear probing. This uses much less memory and is
+       * much faster than a std::map for the millions of edges of large
+       * coarse meshes.
+       */
+      class EdgeTable
+      {
+      public:
+        /**
+         * Constructor. Reserve space for about @p n_edges edges.
+         */
+        EdgeTable (const std::size_t n_edges);
+
+        /**
+         * Return the number of the edge with the given key. If the edge is
+         * not yet in the table, insert it with number @p new_edge_number and
+         * return numbers::invalid_unsigned_int.
+         */
+        unsigned int find_or_insert (const uint64_t     key,
+                                     const unsigned int new_edge_number);
+
+        /**
+         * Compute the key of the edge between the given vertices, which
+         * does not depend on the direction of the edge.
+         */
+        static uint64_t key (const unsigned int v0,
+                             const unsigned int v1);
+
+      private:
+        /**
+         * Double the size of the table.
+         */
+        void grow ();
+
+        /**
+         * The position in the table at which to start searching for the
+         * given key.
+         */
+        std::size_t hash (const uint64_t key) const;
+
+        /**
+         * The keys stored in the table. Empty slots have the key
+         * <tt>empty_key</tt>, which can not be the key of an edge since the
+         * smaller vertex index is stored in the upper half of the key.
+         */
+        std::vector<uint64_t> keys;
+
+        /**
+         * The edge numbers belonging to the keys.
+         */
+        std::vector<unsigned int> values;
+
+        /**
+         * The number of entries in the table.
+         */
+        std::size_t n_entries;
+
+        /**
+         * The number of bits used to index into the table.
+         */
+        unsigned int n_bits;
+
+        static const uint64_t empty_key = static_cast<uint64_t>(-1);
+      };
+
+
+
+      const uint64_t EdgeTable::empty_key;
+
+
+
+      EdgeTable::EdgeTable (const std::size_t n_edges)
+        :
+        n_entries (0),
+        n_bits (4)
+      {
+        // keep the table at most half full
+        while ((static_cast<std::size_t>(1) << n_bits) < 2*n_edges)
+          ++n_bits;
+        keys.resize (static_cast<std::size_t>(1) << n_bits, empty_key);
+        values.resize (static_cast<std::size_t>(1) << n_bits);
+      }
+
+
+
+      inline
+      uint64_t
+      EdgeTable::key (const unsigned int v0,
+                      const unsigned int v1)
+      {
+        return ((static_cast<uint64_t>(std::min (v0, v1)) << 32) |
+                static_cast<uint64_t>(std::max (v0, v1)));
+      }
+
+
+
+      inline
+      std::size_t
+      EdgeTable::hash (const uint64_t key) const
+      {
+        // multiplicative (Fibonacci) hashing
+        return static_cast<std::size_t>
+               ((key * ((static_cast<uint64_t>(0x9E3779B9) << 32) | 0x7F4A7C15))
+                >> (64 - n_bits));
+      }
+
+
+
+      inline
+      unsigned int
+      EdgeTable::find_or_insert (const uint64_t     key,
+                                 const unsigned int new_edge_number)
+      {
+        const std::size_t mask = keys.size() - 1;
+        for (std::size_t i = hash(key); ; i = (i+1) & mask)
+          {
+            if (keys[i] == key)
+              return values[i];
+            if (keys[i] == empty_key)
+              {
+                keys[i] = key;
+                values[i] = new_edge_number;
+                if (2 * ++n_entries > keys.size())
+                  grow ();
+                return numbers::invalid_unsigned_int;
+              }
+          }
+      }
+
+
+
+      void
+      EdgeTable::grow ()
+      {
+        std::vector<uint64_t> old_keys (keys.size()*2, empty_key);
+        std::vector<unsigned int> old_values (values.size()*2);
+        old_keys.swap (keys);
+        old_values.swap (values);
+        ++n_bits;
+
+        const std::size_t mask = keys.size() - 1;
+        for (std::size_t j=0; j<old_keys.size(); ++j)
+          if (old_keys[j] != empty_key)
+            {
+              std::size_t i = hash(old_keys[j]);
+              while (keys[i] != empty_key)
+                i = (i+1) & mask;
+              keys[i] = old_keys[j];
+              values[i] = old_values[j];
+            }
+      }
+    }
+
+
+
     // This is the guts of the matter...
     void Mesh::build_connectivity ()
     {
@@ -1025,108 +1173,84 @@ namespace internal
 
       unsigned int n_edges = 0;
       // Correctly build the edge
-      // list
+      // list. A hexahedral mesh has
+      // about three edges per cell,
+      // which we use as an estimate
+      // for the size of the tables
       {
-        // edge_map stores the
-        // edge_number associated
-        // with a given CheapEdge
-        std::map<CheapEdge,unsigned int> edge_map;
-        unsigned int ctr = 0;
+        EdgeTable edge_table (3 * static_cast<std::size_t>(n_cells) + 12);
+        edge_list.reserve (3 * n_cells + 12);
+
         for (unsigned int cur_cell_id = 0;
              cur_cell_id<n_cells;
              ++cur_cell_id)
           {
-            // Get the local node
-            // numbers on edge
-            // edge_num
-            const Cell &cur_cell = cell_list[cur_cell_id];
+            Cell &cur_cell = cell_list[cur_cell_id];
 
             for (unsigned short int edge_num = 0;
                  edge_num<12;
                  ++edge_num)
               {
-                unsigned int gl_edge_num = 0;
-                EdgeOrientation l_edge_orient = forward_edge;
-
-                // Construct the
-                // CheapEdge
+                // Get the local node
+                // numbers on edge
+                // edge_num
                 const unsigned int
                 node0 = cur_cell.nodes[ElementInfo::nodes_on_edge[edge_num][0]],
                 node1 = cur_cell.nodes[ElementInfo::nodes_on_edge[edge_num][1]];
-                const CheapEdge cur_edge (node0, node1);
 
-                if (edge_map.count(cur_edge) == 0)
-                  // Edge not in map
+                unsigned int gl_edge_num
+                  = edge_table.find_or_insert (EdgeTable::key (node0, node1),
+                                               n_edges);
+                EdgeOrientation l_edge_orient = forward_edge;
+
+                if (gl_edge_num == numbers::invalid_unsigned_int)
+                  // Edge not yet in
+                  // table, so put it
+                  // into the global
+                  // edge list
                   {
-                    // put edge in
-                    // hash map with
-                    // ctr value;
-                    edge_map[cur_edge] = ctr;
-                    gl_edge_num = ctr;
-
-                    // put the edge
-                    // into the
-                    // global edge
-                    // list
+                    gl_edge_num = n_edges;
                     edge_list.push_back(Edge(node0,node1));
-                    ctr++;
-                  }
-                else
-                  {
-                    // get edge_num
-                    // from hash_map
-                    gl_edge_num = edge_map[cur_edge];
-                    if (edge_list[gl_edge_num].nodes[0] != node0)
-                      l_edge_orient = backward_edge;
+                    ++n_edges;
                   }
+                else if (edge_list[gl_edge_num].nodes[0] != node0)
+                  l_edge_orient = backward_edge;
+
                 // set edge number to
                 // edgenum
-                cell_list[cur_cell_id].edges[edge_num] = gl_edge_num;
-                cell_list[cur_cell_id].local_orientation_flags[edge_num]
-                  = l_edge_orient;
+                cur_cell.edges[edge_num] = gl_edge_num;
+                cur_cell.local_orientation_flags[edge_num] = l_edge_orient;
               }
           }
-        n_edges = ctr;
       }
 
-      // Count each of the edges.
-      {
-        std::vector<int> edge_count(n_edges,0);
-
-
-        // Count every time an edge
-        // occurs in a cube.
-        for (unsigned int cur_cell_id=0; cur_cell_id<n_cells; ++cur_cell_id)
-          for (unsigned short int edge_num = 0; edge_num<12; ++edge_num)
-            ++edge_count[cell_list[cur_cell_id].edges[edge_num]];
-
-        // So we now know how many
-        // cubes contain a given
-        // edge. Just need to store
-        // the list of cubes in the
-        // edge
-
-        // Allocate the space for the
-        // neighbor list
-        for (unsigned int cur_edge_id=0; cur_edge_id<n_edges; ++cur_edge_id)
-          edge_list[cur_edge_id].neighboring_cubes
-          .resize (edge_count[cur_edge_id]);
-
-        // Store the position of the
-        // current neighbor in the
-        // edge's neighbor list
-        std::vector<int> cur_cell_edge_list_posn(n_edges,0);
-        for (unsigned int cur_cell_id=0; cur_cell_id<n_cells; ++cur_cell_id)
-          for (unsigned short int edge_num=0; edge_num<12; ++edge_num)
-            {
-              const unsigned int
-              gl_edge_id = cell_list[cur_cell_id].edges[edge_num];
-              Edge &cur_edge = edge_list[gl_edge_id];
-              cur_edge.neighboring_cubes[cur_cell_edge_list_posn[gl_edge_id]]
-                = cur_cell_id;
-              cur_cell_edge_list_posn[gl_edge_id]++;
-            }
-      }
+      // Store the cubes adjacent to
+      // each edge in compressed
+      // form. First count every time
+      // an edge occurs in a cube
+      neighbor_start.clear ();
+      neighbor_start.resize (n_edges+1, 0);
+      for (unsigned int cur_cell_id=0; cur_cell_id<n_cells; ++cur_cell_id)
+        for (unsigned short int edge_num = 0; edge_num<12; ++edge_num)
+          ++neighbor_start[cell_list[cur_cell_id].edges[edge_num]+1];
+      for (unsigned int e=0; e<n_edges; ++e)
+        neighbor_start[e+1] += neighbor_start[e];
+
+      // then fill in the cubes,
+      // using the current position
+      // in each edge's part of the
+      // list
+      neighboring_cubes.resize (neighbor_start[n_edges]);
+      std::vector<unsigned int> cur_cell_edge_list_posn (neighbor_start.begin(),
+                                                         neighbor_start.end()-1);
+      for (unsigned int cur_cell_id=0; cur_cell_id<n_cells; ++cur_cell_id)
+        for (unsigned short int edge_num=0; edge_num<12; ++edge_num)
+          {
+            const unsigned int
+            gl_edge_id = cell_list[cur_cell_id].edges[edge_num];
+            neighboring_cubes[cur_cell_edge_list_posn[gl_edge_id]] = cur_cell_id;
+            ++cur_cell_edge_list_posn[gl_edge_id];
+          }
     }
 
 
@@ -1464,13 +1588,13 @@ namespace internal
         // oriented
         if (edge_orient_array[e] == true)
           {
-            const Edge &the_edge = mesh.edge_list[c.edges[e]];
-            for (unsigned int local_cube_num = 0;
-                 local_cube_num < the_edge.neighboring_cubes.size();
-                 ++local_cube_num)
+            const unsigned int edge = c.edges[e];
+            for (unsigned int n = mesh.neighbor_start[edge];
+                 n < mesh.neighbor_start[edge+1];
+                 ++n)
               {
                 const unsigned int
-                global_cell_num = the_edge.neighboring_cubes[local_cube_num];
+                global_cell_num = mesh.neighboring_cubes[n];
                 Cell &ncell = mesh.cell_list[global_cell_num];
 
                 // If the cell is waiting to be
@@ -1509,6 +1633,20 @@ namespace internal
 
 
     void Orienter::orient_cubes ()
+    {
+      // The cubes can be rotated
+      // independently of each other
+      parallel::apply_to_subranges (0U, static_cast<unsigned int>(mesh.cell_list.size()),
+                                    std_cxx11::bind (&Orienter::orient_cubes_in_range,
+                                                     this,
+                                                     std_cxx11::_1, std_cxx11::_2),
+                                    1024);
+    }
+
+
+
+    void Orienter::orient_cubes_in_range (const unsigned int begin,
+                                          const unsigned int end)
     {
       // We assume that the mesh has
       // all edges oriented already.
@@ -1540,7 +1678,7 @@ namespace internal
       // that should be the local
       // zero node has three edges
       // coming into it.
-      for (unsigned int i=0; i<mesh.cell_list.size(); ++i)
+      for (unsigned int i=begin; i<end; ++i)
         {
           Cell &the_cell = mesh.cell_list[i];
 
@@ -0,0 +1,449 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/std_cxx11/bind.h>
+#include <deal.II/fe/mapping_q_generic.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+
+#include <algorithm>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace GridTools
+{
+  namespace
+  {
+    /**
+     * The maximal number of cells stored in a leaf of the tree.
+     */
+    const unsigned int max_cells_per_leaf = 4;
+
+    /**
+     * The fraction of the extent of a cell by which its bounding box is
+     * enlarged in each direction to account for curved cells and for points
+     * that lie on the boundary of a cell up to roundoff.
+     */
+    const double box_enlargement = 0.1;
+
+    /**
+     * Return whether the point @p p lies inside the box with the given
+     * corners.
+     */
+    template <int spacedim>
+    inline
+    bool
+    box_contains_point (const Point<spacedim> &lower_corner,
+                        const Point<spacedim> &upper_corner,
+                        const Point<spacedim> &p)
+    {
+      for (unsigned int d=0; d<spacedim; ++d)
+        if (p[d] < lower_corner[d] || p[d] > upper_corner[d])
+          return false;
+      return true;
+    }
+
+    /**
+     * A comparison object that orders the indices of cells by the center of
+     * their bounding boxes in a given coordinate direction.
+     */
+    template <int spacedim>
+    class CompareBoxCenters
+    {
+    public:
+      CompareBoxCenters (const std::vector<std::pair<Point<spacedim>,Point<spacedim> > > &boxes,
+                         const unsigned int                                             direction)
+        :
+        boxes (boxes),
+        direction (direction)
+      {}
+
+      bool operator () (const unsigned int i,
+                        const unsigned int j) const
+      {
+        return (boxes[i].first[direction] + boxes[i].second[direction]
+                <
+                boxes[j].first[direction] + boxes[j].second[direction]);
+      }
+
+    private:
+      const std::vector<std::pair<Point<spacedim>,Point<spacedim> > > &boxes;
+      const unsigned int direction;
+    };
+  }
+
+
+
+  template <int dim, int spacedim>
+  Cache<dim,spacedim>::Cache (const Triangulation<dim,spacedim> &tria,
+                              const Mapping<dim,spacedim>       &mapping)
+    :
+    tria (&tria, typeid(*this).name()),
+    mapping (&mapping, typeid(*this).name()),
+    update_needed (true)
+  {
+    tria_listener =
+      tria.signals.any_change.connect
+      (std_cxx11::bind (&Cache<dim,spacedim>::mark_for_update,
+                        std_cxx11::ref(*this)));
+  }
+
+
+
+  template <int dim, int spacedim>
+  Cache<dim,spacedim>::Cache (const Cache<dim,spacedim> &cache)
+    :
+    Subscriptor (),
+    tria (&*cache.tria, typeid(*this).name()),
+    mapping (&*cache.mapping, typeid(*this).name()),
+    update_needed (true)
+  {
+    tria_listener =
+      tria->signals.any_change.connect
+      (std_cxx11::bind (&Cache<dim,spacedim>::mark_for_update,
+                        std_cxx11::ref(*this)));
+  }
+
+
+
+  template <int dim, int spacedim>
+  Cache<dim,spacedim>::~Cache ()
+  {
+    tria_listener.disconnect ();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim,spacedim>::mark_for_update ()
+  {
+    Threads::Mutex::ScopedLock lock (mutex);
+    update_needed = true;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim,spacedim>::update_tree () const
+  {
+    Threads::Mutex::ScopedLock lock (mutex);
+    if (update_needed)
+      {
+        build_tree ();
+        update_needed = false;
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim,spacedim>::build_tree () const
+  {
+    const unsigned int n_cells = tria->n_active_cells();
+
+    active_cells.resize (n_cells);
+    cell_boxes.resize (n_cells);
+    cell_indices.resize (n_cells);
+    tree.clear ();
+
+    if (n_cells == 0)
+      return;
+
+    // compute the bounding boxes of all cells from the vertices the mapping
+    // places them at, and enlarge them a bit
+    for (active_cell_iterator cell = tria->begin_active(); cell != tria->end(); ++cell)
+      {
+        const unsigned int index = cell->active_cell_index();
+        active_cells[index] = cell;
+        cell_indices[index] = index;
+
+        const std_cxx11::array<Point<spacedim>, GeometryInfo<dim>::vertices_per_cell>
+        vertices = mapping->get_vertices (cell);
+
+        Point<spacedim> lower_corner = vertices[0];
+        Point<spacedim> upper_corner = vertices[0];
+        for (unsigned int v=1; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+          for (unsigned int d=0; d<spacedim; ++d)
+            {
+              lower_corner[d] = std::min (lower_corner[d], vertices[v][d]);
+              upper_corner[d] = std::max (upper_corner[d], vertices[v][d]);
+            }
+
+        double extent = 0;
+        for (unsigned int d=0; d<spacedim; ++d)
+          extent = std::max (extent, upper_corner[d] - lower_corner[d]);
+        for (unsigned int d=0; d<spacedim; ++d)
+          {
+            lower_corner[d] -= box_enlargement * extent;
+            upper_corner[d] += box_enlargement * extent;
+          }
+
+        cell_boxes[index] = std::make_pair (lower_corner, upper_corner);
+      }
+
+    // since we only split nodes with more than max_cells_per_leaf cells into
+    // two halves, each leaf holds at least two cells and the tree has fewer
+    // nodes than there are cells
+    tree.reserve (n_cells);
+    tree.resize (1);
+    build_node (0, 0, n_cells);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim,spacedim>::build_node (const unsigned int node,
+                                   const unsigned int begin,
+                                   const unsigned int end) const
+  {
+    Assert (begin < end, ExcInternalError());
+
+    // the box of this node is the union of the boxes of its cells
+    Point<spacedim> lower_corner = cell_boxes[cell_indices[begin]].first;
+    Point<spacedim> upper_corner = cell_boxes[cell_indices[begin]].second;
+    for (unsigned int i=begin+1; i<end; ++i)
+      for (unsigned int d=0; d<spacedim; ++d)
+        {
+          lower_corner[d] = std::min (lower_corner[d],
+                                      cell_boxes[cell_indices[i]].first[d]);
+          upper_corner[d] = std::max (upper_corner[d],
+                                      cell_boxes[cell_indices[i]].second[d]);
+        }
+    tree[node].lower_corner = lower_corner;
+    tree[node].upper_corner = upper_corner;
+
+    if (end - begin <= max_cells_per_leaf)
+      {
+        tree[node].is_leaf = true;
+        tree[node].first   = begin;
+        tree[node].second  = end;
+        return;
+      }
+
+    // otherwise split the cells into two halves along the longest extent of
+    // the box, sorted by the centers of the boxes of the cells
+    unsigned int direction = 0;
+    for (unsigned int d=1; d<spacedim; ++d)
+      if (upper_corner[d] - lower_corner[d] >
+          upper_corner[direction] - lower_corner[direction])
+        direction = d;
+
+    const unsigned int middle = begin + (end - begin) / 2;
+    std::nth_element (cell_indices.begin() + begin,
+                      cell_indices.begin() + middle,
+                      cell_indices.begin() + end,
+                      CompareBoxCenters<spacedim> (cell_boxes, direction));
+
+    // note that adding the children may invalidate references into the
+    // tree, so only work with indices here
+    const unsigned int left_child = tree.size();
+    tree.resize (tree.size() + 2);
+    tree[node].is_leaf = false;
+    tree[node].first   = left_child;
+    tree[node].second  = left_child + 1;
+
+    build_node (left_child, begin, middle);
+    build_node (left_child + 1, middle, end);
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::pair<typename Cache<dim,spacedim>::active_cell_iterator, Point<dim> >
+  Cache<dim,spacedim>::search_tree (const Point<spacedim> &p) const
+  {
+    // use the same criteria as GridTools::find_active_cell_around_point to
+    // select the cell: we allow for a deviation of 1e-10 from the unit cell
+    // and prefer the cell with the smallest distance, then the more refined
+    // of several cells. the order in which we visit the cells depends on the
+    // tree, so break remaining ties (such as for points on a face, edge, or
+    // vertex shared by cells of the same level) by preferring the cell with
+    // the lowest active_cell_index(). this is the first of these cells
+    // GridTools::find_active_cell_around_point visits
+    double best_distance = 1e-10;
+    int    best_level = -1;
+    std::pair<active_cell_iterator, Point<dim> > best_cell (tria->end(), Point<dim>());
+
+    if (tree.empty())
+      return best_cell;
+
+    std::vector<unsigned int> nodes_to_visit (1, 0U);
+    while (nodes_to_visit.empty() == false)
+      {
+        const Node &node = tree[nodes_to_visit.back()];
+        nodes_to_visit.pop_back ();
+
+        if (!box_contains_point (node.lower_corner, node.upper_corner, p))
+          continue;
+
+        if (node.is_leaf == false)
+          {
+            nodes_to_visit.push_back (node.first);
+            nodes_to_visit.push_back (node.second);
+            continue;
+          }
+
+        for (unsigned int i=node.first; i<node.second; ++i)
+          {
+            const unsigned int index = cell_indices[i];
+            if (!box_contains_point (cell_boxes[index].first,
+                                     cell_boxes[index].second,
+                                     p))
+              continue;
+
+            const active_cell_iterator &cell = active_cells[index];
+            try
+              {
+                const Point<dim> p_cell = mapping->transform_real_to_unit_cell (cell, p);
+                const double dist = GeometryInfo<dim>::distance_to_unit_cell (p_cell);
+                if ((dist < best_distance)
+                    ||
+                    ((dist == best_distance)
+                     &&
+                     ((cell->level() > best_level)
+                      ||
+                      ((cell->level() == best_level)
+                       &&
+                       (cell->active_cell_index() <
+                        best_cell.first->active_cell_index())))))
+                  {
+                    best_distance = dist;
+                    best_level    = cell->level();
+                    best_cell     = std::make_pair (cell, p_cell);
+                  }
+              }
+            catch (typename MappingQGeneric<dim,spacedim>::ExcTransformationFailed &)
+              {
+                // the point lies outside of this cell, so we can ignore it
+              }
+          }
+      }
+
+    return best_cell;
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  Cache<dim,spacedim>::point_in_root_box (const Point<spacedim> &p) const
+  {
+    return (tree.empty() == false
+            &&
+            box_contains_point (tree[0].lower_corner, tree[0].upper_corner, p));
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::pair<typename Cache<dim,spacedim>::active_cell_iterator, Point<dim> >
+  Cache<dim,spacedim>::find_active_cell_around_point (const Point<spacedim> &p) const
+  {
+    update_tree ();
+
+    const std::pair<active_cell_iterator, Point<dim> > cell_point = search_tree (p);
+    if (cell_point.first.state() == IteratorState::valid)
+      return cell_point;
+
+    // points outside the box around all cells are not in the triangulation
+    AssertThrow (point_in_root_box (p), ExcPointNotFound<spacedim>(p));
+
+    // the point did not lie in any of the bounding boxes of the cells. this
+    // can either be because it is in a hole of the domain or because a
+    // strongly curved cell is not contained in its bounding box. in either
+    // case, fall back to the slow search, which also throws the appropriate
+    // exception if the point cannot be found
+    return GridTools::find_active_cell_around_point (*mapping, *tria, p);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim,spacedim>::
+  find_active_cells_around_points (const std::vector<Point<spacedim> >                      &points,
+                                   std::vector<std::pair<active_cell_iterator,Point<dim> > > &cells) const
+  {
+    // build the tree before we start working on several threads
+    update_tree ();
+
+    cells.resize (points.size());
+    parallel::apply_to_subranges (0U, static_cast<unsigned int>(points.size()),
+                                  std_cxx11::bind (&Cache<dim,spacedim>::search_points,
+                                                   this,
+                                                   std_cxx11::cref(points),
+                                                   std_cxx11::ref(cells),
+                                                   std_cxx11::_1,
+                                                   std_cxx11::_2),
+                                  32);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim,spacedim>::
+  search_points (const std::vector<Point<spacedim> >                      &points,
+                 std::vector<std::pair<active_cell_iterator,Point<dim> > > &cells,
+                 const unsigned int                                        begin,
+                 const unsigned int                                        end) const
+  {
+    for (unsigned int i=begin; i<end; ++i)
+      {
+        cells[i] = search_tree (points[i]);
+        if (cells[i].first.state() != IteratorState::valid
+            &&
+            point_in_root_box (points[i]))
+          {
+            try
+              {
+                cells[i] = GridTools::find_active_cell_around_point (*mapping, *tria,
+                                                                     points[i]);
+              }
+            catch (const ExcPointNotFound<spacedim> &)
+              {
+                cells[i] = std::make_pair (active_cell_iterator(tria->end()),
+                                           Point<dim>());
+              }
+          }
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  Cache<dim,spacedim>::memory_consumption () const
+  {
+    return (sizeof(*this) +
+            MemoryConsumption::memory_consumption (active_cells) +
+            MemoryConsumption::memory_consumption (cell_boxes) +
+            MemoryConsumption::memory_consumption (cell_indices) +
+            tree.capacity() * sizeof(Node));
+  }
+}
+
+
+// explicit instantiations
+#include "grid_tools_cache.inst"
+
+DEAL_II_NAMESPACE_CLOSE
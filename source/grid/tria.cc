@@ -18,6 +18,7 @@
 #include <deal.II/base/table.h>
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/std_cxx11/bind.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/tria_levels.h>
@@ -3697,6 +3698,11 @@ namespace internal
        * lines, quads and cells have to
        * be passed, which point at (or
        * "before") the reserved space.
+       * If the cell is refined
+       * isotropically, the location
+       * of its new center vertex is
+       * taken from @p next_new_center,
+       * see compute_cell_centers().
        */
       template <int spacedim>
       static
@@ -3705,6 +3711,7 @@ namespace internal
                        unsigned int &next_unused_vertex,
                        typename Triangulation<2,spacedim>::raw_line_iterator &next_unused_line,
                        typename Triangulation<2,spacedim>::raw_cell_iterator &next_unused_cell,
+                       typename std::vector<Point<spacedim> >::const_iterator &next_new_center,
                        typename Triangulation<2,spacedim>::cell_iterator &cell)
       {
         const unsigned int dim=2;
@@ -3829,98 +3836,12 @@ namespace internal
 
             new_vertices[8] = next_unused_vertex;
 
-            // if this quad lives
-            // in 2d, then we can
-            // compute the new
-            // central vertex
-            // location just from
-            // the surrounding
-            // ones. If this is
-            // not the case, then
-            // we need to ask a
-            // boundary object
-            if (dim == spacedim)
-              {
-                // triangulation.vertices[next_unused_vertex] = new_point;
-                triangulation.vertices[next_unused_vertex] = cell->center(true);
-
-                // if the user_flag is set, i.e. if the
-                // cell is at the boundary, use a
-                // different calculation of the middle
-                // vertex here. this is of advantage, if
-                // the boundary is strongly curved and
-                // the cell has a high aspect ratio. this
-                // can happen for example, if it was
-                // refined anisotropically before.
-                if (cell->user_flag_set())
-                  {
-                    // first reset the user_flag
-                    cell->clear_user_flag();
-                    // the user flag indicates: at least
-                    // one face is at the boundary. if it
-                    // is only one, set the new middle
-                    // vertex in a different way to avoid
-                    // some mis-shaped elements if the
-                    // new point on the boundary is not
-                    // where we expect it, especially if
-                    // it is to far inside the current
-                    // cell
-                    unsigned int boundary_face=GeometryInfo<dim>::faces_per_cell;
-                    for (unsigned int face=0; face<GeometryInfo<dim>::faces_per_cell; ++face)
-                      if (cell->face(face)->at_boundary())
-                        {
-                          if (boundary_face == GeometryInfo<dim>::faces_per_cell)
-                            // no boundary face found so
-                            // far, so set it now
-                            boundary_face=face;
-                          else
-                            // there is another boundary
-                            // face, so reset boundary_face to
-                            // invalid value as a flag to
-                            // do nothing in the following
-                            boundary_face=GeometryInfo<dim>::faces_per_cell+1;
-                        }
-
-                    if (boundary_face<GeometryInfo<dim>::faces_per_cell)
-                      // reset the cell's middle vertex to the middle
-                      // of the straight connection between the new
-                      // points on this face and on the opposite face,
-                      // as returned by the underlying manifold
-                      // object.
-                      {
-                        std::vector<Point<spacedim> > ps(2);
-                        std::vector<double> ws(2, 0.5);
-                        ps[0] = cell->face(boundary_face)
-                                ->child(0)->vertex(1);
-                        ps[1] = cell->face(GeometryInfo<dim>
-                                           ::opposite_face[boundary_face])
-                                ->child(0)->vertex(1);
-                        Quadrature<spacedim> qs(ps,ws);
-                        triangulation.vertices[next_unused_vertex]
-                          = cell->get_manifold().get_new_point(qs);
-                      }
-                  }
-              }
-            else
-              {
-                // if this quad lives in a higher dimensional space
-                // then we don't need to worry if it is at the
-                // boundary of the manifold -- we always have to use
-                // the boundary object anyway; so ignore whether the
-                // user flag is set or not
-                cell->clear_user_flag();
-
-                // An assert to make sure that the static_cast in the
-                // next line has the chance to give reasonable
-                // results.
-                Assert(cell->material_id()<= std::numeric_limits<types::material_id>::max(),
-                       ExcIndexRange(cell->material_id(),0,std::numeric_limits<types::material_id>::max()));
-
-                // new vertex is placed on the surface according to
-                // the information stored in the boundary class
-                triangulation.vertices[next_unused_vertex] =
-                  cell->center(true);
-              }
+            // the location of the new central vertex has been computed
+            // before any cell was refined. clear the user flag that
+            // indicated that the cell is at the boundary
+            cell->clear_user_flag();
+            triangulation.vertices[next_unused_vertex] = *next_new_center;
+            ++next_new_center;
           }
 
 
@@ -4164,6 +4085,222 @@ namespace internal
 
 
 
+      /**
+       * Compute the locations of the new vertices at the midpoints of the
+       * lines in the range <tt>[begin,end)</tt> of @p new_midpoints. Each
+       * entry holds a line that has just been refined and the index of the
+       * vertex that has been allocated for its midpoint. The location of a
+       * midpoint only depends on the line itself and its manifold, so
+       * different ranges can be worked on concurrently.
+       */
+      template <int dim, int spacedim>
+      static
+      void
+      compute_line_midpoints (Triangulation<dim,spacedim> &triangulation,
+                              const std::vector<std::pair<typename Triangulation<dim,spacedim>::line_iterator,unsigned int> > &new_midpoints,
+                              const unsigned int begin,
+                              const unsigned int end)
+      {
+        for (unsigned int i=begin; i<end; ++i)
+          {
+            const typename Triangulation<dim,spacedim>::line_iterator
+            &line = new_midpoints[i].first;
+            Point<spacedim> &vertex = triangulation.vertices[new_midpoints[i].second];
+
+            // for the case of a domain in an equal-dimensional space we
+            // can just ask the line for its center. however, if
+            // spacedim>dim, we have to ask the boundary object we stored
+            // in line->user_index() before unless a manifold_id has been
+            // set on this very line.
+            if (spacedim == dim ||
+                line->manifold_id() != numbers::invalid_manifold_id)
+              vertex = line->center(true);
+            else
+              vertex = triangulation.get_manifold(line->user_index())
+                       .get_new_point_on_line (line);
+          }
+      }
+
+
+
+      /**
+       * Compute the locations of the midpoints of all lines in @p
+       * new_midpoints, see compute_line_midpoints(), in parallel. Asking
+       * the manifolds for new points is the most expensive part of
+       * refining lines, but it does not depend on the order in which lines
+       * are refined, so the result is the same as the one of computing the
+       * points one after the other.
+       */
+      template <int dim, int spacedim>
+      static
+      void
+      compute_line_midpoints (Triangulation<dim,spacedim> &triangulation,
+                              const std::vector<std::pair<typename Triangulation<dim,spacedim>::line_iterator,unsigned int> > &new_midpoints)
+      {
+        void (*fun_ptr) (Triangulation<dim,spacedim> &,
+                         const std::vector<std::pair<typename Triangulation<dim,spacedim>::line_iterator,unsigned int> > &,
+                         const unsigned int,
+                         const unsigned int)
+          = &compute_line_midpoints<dim,spacedim>;
+        parallel::apply_to_subranges (0U,
+                                      static_cast<unsigned int>(new_midpoints.size()),
+                                      std_cxx11::bind (fun_ptr,
+                                                       std_cxx11::ref(triangulation),
+                                                       std_cxx11::cref(new_midpoints),
+                                                       std_cxx11::_1,
+                                                       std_cxx11::_2),
+                                      64);
+      }
+
+
+
+      /**
+       * Return the location of the new vertex at the center of a cell in 2d
+       * that is refined isotropically. The lines of the cell must already
+       * have been refined.
+       */
+      template <int spacedim>
+      static
+      Point<spacedim>
+      compute_new_center (const TriaIterator<dealii::CellAccessor<2,spacedim> > &cell)
+      {
+        const unsigned int dim = 2;
+
+        // if this quad lives in a higher dimensional space then we don't
+        // need to worry if it is at the boundary of the manifold -- we
+        // always have to use the boundary object anyway
+        if (dim != spacedim)
+          return cell->center(true);
+
+        // if the cell is at the boundary with only one of its faces, set
+        // the new middle vertex in a different way to avoid some
+        // mis-shaped elements if the new point on the boundary is not where
+        // we expect it, especially if it is to far inside the current
+        // cell. this is of advantage, if the boundary is strongly curved
+        // and the cell has a high aspect ratio. this can happen for
+        // example, if it was refined anisotropically before.
+        if (cell->at_boundary())
+          {
+            unsigned int boundary_face=GeometryInfo<dim>::faces_per_cell;
+            for (unsigned int face=0; face<GeometryInfo<dim>::faces_per_cell; ++face)
+              if (cell->face(face)->at_boundary())
+                {
+                  if (boundary_face == GeometryInfo<dim>::faces_per_cell)
+                    // no boundary face found so far, so set it now
+                    boundary_face=face;
+                  else
+                    // there is another boundary face, so reset
+                    // boundary_face to invalid value as a flag to do
+                    // nothing in the following
+                    boundary_face=GeometryInfo<dim>::faces_per_cell+1;
+                }
+
+            if (boundary_face<GeometryInfo<dim>::faces_per_cell)
+              // place the cell's middle vertex at the middle of the
+              // straight connection between the new points on this face
+              // and on the opposite face, as returned by the underlying
+              // manifold object.
+              {
+                std::vector<Point<spacedim> > ps(2);
+                std::vector<double> ws(2, 0.5);
+                ps[0] = cell->face(boundary_face)
+                        ->child(0)->vertex(1);
+                ps[1] = cell->face(GeometryInfo<dim>
+                                   ::opposite_face[boundary_face])
+                        ->child(0)->vertex(1);
+                Quadrature<spacedim> qs(ps,ws);
+                return cell->get_manifold().get_new_point(qs);
+              }
+          }
+
+        return cell->center(true);
+      }
+
+
+
+      /**
+       * Return the location of the new vertex at the center of a hex that
+       * is refined isotropically. The lines and quads of the hex must
+       * already have been refined.
+       */
+      template <int spacedim>
+      static
+      Point<spacedim>
+      compute_new_center (const TriaIterator<dealii::CellAccessor<3,spacedim> > &hex)
+      {
+        // the new vertex is definitely in the interior, so we need not
+        // worry about the boundary. However we need to worry about
+        // Manifolds. Let the cell compute its own center, by querying the
+        // underlying manifold object.
+        return hex->center(true, true);
+      }
+
+
+
+      /**
+       * Compute the locations of the new vertices at the centers of the
+       * cells in the range <tt>[begin,end)</tt> of @p cells with
+       * compute_new_center() and store them in @p new_centers. As for the
+       * midpoints of lines, different ranges can be worked on concurrently.
+       */
+      template <int dim, int spacedim>
+      static
+      void
+      compute_cell_centers (const std::vector<typename Triangulation<dim,spacedim>::cell_iterator> &cells,
+                            std::vector<Point<spacedim> > &new_centers,
+                            const unsigned int begin,
+                            const unsigned int end)
+      {
+        for (unsigned int i=begin; i<end; ++i)
+          new_centers[i] = compute_new_center (cells[i]);
+      }
+
+
+
+      /**
+       * Compute the locations of the new vertices at the centers of all
+       * cells on levels below the finest one that are flagged for
+       * refinement with @p ref_case, in the order in which
+       * execute_refinement() creates their children. This is done in
+       * parallel before any cell is refined. The locations only depend on
+       * the cell, its manifold and the new vertices on its lines and faces,
+       * which have all been created at this point, so the result is the
+       * same as the one of computing the points while refining the cells
+       * one after the other.
+       */
+      template <int dim, int spacedim>
+      static
+      void
+      compute_cell_centers (const Triangulation<dim,spacedim> &triangulation,
+                            const RefinementCase<dim>          ref_case,
+                            std::vector<Point<spacedim> >     &new_centers)
+      {
+        std::vector<typename Triangulation<dim,spacedim>::cell_iterator> cells;
+        for (unsigned int level=0; level+1<triangulation.levels.size(); ++level)
+          for (typename Triangulation<dim,spacedim>::active_cell_iterator
+               cell = triangulation.begin_active(level);
+               cell != triangulation.begin_active(level+1); ++cell)
+            if (cell->refine_flag_set() == ref_case)
+              cells.push_back (cell);
+
+        new_centers.resize (cells.size());
+        void (*fun_ptr) (const std::vector<typename Triangulation<dim,spacedim>::cell_iterator> &,
+                         std::vector<Point<spacedim> > &,
+                         const unsigned int,
+                         const unsigned int)
+          = &compute_cell_centers<dim,spacedim>;
+        parallel::apply_to_subranges (0U,
+                                      static_cast<unsigned int>(cells.size()),
+                                      std_cxx11::bind (fun_ptr,
+                                                       std_cxx11::cref(cells),
+                                                       std_cxx11::ref(new_centers),
+                                                       std_cxx11::_1,
+                                                       std_cxx11::_2),
+                                      32);
+      }
+
+
+
       /**
        * A function that performs the
        * refinement of a triangulation in 1d.
@@ -4602,6 +4739,11 @@ namespace internal
             typename Triangulation<dim,spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line ();
 
+            // the locations of the new vertices are computed after all
+            // lines have been refined, see below
+            std::vector<std::pair<typename Triangulation<dim,spacedim>::line_iterator,unsigned int> >
+            new_midpoints;
+
             for (; line!=endl; ++line)
               if (line->user_flag_set())
                 {
@@ -4615,32 +4757,10 @@ namespace internal
                           ExcMessage("Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                   triangulation.vertices_used[next_unused_vertex] = true;
 
-                  if (spacedim == dim)
-                    {
-                      // for the case of a domain in an
-                      // equal-dimensional space we only have to treat
-                      // boundary lines differently; for interior
-                      // lines we can compute the midpoint as the mean
-                      // of the two vertices: if (line->at_boundary())
-                      triangulation.vertices[next_unused_vertex]
-                        = line->center(true);
-                    }
-                  else
-                    // however, if spacedim>dim, we always have to ask
-                    // the boundary object for its answer. We use the
-                    // same object of the cell (which was stored in
-                    // line->user_index() before) unless a manifold_id
-                    // has been set on this very line.
-                    if (line->manifold_id() == numbers::invalid_manifold_id)
-                      triangulation.vertices[next_unused_vertex]
-                        = triangulation.get_manifold(line->user_index()).get_new_point_on_line (line);
-                    else
-                      triangulation.vertices[next_unused_vertex]
-                        = line->center(true);
+                  new_midpoints.push_back (std::make_pair (line, next_unused_vertex));
 
-                  // now that we created the right point, make up the
-                  // two child lines.  To this end, find a pair of
-                  // unused lines
+                  // now make up the two child lines. To this end, find
+                  // a pair of unused lines
                   bool pair_found=false;
                   (void)pair_found;
                   for (; next_unused_line!=endl; ++next_unused_line)
@@ -4696,6 +4816,11 @@ namespace internal
                   // refinement
                   line->clear_user_flag ();
                 }
+
+            // now create the new points at the midpoints of the refined
+            // lines. they are not needed before the refinement of cells
+            // below
+            compute_line_midpoints (triangulation, new_midpoints);
           }
 
 
@@ -4714,6 +4839,15 @@ namespace internal
         typename Triangulation<dim,spacedim>::raw_line_iterator
         next_unused_line = triangulation.begin_raw_line ();
 
+        // compute the locations of the new vertices at the centers of the
+        // cells that are refined isotropically, now that the lines have
+        // been refined
+        std::vector<Point<spacedim> > new_centers;
+        compute_cell_centers (triangulation, RefinementCase<dim>(RefinementCase<dim>::cut_xy),
+                              new_centers);
+        typename std::vector<Point<spacedim> >::const_iterator
+        next_new_center = new_centers.begin();
+
         for (int level=0; level<static_cast<int>(triangulation.levels.size())-1; ++level)
           {
 
@@ -4744,6 +4878,7 @@ namespace internal
                                    next_unused_vertex,
                                    next_unused_line,
                                    next_unused_cell,
+                                   next_new_center,
                                    cell);
 
                   if ((check_for_distorted_cells == true)
@@ -4756,6 +4891,7 @@ namespace internal
                   triangulation.signals.post_refinement_on_cell(cell);
                 }
           }
+        Assert (next_new_center == new_centers.end(), ExcInternalError());
 
         return cells_with_distorted_children;
       }
@@ -5070,6 +5206,11 @@ namespace internal
             typename Triangulation<dim,spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line ();
 
+            // the locations of the new vertices are computed after all
+            // lines have been refined, see below
+            std::vector<std::pair<typename Triangulation<dim,spacedim>::line_iterator,unsigned int> >
+            new_midpoints;
+
             for (; line!=endl; ++line)
               if (line->user_flag_set())
                 {
@@ -5083,12 +5224,10 @@ namespace internal
                           ExcMessage("Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                   triangulation.vertices_used[next_unused_vertex] = true;
 
-                  triangulation.vertices[next_unused_vertex]
-                    = line->center(true);
+                  new_midpoints.push_back (std::make_pair (line, next_unused_vertex));
 
-                  // now that we created the right point, make up the
-                  // two child lines (++ takes care of the end of the
-                  // vector)
+                  // now make up the two child lines (++ takes care of
+                  // the end of the vector)
                   next_unused_line=triangulation.faces->lines.next_free_pair_object(triangulation);
                   Assert(next_unused_line.state() == IteratorState::valid,
                          ExcInternalError());
@@ -5136,6 +5275,11 @@ namespace internal
                   // for refinement
                   line->clear_user_flag ();
                 }
+
+            // now create the new points at the midpoints of the refined
+            // lines. they are not needed before the refinement of quads
+            // below
+            compute_line_midpoints (triangulation, new_midpoints);
           }
 
 
@@ -5907,6 +6051,15 @@ namespace internal
         typename Triangulation<3,spacedim>::DistortedCellList
         cells_with_distorted_children;
 
+        // compute the locations of the new vertices at the centers of the
+        // hexes that are refined isotropically, now that the lines and
+        // quads have been refined
+        std::vector<Point<spacedim> > new_centers;
+        compute_cell_centers (triangulation, RefinementCase<dim>(RefinementCase<dim>::cut_xyz),
+                              new_centers);
+        typename std::vector<Point<spacedim> >::const_iterator
+        next_new_center = new_centers.begin();
+
         for (unsigned int level=0; level!=triangulation.levels.size()-1; ++level)
           {
             // only active objects can be refined further; remember
@@ -7803,14 +7956,11 @@ namespace internal
                               ExcMessage("Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                       triangulation.vertices_used[next_unused_vertex] = true;
 
-                      // the new vertex is definitely in the interior,
-                      // so we need not worry about the
-                      // boundary. However we need to worry about
-                      // Manifolds. Let the cell compute its own
-                      // center, by querying the underlying manifold
-                      // object.
-                      triangulation.vertices[next_unused_vertex] =
-                        hex->center(true, true);
+                      // the location of the new vertex has been
+                      // computed before any hex was refined, see
+                      // compute_cell_centers()
+                      triangulation.vertices[next_unused_vertex] = *next_new_center;
+                      ++next_new_center;
 
                       // set the data of the six lines.  first collect
                       // the indices of the seven vertices (consider
@@ -8371,6 +8521,7 @@ namespace internal
                   triangulation.signals.post_refinement_on_cell(hex);
                 }
           }
+        Assert (next_new_center == new_centers.end(), ExcInternalError());
 
         // clear user data on quads. we used some of this data to
         // indicate anisotropic refinemnt cases on faces. all data
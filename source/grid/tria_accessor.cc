@@ -1477,7 +1477,7 @@ CellAccessor<dim, spacedim>::set_subdomain_id (const types::subdomain_id new_sub
   Assert (this->used(), TriaAccessorExceptions::ExcCellNotUsed());
   Assert (this->active(),
           ExcMessage("set_subdomain_id() can only be called on active cells!"));
-  this->tria->levels[this->present_level]->subdomain_ids[this->present_index]
+  this->tria->levels[this->present_level]->cell_properties[this->present_index].subdomain_id
     = new_subdomain_id;
 }
 
@@ -1535,7 +1535,7 @@ CellAccessor<dim, spacedim>::set_active_cell_index (const unsigned int active_ce
 {
   // set the active cell index. allow setting it also for non-active (and unused)
   // cells to allow resetting the index after refinement
-  this->tria->levels[this->present_level]->active_cell_indices[this->present_index]
+  this->tria->levels[this->present_level]->cell_properties[this->present_index].active_cell_index
     = active_cell_index;
 }
 
@@ -1574,7 +1574,7 @@ CellAccessor<dim, spacedim>::
 active_cell_index () const
 {
   Assert (this->has_children()==false, TriaAccessorExceptions::ExcCellNotActive());
-  return this->tria->levels[this->present_level]->active_cell_indices[this->present_index];
+  return this->tria->levels[this->present_level]->cell_properties[this->present_index].active_cell_index;
 }
 
 
@@ -35,27 +35,14 @@ namespace internal
       //
       // note that all arrays should have equal sizes (checked by
       // @p{monitor_memory}
-      if (total_cells > refine_flags.size())
+      if (total_cells > cell_properties.size())
         {
-          refine_flags.reserve (total_cells);
-          refine_flags.insert (refine_flags.end(),
-                               total_cells - refine_flags.size(),
-                               RefinementCase<dim>::no_refinement);
-
-          coarsen_flags.reserve (total_cells);
-          coarsen_flags.insert (coarsen_flags.end(),
-                                total_cells - coarsen_flags.size(),
-                                false);
-
-          active_cell_indices.reserve (total_cells);
-          active_cell_indices.insert (active_cell_indices.end(),
-                                      total_cells - active_cell_indices.size(),
-                                      numbers::invalid_unsigned_int);
-
-          subdomain_ids.reserve (total_cells);
-          subdomain_ids.insert (subdomain_ids.end(),
-                                total_cells - subdomain_ids.size(),
-                                0);
+          // the default constructed object has no refinement flag, no
+          // coarsening flag, an invalid active cell index and subdomain id 0
+          cell_properties.reserve (total_cells);
+          cell_properties.insert (cell_properties.end(),
+                                  total_cells - cell_properties.size(),
+                                  CellProperties());
 
           level_subdomain_ids.reserve (total_cells);
           level_subdomain_ids.insert (level_subdomain_ids.end(),
@@ -90,10 +77,8 @@ namespace internal
     TriaLevel<dim>::monitor_memory (const unsigned int true_dimension) const
     {
       (void)true_dimension;
-      Assert (2*true_dimension*refine_flags.size() == neighbors.size(),
-              ExcMemoryInexact (refine_flags.size(), neighbors.size()));
-      Assert (2*true_dimension*coarsen_flags.size() == neighbors.size(),
-              ExcMemoryInexact (coarsen_flags.size(), neighbors.size()));
+      Assert (2*true_dimension*cell_properties.size() == neighbors.size(),
+              ExcMemoryInexact (cell_properties.size(), neighbors.size()));
     }
 
 
@@ -101,11 +86,9 @@ namespace internal
     std::size_t
     TriaLevel<dim>::memory_consumption () const
     {
-      return (MemoryConsumption::memory_consumption (refine_flags) +
-              MemoryConsumption::memory_consumption (coarsen_flags) +
-              MemoryConsumption::memory_consumption (active_cell_indices) +
+      return (sizeof(cell_properties) +
+              cell_properties.capacity() * sizeof(CellProperties) +
               MemoryConsumption::memory_consumption (neighbors) +
-              MemoryConsumption::memory_consumption (subdomain_ids) +
               MemoryConsumption::memory_consumption (level_subdomain_ids) +
               MemoryConsumption::memory_consumption (parents) +
               MemoryConsumption::memory_consumption (direction_flags) +
@@ -127,27 +110,14 @@ namespace internal
       //
       // note that all arrays should have equal
       // sizes (checked by @p{monitor_memory}
-      if (total_cells > refine_flags.size())
+      if (total_cells > cell_properties.size())
         {
-          refine_flags.reserve (total_cells);
-          refine_flags.insert (refine_flags.end(),
-                               total_cells - refine_flags.size(),
-                               RefinementCase<3>::no_refinement);
-
-          coarsen_flags.reserve (total_cells);
-          coarsen_flags.insert (coarsen_flags.end(),
-                                total_cells - coarsen_flags.size(),
-                                false);
-
-          active_cell_indices.reserve (total_cells);
-          active_cell_indices.insert (active_cell_indices.end(),
-                                      total_cells - active_cell_indices.size(),
-                                      numbers::invalid_unsigned_int);
-
-          subdomain_ids.reserve (total_cells);
-          subdomain_ids.insert (subdomain_ids.end(),
-                                total_cells - subdomain_ids.size(),
-                                0);
+          // the default constructed object has no refinement flag, no
+          // coarsening flag, an invalid active cell index and subdomain id 0
+          cell_properties.reserve (total_cells);
+          cell_properties.insert (cell_properties.end(),
+                                  total_cells - cell_properties.size(),
+                                  CellProperties());
 
           level_subdomain_ids.reserve (total_cells);
           level_subdomain_ids.insert (level_subdomain_ids.end(),
@@ -181,21 +151,17 @@ namespace internal
     TriaLevel<3>::monitor_memory (const unsigned int true_dimension) const
     {
       (void)true_dimension;
-      Assert (2*true_dimension*refine_flags.size() == neighbors.size(),
-              ExcMemoryInexact (refine_flags.size(), neighbors.size()));
-      Assert (2*true_dimension*coarsen_flags.size() == neighbors.size(),
-              ExcMemoryInexact (coarsen_flags.size(), neighbors.size()));
+      Assert (2*true_dimension*cell_properties.size() == neighbors.size(),
+              ExcMemoryInexact (cell_properties.size(), neighbors.size()));
     }
 
 
     std::size_t
     TriaLevel<3>::memory_consumption () const
     {
-      return (MemoryConsumption::memory_consumption (refine_flags) +
-              MemoryConsumption::memory_consumption (coarsen_flags) +
-              MemoryConsumption::memory_consumption (active_cell_indices) +
+      return (sizeof(cell_properties) +
+              cell_properties.capacity() * sizeof(CellProperties) +
               MemoryConsumption::memory_consumption (neighbors) +
-              MemoryConsumption::memory_consumption (subdomain_ids) +
               MemoryConsumption::memory_consumption (parents) +
               MemoryConsumption::memory_consumption (direction_flags) +
               MemoryConsumption::memory_consumption (cells));
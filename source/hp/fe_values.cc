@@ -15,6 +15,7 @@
 
 #include <deal.II/hp/fe_values.h>
 #include <deal.II/fe/mapping_q1.h>
+#include <deal.II/base/thread_management.h>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -66,6 +67,72 @@ namespace internal
 
 
 
+    template <int dim, int q_dim, class FEValuesType>
+    FEValuesBase<dim,q_dim,FEValuesType>::FEValuesBase
+    (const FEValuesBase<dim,q_dim,FEValuesType> &other)
+      :
+      fe_collection (other.fe_collection),
+      mapping_collection (other.mapping_collection),
+      q_collection (other.q_collection),
+      fe_values_table (other.fe_values_table.size(0),
+                       other.fe_values_table.size(1),
+                       other.fe_values_table.size(2)),
+      present_fe_values_index (numbers::invalid_unsigned_int,
+                               numbers::invalid_unsigned_int,
+                               numbers::invalid_unsigned_int),
+      update_flags (other.update_flags)
+    {
+      // create new objects for all the ones the other object has, rather
+      // than sharing them
+      Threads::TaskGroup<> tasks;
+      for (unsigned int fe_index=0; fe_index<fe_values_table.size(0); ++fe_index)
+        for (unsigned int mapping_index=0; mapping_index<fe_values_table.size(1); ++mapping_index)
+          for (unsigned int q_index=0; q_index<fe_values_table.size(2); ++q_index)
+            {
+              const TableIndices<3> index (fe_index, mapping_index, q_index);
+              if (other.fe_values_table(index).get() != 0)
+                tasks += Threads::new_task (&FEValuesBase<dim,q_dim,FEValuesType>::create_fe_values,
+                                            *this, index);
+            }
+      tasks.join_all ();
+    }
+
+
+
+    template <int dim, int q_dim, class FEValuesType>
+    void
+    FEValuesBase<dim,q_dim,FEValuesType>::precalculate_fe_values ()
+    {
+      Threads::TaskGroup<> tasks;
+      for (unsigned int fe_index=0; fe_index<fe_values_table.size(0); ++fe_index)
+        for (unsigned int mapping_index=0; mapping_index<fe_values_table.size(1); ++mapping_index)
+          for (unsigned int q_index=0; q_index<fe_values_table.size(2); ++q_index)
+            {
+              const TableIndices<3> index (fe_index, mapping_index, q_index);
+              if (fe_values_table(index).get() == 0)
+                tasks += Threads::new_task (&FEValuesBase<dim,q_dim,FEValuesType>::create_fe_values,
+                                            *this, index);
+            }
+      tasks.join_all ();
+    }
+
+
+
+    template <int dim, int q_dim, class FEValuesType>
+    void
+    FEValuesBase<dim,q_dim,FEValuesType>::create_fe_values (const TableIndices<3> index)
+    {
+      fe_values_table(index)
+        =
+          std_cxx11::shared_ptr<FEValuesType>
+          (new FEValuesType ((*mapping_collection)[index[1]],
+                             (*fe_collection)[index[0]],
+                             q_collection[index[2]],
+                             update_flags));
+    }
+
+
+
     template <int dim, int q_dim, class FEValuesType>
     FEValuesType &
     FEValuesBase<dim,q_dim,FEValuesType>::select_fe_values
@@ -92,13 +159,7 @@ namespace internal
       // this particular combination
       // of indices
       if (fe_values_table(present_fe_values_index).get() == 0)
-        fe_values_table(present_fe_values_index)
-          =
-            std_cxx11::shared_ptr<FEValuesType>
-            (new FEValuesType ((*mapping_collection)[mapping_index],
-                               (*fe_collection)[fe_index],
-                               q_collection[q_index],
-                               update_flags));
+        create_fe_values (present_fe_values_index);
 
       // now there definitely is one!
       return *fe_values_table(present_fe_values_index);
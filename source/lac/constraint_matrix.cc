@@ -17,7 +17,10 @@
 #include <deal.II/lac/constraint_matrix.templates.h>
 
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/std_cxx11/bind.h>
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_entry_recorder.h>
 #include <deal.II/lac/block_vector.h>
 #include <deal.II/lac/block_sparse_matrix.h>
 #include <deal.II/lac/sparse_matrix_ez.h>
@@ -157,6 +160,40 @@ ConstraintMatrix::add_entries
 
 
 
+bool
+ConstraintMatrix::add_constraint
+(const size_type                                  line,
+ const std::vector<std::pair<size_type,double> > &col_val_pairs,
+ const double                                     inhomogeneity)
+{
+  Assert (sorted==false, ExcMatrixIsClosed());
+
+  if (is_constrained(line))
+    return false;
+
+#ifdef DEBUG
+  for (size_type i=0; i<col_val_pairs.size(); ++i)
+    {
+      Assert (line != col_val_pairs[i].first,
+              ExcMessage ("Can't constrain a degree of freedom to itself"));
+      Assert (!local_lines.size() || local_lines.is_element(col_val_pairs[i].first),
+              ExcColumnNotStoredHere(line, col_val_pairs[i].first));
+      for (size_type j=0; j<i; ++j)
+        Assert (col_val_pairs[j].first != col_val_pairs[i].first,
+                ExcMessage ("The column indices of a constraint need to be unique."));
+    }
+#endif
+
+  add_line (line);
+  ConstraintLine &new_line = lines.back();
+  Assert (new_line.line == line, ExcInternalError());
+  new_line.entries.assign (col_val_pairs.begin(), col_val_pairs.end());
+  new_line.inhomogeneity = inhomogeneity;
+  return true;
+}
+
+
+
 void ConstraintMatrix::add_selected_constraints
 (const ConstraintMatrix &constraints,
  const IndexSet         &filter)
@@ -182,196 +219,81 @@ void ConstraintMatrix::add_selected_constraints
 
 
 
-void ConstraintMatrix::close ()
+ConstraintMatrix::size_type
+ConstraintMatrix::find_chained_line (const size_type index) const
 {
-  if (sorted == true)
-    return;
-
-  // sort the lines
-  std::sort (lines.begin(), lines.end());
-
-  // update list of pointers and give the vector a sharp size since we
-  // won't modify the size any more after this point.
-  {
-    std::vector<size_type> new_lines (lines_cache.size(),
-                                      numbers::invalid_size_type);
-    size_type counter = 0;
-    for (std::vector<ConstraintLine>::const_iterator line=lines.begin();
-         line!=lines.end(); ++line, ++counter)
-      new_lines[calculate_line_index(line->line)] = counter;
-    std::swap (lines_cache, new_lines);
-  }
-
-  // in debug mode: check whether we really set the pointers correctly.
-  for (size_type i=0; i<lines_cache.size(); ++i)
-    if (lines_cache[i] != numbers::invalid_size_type)
-      Assert (i == calculate_line_index(lines[lines_cache[i]].line),
-              ExcInternalError());
-
-  // first, strip zero entries, as we have to do that only once
-  for (std::vector<ConstraintLine>::iterator line = lines.begin();
-       line!=lines.end(); ++line)
-    // first remove zero entries. that would mean that in the linear
-    // constraint for a node, x_i = ax_1 + bx_2 + ..., another node times 0
-    // appears. obviously, 0*something can be omitted
-    line->entries.erase (std::remove_if (line->entries.begin(),
-                                         line->entries.end(),
-                                         &check_zero_weight),
-                         line->entries.end());
-
+  if (((local_lines.size() == 0)
+       ||
+       (local_lines.is_element(index)))
+      &&
+      is_constrained (index))
+    return lines_cache[calculate_line_index(index)];
+  else
+    return numbers::invalid_size_type;
+}
 
 
-#ifdef DEBUG
-  // In debug mode we are computing an estimate for the maximum number
-  // of constraints so that we can bail out if there is a cycle in the
-  // constraints (which is easier than searching for cycles in the graph).
-  //
-  // Let us figure out the largest dof index. This is an upper bound for the
-  // number of constraints because it is an approximation for the number of dofs
-  // in our system.
-  size_type largest_idx = 0;
-  for (std::vector<ConstraintLine>::iterator line = lines.begin();
-       line!=lines.end(); ++line)
-    {
-      for (ConstraintLine::Entries::iterator it = line->entries.begin(); it!=line->entries.end(); ++it)
-        {
-          largest_idx=std::max(largest_idx, it->first);
-        }
-    }
-#endif
 
-  // replace references to dofs that are themselves constrained. note that
-  // because we may replace references to other dofs that may themselves be
-  // constrained to third ones, we have to iterate over all this until we
-  // replace no chains of constraints any more
-  //
-  // the iteration replaces references to constrained degrees of freedom by
-  // second-order references. for example if x3=x0/2+x2/2 and x2=x0/2+x1/2,
-  // then the new list will be x3=x0/2+x0/4+x1/4. note that x0 appear
-  // twice. we will throw this duplicate out in the following step, where
-  // we sort the list so that throwing out duplicates becomes much more
-  // efficient. also, we have to do it only once, rather than in each
-  // iteration
-  size_type iteration = 0;
-  while (true)
+void ConstraintMatrix::close_lines (const std::vector<size_type> &line_order,
+                                    const size_type               begin,
+                                    const size_type               end)
+{
+  ConstraintLine::Entries new_entries;
+  for (size_type l=begin; l<end; ++l)
     {
-      bool chained_constraint_replaced = false;
+      ConstraintLine *line = &lines[line_order[l]];
+
+      // replace references to dofs that are themselves constrained. the
+      // lines of these dofs have already been resolved, so a single
+      // replacement suffices. for example if x3=x0/2+x2/2 and x2=x0/2+x1/2,
+      // then the new list will be x3=x0/2+x0/4+x1/4. note that x0 appears
+      // twice. we throw out this duplicate in the following step, where we
+      // sort the list so that throwing out duplicates becomes much more
+      // efficient
+      bool has_chained_entries = false;
+      for (size_type i=0; i<line->entries.size(); ++i)
+        if (find_chained_line (line->entries[i].first) != numbers::invalid_size_type)
+          {
+            has_chained_entries = true;
+            break;
+          }
 
-      for (std::vector<ConstraintLine>::iterator line = lines.begin();
-           line!=lines.end(); ++line)
+      if (has_chained_entries == true)
         {
-#ifdef DEBUG
-          // we need to keep track of how many replacements we do in this line, because we can
-          // end up in a cycle A->B->C->A without the number of entries growing.
-          size_type n_replacements = 0;
-#endif
-
-          // loop over all entries of this line (including ones that we
-          // have appended in this go around) and see whether they are
-          // further constrained. ignore elements that we don't store on
-          // the current processor
-          size_type entry = 0;
-          while (entry < line->entries.size())
-            if (((local_lines.size() == 0)
-                 ||
-                 (local_lines.is_element(line->entries[entry].first)))
-                &&
-                is_constrained (line->entries[entry].first))
-              {
-                // ok, this entry is further constrained:
-                chained_constraint_replaced = true;
-
-                // look up the chain of constraints for this entry
-                const size_type  dof_index = line->entries[entry].first;
-                const double     weight = line->entries[entry].second;
-
-                Assert (dof_index != line->line,
-                        ExcMessage ("Cycle in constraints detected!"));
-
-                const ConstraintLine *constrained_line =
-                  &lines[lines_cache[calculate_line_index(dof_index)]];
-                Assert (constrained_line->line == dof_index,
-                        ExcInternalError());
-
-                // now we have to replace an entry by its expansion. we do
-                // that by overwriting the entry by the first entry of the
-                // expansion and adding the remaining ones to the end,
-                // where we will later process them once more
-                //
-                // we can of course only do that if the DoF that we are
-                // currently handle is constrained by a linear combination
-                // of other dofs:
-                if (constrained_line->entries.size() > 0)
-                  {
-                    for (size_type i=0; i<constrained_line->entries.size(); ++i)
-                      Assert (dof_index != constrained_line->entries[i].first,
-                              ExcMessage ("Cycle in constraints detected!"));
-
-                    // replace first entry, then tack the rest to the end
-                    // of the list
-                    line->entries[entry] =
-                      std::make_pair (constrained_line->entries[0].first,
-                                      constrained_line->entries[0].second *
-                                      weight);
-
-                    for (size_type i=1; i<constrained_line->entries.size(); ++i)
-                      line->entries
-                      .push_back (std::make_pair (constrained_line->entries[i].first,
-                                                  constrained_line->entries[i].second *
-                                                  weight));
-
-#ifdef DEBUG
-                    // keep track of how many entries we replace in this
-                    // line. If we do more than there are constraints or
-                    // dofs in our system, we must have a cycle.
-                    ++n_replacements;
-                    Assert(n_replacements/2<largest_idx, ExcMessage("Cycle in constraints detected!"));
-                    if (n_replacements/2>=largest_idx)
-                      return; // this enables us to test for this Exception.
-#endif
-                  }
-                else
-                  // the DoF that we encountered is not constrained by a
-                  // linear combination of other dofs but is equal to just
-                  // the inhomogeneity (i.e. its chain of entries is
-                  // empty). in that case, we can't just overwrite the
-                  // current entry, but we have to actually eliminate it
-                  {
-                    line->entries.erase (line->entries.begin()+entry);
-                  }
+          new_entries.clear ();
+          for (size_type i=0; i<line->entries.size(); ++i)
+            {
+              const size_type chained_line =
+                find_chained_line (line->entries[i].first);
+              if (chained_line == numbers::invalid_size_type)
+                new_entries.push_back (line->entries[i]);
+              else
+                {
+                  // replace the entry by the expansion of the line it
+                  // refers to. if that dof is only equal to an
+                  // inhomogeneity, its list of entries is empty and the
+                  // entry simply disappears
+                  const ConstraintLine &constrained_line = lines[chained_line];
+                  Assert (constrained_line.line == line->entries[i].first,
+                          ExcInternalError());
 
-                line->inhomogeneity += constrained_line->inhomogeneity *
-                                       weight;
+                  const double weight = line->entries[i].second;
+                  for (size_type j=0; j<constrained_line.entries.size(); ++j)
+                    new_entries.push_back (std::make_pair (constrained_line.entries[j].first,
+                                                           constrained_line.entries[j].second *
+                                                           weight));
 
-                // now that we're here, do not increase index by one but
-                // rather make another pass for the present entry because
-                // we have replaced the present entry by another one, or
-                // because we have deleted it and shifted all following
-                // ones one forward
-              }
-            else
-              // entry not further constrained. just move ahead by one
-              ++entry;
+                  line->inhomogeneity += constrained_line.inhomogeneity *
+                                         weight;
+                }
+            }
+          line->entries = new_entries;
         }
 
-      // if we didn't do anything in this round, then quit the loop
-      if (chained_constraint_replaced == false)
-        break;
-
-      // increase iteration count. note that we should not iterate more
-      // times than there are constraints, since this puts a natural upper
-      // bound on the length of constraint chains
-      ++iteration;
-      Assert (iteration <= lines.size(), ExcInternalError());
-    }
-
-  // finally sort the entries and re-scale them if necessary. in this step,
-  // we also throw out duplicates as mentioned above. moreover, as some
-  // entries might have had zero weights, we replace them by a vector with
-  // sharp sizes.
-  for (std::vector<ConstraintLine>::iterator line = lines.begin();
-       line!=lines.end(); ++line)
-    {
+      // now sort the entries and re-scale them if necessary. in this step,
+      // we also throw out duplicates as mentioned above. moreover, as some
+      // entries might have had zero weights, we replace them by a vector
+      // with sharp sizes.
       std::sort (line->entries.begin(), line->entries.end());
 
       // loop over the now sorted list and see whether any of the entries
@@ -385,44 +307,44 @@ void ConstraintMatrix::close ()
 
       if (duplicates > 0 || line->entries.size() < line->entries.capacity())
         {
-          ConstraintLine::Entries new_entries;
+          ConstraintLine::Entries compressed_entries;
 
           // if we have no duplicates, copy verbatim the entries. this way,
           // the final size is of the vector is correct.
           if (duplicates == 0)
-            new_entries = line->entries;
+            compressed_entries = line->entries;
           else
             {
               // otherwise, we need to go through the list by and and
               // resolve the duplicates
-              new_entries.reserve (line->entries.size() - duplicates);
-              new_entries.push_back(line->entries[0]);
+              compressed_entries.reserve (line->entries.size() - duplicates);
+              compressed_entries.push_back(line->entries[0]);
               for (size_type j=1; j<line->entries.size(); ++j)
                 if (line->entries[j].first == line->entries[j-1].first)
                   {
-                    Assert (new_entries.back().first == line->entries[j].first,
+                    Assert (compressed_entries.back().first == line->entries[j].first,
                             ExcInternalError());
-                    new_entries.back().second += line->entries[j].second;
+                    compressed_entries.back().second += line->entries[j].second;
                   }
                 else
-                  new_entries.push_back (line->entries[j]);
+                  compressed_entries.push_back (line->entries[j]);
 
-              Assert (new_entries.size() == line->entries.size() - duplicates,
+              Assert (compressed_entries.size() == line->entries.size() - duplicates,
                       ExcInternalError());
 
               // make sure there are really no duplicates left and that the
               // list is still sorted
-              for (size_type j=1; j<new_entries.size(); ++j)
+              for (size_type j=1; j<compressed_entries.size(); ++j)
                 {
-                  Assert (new_entries[j].first != new_entries[j-1].first,
+                  Assert (compressed_entries[j].first != compressed_entries[j-1].first,
                           ExcInternalError());
-                  Assert (new_entries[j].first > new_entries[j-1].first,
+                  Assert (compressed_entries[j].first > compressed_entries[j-1].first,
                           ExcInternalError());
                 }
             }
 
           // replace old list of constraints for this dof by the new one
-          line->entries.swap (new_entries);
+          line->entries.swap (compressed_entries);
         }
 
       // finally do the following check: if the sum of weights for the
@@ -444,7 +366,229 @@ void ConstraintMatrix::close ()
             line->entries[i].second /= sum;
           line->inhomogeneity /= sum;
         }
-    } // end of loop over all constraint lines
+    }
+}
+
+
+
+namespace
+{
+  // remove entries with zero weight from the given range of constraint
+  // lines. in the linear constraint for a node, x_i = ax_1 + bx_2 + ...,
+  // another node times 0 may appear. obviously, 0*something can be omitted
+  // the lines treated are the ones whose positions in the lines array are
+  // given by the elements begin to end of line_positions
+  template <typename LineType, typename Predicate>
+  void strip_zero_entries (std::vector<LineType>                    &lines,
+                           const std::vector<types::global_dof_index> &line_positions,
+                           const Predicate                           is_zero_entry,
+                           const types::global_dof_index             begin,
+                           const types::global_dof_index             end)
+  {
+    for (types::global_dof_index i=begin; i<end; ++i)
+      {
+        LineType &line = lines[line_positions[i]];
+        line.entries.erase (std::remove_if (line.entries.begin(),
+                                            line.entries.end(),
+                                            is_zero_entry),
+                            line.entries.end());
+      }
+  }
+}
+
+
+
+void ConstraintMatrix::close ()
+{
+  if (sorted == true)
+    return;
+
+  do_close (0);
+}
+
+
+
+void ConstraintMatrix::do_close (const std::vector<size_type> *changed_lines)
+{
+
+  // sort the lines. if the object had been closed before and more lines were
+  // appended afterwards (for example by merge()), then the leading part of
+  // the array is still sorted and we only need to sort the new lines and
+  // merge the two sorted ranges
+  {
+    std::vector<ConstraintLine>::iterator sorted_end = lines.begin();
+    if (sorted_end != lines.end())
+      for (++sorted_end; sorted_end!=lines.end(); ++sorted_end)
+        if (*sorted_end < *(sorted_end-1))
+          break;
+    std::sort (sorted_end, lines.end());
+    std::inplace_merge (lines.begin(), sorted_end, lines.end());
+  }
+
+  // update list of pointers and give the vector a sharp size since we
+  // won't modify the size any more after this point.
+  {
+    std::vector<size_type> new_lines (lines_cache.size(),
+                                      numbers::invalid_size_type);
+    size_type counter = 0;
+    for (std::vector<ConstraintLine>::const_iterator line=lines.begin();
+         line!=lines.end(); ++line, ++counter)
+      new_lines[calculate_line_index(line->line)] = counter;
+    std::swap (lines_cache, new_lines);
+  }
+
+  // in debug mode: check whether we really set the pointers correctly.
+  for (size_type i=0; i<lines_cache.size(); ++i)
+    if (lines_cache[i] != numbers::invalid_size_type)
+      Assert (i == calculate_line_index(lines[lines_cache[i]].line),
+              ExcInternalError());
+
+  // the following steps work on the lines in parallel and query
+  // local_lines concurrently, which is only safe on a compressed index set
+  local_lines.compress ();
+
+  // find the positions of the lines we have to work on: all of them, or
+  // only the changed ones. the other lines are already resolved
+  std::vector<size_type> line_positions;
+  if (changed_lines == 0)
+    {
+      line_positions.resize (lines.size());
+      for (size_type l=0; l<lines.size(); ++l)
+        line_positions[l] = l;
+    }
+  else
+    {
+      line_positions.reserve (changed_lines->size());
+      for (size_type i=0; i<changed_lines->size(); ++i)
+        line_positions.push_back (lines_cache[calculate_line_index((*changed_lines)[i])]);
+      std::sort (line_positions.begin(), line_positions.end());
+      line_positions.erase (std::unique (line_positions.begin(), line_positions.end()),
+                            line_positions.end());
+    }
+
+  // first, strip zero entries, as we have to do that only once
+  parallel::apply_to_subranges (size_type(0), line_positions.size(),
+                                std_cxx11::bind (&strip_zero_entries<ConstraintLine,
+                                                 bool (*)(const std::pair<size_type,double> &)>,
+                                                 std_cxx11::ref(lines),
+                                                 std_cxx11::cref(line_positions),
+                                                 &check_zero_weight,
+                                                 std_cxx11::_1,
+                                                 std_cxx11::_2),
+                                256);
+
+  // next compute for each line the length of the longest chain of
+  // constraints that starts at it, using a depth-first search through the
+  // graph in which each line is connected to the lines of the constrained
+  // dofs it refers to. lines that refer to no constrained dofs have depth
+  // zero. a line we reach again while still looking at its dependencies
+  // indicates a cycle in the constraints, which we can not resolve. lines
+  // we do not work on are resolved already and have depth zero
+  const unsigned int not_visited = numbers::invalid_unsigned_int;
+  const unsigned int in_progress = numbers::invalid_unsigned_int - 1;
+  std::vector<unsigned int> depth (lines.size(),
+                                   changed_lines == 0 ? not_visited : 0U);
+  for (size_type i=0; i<line_positions.size(); ++i)
+    depth[line_positions[i]] = not_visited;
+  unsigned int max_depth = 0;
+  {
+    std::vector<std::pair<size_type,size_type> > stack;
+    for (size_type i=0; i<line_positions.size(); ++i)
+      if (depth[line_positions[i]] == not_visited)
+        {
+          const size_type l = line_positions[i];
+          depth[l] = in_progress;
+          stack.push_back (std::make_pair (l, size_type(0)));
+          while (stack.empty() == false)
+            {
+              const ConstraintLine &line = lines[stack.back().first];
+
+              // find the next entry that refers to a line whose depth is
+              // not yet known
+              size_type entry = stack.back().second;
+              size_type next_line = numbers::invalid_size_type;
+              for (; entry<line.entries.size(); ++entry)
+                {
+                  const size_type chained_line =
+                    find_chained_line (line.entries[entry].first);
+                  if ((chained_line != numbers::invalid_size_type)
+                      &&
+                      (depth[chained_line] >= in_progress))
+                    {
+                      AssertThrow (depth[chained_line] != in_progress,
+                                   ExcMessage("Cycle in constraints detected!"));
+                      next_line = chained_line;
+                      break;
+                    }
+                }
+
+              if (next_line != numbers::invalid_size_type)
+                {
+                  stack.back().second = entry;
+                  depth[next_line] = in_progress;
+                  stack.push_back (std::make_pair (next_line, size_type(0)));
+                }
+              else
+                {
+                  // all lines this line depends on are known, so we can
+                  // compute its depth
+                  unsigned int line_depth = 0;
+                  for (size_type i=0; i<line.entries.size(); ++i)
+                    {
+                      const size_type chained_line =
+                        find_chained_line (line.entries[i].first);
+                      if (chained_line != numbers::invalid_size_type)
+                        line_depth = std::max (line_depth, depth[chained_line]+1);
+                    }
+                  depth[stack.back().first] = line_depth;
+                  max_depth = std::max (max_depth, line_depth);
+                  stack.pop_back ();
+                }
+            }
+        }
+  }
+
+  // sort the lines by their depth. lines of the same depth only refer to
+  // lines of smaller depth, so we can treat all lines of one depth in
+  // parallel once the lines of smaller depth are done. lines that had
+  // already been resolved in a previous call to this function have depth
+  // zero and are not expanded again
+  std::vector<size_type> depth_start (max_depth+2, 0);
+  for (size_type i=0; i<line_positions.size(); ++i)
+    ++depth_start[depth[line_positions[i]]+1];
+  for (unsigned int d=0; d<=max_depth; ++d)
+    depth_start[d+1] += depth_start[d];
+
+  std::vector<size_type> line_order (line_positions.size());
+  {
+    std::vector<size_type> next_position (depth_start.begin(),
+                                          depth_start.end()-1);
+    for (size_type i=0; i<line_positions.size(); ++i)
+      line_order[next_position[depth[line_positions[i]]]++] = line_positions[i];
+  }
+
+  for (unsigned int d=0; d<=max_depth; ++d)
+    parallel::apply_to_subranges (depth_start[d], depth_start[d+1],
+                                  std_cxx11::bind (&ConstraintMatrix::close_lines,
+                                                   this,
+                                                   std_cxx11::cref(line_order),
+                                                   std_cxx11::_1,
+                                                   std_cxx11::_2),
+                                  64);
+
+  // store the entries of all lines contiguously for the functions that
+  // apply the constraints
+  closed_entry_offsets.resize (lines.size()+1);
+  closed_entry_offsets[0] = 0;
+  for (size_type l=0; l<lines.size(); ++l)
+    closed_entry_offsets[l+1] = closed_entry_offsets[l] + lines[l].entries.size();
+  {
+    ConstraintLine::Entries tmp;
+    tmp.reserve (closed_entry_offsets.back());
+    for (size_type l=0; l<lines.size(); ++l)
+      tmp.insert (tmp.end(), lines[l].entries.begin(), lines[l].entries.end());
+    closed_entries.swap (tmp);
+  }
 
 #ifdef DEBUG
   // if in debug mode: check that no dof is constrained to another dof that
@@ -494,10 +638,15 @@ ConstraintMatrix::merge (const ConstraintMatrix &other_constraints,
   //
   // for this, loop over all constraints and replace the constraint lines
   // with a new one where constraints are replaced if necessary.
+  //
+  // remember the lines we change or add, so that we only need to close
+  // these if the object was closed before
+  std::vector<size_type> changed_lines;
   ConstraintLine::Entries tmp;
   for (std::vector<ConstraintLine>::iterator line=lines.begin();
        line!=lines.end(); ++line)
     {
+      bool line_changed = false;
       tmp.clear ();
       for (size_type i=0; i<line->entries.size(); ++i)
         {
@@ -530,10 +679,13 @@ ConstraintMatrix::merge (const ConstraintMatrix &other_constraints,
 
               line->inhomogeneity += other_constraints.get_inhomogeneity(line->entries[i].first) *
                                      weight;
+              line_changed = true;
             }
         }
       // finally exchange old and newly resolved line
       line->entries.swap (tmp);
+      if (line_changed)
+        changed_lines.push_back (line->line);
     }
 
 
@@ -543,7 +695,10 @@ ConstraintMatrix::merge (const ConstraintMatrix &other_constraints,
        line=other_constraints.lines.begin();
        line!=other_constraints.lines.end(); ++line)
     if (is_constrained(line->line) == false)
-      lines.push_back (*line);
+      {
+        lines.push_back (*line);
+        changed_lines.push_back (line->line);
+      }
     else
       {
         // the constrained dof we want to copy from the other object is
@@ -566,6 +721,7 @@ ConstraintMatrix::merge (const ConstraintMatrix &other_constraints,
               = line->entries;
             lines[lines_cache[calculate_line_index(line->line)]].inhomogeneity
               = line->inhomogeneity;
+            changed_lines.push_back (line->line);
             break;
 
           default:
@@ -580,9 +736,12 @@ ConstraintMatrix::merge (const ConstraintMatrix &other_constraints,
     lines_cache[calculate_line_index(line->line)] = counter;
 
   // if the object was sorted before, then make sure it is so afterward as
-  // well. otherwise leave everything in the unsorted state
+  // well. otherwise leave everything in the unsorted state. the lines we
+  // did not touch only refer to dofs that are not constrained in either
+  // object, so they are still resolved and only the changed lines need to
+  // be closed
   if (object_was_sorted == true)
-    close ();
+    do_close (&changed_lines);
 }
 
 
@@ -604,6 +763,11 @@ void ConstraintMatrix::shift (const size_type offset)
            j != i->entries.end(); ++j)
         j->first += offset;
     }
+
+  for (ConstraintLine::Entries::iterator
+       j = closed_entries.begin();
+       j != closed_entries.end(); ++j)
+    j->first += offset;
 }
 
 
@@ -620,6 +784,16 @@ void ConstraintMatrix::clear ()
     lines_cache.swap (tmp);
   }
 
+  {
+    std::vector<size_type> tmp;
+    closed_entry_offsets.swap (tmp);
+  }
+
+  {
+    ConstraintLine::Entries tmp;
+    closed_entries.swap (tmp);
+  }
+
   sorted = false;
 }
 
@@ -1175,6 +1349,8 @@ ConstraintMatrix::memory_consumption () const
   return (MemoryConsumption::memory_consumption (lines) +
           MemoryConsumption::memory_consumption (lines_cache) +
           MemoryConsumption::memory_consumption (sorted) +
+          MemoryConsumption::memory_consumption (closed_entry_offsets) +
+          MemoryConsumption::memory_consumption (closed_entries) +
           MemoryConsumption::memory_consumption (local_lines));
 }
 
@@ -1293,6 +1469,20 @@ MATRIX_FUNCTIONS(SparseMatrix<std::complex<double> >);
 MATRIX_FUNCTIONS(SparseMatrix<std::complex<long double> >);
 MATRIX_FUNCTIONS(SparseMatrix<std::complex<float> >);
 
+#define BATCH_MATRIX_VECTOR_FUNCTIONS(MatrixType, VectorType) \
+  template void ConstraintMatrix:: \
+  distribute_local_to_global<MatrixType,VectorType > (const std::vector<FullMatrix<MatrixType::value_type> > &, \
+                                                      const std::vector<Vector<VectorType::value_type> >     &, \
+                                                      const std::vector<std::vector<ConstraintMatrix::size_type> > &, \
+                                                      MatrixType                      &, \
+                                                      VectorType                      &, \
+                                                      bool                             ) const
+
+BATCH_MATRIX_VECTOR_FUNCTIONS(SparseMatrix<double>, Vector<double>);
+BATCH_MATRIX_VECTOR_FUNCTIONS(SparseMatrix<float>,  Vector<float>);
+BATCH_MATRIX_VECTOR_FUNCTIONS(BlockSparseMatrix<double>, BlockVector<double>);
+BATCH_MATRIX_VECTOR_FUNCTIONS(BlockSparseMatrix<float>,  BlockVector<float>);
+
 BLOCK_MATRIX_FUNCTIONS(BlockSparseMatrix<double>);
 BLOCK_MATRIX_FUNCTIONS(BlockSparseMatrix<float>);
 BLOCK_MATRIX_VECTOR_FUNCTIONS(BlockSparseMatrix<double>, BlockVector<double>);
@@ -1356,6 +1546,7 @@ BLOCK_MATRIX_VECTOR_FUNCTIONS(TrilinosWrappers::BlockSparseMatrix, TrilinosWrapp
 
 SPARSITY_FUNCTIONS(SparsityPattern);
 SPARSITY_FUNCTIONS(DynamicSparsityPattern);
+SPARSITY_FUNCTIONS(internals::SparsityEntryRecorder);
 BLOCK_SPARSITY_FUNCTIONS(BlockSparsityPattern);
 BLOCK_SPARSITY_FUNCTIONS(BlockDynamicSparsityPattern);
 
@@ -0,0 +1,147 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// IndexSet uses lookup tables for sets with many ranges. check
+// is_element(), index_within_set() and nth_index_in_set() against a list
+// of the elements for sets with few and with many ranges, also after the
+// set has been changed or loaded from an archive
+
+#include "../tests.h"
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include <deal.II/base/index_set.h>
+
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/text_iarchive.hpp>
+
+
+// add the indices [begin,end) to both the index set and the list of
+// flags that tells which indices are in the set
+void add_range (const IndexSet::size_type begin,
+                const IndexSet::size_type end,
+                IndexSet                 &is,
+                std::vector<bool>        &in_set)
+{
+  is.add_range (begin, end);
+  for (IndexSet::size_type i=begin; i<end; ++i)
+    in_set[i] = true;
+}
+
+
+
+bool check (const IndexSet          &is,
+            const std::vector<bool> &in_set)
+{
+  is.compress ();
+
+  std::vector<IndexSet::size_type> elements;
+  for (IndexSet::size_type i=0; i<in_set.size(); ++i)
+    {
+      if (is.is_element(i) != in_set[i])
+        return false;
+      if (in_set[i])
+        elements.push_back (i);
+    }
+
+  if (is.n_elements() != elements.size())
+    return false;
+
+  for (unsigned int n=0; n<elements.size(); ++n)
+    if (is.nth_index_in_set(n) != elements[n]
+        ||
+        is.index_within_set(elements[n]) != n)
+      return false;
+
+  return true;
+}
+
+
+
+void test ()
+{
+  const IndexSet::size_type size = 100000;
+  IndexSet is (size);
+  std::vector<bool> in_set (size, false);
+
+  // few ranges: one large one and some single indices
+  add_range (40000, 60000, is, in_set);
+  add_range (7, 8, is, in_set);
+  add_range (99999, 100000, is, in_set);
+  deallog << "Few ranges, " << is.n_intervals() << " intervals: "
+          << check (is, in_set) << std::endl;
+
+  // many ranges of different lengths scattered over the index space, in
+  // particular at the ends of buckets
+  for (unsigned int i=0; i<500; ++i)
+    {
+      const IndexSet::size_type begin = Testing::rand() % size;
+      const IndexSet::size_type end = std::min (size,
+                                                begin + 1 + Testing::rand() % 20);
+      add_range (begin, end, is, in_set);
+    }
+  for (IndexSet::size_type i=1024; i<size; i+=1024)
+    add_range (i-1, i, is, in_set);
+  deallog << "Many ranges, " << is.n_intervals() << " intervals: "
+          << check (is, in_set) << std::endl;
+
+  // merge the ranges into fewer ones and check that the lookup tables are
+  // recomputed
+  add_range (0, 50000, is, in_set);
+  deallog << "Merged ranges: " << check (is, in_set) << std::endl;
+
+  // a copy has the same lookup tables
+  const IndexSet copy (is);
+  deallog << "Copy: " << check (copy, in_set) << std::endl;
+
+  // a set loaded from an archive rebuilds the lookup tables, which are not
+  // stored in the archive
+  std::ostringstream oss;
+  {
+    boost::archive::text_oarchive oa (oss, boost::archive::no_header);
+    oa << is;
+  }
+  IndexSet loaded;
+  {
+    std::istringstream iss (oss.str());
+    boost::archive::text_iarchive ia (iss, boost::archive::no_header);
+    ia >> loaded;
+  }
+  deallog << "Loaded: " << check (loaded, in_set) << std::endl;
+
+  // an empty set
+  is.clear ();
+  std::fill (in_set.begin(), in_set.end(), false);
+  deallog << "Cleared: " << check (is, in_set) << std::endl;
+
+  // only many small ranges without a dominating one
+  for (IndexSet::size_type i=0; i<size; i+=100)
+    add_range (i, i+1+i%7, is, in_set);
+  deallog << "Only small ranges: " << check (is, in_set) << std::endl;
+}
+
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.threshold_double(1.e-10);
+
+  test ();
+}
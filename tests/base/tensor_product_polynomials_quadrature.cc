@@ -0,0 +1,110 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check Quadrature::is_tensor_product() for a number of quadrature formulas
+// and that TensorProductPolynomials::compute() on a tensor product
+// quadrature formula gives the same results as evaluating point by point
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/tensor_product_polynomials.h>
+
+#include <vector>
+#include <fstream>
+
+
+template <int dim>
+void check_quadrature (const Quadrature<dim> &quadrature,
+                       const unsigned int     degree)
+{
+  TensorProductPolynomials<dim>
+  poly(Polynomials::LagrangeEquidistant::generate_complete_basis(degree));
+  const unsigned int n = poly.n();
+  const unsigned int n_q_points = quadrature.size();
+
+  Table<2,double> values (n, n_q_points);
+  Table<2,Tensor<1,dim> > grads (n, n_q_points);
+  Table<2,Tensor<2,dim> > grad_grads (n, n_q_points);
+  Table<2,Tensor<3,dim> > third_derivatives (n, n_q_points);
+  poly.compute (quadrature, values, grads, grad_grads, third_derivatives);
+
+  std::vector<double> values_p (n);
+  std::vector<Tensor<1,dim> > grads_p (n);
+  std::vector<Tensor<2,dim> > grad_grads_p (n);
+  std::vector<Tensor<3,dim> > third_derivatives_p (n);
+  std::vector<Tensor<4,dim> > fourth_derivatives_p;
+
+  double max_diff = 0;
+  for (unsigned int q=0; q<n_q_points; ++q)
+    {
+      poly.compute (quadrature.point(q), values_p, grads_p, grad_grads_p,
+                    third_derivatives_p, fourth_derivatives_p);
+      for (unsigned int i=0; i<n; ++i)
+        {
+          max_diff = std::max (max_diff, std::abs(values(i,q) - values_p[i]));
+          max_diff = std::max (max_diff, (grads(i,q) - grads_p[i]).norm());
+          max_diff = std::max (max_diff, (grad_grads(i,q) - grad_grads_p[i]).norm());
+          max_diff = std::max (max_diff, (third_derivatives(i,q) -
+                                          third_derivatives_p[i]).norm());
+        }
+    }
+  deallog << "degree " << degree << ", " << n_q_points
+          << " points: difference " << max_diff << std::endl;
+}
+
+
+
+template <int dim>
+void check ()
+{
+  deallog << "QGauss: " << QGauss<dim>(3).is_tensor_product() << std::endl;
+  deallog << "QGaussLobatto: " << QGaussLobatto<dim>(3).is_tensor_product() << std::endl;
+  deallog << "QIterated: " << QIterated<dim>(QTrapez<1>(), 3).is_tensor_product() << std::endl;
+  deallog << "QSorted: " << QSorted<dim>(QGauss<dim>(3)).is_tensor_product() << std::endl;
+  deallog << "Point list: "
+          << Quadrature<dim>(QGauss<dim>(3).get_points()).is_tensor_product()
+          << std::endl;
+
+  check_quadrature (Quadrature<dim>(QGauss<dim>(3)), 2);
+  check_quadrature (QGauss<dim>(5), 4);
+  check_quadrature (QGaussLobatto<dim>(4), 3);
+  check_quadrature (QIterated<dim>(QGauss<1>(2), 2), 3);
+}
+
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.threshold_double(1.e-10);
+
+  deallog.push("1d");
+  check<1>();
+  deallog.pop();
+  deallog.push("2d");
+  check<2>();
+  check_quadrature (QAnisotropic<2>(QGauss<1>(2), QGaussLobatto<1>(4)), 3);
+  deallog.pop();
+  deallog.push("3d");
+  check<3>();
+  check_quadrature (QAnisotropic<3>(QGauss<1>(2), QGaussLobatto<1>(4),
+                                    QGauss<1>(3)), 2);
+  deallog.pop();
+}
@@ -0,0 +1,132 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// time the setup of a large coarse mesh as it is done when reading a mesh
+// from a file: the cells of a structured mesh are rotated randomly and then
+// brought into a consistent orientation by GridReordering before the
+// triangulation is created. the number of cells per direction can be given
+// on the command line
+
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_reordering.h>
+
+#include <iostream>
+#include <cstdlib>
+
+
+using namespace dealii;
+
+
+// rotations of a hexahedron in the classic (ucd) numbering of vertices
+const unsigned int rotations[8][8] =
+{
+  {0,1,2,3,4,5,6,7},
+  {1,2,3,0,5,6,7,4},
+  {2,3,0,1,6,7,4,5},
+  {3,0,1,2,7,4,5,6},
+  {4,7,6,5,0,3,2,1},
+  {5,4,7,6,1,0,3,2},
+  {6,5,4,7,2,1,0,3},
+  {7,6,5,4,3,2,1,0}
+};
+
+
+void run (const unsigned int n)
+{
+  TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+
+  std::vector<Point<3> > vertices;
+  std::vector<CellData<3> > cells;
+
+  timer.enter_subsection ("create cell list");
+  vertices.reserve ((n+1)*(n+1)*(n+1));
+  for (unsigned int k=0; k<n+1; ++k)
+    for (unsigned int j=0; j<n+1; ++j)
+      for (unsigned int i=0; i<n+1; ++i)
+        vertices.push_back (Point<3>(1.*i/n, 1.*j/n, 1.*k/n));
+
+  cells.reserve (n*n*n);
+  for (unsigned int k=0; k<n; ++k)
+    for (unsigned int j=0; j<n; ++j)
+      for (unsigned int i=0; i<n; ++i)
+        {
+          unsigned int lex[8], ucd[8];
+          for (unsigned int v=0; v<8; ++v)
+            lex[v] = ((k + v/4) * (n+1) + j + (v/2)%2) * (n+1) + i + v%2;
+          for (unsigned int v=0; v<8; ++v)
+            ucd[v] = lex[GeometryInfo<3>::ucd_to_deal[v]];
+
+          CellData<3> cell;
+          const unsigned int rotation = std::rand() % 8;
+          for (unsigned int v=0; v<8; ++v)
+            cell.vertices[v] = ucd[rotations[rotation][v]];
+          cells.push_back (cell);
+        }
+  timer.leave_subsection ();
+
+  std::cout << "Number of coarse cells: " << cells.size() << std::endl;
+
+  timer.enter_subsection ("reorder cells");
+  GridReordering<3>::reorder_cells (cells);
+  timer.leave_subsection ();
+
+  timer.enter_subsection ("create triangulation");
+  Triangulation<3> tria;
+  tria.create_triangulation_compatibility (vertices, cells, SubCellData());
+  timer.leave_subsection ();
+}
+
+
+
+int main (int argc, char **argv)
+{
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization (argc, argv,
+                                                           numbers::invalid_unsigned_int);
+      const unsigned int n = (argc > 1 ? std::atoi (argv[1]) : 60);
+      run (n);
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
@@ -44,11 +44,14 @@
 #include <deal.II/hp/dof_handler.h>
 #include <deal.II/hp/fe_values.h>
 #include <deal.II/base/timer.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/lac/sparse_direct.h>
 
 #include <fstream>
 #include <iostream>
+#include <new>
+#include <cstdlib>
 
 // From the following include file we will import the declaration of
 // H1-conforming finite element shape functions. This family of finite
@@ -88,6 +91,84 @@
 using namespace dealii;
 
 
+// @sect3{Counting memory allocations}
+
+// The global operator new is replaced by one that counts the allocations
+// while <code>count_allocations</code> is set. Counting is only switched on
+// in a loop that runs on a single thread, see
+// Step6::check_allocations_hp().
+namespace
+{
+  bool               count_allocations = false;
+  unsigned long int  n_allocations     = 0;
+}
+
+
+void *operator new (std::size_t size)
+#ifndef DEAL_II_WITH_CXX11
+throw (std::bad_alloc)
+#endif
+{
+  if (count_allocations)
+    ++n_allocations;
+
+  void *p = std::malloc (size == 0 ? 1 : size);
+  if (p == 0)
+    throw std::bad_alloc();
+  return p;
+}
+
+
+void operator delete (void *p)
+#ifdef DEAL_II_WITH_CXX11
+noexcept
+#else
+throw ()
+#endif
+{
+  std::free (p);
+}
+
+
+// @sect3{Scratch and copy data for the threaded hp assembly}
+
+// The following two structures are used by the WorkStream based hp assembly
+// loop. WorkStream copies the scratch data once for every thread, which
+// copies the hp::FEValues object in it. If the original object has set up
+// all of its FEValues objects via precalculate_fe_values(), the copies are
+// fully set up as well and the assembly loop itself does not need to create
+// any FEValues objects any more. Otherwise, each thread creates them lazily
+// when it first encounters a cell with a given active_fe_index.
+template <int dim>
+struct HpScratchData
+{
+  HpScratchData (const hp::FECollection<dim> &fe_collection,
+                 const hp::QCollection<dim>  &q_collection,
+                 const bool                   precalculate)
+    :
+    hp_fe_values (fe_collection, q_collection,
+                  update_gradients | update_JxW_values)
+  {
+    if (precalculate)
+      hp_fe_values.precalculate_fe_values ();
+  }
+
+  HpScratchData (const HpScratchData &scratch_data)
+    :
+    hp_fe_values (scratch_data.hp_fe_values)
+  {}
+
+  hp::FEValues<dim>  hp_fe_values;
+  FullMatrix<double> cell_matrix;
+};
+
+
+struct HpCopyData
+{
+  double cell_matrix_norm;
+};
+
+
 // @sect3{The <code>Step6</code> class template}
 
 // The main class is again almost unchanged. Two additions, however, are made:
@@ -111,6 +192,12 @@ private:
   void setup_system_hp ();
   void assemble_system ();
   void assemble_system_hp ();
+  void assemble_system_hp_workstream (const bool precalculate);
+  void local_assemble_hp (const typename hp::DoFHandler<dim>::active_cell_iterator &cell,
+                          HpScratchData<dim> &scratch_data,
+                          HpCopyData         &copy_data);
+  void copy_local_hp (const HpCopyData &copy_data);
+  void check_allocations_hp ();
   void solve ();
   void refine_grid ();
   void output_results (const unsigned int cycle) const;
@@ -122,6 +209,13 @@ private:
   FE_Q<dim> fe;
   hp::FECollection<dim> hpfe;
 
+  // A collection of elements of different degrees, together with a DoF
+  // handler that uses all of them, for the threaded hp assembly
+  hp::FECollection<dim> hpfe_mixed;
+  hp::QCollection<dim>  hpq_mixed;
+  hp::DoFHandler<dim>   hpdof_handler_mixed;
+  double                hp_matrix_norm;
+
   // This is the new variable in the main class. We need an object which holds
   // a list of constraints to hold the hanging nodes and the boundary
   // conditions.
@@ -207,12 +301,19 @@ Step6<dim>::Step6 ()
   dof_handler (triangulation),
   hpdof_handler (triangulation),
   fe (3),
+  hpdof_handler_mixed (triangulation),
   computing_timer (std::cout,
                    TimerOutput::summary,
                    TimerOutput::wall_times)
 
 {
   hpfe.push_back (FE_Q<dim>(3));
+
+  for (unsigned int degree=1; degree<=4; ++degree)
+    {
+      hpfe_mixed.push_back (FE_Q<dim>(degree));
+      hpq_mixed.push_back (QGauss<dim>(degree+1));
+    }
 }
 
 
@@ -281,6 +382,7 @@ template <int dim>
 Step6<dim>::~Step6 ()
 {
   dof_handler.clear ();
+  hpdof_handler_mixed.clear ();
 }
 
 
@@ -315,6 +417,15 @@ void Step6<dim>::setup_system ()
   hpdof_handler.distribute_dofs (hpfe);
   computing_timer.exit_section ("distribute_hp");
 
+  // cycle through the elements of the mixed collection so that every thread
+  // sees all of them early on
+  unsigned int cell_no = 0;
+  for (typename hp::DoFHandler<dim>::active_cell_iterator
+       cell = hpdof_handler_mixed.begin_active();
+       cell != hpdof_handler_mixed.end(); ++cell, ++cell_no)
+    cell->set_active_fe_index (cell_no % hpfe_mixed.size());
+  hpdof_handler_mixed.distribute_dofs (hpfe_mixed);
+
   solution.reinit (dof_handler.n_dofs());
   system_rhs.reinit (dof_handler.n_dofs());
 
@@ -571,6 +682,99 @@ void Step6<dim>::assemble_system_hp ()
 
 
 
+// @sect4{Step6::assemble_system_hp_workstream}
+
+// Compute the cell matrices on the mesh with mixed polynomial degrees using
+// WorkStream. Only the norms of the cell matrices are collected, so that the
+// time spent is dominated by the setup and use of the FEValues objects, not
+// by writing into a global matrix. Calling this function with
+// <code>precalculate=true</code> creates all FEValues objects before the
+// loop starts, otherwise they are created lazily on each thread.
+template <int dim>
+void Step6<dim>::assemble_system_hp_workstream (const bool precalculate)
+{
+  hp_matrix_norm = 0;
+  WorkStream::run (hpdof_handler_mixed.begin_active(),
+                   hpdof_handler_mixed.end(),
+                   *this,
+                   &Step6<dim>::local_assemble_hp,
+                   &Step6<dim>::copy_local_hp,
+                   HpScratchData<dim> (hpfe_mixed, hpq_mixed, precalculate),
+                   HpCopyData());
+}
+
+
+
+template <int dim>
+void
+Step6<dim>::local_assemble_hp (const typename hp::DoFHandler<dim>::active_cell_iterator &cell,
+                               HpScratchData<dim> &scratch_data,
+                               HpCopyData         &copy_data)
+{
+  scratch_data.hp_fe_values.reinit (cell);
+  const FEValues<dim> &fe_values = scratch_data.hp_fe_values.get_present_fe_values ();
+
+  const unsigned int dofs_per_cell = cell->get_fe().dofs_per_cell;
+  FullMatrix<double> &cell_matrix = scratch_data.cell_matrix;
+  cell_matrix.reinit (dofs_per_cell, dofs_per_cell);
+
+  for (unsigned int q_point=0; q_point<fe_values.n_quadrature_points; ++q_point)
+    for (unsigned int i=0; i<dofs_per_cell; ++i)
+      for (unsigned int j=0; j<dofs_per_cell; ++j)
+        cell_matrix(i,j) += (fe_values.shape_grad(i,q_point) *
+                             fe_values.shape_grad(j,q_point) *
+                             fe_values.JxW(q_point));
+
+  copy_data.cell_matrix_norm = cell_matrix.frobenius_norm();
+}
+
+
+
+template <int dim>
+void
+Step6<dim>::copy_local_hp (const HpCopyData &copy_data)
+{
+  hp_matrix_norm += copy_data.cell_matrix_norm;
+}
+
+
+
+// @sect4{Step6::check_allocations_hp}
+
+// Check that the hp assembly loop does not allocate memory once it is warmed
+// up. As WorkStream::run() does for each thread, the scratch data is set up
+// with all FEValues objects created beforehand and then copied. After one
+// pass over all cells, in which each FEValues object sets up the storage for
+// its present cell and the cell matrix reaches its largest size, a second
+// pass must not allocate memory any more; in particular, it must not create
+// FEValues objects.
+template <int dim>
+void Step6<dim>::check_allocations_hp ()
+{
+  const HpScratchData<dim> precalculated_scratch_data (hpfe_mixed, hpq_mixed, true);
+  HpScratchData<dim> scratch_data (precalculated_scratch_data);
+  HpCopyData         copy_data;
+
+  const typename hp::DoFHandler<dim>::active_cell_iterator
+  endc = hpdof_handler_mixed.end();
+  for (typename hp::DoFHandler<dim>::active_cell_iterator
+       cell = hpdof_handler_mixed.begin_active(); cell != endc; ++cell)
+    local_assemble_hp (cell, scratch_data, copy_data);
+
+  n_allocations = 0;
+  count_allocations = true;
+  for (typename hp::DoFHandler<dim>::active_cell_iterator
+       cell = hpdof_handler_mixed.begin_active(); cell != endc; ++cell)
+    local_assemble_hp (cell, scratch_data, copy_data);
+  count_allocations = false;
+
+  std::cout << "   Allocations after warmup:     " << n_allocations
+            << std::endl;
+  AssertThrow (n_allocations == 0, ExcInternalError());
+}
+
+
+
 // @sect4{Step6::solve}
 
 // We continue with gradual improvements. The function that solves the linear
@@ -816,6 +1020,22 @@ void Step6<dim>::run ()
       assemble_system_hp ();
       computing_timer.exit_section ("assembly_hp");
 
+      std::cout << "assemble hp workstream" << std::endl;
+
+      computing_timer.enter_section ("assembly_hp_workstream_lazy");
+      assemble_system_hp_workstream (false);
+      computing_timer.exit_section ("assembly_hp_workstream_lazy");
+      const double lazy_norm = hp_matrix_norm;
+
+      computing_timer.enter_section ("assembly_hp_workstream_precalculated");
+      assemble_system_hp_workstream (true);
+      computing_timer.exit_section ("assembly_hp_workstream_precalculated");
+      std::cout << "   Sum of cell matrix norms:     "
+                << lazy_norm << " " << hp_matrix_norm
+                << std::endl;
+
+      check_allocations_hp ();
+
       std::cout << "solve" << std::endl;
 
       solve ();
@@ -0,0 +1,152 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// time the computation of the sparsity patterns of a continuous and a
+// discontinuous discretization on a locally refined mesh with hanging node
+// constraints, both into a DynamicSparsityPattern and into a
+// BlockDynamicSparsityPattern. the number of global refinement steps can be
+// given on the command line
+
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/lac/constraint_matrix.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/block_sparsity_pattern.h>
+
+#include <iostream>
+#include <cstdlib>
+
+
+using namespace dealii;
+
+
+template <int dim>
+void run (const unsigned int n_refinements,
+          const unsigned int degree)
+{
+  TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+
+  timer.enter_subsection ("setup");
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  tria.refine_global (n_refinements);
+
+  // refine the cells in one corner once more so that the mesh has hanging
+  // nodes
+  for (typename Triangulation<dim>::active_cell_iterator
+       cell = tria.begin_active(); cell != tria.end(); ++cell)
+    if (cell->center()[0] < 0.5)
+      cell->set_refine_flag ();
+  tria.execute_coarsening_and_refinement ();
+
+  FE_Q<dim>   fe_q (degree);
+  FE_DGQ<dim> fe_dgq (degree);
+  DoFHandler<dim> dof_q (tria), dof_dgq (tria);
+  dof_q.distribute_dofs (fe_q);
+  dof_dgq.distribute_dofs (fe_dgq);
+
+  ConstraintMatrix constraints;
+  DoFTools::make_hanging_node_constraints (dof_q, constraints);
+  constraints.close ();
+  timer.leave_subsection ();
+
+  std::cout << "Dimension:              " << dim << std::endl
+            << "Number of active cells: " << tria.n_active_cells() << std::endl
+            << "Number of FE_Q dofs:    " << dof_q.n_dofs() << std::endl
+            << "Number of FE_DGQ dofs:  " << dof_dgq.n_dofs() << std::endl;
+
+  timer.enter_subsection ("make sparsity pattern");
+  {
+    DynamicSparsityPattern dsp (dof_q.n_dofs(), dof_q.n_dofs());
+    DoFTools::make_sparsity_pattern (dof_q, dsp, constraints, false);
+    std::cout << "Sparsity pattern entries:       " << dsp.n_nonzero_elements()
+              << std::endl;
+  }
+  timer.leave_subsection ();
+
+  // split the degrees of freedom into two blocks, as a system with two
+  // variables would
+  timer.enter_subsection ("make block sparsity pattern");
+  {
+    const types::global_dof_index n_dofs = dof_q.n_dofs();
+    std::vector<types::global_dof_index> block_sizes (2);
+    block_sizes[0] = n_dofs / 2;
+    block_sizes[1] = n_dofs - block_sizes[0];
+    BlockDynamicSparsityPattern bdsp (block_sizes, block_sizes);
+    DoFTools::make_sparsity_pattern (dof_q, bdsp, constraints, false);
+    std::cout << "Block sparsity pattern entries: " << bdsp.n_nonzero_elements()
+              << std::endl;
+  }
+  timer.leave_subsection ();
+
+  timer.enter_subsection ("make flux sparsity pattern");
+  {
+    DynamicSparsityPattern dsp (dof_dgq.n_dofs(), dof_dgq.n_dofs());
+    DoFTools::make_flux_sparsity_pattern (dof_dgq, dsp);
+    std::cout << "Flux sparsity pattern entries:  " << dsp.n_nonzero_elements()
+              << std::endl;
+  }
+  timer.leave_subsection ();
+}
+
+
+
+int main (int argc, char **argv)
+{
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization (argc, argv);
+      const unsigned int n_refinements_2d = (argc > 1 ? std::atoi (argv[1]) : 8);
+      const unsigned int degree = (argc > 2 ? std::atoi (argv[2]) : 2);
+      run<2> (n_refinements_2d, degree);
+      run<3> ((n_refinements_2d*2)/3, degree);
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,175 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// time the loops over the cells of a locally refined mesh that are found in
+// most programs: iterating over all active cells and querying the data
+// stored per cell, visiting the neighbors of each cell, and setting and
+// reading refinement flags. each loop is repeated several times. the number
+// of global refinement steps can be given on the command line
+
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <iostream>
+#include <cstdlib>
+
+
+using namespace dealii;
+
+
+template <int dim>
+void run (const unsigned int n_refinements,
+          const unsigned int n_repetitions)
+{
+  TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+
+  timer.enter_subsection ("create mesh");
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  tria.refine_global (n_refinements);
+
+  // refine the cells in one corner once more so that the mesh has hanging
+  // nodes and cells that are not active on the finest levels
+  for (typename Triangulation<dim>::active_cell_iterator
+       cell = tria.begin_active(); cell != tria.end(); ++cell)
+    if (cell->center()[0] < 0.5)
+      cell->set_refine_flag ();
+  tria.execute_coarsening_and_refinement ();
+
+  // give the cells different subdomain ids, as a partitioner would
+  for (typename Triangulation<dim>::active_cell_iterator
+       cell = tria.begin_active(); cell != tria.end(); ++cell)
+    cell->set_subdomain_id (cell->active_cell_index() % 4);
+  timer.leave_subsection ();
+
+  std::cout << "Dimension:              " << dim << std::endl
+            << "Number of active cells: " << tria.n_active_cells() << std::endl
+            << "Number of cells:        " << tria.n_cells() << std::endl;
+
+  // loop over the active cells and read the data of each cell that loops in
+  // assembly functions typically ask for
+  timer.enter_subsection ("active cell loop");
+  unsigned long long int checksum = 0;
+  for (unsigned int r=0; r<n_repetitions; ++r)
+    for (typename Triangulation<dim>::active_cell_iterator
+         cell = tria.begin_active(); cell != tria.end(); ++cell)
+      if (cell->subdomain_id() == r % 4)
+        checksum += cell->active_cell_index() + cell->level();
+  timer.leave_subsection ();
+  std::cout << "Active cell loop checksum: " << checksum << std::endl;
+
+  // loop over all cells, including the ones that are not active
+  timer.enter_subsection ("cell loop");
+  checksum = 0;
+  for (unsigned int r=0; r<n_repetitions; ++r)
+    for (typename Triangulation<dim>::cell_iterator
+         cell = tria.begin(); cell != tria.end(); ++cell)
+      checksum += (cell->has_children() ? 1 : cell->subdomain_id());
+  timer.leave_subsection ();
+  std::cout << "Cell loop checksum:        " << checksum << std::endl;
+
+  // visit the neighbors of the active cells as in the assembly of face
+  // terms
+  timer.enter_subsection ("neighbor access");
+  checksum = 0;
+  for (unsigned int r=0; r<n_repetitions; ++r)
+    for (typename Triangulation<dim>::active_cell_iterator
+         cell = tria.begin_active(); cell != tria.end(); ++cell)
+      for (unsigned int f=0; f<GeometryInfo<dim>::faces_per_cell; ++f)
+        if (cell->at_boundary(f) == false)
+          {
+            const typename Triangulation<dim>::cell_iterator
+            neighbor = cell->neighbor(f);
+            if (neighbor->has_children() == false)
+              checksum += neighbor->active_cell_index();
+            else
+              checksum += neighbor->level();
+          }
+  timer.leave_subsection ();
+  std::cout << "Neighbor access checksum:  " << checksum << std::endl;
+
+  // set and clear refinement and coarsening flags as error estimators and
+  // the flag smoothing in Triangulation do
+  timer.enter_subsection ("refinement flags");
+  checksum = 0;
+  for (unsigned int r=0; r<n_repetitions; ++r)
+    {
+      for (typename Triangulation<dim>::active_cell_iterator
+           cell = tria.begin_active(); cell != tria.end(); ++cell)
+        if (cell->subdomain_id() == r % 4)
+          cell->set_refine_flag ();
+        else if (cell->level() > 0)
+          cell->set_coarsen_flag ();
+
+      for (typename Triangulation<dim>::active_cell_iterator
+           cell = tria.begin_active(); cell != tria.end(); ++cell)
+        {
+          if (cell->refine_flag_set())
+            ++checksum;
+          if (cell->coarsen_flag_set())
+            checksum += 2;
+          cell->clear_refine_flag ();
+          cell->clear_coarsen_flag ();
+        }
+    }
+  timer.leave_subsection ();
+  std::cout << "Refinement flags checksum: " << checksum << std::endl;
+}
+
+
+
+int main (int argc, char **argv)
+{
+  try
+    {
+      Utilities::MPI::MPI_InitFinalize mpi_initialization (argc, argv, 1);
+      const unsigned int n_refinements_2d = (argc > 1 ? std::atoi (argv[1]) : 10);
+      const unsigned int n_repetitions = (argc > 2 ? std::atoi (argv[2]) : 10);
+      run<2> (n_refinements_2d, n_repetitions);
+      run<3> ((2*n_refinements_2d)/3, n_repetitions);
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+  catch (...)
+    {
+      std::cerr << std::endl << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Unknown exception!" << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
@@ -1,2 +1,2 @@
 #!/bin/bash
-export TESTS="step-22 tablehandler test_assembly test_poisson test_hp"
+export TESTS="step-22 tablehandler test_assembly test_poisson test_hp test_coarse_mesh test_traversal test_sparsity"
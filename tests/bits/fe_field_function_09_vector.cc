@@ -0,0 +1,105 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that the list versions of FEFieldFunction, which evaluate points
+// grouped by cells in parallel, give the same result as evaluating the
+// points one by one, for points in random order on a different mesh
+
+#include "../tests.h"
+#include <fstream>
+
+#include <deal.II/numerics/fe_field_function.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/base/function_lib.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/numerics/vector_tools.h>
+
+
+template <int dim>
+void test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, -1, 1);
+  tria.refine_global(6/dim);
+
+  FESystem<dim> fe(FE_Q<dim>(2), 2);
+  DoFHandler<dim> dh(tria);
+  dh.distribute_dofs(fe);
+
+  Vector<double> v(dh.n_dofs());
+  VectorTools::interpolate(dh, Functions::CosineFunction<dim>(2), v);
+
+  Functions::FEFieldFunction<dim, DoFHandler<dim>, Vector<double> >
+  fef(dh, v);
+
+  std::vector<Point<dim> > points(500);
+  for (unsigned int i=0; i<points.size(); ++i)
+    for (unsigned int d=0; d<dim; ++d)
+      points[i][d] = 1.98 * Testing::rand() / RAND_MAX - 0.99;
+
+  std::vector<Vector<double> > values(points.size(), Vector<double>(2));
+  std::vector<std::vector<Tensor<1,dim> > >
+  gradients(points.size(), std::vector<Tensor<1,dim> >(2));
+  std::vector<Vector<double> > laplacians(points.size(), Vector<double>(2));
+  fef.vector_value_list(points, values);
+  fef.vector_gradient_list(points, gradients);
+  fef.vector_laplacian_list(points, laplacians);
+
+  double error = 0;
+  Vector<double> value(2), laplacian(2);
+  std::vector<Tensor<1,dim> > gradient(2);
+  for (unsigned int i=0; i<points.size(); ++i)
+    {
+      fef.vector_value(points[i], value);
+      fef.vector_gradient(points[i], gradient);
+      fef.vector_laplacian(points[i], laplacian);
+      for (unsigned int c=0; c<2; ++c)
+        {
+          error = std::max(error, std::abs(value[c] - values[i][c]));
+          error = std::max(error, (gradient[c] - gradients[i][c]).norm());
+          error = std::max(error, std::abs(laplacian[c] - laplacians[i][c]));
+        }
+    }
+  deallog << "Difference between list and single point evaluation: "
+          << error << std::endl;
+
+  std::vector<typename DoFHandler<dim>::active_cell_iterator> cells;
+  std::vector<std::vector<Point<dim> > > qpoints;
+  std::vector<std::vector<unsigned int> > maps;
+  const unsigned int n_cells = fef.compute_point_locations(points, cells, qpoints, maps);
+  unsigned int n_points = 0;
+  for (unsigned int c=0; c<n_cells; ++c)
+    n_points += maps[c].size();
+  deallog << "Points in cells: " << n_points << std::endl;
+}
+
+int main ()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.threshold_double(1.e-10);
+
+  test<1>();
+  test<2>();
+  test<3>();
+
+  return 0;
+}
@@ -0,0 +1,181 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check DoFTools::CellColoring: no two cells of one color may write into
+// the same rows, including through hanging node constraints, the coloring
+// is updated after refinement, and assembling with run() gives the same
+// matrix as a serial loop
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/std_cxx11/bind.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_tools.h>
+#include <deal.II/dofs/cell_coloring.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/lac/constraint_matrix.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+
+#include <fstream>
+#include <set>
+
+
+struct ScratchData
+{};
+
+
+struct CopyData
+{
+  FullMatrix<double>                   local_matrix;
+  std::vector<types::global_dof_index> local_dof_indices;
+};
+
+
+template <int dim>
+void assemble_on_cell (const typename DoFHandler<dim>::active_cell_iterator &cell,
+                       ScratchData &,
+                       CopyData    &copy_data)
+{
+  const unsigned int dofs_per_cell = cell->get_fe().dofs_per_cell;
+  copy_data.local_matrix.reinit (dofs_per_cell, dofs_per_cell);
+  copy_data.local_dof_indices.resize (dofs_per_cell);
+  for (unsigned int i=0; i<dofs_per_cell; ++i)
+    for (unsigned int j=0; j<dofs_per_cell; ++j)
+      copy_data.local_matrix(i,j) = 1. + (cell->active_cell_index() + 3*i + 7*j) % 5;
+  cell->get_dof_indices (copy_data.local_dof_indices);
+}
+
+
+void copy_local_to_global (const ConstraintMatrix &constraints,
+                           SparseMatrix<double>   &matrix,
+                           const CopyData         &copy_data)
+{
+  constraints.distribute_local_to_global (copy_data.local_matrix,
+                                          copy_data.local_dof_indices,
+                                          matrix);
+}
+
+
+template <int dim>
+void check_coloring (const DoFTools::CellColoring<DoFHandler<dim> > &coloring,
+                     const ConstraintMatrix                         &constraints)
+{
+  const std::vector<std::vector<typename DoFHandler<dim>::active_cell_iterator> >
+  &colors = coloring.get_coloring();
+
+  bool conflict_free = true;
+  unsigned int n_cells = 0;
+  std::set<unsigned int> colored_cells;
+  std::vector<types::global_dof_index> indices;
+  for (unsigned int c=0; c<colors.size(); ++c)
+    {
+      std::set<types::global_dof_index> rows;
+      for (unsigned int i=0; i<colors[c].size(); ++i)
+        {
+          indices.resize (colors[c][i]->get_fe().dofs_per_cell);
+          colors[c][i]->get_dof_indices (indices);
+          constraints.resolve_indices (indices);
+          for (unsigned int k=0; k<indices.size(); ++k)
+            if (rows.insert (indices[k]).second == false)
+              conflict_free = false;
+          colored_cells.insert (colors[c][i]->active_cell_index());
+          ++n_cells;
+        }
+    }
+  deallog << "Colors are conflict free: " << conflict_free << std::endl;
+  deallog << "All cells colored once: "
+          << (n_cells == coloring.get_dof_handler().get_triangulation().n_active_cells()
+              &&
+              colored_cells.size() == n_cells)
+          << std::endl;
+}
+
+
+template <int dim>
+void test ()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  tria.refine_global (2);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement ();
+
+  FE_Q<dim> fe (2);
+  DoFHandler<dim> dof_handler (tria);
+  dof_handler.distribute_dofs (fe);
+
+  ConstraintMatrix constraints;
+  DoFTools::make_hanging_node_constraints (dof_handler, constraints);
+  constraints.close ();
+
+  DoFTools::CellColoring<DoFHandler<dim> > coloring (dof_handler, constraints);
+  check_coloring (coloring, constraints);
+
+  DynamicSparsityPattern dsp (dof_handler.n_dofs(), dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern (dof_handler, dsp, constraints, false);
+  SparsityPattern sparsity;
+  sparsity.copy_from (dsp);
+  SparseMatrix<double> matrix (sparsity), reference (sparsity);
+
+  coloring.run (&assemble_on_cell<dim>,
+                std_cxx11::bind (&copy_local_to_global,
+                                 std_cxx11::cref(constraints),
+                                 std_cxx11::ref(matrix),
+                                 std_cxx11::_1),
+                ScratchData(), CopyData());
+
+  ScratchData scratch;
+  CopyData copy_data;
+  for (typename DoFHandler<dim>::active_cell_iterator
+       cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell)
+    {
+      assemble_on_cell<dim> (cell, scratch, copy_data);
+      copy_local_to_global (constraints, reference, copy_data);
+    }
+  reference.add (-1., matrix);
+  deallog << "Matrix difference: " << reference.frobenius_norm() << std::endl;
+
+  // refine and redistribute the dofs. the coloring needs to follow
+  tria.refine_global (1);
+  dof_handler.distribute_dofs (fe);
+  constraints.clear ();
+  DoFTools::make_hanging_node_constraints (dof_handler, constraints);
+  constraints.close ();
+  check_coloring (coloring, constraints);
+}
+
+
+int main ()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.threshold_double(1.e-10);
+
+  deallog.push ("2d");
+  test<2> ();
+  deallog.pop ();
+  deallog.push ("3d");
+  test<3> ();
+  deallog.pop ();
+}
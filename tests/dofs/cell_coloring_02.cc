@@ -0,0 +1,104 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that DoFTools::CellColoring recomputes the coloring when the
+// constraints change in a way that neither changes the number of
+// constraints nor the number of degrees of freedom
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/cell_coloring.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/lac/constraint_matrix.h>
+
+#include <fstream>
+#include <set>
+
+
+template <int dim>
+void check_coloring (const DoFTools::CellColoring<DoFHandler<dim> > &coloring,
+                     const ConstraintMatrix                         &constraints)
+{
+  const std::vector<std::vector<typename DoFHandler<dim>::active_cell_iterator> >
+  colors = coloring.get_coloring();
+
+  bool conflict_free = true;
+  std::vector<types::global_dof_index> indices;
+  for (unsigned int c=0; c<colors.size(); ++c)
+    {
+      std::set<types::global_dof_index> rows;
+      for (unsigned int i=0; i<colors[c].size(); ++i)
+        {
+          indices.resize (colors[c][i]->get_fe().dofs_per_cell);
+          colors[c][i]->get_dof_indices (indices);
+          constraints.resolve_indices (indices);
+          for (unsigned int k=0; k<indices.size(); ++k)
+            if (rows.insert (indices[k]).second == false)
+              conflict_free = false;
+        }
+    }
+  deallog << "Colors are conflict free: " << conflict_free << std::endl;
+}
+
+
+template <int dim>
+void test ()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  tria.refine_global (3);
+
+  FE_Q<dim> fe (1);
+  DoFHandler<dim> dof_handler (tria);
+  dof_handler.distribute_dofs (fe);
+
+  // constrain the first degree of freedom to degrees of freedom of cells
+  // far away from the first cell, one after the other. the number of
+  // constraints stays the same
+  ConstraintMatrix constraints;
+  DoFTools::CellColoring<DoFHandler<dim> > coloring (dof_handler, constraints);
+  for (types::global_dof_index target = dof_handler.n_dofs()-1;
+       target >= dof_handler.n_dofs()-3; --target)
+    {
+      constraints.clear ();
+      constraints.add_line (0);
+      constraints.add_entry (0, target, 1.);
+      constraints.close ();
+      check_coloring (coloring, constraints);
+    }
+}
+
+
+int main ()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.threshold_double(1.e-10);
+
+  deallog.push ("2d");
+  test<2> ();
+  deallog.pop ();
+  deallog.push ("3d");
+  test<3> ();
+  deallog.pop ();
+}
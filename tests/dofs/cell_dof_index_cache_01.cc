@@ -0,0 +1,221 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// DoFHandler stores the cache of the DoF indices of cells in compressed
+// form. check that the functions of DoFCellAccessor that read from the
+// cache give the same results as the DoF indices stored on the objects of
+// the cell, also after renumbering, and that the compressed cache of a
+// DoFLevel returns the indices it was built from
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_levels.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/lac/constraint_matrix.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <fstream>
+#include <vector>
+
+
+template <int dim>
+bool check_indices (const DoFHandler<dim> &dof_handler)
+{
+  const unsigned int dofs_per_cell = dof_handler.get_fe().dofs_per_cell;
+  std::vector<types::global_dof_index> cached (dofs_per_cell);
+  std::vector<types::global_dof_index> stored (dofs_per_cell);
+  for (typename DoFHandler<dim>::active_cell_iterator
+       cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell)
+    {
+      cell->get_dof_indices (cached);
+      cell->DoFAccessor<dim,DoFHandler<dim>,false>::get_dof_indices (stored, 0);
+      if (cached != stored)
+        return false;
+    }
+  return true;
+}
+
+
+
+template <int dim>
+void check_values (const DoFHandler<dim>  &dof_handler,
+                   const ConstraintMatrix &constraints)
+{
+  const unsigned int dofs_per_cell = dof_handler.get_fe().dofs_per_cell;
+  const types::global_dof_index n_dofs = dof_handler.n_dofs();
+
+  Vector<double> values (n_dofs);
+  for (unsigned int i=0; i<n_dofs; ++i)
+    values(i) = i+1.;
+
+  DynamicSparsityPattern dsp (n_dofs);
+  DoFTools::make_sparsity_pattern (dof_handler, dsp);
+  SparsityPattern sparsity;
+  sparsity.copy_from (dsp);
+  SparseMatrix<double> matrix (sparsity), matrix_reference (sparsity);
+  Vector<double> rhs (n_dofs), rhs_reference (n_dofs);
+  Vector<double> rhs_constrained (n_dofs), rhs_constrained_reference (n_dofs);
+
+  bool values_ok = true;
+  bool constrained_values_ok = true;
+  std::vector<types::global_dof_index> dofs (dofs_per_cell);
+  Vector<double> local_values (dofs_per_cell);
+  Vector<double> local_constrained_values (dofs_per_cell);
+  Vector<double> local_constrained_values_reference (dofs_per_cell);
+  FullMatrix<double> local_matrix (dofs_per_cell, dofs_per_cell);
+  for (typename DoFHandler<dim>::active_cell_iterator
+       cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell)
+    {
+      cell->get_dof_indices (dofs);
+
+      cell->get_dof_values (values, local_values);
+      cell->get_dof_values (constraints, values,
+                            local_constrained_values.begin(),
+                            local_constrained_values.end());
+      constraints.get_dof_values (values, dofs.begin(),
+                                  local_constrained_values_reference.begin(),
+                                  local_constrained_values_reference.end());
+      for (unsigned int i=0; i<dofs_per_cell; ++i)
+        if (local_values(i) != values(dofs[i]))
+          values_ok = false;
+      if (local_constrained_values != local_constrained_values_reference)
+        constrained_values_ok = false;
+
+      for (unsigned int i=0; i<dofs_per_cell; ++i)
+        for (unsigned int j=0; j<dofs_per_cell; ++j)
+          local_matrix(i,j) = local_values(i) + 2.*local_values(j);
+
+      cell->distribute_local_to_global (local_values, rhs);
+      cell->distribute_local_to_global (local_matrix, matrix);
+      constraints.distribute_local_to_global (local_values.begin(),
+                                              local_values.end(),
+                                              dofs.begin(),
+                                              rhs_constrained_reference);
+      for (unsigned int i=0; i<dofs_per_cell; ++i)
+        {
+          rhs_reference(dofs[i]) += local_values(i);
+          for (unsigned int j=0; j<dofs_per_cell; ++j)
+            matrix_reference.add (dofs[i], dofs[j], local_matrix(i,j));
+        }
+    }
+
+  for (typename DoFHandler<dim>::active_cell_iterator
+       cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell)
+    {
+      cell->get_dof_values (values, local_values);
+      cell->distribute_local_to_global (constraints,
+                                        local_values.begin(), local_values.end(),
+                                        rhs_constrained);
+    }
+
+  rhs -= rhs_reference;
+  rhs_constrained -= rhs_constrained_reference;
+  matrix.add (-1., matrix_reference);
+
+  deallog << "get_dof_values: " << values_ok << std::endl;
+  deallog << "get_dof_values with constraints: " << constrained_values_ok << std::endl;
+  deallog << "distribute_local_to_global, vector: " << (rhs.l2_norm() == 0) << std::endl;
+  deallog << "distribute_local_to_global, constraints: "
+          << (rhs_constrained.l2_norm() == 0) << std::endl;
+  deallog << "distribute_local_to_global, matrix: "
+          << (matrix.frobenius_norm() == 0) << std::endl;
+}
+
+
+
+template <int dim>
+void test ()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  tria.refine_global (4-dim);
+  tria.begin_active()->set_refine_flag ();
+  tria.execute_coarsening_and_refinement ();
+
+  FE_Q<dim> fe(2);
+  DoFHandler<dim> dof_handler (tria);
+  dof_handler.distribute_dofs (fe);
+
+  ConstraintMatrix constraints;
+  DoFTools::make_hanging_node_constraints (dof_handler, constraints);
+  constraints.close ();
+
+  deallog << "Indices: " << check_indices (dof_handler) << std::endl;
+  check_values (dof_handler, constraints);
+
+  DoFRenumbering::Cuthill_McKee (dof_handler);
+  constraints.clear ();
+  DoFTools::make_hanging_node_constraints (dof_handler, constraints);
+  constraints.close ();
+
+  deallog << "Indices after renumbering: " << check_indices (dof_handler) << std::endl;
+  check_values (dof_handler, constraints);
+}
+
+
+
+void test_level ()
+{
+  // choose indices whose range fits into 32 bits, but whose values may not
+  const types::global_dof_index first = numbers::invalid_dof_index/2;
+
+  internal::DoFHandler::DoFLevel<2> level;
+  level.cell_dof_indices_cache.push_back (first+7);
+  level.cell_dof_indices_cache.push_back (numbers::invalid_dof_index);
+  level.cell_dof_indices_cache.push_back (first);
+  level.cell_dof_indices_cache.push_back (first+3);
+  const std::vector<types::global_dof_index> indices = level.cell_dof_indices_cache;
+
+  level.compress_cell_dof_indices_cache ();
+  deallog << "Compressed: " << (level.cell_dof_indices_cache.size() == 0) << std::endl;
+
+  internal::DoFHandler::CellDoFIndexIterator cache
+    = level.get_cell_cache_start (1, 2);
+  deallog << "Offsets:";
+  for (unsigned int i=0; i<2; ++i, ++cache)
+    deallog << ' ' << *cache - first;
+  deallog << std::endl;
+  deallog << "Invalid: "
+          << (level.get_cell_cache_start (0, 2)[1] == numbers::invalid_dof_index)
+          << std::endl;
+
+  level.uncompress_cell_dof_indices_cache ();
+  deallog << "Uncompressed: " << (level.cell_dof_indices_cache == indices) << std::endl;
+}
+
+
+
+int main ()
+{
+  initlog ();
+
+  test<2> ();
+  test<3> ();
+  test_level ();
+}
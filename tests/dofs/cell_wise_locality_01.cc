@@ -0,0 +1,90 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check DoFRenumbering::cell_wise_locality: the result must be a
+// permutation, and the average span of the dof indices on a cell as
+// returned by DoFTools::average_cell_dof_index_span must be clearly smaller than
+// for a random numbering
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+#include <deal.II/fe/fe_q.h>
+
+#include <fstream>
+#include <algorithm>
+#include <vector>
+
+
+template <int dim>
+void test (const unsigned int n_refinements)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball (tria);
+  tria.refine_global (n_refinements);
+
+  unsigned int index = 0;
+  for (typename Triangulation<dim>::active_cell_iterator
+       cell = tria.begin_active(); cell != tria.end(); ++cell, ++index)
+    if (index % 5 == 0)
+      cell->set_refine_flag ();
+  tria.execute_coarsening_and_refinement ();
+
+  FE_Q<dim> fe(2);
+  DoFHandler<dim> dof_handler (tria);
+  dof_handler.distribute_dofs (fe);
+
+  std::vector<types::global_dof_index> new_indices (dof_handler.n_dofs());
+  DoFRenumbering::compute_cell_wise_locality (new_indices, dof_handler);
+  std::vector<types::global_dof_index> sorted_indices (new_indices);
+  std::sort (sorted_indices.begin(), sorted_indices.end());
+  bool is_permutation = true;
+  for (types::global_dof_index i=0; i<sorted_indices.size(); ++i)
+    if (sorted_indices[i] != i)
+      is_permutation = false;
+  deallog << "Permutation: " << is_permutation << std::endl;
+
+  DoFRenumbering::random (dof_handler);
+  const double random_span = DoFTools::average_cell_dof_index_span (dof_handler);
+
+  DoFRenumbering::cell_wise_locality (dof_handler);
+  const double locality_span = DoFTools::average_cell_dof_index_span (dof_handler);
+
+  deallog << "Span at least dofs per cell: "
+          << (locality_span >= fe.dofs_per_cell) << std::endl;
+  deallog << "Span reduced by more than a factor of 2: "
+          << (2 * locality_span < random_span) << std::endl;
+}
+
+
+
+int main ()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.threshold_double(1.e-10);
+
+  test<2> (4);
+  test<3> (2);
+}
@@ -0,0 +1,130 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// DoFHandler::distribute_dofs() numbers the degrees of freedom in parallel
+// on chunks of cells. check on meshes with many cells and hanging nodes that
+// the result is still the numbering in which each degree of freedom gets the
+// next free index the first time it is encountered in a loop over all
+// active cells, and that renumbering updates the cell caches correctly
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <fstream>
+#include <vector>
+
+
+template <int dim>
+bool check_first_touch_numbering (const DoFHandler<dim> &dof_handler)
+{
+  std::vector<bool> seen (dof_handler.n_dofs(), false);
+  std::vector<types::global_dof_index> dof_indices (dof_handler.get_fe().dofs_per_cell);
+  types::global_dof_index next_dof = 0;
+  bool consistent = true;
+
+  for (typename DoFHandler<dim>::active_cell_iterator
+       cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell)
+    {
+      cell->get_dof_indices (dof_indices);
+      for (unsigned int i=0; i<dof_indices.size(); ++i)
+        if (seen[dof_indices[i]] == false)
+          {
+            if (dof_indices[i] != next_dof)
+              consistent = false;
+            seen[dof_indices[i]] = true;
+            ++next_dof;
+          }
+    }
+  return consistent && (next_dof == dof_handler.n_dofs());
+}
+
+
+
+template <int dim>
+void test (const FiniteElement<dim> &fe,
+           const unsigned int        n_refinements)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  tria.refine_global (n_refinements);
+
+  unsigned int index = 0;
+  for (typename Triangulation<dim>::active_cell_iterator
+       cell = tria.begin_active(); cell != tria.end(); ++cell, ++index)
+    if (index % 3 == 0)
+      cell->set_refine_flag ();
+  tria.execute_coarsening_and_refinement ();
+
+  DoFHandler<dim> dof_handler (tria);
+  dof_handler.distribute_dofs (fe);
+  deallog << fe.get_name() << ", cells: " << tria.n_active_cells() << std::endl;
+  deallog << "First-touch numbering: "
+          << check_first_touch_numbering (dof_handler) << std::endl;
+
+  // reverse the numbering and compare the cached dof indices with the ones
+  // computed without the cache
+  std::vector<types::global_dof_index> new_numbers (dof_handler.n_dofs());
+  for (unsigned int i=0; i<new_numbers.size(); ++i)
+    new_numbers[i] = dof_handler.n_dofs() - 1 - i;
+  std::vector<types::global_dof_index> old_indices (fe.dofs_per_cell);
+  std::vector<std::vector<types::global_dof_index> > expected;
+  for (typename DoFHandler<dim>::active_cell_iterator
+       cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell)
+    {
+      cell->get_dof_indices (old_indices);
+      for (unsigned int i=0; i<old_indices.size(); ++i)
+        old_indices[i] = new_numbers[old_indices[i]];
+      expected.push_back (old_indices);
+    }
+
+  dof_handler.renumber_dofs (new_numbers);
+
+  bool renumbered = true;
+  std::vector<types::global_dof_index> new_indices (fe.dofs_per_cell);
+  index = 0;
+  for (typename DoFHandler<dim>::active_cell_iterator
+       cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell, ++index)
+    {
+      cell->get_dof_indices (new_indices);
+      if (new_indices != expected[index])
+        renumbered = false;
+    }
+  deallog << "Renumbered caches: " << renumbered << std::endl;
+}
+
+
+
+int main ()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.threshold_double(1.e-10);
+
+  test<1> (FE_Q<1>(3), 12);
+  test<2> (FE_Q<2>(3), 6);
+  test<2> (FESystem<2>(FE_Q<2>(2), 2), 6);
+  test<3> (FE_Q<3>(2), 4);
+}
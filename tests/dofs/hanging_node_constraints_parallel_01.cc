@@ -0,0 +1,168 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// DoFTools::make_hanging_node_constraints computes the constraints of the
+// faces of the cells in parallel for a DoFHandler with a single element.
+// compare the result with the constraints computed in a serial loop over
+// all refined faces, and check ConstraintMatrix::add_constraint
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_tools.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/lac/constraint_matrix.h>
+#include <deal.II/lac/full_matrix.h>
+
+#include <fstream>
+#include <vector>
+
+
+template <int dim>
+void make_reference_constraints (const DoFHandler<dim> &dof_handler,
+                                 ConstraintMatrix      &constraints)
+{
+  const FiniteElement<dim> &fe = dof_handler.get_fe();
+  std::vector<types::global_dof_index> master_dofs (fe.dofs_per_face);
+  std::vector<types::global_dof_index> slave_dofs (fe.dofs_per_face);
+  FullMatrix<double> matrix (fe.dofs_per_face, fe.dofs_per_face);
+
+  for (typename DoFHandler<dim>::active_cell_iterator
+       cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell)
+    for (unsigned int face=0; face<GeometryInfo<dim>::faces_per_cell; ++face)
+      if (cell->face(face)->has_children())
+        {
+          cell->face(face)->get_dof_indices (master_dofs);
+          for (unsigned int c=0; c<cell->face(face)->n_children(); ++c)
+            {
+              cell->face(face)->child(c)->get_dof_indices (slave_dofs);
+              fe.get_subface_interpolation_matrix (fe, c, matrix);
+              for (unsigned int row=0; row<slave_dofs.size(); ++row)
+                if (constraints.is_constrained (slave_dofs[row]) == false)
+                  {
+                    bool satisfied = false;
+                    for (unsigned int i=0; i<master_dofs.size(); ++i)
+                      if (matrix(row,i) == 1.0 && master_dofs[i] == slave_dofs[row])
+                        satisfied = true;
+                    if (satisfied)
+                      continue;
+
+                    double abs_sum = 0;
+                    for (unsigned int i=0; i<master_dofs.size(); ++i)
+                      abs_sum += std::abs (matrix(row,i));
+                    constraints.add_line (slave_dofs[row]);
+                    for (unsigned int i=0; i<master_dofs.size(); ++i)
+                      if (matrix(row,i) != 0 && std::fabs(matrix(row,i)) >= 1e-14*abs_sum)
+                        constraints.add_entry (slave_dofs[row], master_dofs[i],
+                                               matrix(row,i));
+                  }
+            }
+        }
+}
+
+
+
+bool same_constraints (const ConstraintMatrix        &a,
+                       const ConstraintMatrix        &b,
+                       const types::global_dof_index  n_dofs)
+{
+  if (a.n_constraints() != b.n_constraints())
+    return false;
+  for (types::global_dof_index i=0; i<n_dofs; ++i)
+    {
+      if (a.is_constrained(i) != b.is_constrained(i))
+        return false;
+      if (a.is_constrained(i) == false)
+        continue;
+      const std::vector<std::pair<types::global_dof_index,double> >
+      &entries_a = *a.get_constraint_entries(i),
+       &entries_b = *b.get_constraint_entries(i);
+      if (entries_a.size() != entries_b.size())
+        return false;
+      for (unsigned int e=0; e<entries_a.size(); ++e)
+        if (entries_a[e].first != entries_b[e].first
+            ||
+            std::fabs(entries_a[e].second - entries_b[e].second) > 1e-12)
+          return false;
+    }
+  return true;
+}
+
+
+
+template <int dim>
+void test (const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  tria.refine_global (6-dim);
+  for (unsigned int cycle=0; cycle<2; ++cycle)
+    {
+      unsigned int index = 0;
+      for (typename Triangulation<dim>::active_cell_iterator
+           cell = tria.begin_active(); cell != tria.end(); ++cell, ++index)
+        if (index % 7 == 0)
+          cell->set_refine_flag ();
+      tria.execute_coarsening_and_refinement ();
+    }
+
+  DoFHandler<dim> dof_handler (tria);
+  dof_handler.distribute_dofs (fe);
+
+  ConstraintMatrix constraints, reference;
+  DoFTools::make_hanging_node_constraints (dof_handler, constraints);
+  make_reference_constraints (dof_handler, reference);
+  constraints.close ();
+  reference.close ();
+
+  deallog << fe.get_name() << ": "
+          << same_constraints (constraints, reference, dof_handler.n_dofs())
+          << std::endl;
+}
+
+
+
+int main ()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.threshold_double(1.e-10);
+
+  test<2> (FE_Q<2>(3));
+  test<2> (FESystem<2>(FE_Q<2>(2), 2));
+  test<3> (FE_Q<3>(2));
+
+  ConstraintMatrix constraints;
+  std::vector<std::pair<types::global_dof_index,double> > entries;
+  entries.push_back (std::make_pair (3, 0.5));
+  entries.push_back (std::make_pair (1, 0.5));
+  deallog << "New line: " << constraints.add_constraint (2, entries, 1.) << std::endl;
+  entries.pop_back ();
+  deallog << "Existing line: " << constraints.add_constraint (2, entries) << std::endl;
+  constraints.close ();
+  for (unsigned int i=0; i<constraints.get_constraint_entries(2)->size(); ++i)
+    deallog << "2 " << (*constraints.get_constraint_entries(2))[i].first
+            << ": " << (*constraints.get_constraint_entries(2))[i].second
+            << std::endl;
+  deallog << "Inhomogeneity: " << constraints.get_inhomogeneity(2) << std::endl;
+}
@@ -0,0 +1,214 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// DoFTools::make_sparsity_pattern and DoFTools::make_flux_sparsity_pattern
+// compute the entries of the cells in parallel. check that the result is
+// the same as the one of a serial loop over all cells, for both
+// DynamicSparsityPattern and BlockDynamicSparsityPattern
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_tools.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/lac/constraint_matrix.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/block_sparsity_pattern.h>
+
+#include <fstream>
+#include <vector>
+
+
+bool same_entries (const DynamicSparsityPattern &a,
+                   const DynamicSparsityPattern &b)
+{
+  if (a.n_nonzero_elements() != b.n_nonzero_elements())
+    return false;
+  for (types::global_dof_index row=0; row<a.n_rows(); ++row)
+    for (types::global_dof_index i=0; i<a.row_length(row); ++i)
+      if (b.exists (row, a.column_number(row, i)) == false)
+        return false;
+  return true;
+}
+
+
+
+bool same_entries (const BlockDynamicSparsityPattern &a,
+                   const BlockDynamicSparsityPattern &b)
+{
+  for (unsigned int i=0; i<a.n_block_rows(); ++i)
+    for (unsigned int j=0; j<a.n_block_cols(); ++j)
+      if (same_entries (a.block(i,j), b.block(i,j)) == false)
+        return false;
+  return true;
+}
+
+
+
+void reinit_blocks (BlockDynamicSparsityPattern   &sparsity,
+                    const types::global_dof_index  n_dofs)
+{
+  std::vector<types::global_dof_index> block_sizes (2);
+  block_sizes[0] = n_dofs / 3;
+  block_sizes[1] = n_dofs - block_sizes[0];
+  sparsity.reinit (block_sizes, block_sizes);
+}
+
+
+
+template <int dim, typename SparsityPatternType>
+void add_cell_entries (const DoFHandler<dim>  &dof_handler,
+                       const ConstraintMatrix &constraints,
+                       SparsityPatternType    &sparsity)
+{
+  std::vector<types::global_dof_index> dofs (dof_handler.get_fe().dofs_per_cell);
+  for (typename DoFHandler<dim>::active_cell_iterator
+       cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell)
+    {
+      cell->get_dof_indices (dofs);
+      constraints.add_entries_local_to_global (dofs, sparsity, false);
+    }
+}
+
+
+
+template <int dim, typename SparsityPatternType>
+void add_flux_entries (const DoFHandler<dim> &dof_handler,
+                       SparsityPatternType   &sparsity)
+{
+  const unsigned int dofs_per_cell = dof_handler.get_fe().dofs_per_cell;
+  std::vector<types::global_dof_index> dofs (dofs_per_cell);
+  std::vector<types::global_dof_index> neighbor_dofs (dofs_per_cell);
+  for (typename DoFHandler<dim>::active_cell_iterator
+       cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell)
+    {
+      cell->get_dof_indices (dofs);
+      for (unsigned int i=0; i<dofs_per_cell; ++i)
+        for (unsigned int j=0; j<dofs_per_cell; ++j)
+          sparsity.add (dofs[i], dofs[j]);
+
+      for (unsigned int face=0; face<GeometryInfo<dim>::faces_per_cell; ++face)
+        if (cell->at_boundary(face) == false)
+          {
+            std::vector<typename DoFHandler<dim>::active_cell_iterator> neighbors;
+            if (cell->neighbor(face)->has_children())
+              for (unsigned int c=0; c<cell->face(face)->number_of_children(); ++c)
+                neighbors.push_back (cell->neighbor_child_on_subface (face, c));
+            else
+              neighbors.push_back (cell->neighbor(face));
+
+            for (unsigned int n=0; n<neighbors.size(); ++n)
+              {
+                neighbors[n]->get_dof_indices (neighbor_dofs);
+                for (unsigned int i=0; i<dofs_per_cell; ++i)
+                  for (unsigned int j=0; j<dofs_per_cell; ++j)
+                    {
+                      sparsity.add (dofs[i], neighbor_dofs[j]);
+                      sparsity.add (neighbor_dofs[j], dofs[i]);
+                    }
+              }
+          }
+    }
+}
+
+
+
+template <int dim>
+void refine_mesh (Triangulation<dim> &tria)
+{
+  GridGenerator::hyper_cube (tria);
+  tria.refine_global (6-dim);
+  unsigned int index = 0;
+  for (typename Triangulation<dim>::active_cell_iterator
+       cell = tria.begin_active(); cell != tria.end(); ++cell, ++index)
+    if (index % 4 == 0)
+      cell->set_refine_flag ();
+  tria.execute_coarsening_and_refinement ();
+}
+
+
+
+template <int dim>
+void test ()
+{
+  Triangulation<dim> tria;
+  refine_mesh (tria);
+
+  {
+    FE_Q<dim> fe(2);
+    DoFHandler<dim> dof_handler (tria);
+    dof_handler.distribute_dofs (fe);
+    const types::global_dof_index n_dofs = dof_handler.n_dofs();
+
+    ConstraintMatrix constraints;
+    DoFTools::make_hanging_node_constraints (dof_handler, constraints);
+    constraints.close ();
+
+    DynamicSparsityPattern dsp (n_dofs), dsp_reference (n_dofs);
+    DoFTools::make_sparsity_pattern (dof_handler, dsp, constraints, false);
+    add_cell_entries (dof_handler, constraints, dsp_reference);
+    deallog << "Cell entries, DynamicSparsityPattern: "
+            << same_entries (dsp, dsp_reference) << std::endl;
+
+    BlockDynamicSparsityPattern bdsp, bdsp_reference;
+    reinit_blocks (bdsp, n_dofs);
+    reinit_blocks (bdsp_reference, n_dofs);
+    DoFTools::make_sparsity_pattern (dof_handler, bdsp, constraints, false);
+    add_cell_entries (dof_handler, constraints, bdsp_reference);
+    deallog << "Cell entries, BlockDynamicSparsityPattern: "
+            << same_entries (bdsp, bdsp_reference) << std::endl;
+  }
+
+  {
+    FE_DGQ<dim> fe(1);
+    DoFHandler<dim> dof_handler (tria);
+    dof_handler.distribute_dofs (fe);
+    const types::global_dof_index n_dofs = dof_handler.n_dofs();
+
+    DynamicSparsityPattern dsp (n_dofs), dsp_reference (n_dofs);
+    DoFTools::make_flux_sparsity_pattern (dof_handler, dsp);
+    add_flux_entries (dof_handler, dsp_reference);
+    deallog << "Flux entries, DynamicSparsityPattern: "
+            << same_entries (dsp, dsp_reference) << std::endl;
+
+    BlockDynamicSparsityPattern bdsp, bdsp_reference;
+    reinit_blocks (bdsp, n_dofs);
+    reinit_blocks (bdsp_reference, n_dofs);
+    DoFTools::make_flux_sparsity_pattern (dof_handler, bdsp);
+    add_flux_entries (dof_handler, bdsp_reference);
+    deallog << "Flux entries, BlockDynamicSparsityPattern: "
+            << same_entries (bdsp, bdsp_reference) << std::endl;
+  }
+}
+
+
+
+int main ()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.threshold_double(1.e-10);
+
+  test<2> ();
+  test<3> ();
+}
@@ -0,0 +1,85 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that FETools::compute_embedding_matrices for a single refinement
+// case computes the same matrices as the function that computes them for
+// all refinement cases at once, and that the finite elements computing their
+// embedding matrices on demand per refinement case return the same matrices
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_raviart_thomas.h>
+#include <deal.II/fe/fe_tools.h>
+
+#include <fstream>
+
+
+template <int dim>
+void
+check (const FiniteElement<dim> &fe)
+{
+  deallog << fe.get_name() << std::endl;
+
+  const unsigned int n = fe.dofs_per_cell;
+  std::vector<std::vector<FullMatrix<double> > >
+  all_matrices (RefinementCase<dim>::isotropic_refinement);
+  for (unsigned int ref_case=RefinementCase<dim>::cut_x;
+       ref_case <= RefinementCase<dim>::isotropic_refinement; ++ref_case)
+    all_matrices[ref_case-1].resize (GeometryInfo<dim>::n_children(RefinementCase<dim>(ref_case)),
+                                     FullMatrix<double>(n,n));
+  FETools::compute_embedding_matrices (fe, all_matrices);
+
+  for (unsigned int ref_case=RefinementCase<dim>::cut_x;
+       ref_case <= RefinementCase<dim>::isotropic_refinement; ++ref_case)
+    {
+      const RefinementCase<dim> refinement_case (ref_case);
+      std::vector<FullMatrix<double> >
+      matrices (GeometryInfo<dim>::n_children(refinement_case),
+                FullMatrix<double>(n,n));
+      FETools::compute_embedding_matrices (fe, matrices, refinement_case);
+
+      double difference = 0, difference_fe = 0;
+      for (unsigned int c=0; c<matrices.size(); ++c)
+        {
+          FullMatrix<double> tmp (all_matrices[ref_case-1][c]);
+          tmp.add (-1., matrices[c]);
+          difference = std::max (difference, tmp.frobenius_norm());
+
+          tmp = all_matrices[ref_case-1][c];
+          tmp.add (-1., fe.get_prolongation_matrix (c, refinement_case));
+          difference_fe = std::max (difference_fe, tmp.frobenius_norm());
+        }
+      deallog << "refinement case " << ref_case
+              << ": " << (difference < 1e-12 ? "OK" : "Failed")
+              << ' ' << (difference_fe < 1e-12 ? "OK" : "Failed")
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check (FE_DGQ<2>(2));
+  check (FE_DGQ<3>(1));
+  check (FE_RaviartThomas<2>(1));
+}
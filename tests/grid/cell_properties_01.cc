@@ -0,0 +1,145 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// the active cell index, subdomain id and refinement and coarsening flags of
+// a cell are stored next to each other. check that setting one of them does
+// not change the others, that they survive the growth of the arrays during
+// refinement, and that they are saved to and loaded from archives
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/archive/text_iarchive.hpp>
+
+#include <fstream>
+#include <sstream>
+
+
+template <int dim>
+void print_statistics (const Triangulation<dim> &tria)
+{
+  unsigned int n_refine = 0, n_coarsen = 0, n_wrong_index = 0;
+  unsigned int subdomain_sum = 0, index = 0;
+  for (typename Triangulation<dim>::active_cell_iterator
+       cell = tria.begin_active(); cell != tria.end(); ++cell, ++index)
+    {
+      if (cell->refine_flag_set())
+        ++n_refine;
+      if (cell->coarsen_flag_set())
+        ++n_coarsen;
+      if (cell->active_cell_index() != index)
+        ++n_wrong_index;
+      subdomain_sum += cell->subdomain_id();
+    }
+  deallog << tria.n_active_cells() << " active cells, "
+          << n_refine << " refine flags, "
+          << n_coarsen << " coarsen flags, "
+          << "sum of subdomain ids " << subdomain_sum << ", "
+          << n_wrong_index << " wrong active cell indices"
+          << std::endl;
+}
+
+
+
+template <int dim>
+void flag_cells (Triangulation<dim> &tria)
+{
+  for (typename Triangulation<dim>::active_cell_iterator
+       cell = tria.begin_active(); cell != tria.end(); ++cell)
+    {
+      cell->set_subdomain_id (cell->active_cell_index() % 3);
+      if (cell->active_cell_index() % 5 == 0)
+        cell->set_refine_flag ();
+      else if (cell->active_cell_index() % 5 == 1)
+        cell->set_coarsen_flag ();
+    }
+}
+
+
+
+template <int dim>
+void test ()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  tria.refine_global (2);
+
+  flag_cells (tria);
+  print_statistics (tria);
+
+  // clearing the flags must leave the subdomain ids alone
+  for (typename Triangulation<dim>::active_cell_iterator
+       cell = tria.begin_active(); cell != tria.end(); ++cell)
+    {
+      cell->clear_refine_flag ();
+      cell->clear_coarsen_flag ();
+    }
+  print_statistics (tria);
+
+  // refining the mesh appends cells to the arrays of the levels
+  flag_cells (tria);
+  tria.execute_coarsening_and_refinement ();
+  print_statistics (tria);
+
+  // save a mesh with flags and subdomain ids and load it into another
+  // triangulation
+  flag_cells (tria);
+  std::ostringstream oss;
+  {
+    boost::archive::text_oarchive oa (oss, boost::archive::no_header);
+    tria.save (oa, 0);
+  }
+
+  Triangulation<dim> tria2;
+  {
+    std::istringstream iss (oss.str());
+    boost::archive::text_iarchive ia (iss, boost::archive::no_header);
+    tria2.load (ia, 0);
+  }
+  print_statistics (tria2);
+
+  unsigned int n_different = 0;
+  typename Triangulation<dim>::active_cell_iterator
+  cell1 = tria.begin_active(),
+  cell2 = tria2.begin_active();
+  for (; cell1 != tria.end(); ++cell1, ++cell2)
+    if (cell1->refine_flag_set() != cell2->refine_flag_set() ||
+        cell1->coarsen_flag_set() != cell2->coarsen_flag_set() ||
+        cell1->subdomain_id() != cell2->subdomain_id() ||
+        cell1->active_cell_index() != cell2->active_cell_index())
+      ++n_different;
+  deallog << "Cells with different properties after loading: "
+          << n_different << std::endl;
+}
+
+
+
+int main ()
+{
+  initlog();
+
+  test<1> ();
+  test<2> ();
+  test<3> ();
+}
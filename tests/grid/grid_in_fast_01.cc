@@ -0,0 +1,136 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that GridIn::read_msh and GridIn::read_ucd give exactly the same
+// triangulation when reading from a file by name (which uses the parallel
+// parser) as when reading from a stream
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/grid_out.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <fstream>
+#include <iomanip>
+
+
+template <int dim>
+void compare (const Triangulation<dim> &tria1,
+              const Triangulation<dim> &tria2)
+{
+  bool identical = (tria1.n_active_cells() == tria2.n_active_cells() &&
+                    tria1.get_vertices() == tria2.get_vertices());
+
+  typename Triangulation<dim>::active_cell_iterator
+  cell1 = tria1.begin_active(), cell2 = tria2.begin_active();
+  for (; identical && cell1 != tria1.end(); ++cell1, ++cell2)
+    {
+      if (cell1->material_id() != cell2->material_id())
+        identical = false;
+      for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+        if (cell1->vertex_index(v) != cell2->vertex_index(v))
+          identical = false;
+      for (unsigned int f=0; f<GeometryInfo<dim>::faces_per_cell; ++f)
+        if (cell1->face(f)->boundary_id() != cell2->face(f)->boundary_id())
+          identical = false;
+    }
+
+  deallog << "  " << tria2.n_active_cells() << " active cells, identical: "
+          << identical << std::endl;
+}
+
+
+
+template <int dim>
+void check_file (const std::string &name,
+                 const typename GridIn<dim>::Format format)
+{
+  Triangulation<dim> tria1, tria2;
+  GridIn<dim> grid_in;
+
+  grid_in.attach_triangulation (tria1);
+  std::ifstream in (name.c_str());
+  if (format == GridIn<dim>::msh)
+    grid_in.read_msh (in);
+  else
+    grid_in.read_ucd (in);
+
+  grid_in.attach_triangulation (tria2);
+  if (format == GridIn<dim>::msh)
+    grid_in.read_msh (name);
+  else
+    grid_in.read_ucd (name);
+
+  compare (tria1, tria2);
+}
+
+
+
+// write a mesh with vertices that need all 17 digits to be represented and
+// read it back in
+template <int dim>
+void check_written_file ()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell (tria, Point<dim>(), 0.3, 1.);
+  tria.refine_global (1);
+  GridTools::distort_random (0.2, tria);
+  GridTools::scale (1.e-7, tria);
+
+  GridOut grid_out;
+  {
+    std::ofstream out ("grid.msh");
+    out << std::setprecision (17);
+    grid_out.write_msh (tria, out);
+  }
+  check_file<dim> ("grid.msh", GridIn<dim>::msh);
+
+  {
+    std::ofstream out ("grid.inp");
+    out << std::setprecision (17);
+    grid_out.write_ucd (tria, out);
+  }
+  check_file<dim> ("grid.inp", GridIn<dim>::ucd);
+}
+
+
+
+int main ()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.threshold_double(1.e-10);
+
+  check_file<1> (SOURCE_DIR "/grids/grid_in_msh_02.msh", GridIn<1>::msh);
+  check_file<2> (SOURCE_DIR "/grids/grid_in_msh_01.2d.msh", GridIn<2>::msh);
+  check_file<2> (SOURCE_DIR "/grids/grid_in_msh_01.2da.msh", GridIn<2>::msh);
+  check_file<3> (SOURCE_DIR "/grids/grid_in_msh_01.3d.msh", GridIn<3>::msh);
+  check_file<3> (SOURCE_DIR "/grids/grid_in_msh_01.3da.msh", GridIn<3>::msh);
+  check_file<3> (SOURCE_DIR "/grids/grid_in_msh_01.3d_neg.msh", GridIn<3>::msh);
+
+  check_file<2> (SOURCE_DIR "/grids/circle-grid.inp", GridIn<2>::ucd);
+  check_file<2> (SOURCE_DIR "/grids/ucd/2d/2d_test.ucd", GridIn<2>::ucd);
+  check_file<3> (SOURCE_DIR "/grids/ucd/3d/3d_test_cube_two_materials.ucd", GridIn<3>::ucd);
+
+  check_written_file<2> ();
+  check_written_file<3> ();
+}
@@ -0,0 +1,134 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that GridIn::read still accepts msh and ucd files in which the
+// vertex and element records are not given on lines of their own. the
+// parallel parser used for files read by name can not deal with them, so
+// GridIn::read has to fall back to the stream based readers when it throws
+// GridIn::ExcUnsupportedLineLayout
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/grid_out.h>
+
+#include <fstream>
+#include <sstream>
+
+
+// write the given mesh file again, but put every number of the vertex and
+// element lists on a line of its own. comment and section header lines are
+// kept as they are
+void split_records (const std::string &text,
+                    const std::string &name)
+{
+  std::istringstream in (text);
+  std::ofstream out (name.c_str());
+  std::string line;
+  while (std::getline (in, line))
+    {
+      if (line.size() > 0 && line[0] != '#' && line[0] != '$')
+        for (unsigned int i=0; i<line.size(); ++i)
+          if (line[i] == ' ')
+            line[i] = '\n';
+      out << line << '\n';
+    }
+}
+
+
+
+template <int dim>
+void check (const typename GridIn<dim>::Format format)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell (tria, Point<dim>(), 0.3, 1.);
+  tria.refine_global (1);
+
+  std::ostringstream text;
+  GridOut grid_out;
+  std::string name;
+  if (format == GridIn<dim>::msh)
+    {
+      grid_out.write_msh (tria, text);
+      name = "grid.msh";
+    }
+  else
+    {
+      grid_out.write_ucd (tria, text);
+      name = "grid.inp";
+    }
+  split_records (text.str(), name);
+
+  Triangulation<dim> tria1, tria2, tria3;
+  GridIn<dim> grid_in;
+
+  grid_in.attach_triangulation (tria1);
+  std::ifstream in (name.c_str());
+  if (format == GridIn<dim>::msh)
+    grid_in.read_msh (in);
+  else
+    grid_in.read_ucd (in);
+
+  grid_in.attach_triangulation (tria2);
+  grid_in.read (name);
+
+  bool identical = (tria1.n_active_cells() == tria2.n_active_cells() &&
+                    tria1.get_vertices() == tria2.get_vertices());
+  typename Triangulation<dim>::active_cell_iterator
+  cell1 = tria1.begin_active(), cell2 = tria2.begin_active();
+  for (; identical && cell1 != tria1.end(); ++cell1, ++cell2)
+    for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+      if (cell1->vertex_index(v) != cell2->vertex_index(v))
+        identical = false;
+
+  deallog << name << ": " << tria2.n_active_cells()
+          << " active cells, identical: " << identical << std::endl;
+
+  // the parallel parser has to report the layout of the file with the
+  // exception that GridIn::read catches, rather than with any other one
+  grid_in.attach_triangulation (tria3);
+  try
+    {
+      if (format == GridIn<dim>::msh)
+        grid_in.read_msh (name);
+      else
+        grid_in.read_ucd (name);
+      deallog << "No exception" << std::endl;
+    }
+  catch (const typename GridIn<dim>::ExcUnsupportedLineLayout &)
+    {
+      deallog << "Caught ExcUnsupportedLineLayout" << std::endl;
+    }
+}
+
+
+
+int main ()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.threshold_double(1.e-10);
+
+  check<2> (GridIn<2>::msh);
+  check<2> (GridIn<2>::ucd);
+  check<3> (GridIn<3>::msh);
+  check<3> (GridIn<3>::ucd);
+}
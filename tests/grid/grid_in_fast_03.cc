@@ -0,0 +1,55 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that GridIn::read_ucd(filename) handles vertex numbers whose
+// difference does not fit into an int. such numbers used to overflow when
+// deciding how to store the map from vertex numbers to vertex indices
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_in.h>
+
+#include <fstream>
+
+
+int main ()
+{
+  initlog();
+
+  {
+    std::ofstream out ("grid.inp");
+    out << "4 1 0 0 0" << std::endl
+        << "-2147483000 0 0 0" << std::endl
+        << "7 1 0 0" << std::endl
+        << "2147483000 1 1 0" << std::endl
+        << "0 0 1 0" << std::endl
+        << "1 3 quad -2147483000 7 2147483000 0" << std::endl;
+  }
+
+  Triangulation<2> tria;
+  GridIn<2> grid_in;
+  grid_in.attach_triangulation (tria);
+  grid_in.read_ucd (std::string ("grid.inp"));
+
+  const Triangulation<2>::active_cell_iterator cell = tria.begin_active();
+  deallog << "Material id: " << (int)cell->material_id() << std::endl;
+  for (unsigned int v=0; v<GeometryInfo<2>::vertices_per_cell; ++v)
+    deallog << "Vertex " << v << ": " << cell->vertex(v) << std::endl;
+}
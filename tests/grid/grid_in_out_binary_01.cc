@@ -0,0 +1,164 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// write a refined mesh with material, boundary and manifold ids with
+// GridOut::write_binary and read it back with GridIn::read_binary, both from
+// a stream and from a file, and check that the two meshes are the same
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/grid_out.h>
+
+#include <fstream>
+#include <sstream>
+
+
+template <int dim, int spacedim>
+bool same_faces (const typename Triangulation<dim,spacedim>::active_cell_iterator &cell1,
+                 const typename Triangulation<dim,spacedim>::active_cell_iterator &cell2)
+{
+  for (unsigned int f=0; f<GeometryInfo<dim>::faces_per_cell; ++f)
+    {
+      if (cell1->face(f)->at_boundary() != cell2->face(f)->at_boundary())
+        return false;
+      if (cell1->face(f)->at_boundary() &&
+          cell1->face(f)->boundary_id() != cell2->face(f)->boundary_id())
+        return false;
+      if (dim > 1 &&
+          cell1->face(f)->manifold_id() != cell2->face(f)->manifold_id())
+        return false;
+    }
+  return true;
+}
+
+
+
+template <int dim, int spacedim>
+void compare (const Triangulation<dim,spacedim> &tria1,
+              const Triangulation<dim,spacedim> &tria2)
+{
+  deallog << "Cells: " << tria2.n_active_cells()
+          << ", vertices: " << tria2.n_used_vertices() << std::endl;
+  AssertThrow (tria1.n_active_cells() == tria2.n_active_cells(),
+               ExcInternalError());
+  AssertThrow (tria1.n_used_vertices() == tria2.n_used_vertices(),
+               ExcInternalError());
+
+  unsigned int n_equal = 0;
+  typename Triangulation<dim,spacedim>::active_cell_iterator
+  cell1 = tria1.begin_active(), cell2 = tria2.begin_active();
+  for (; cell1 != tria1.end(); ++cell1, ++cell2)
+    {
+      bool equal = (cell1->material_id() == cell2->material_id() &&
+                    cell1->manifold_id() == cell2->manifold_id() &&
+                    same_faces<dim,spacedim>(cell1, cell2));
+      for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+        if (cell1->vertex(v).distance(cell2->vertex(v)) > 1e-12)
+          equal = false;
+      if (equal)
+        ++n_equal;
+    }
+  deallog << "Equal cells: " << n_equal << std::endl;
+}
+
+
+
+template <int dim, int spacedim>
+void test (Triangulation<dim,spacedim> &tria)
+{
+  tria.begin_active()->set_material_id (3);
+  tria.begin_active()->set_manifold_id (2);
+  // the binary format does not store boundary indicators of vertices, so
+  // only set them in 2d and 3d
+  if (dim > 1)
+    for (typename Triangulation<dim,spacedim>::active_cell_iterator
+         cell = tria.begin_active(); cell != tria.end(); ++cell)
+      for (unsigned int f=0; f<GeometryInfo<dim>::faces_per_cell; ++f)
+        if (cell->face(f)->at_boundary())
+          {
+            cell->face(f)->set_boundary_id (f+1);
+            cell->face(f)->set_manifold_id (7);
+          }
+  tria.refine_global (1);
+
+  GridOut grid_out;
+  std::stringstream stream;
+  grid_out.write (tria, stream, GridOut::binary);
+
+  {
+    Triangulation<dim,spacedim> tria2;
+    GridIn<dim,spacedim> grid_in;
+    grid_in.attach_triangulation (tria2);
+    grid_in.read (stream, GridIn<dim,spacedim>::binary);
+    compare (tria, tria2);
+  }
+
+  {
+    std::ofstream file ("grid.dmesh", std::ios::binary);
+    grid_out.write_binary (tria, file);
+  }
+  {
+    Triangulation<dim,spacedim> tria2;
+    GridIn<dim,spacedim> grid_in;
+    grid_in.attach_triangulation (tria2);
+    grid_in.read ("grid.dmesh");
+    compare (tria, tria2);
+  }
+}
+
+
+
+int main ()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.threshold_double(1.e-10);
+
+  {
+    deallog.push("1d");
+    Triangulation<1> tria;
+    GridGenerator::subdivided_hyper_cube (tria, 3);
+    test (tria);
+    deallog.pop();
+  }
+  {
+    deallog.push("2d");
+    Triangulation<2> tria;
+    GridGenerator::hyper_shell (tria, Point<2>(), 0.5, 1., 8);
+    test (tria);
+    deallog.pop();
+  }
+  {
+    deallog.push("2d/3d");
+    Triangulation<2,3> tria;
+    GridGenerator::hyper_cube (tria);
+    test (tria);
+    deallog.pop();
+  }
+  {
+    deallog.push("3d");
+    Triangulation<3> tria;
+    GridGenerator::hyper_shell (tria, Point<3>(), 0.5, 1., 6);
+    test (tria);
+    deallog.pop();
+  }
+}
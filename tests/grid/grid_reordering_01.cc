@@ -0,0 +1,114 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// take a structured mesh, rotate each of its cells randomly, and check that
+// GridReordering finds a consistent orientation that lets us create a
+// triangulation
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_reordering.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <fstream>
+
+
+// rotations of a cell in the classic (ucd) numbering of vertices
+const unsigned int rotations_2d[4][4] =
+{
+  {0,1,2,3},
+  {1,2,3,0},
+  {2,3,0,1},
+  {3,0,1,2}
+};
+
+const unsigned int rotations_3d[8][8] =
+{
+  {0,1,2,3,4,5,6,7},
+  {1,2,3,0,5,6,7,4},
+  {2,3,0,1,6,7,4,5},
+  {3,0,1,2,7,4,5,6},
+  {4,7,6,5,0,3,2,1},
+  {5,4,7,6,1,0,3,2},
+  {6,5,4,7,2,1,0,3},
+  {7,6,5,4,3,2,1,0}
+};
+
+
+template <int dim>
+void test (const unsigned int n)
+{
+  // vertices of a structured mesh with n cells in each direction
+  std::vector<Point<dim> > vertices;
+  for (unsigned int k=0; k<(dim == 3 ? n+1 : 1); ++k)
+    for (unsigned int j=0; j<n+1; ++j)
+      for (unsigned int i=0; i<n+1; ++i)
+        {
+          Point<dim> p;
+          p[0] = 1.*i/n;
+          p[1] = 1.*j/n;
+          if (dim == 3)
+            p[dim-1] = 1.*k/n;
+          vertices.push_back (p);
+        }
+
+  std::vector<CellData<dim> > cells;
+  for (unsigned int k=0; k<(dim == 3 ? n : 1); ++k)
+    for (unsigned int j=0; j<n; ++j)
+      for (unsigned int i=0; i<n; ++i)
+        {
+          unsigned int lex[GeometryInfo<dim>::vertices_per_cell];
+          for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+            lex[v] = ((k + (v/4)) * (n+1) + j + (v/2)%2) * (n+1) + i + v%2;
+
+          // convert to the classic numbering and rotate randomly
+          unsigned int ucd[GeometryInfo<dim>::vertices_per_cell];
+          for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+            ucd[v] = lex[GeometryInfo<dim>::ucd_to_deal[v]];
+
+          CellData<dim> cell;
+          const unsigned int rotation = Testing::rand() % (dim == 2 ? 4 : 8);
+          for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+            cell.vertices[v] = (dim == 2 ?
+                                ucd[rotations_2d[rotation][v]] :
+                                ucd[rotations_3d[rotation][v]]);
+          cells.push_back (cell);
+        }
+
+  GridReordering<dim>::reorder_cells (cells);
+
+  Triangulation<dim> tria;
+  tria.create_triangulation_compatibility (vertices, cells, SubCellData());
+
+  deallog << "Cells: " << tria.n_active_cells()
+          << ", volume: " << GridTools::volume (tria) << std::endl;
+}
+
+
+
+int main ()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.threshold_double(1.e-10);
+
+  test<2> (1);
+  test<2> (20);
+  test<3> (1);
+  test<3> (8);
+}
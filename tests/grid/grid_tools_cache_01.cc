@@ -0,0 +1,146 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check GridTools::Cache::find_active_cell_around_point and
+// find_active_cells_around_points on a curved mesh, also after the mesh has
+// been refined, and for a point outside the mesh
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <fstream>
+
+
+template <int dim>
+Point<dim> random_point ()
+{
+  // points inside the ball of radius 0.9
+  Point<dim> p;
+  do
+    for (unsigned int d=0; d<dim; ++d)
+      p[d] = 1.8 * Testing::rand() / RAND_MAX - 0.9;
+  while (p.norm() > 0.9);
+  return p;
+}
+
+
+
+template <int dim>
+void check_points (const GridTools::Cache<dim> &cache,
+                   const MappingQGeneric<dim>  &mapping)
+{
+  std::vector<Point<dim> > points (200);
+  for (unsigned int i=0; i<points.size(); ++i)
+    points[i] = random_point<dim>();
+
+  unsigned int n_found = 0;
+  for (unsigned int i=0; i<points.size(); ++i)
+    {
+      const std::pair<typename Triangulation<dim>::active_cell_iterator, Point<dim> >
+      cell_point = cache.find_active_cell_around_point (points[i]);
+      AssertThrow (GeometryInfo<dim>::distance_to_unit_cell (cell_point.second) < 1e-10,
+                   ExcInternalError());
+      AssertThrow (mapping.transform_unit_to_real_cell (cell_point.first,
+                                                        cell_point.second)
+                   .distance (points[i]) < 1e-10,
+                   ExcInternalError());
+
+      const std::pair<typename Triangulation<dim>::active_cell_iterator, Point<dim> >
+      reference = GridTools::find_active_cell_around_point (mapping,
+                                                             cache.get_triangulation(),
+                                                             points[i]);
+      if (reference.first == cell_point.first)
+        ++n_found;
+    }
+  deallog << "Points in same cell as GridTools: " << n_found << " of "
+          << points.size() << std::endl;
+
+  std::vector<std::pair<typename Triangulation<dim>::active_cell_iterator, Point<dim> > >
+  cells;
+  points.push_back (Point<dim>::unit_vector(0) * 2.);
+  cache.find_active_cells_around_points (points, cells);
+  n_found = 0;
+  for (unsigned int i=0; i<points.size()-1; ++i)
+    if (cells[i].first == cache.find_active_cell_around_point (points[i]).first)
+      ++n_found;
+  deallog << "Points found by batch search: " << n_found << " of "
+          << points.size()-1 << std::endl;
+  deallog << "Point outside found: "
+          << (cells.back().first != cache.get_triangulation().end())
+          << std::endl;
+
+  // the point outside is rejected without searching all cells, but has to
+  // result in the same exception as for GridTools
+  try
+    {
+      cache.find_active_cell_around_point (points.back());
+      deallog << "No exception for point outside" << std::endl;
+    }
+  catch (const GridTools::ExcPointNotFound<dim> &)
+    {
+      deallog << "Point outside: ExcPointNotFound" << std::endl;
+    }
+}
+
+
+
+template <int dim>
+void test ()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball (tria);
+  static const SphericalManifold<dim> manifold;
+  tria.set_all_manifold_ids_on_boundary (0);
+  tria.set_manifold (0, manifold);
+  tria.refine_global (1);
+
+  MappingQGeneric<dim> mapping (3);
+  GridTools::Cache<dim> cache (tria, mapping);
+
+  deallog << "Cells: " << tria.n_active_cells() << std::endl;
+  check_points (cache, mapping);
+
+  tria.refine_global (1);
+  deallog << "Cells: " << tria.n_active_cells() << std::endl;
+  check_points (cache, mapping);
+
+  tria.set_manifold (0);
+}
+
+
+
+int main ()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.threshold_double(1.e-10);
+
+  deallog.push("2d");
+  test<2> ();
+  deallog.pop();
+  deallog.push("3d");
+  test<3> ();
+  deallog.pop();
+}
@@ -0,0 +1,108 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check hp::FEValues::precalculate_fe_values() and that copies of an
+// hp::FEValues object set up their own FEValues objects that give the same
+// results as the ones of the original object
+
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/hp/dof_handler.h>
+#include <deal.II/hp/fe_collection.h>
+#include <deal.II/hp/q_collection.h>
+#include <deal.II/hp/fe_values.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <fstream>
+
+
+template <int dim>
+void test ()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria, -1, 1);
+  tria.refine_global (2);
+
+  hp::FECollection<dim> fe_collection;
+  hp::QCollection<dim> q_collection;
+  for (unsigned int degree=1; degree<=3; ++degree)
+    {
+      fe_collection.push_back (FE_Q<dim>(degree));
+      q_collection.push_back (QGauss<dim>(degree+1));
+    }
+
+  hp::DoFHandler<dim> dof_handler (tria);
+  unsigned int index = 0;
+  for (typename hp::DoFHandler<dim>::active_cell_iterator
+       cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell, ++index)
+    cell->set_active_fe_index (index % fe_collection.size());
+  dof_handler.distribute_dofs (fe_collection);
+
+  hp::FEValues<dim> fe_values (fe_collection, q_collection,
+                               update_values | update_gradients |
+                               update_JxW_values);
+  fe_values.precalculate_fe_values ();
+
+  // a copy must not share the FEValues objects with the original one
+  hp::FEValues<dim> fe_values_copy (fe_values);
+
+  double max_diff = 0;
+  for (typename hp::DoFHandler<dim>::active_cell_iterator
+       cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell)
+    {
+      fe_values.reinit (cell);
+      fe_values_copy.reinit (cell);
+      const FEValues<dim> &fev = fe_values.get_present_fe_values ();
+      const FEValues<dim> &fev_copy = fe_values_copy.get_present_fe_values ();
+      AssertThrow (&fev != &fev_copy, ExcInternalError());
+
+      for (unsigned int q=0; q<fev.n_quadrature_points; ++q)
+        {
+          max_diff = std::max (max_diff, std::abs(fev.JxW(q) - fev_copy.JxW(q)));
+          for (unsigned int i=0; i<fev.dofs_per_cell; ++i)
+            {
+              max_diff = std::max (max_diff, std::abs(fev.shape_value(i,q) -
+                                                      fev_copy.shape_value(i,q)));
+              max_diff = std::max (max_diff, (fev.shape_grad(i,q) -
+                                              fev_copy.shape_grad(i,q)).norm());
+            }
+        }
+    }
+
+  deallog << dim << "d: " << max_diff << std::endl;
+}
+
+
+
+int main ()
+{
+  std::ofstream logfile("output");
+  logfile.precision(2);
+
+  deallog.attach(logfile);
+  deallog.threshold_double(1.e-10);
+
+  test<1> ();
+  test<2> ();
+  test<3> ();
+
+  deallog << "OK" << std::endl;
+}
@@ -0,0 +1,103 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// ConstraintMatrix::close() resolves chains of constraints ordered by the
+// length of the chain. check a long chain, merging more constraints into a
+// closed object, and that cycles are detected
+
+#include "../tests.h"
+#include <deal.II/lac/constraint_matrix.h>
+#include <deal.II/base/logstream.h>
+
+#include <fstream>
+
+
+void print_line (const ConstraintMatrix                  &cm,
+                 const ConstraintMatrix::size_type        line)
+{
+  const std::vector<std::pair<types::global_dof_index,double> > *entries
+    = cm.get_constraint_entries (line);
+  double sum = 0;
+  for (unsigned int i=0; i<entries->size(); ++i)
+    sum += (*entries)[i].second;
+  deallog << "Line " << line << ": " << entries->size() << " entries, "
+          << "sum of weights " << sum << ", inhomogeneity "
+          << cm.get_inhomogeneity (line) << std::endl;
+}
+
+
+
+void test ()
+{
+  // x_i = x_{i+1}/2 + x_{100+i}/2 + 1 for i=0..9
+  ConstraintMatrix cm;
+  for (unsigned int i=0; i<10; ++i)
+    {
+      cm.add_line (i);
+      cm.add_entry (i, i+1, 0.5);
+      cm.add_entry (i, 100+i, 0.5);
+      cm.set_inhomogeneity (i, 1.);
+    }
+  cm.close ();
+  print_line (cm, 0);
+  print_line (cm, 9);
+  deallog << "Weight of x_10 in line 0: "
+          << (*cm.get_constraint_entries (0))[0].second * 1024
+          << std::endl;
+
+  // merge a constraint for x_10 and one that refers to x_0 into the closed
+  // object
+  ConstraintMatrix other;
+  other.add_line (10);
+  other.add_entry (10, 200, 1.);
+  other.add_line (300);
+  other.add_entry (300, 0, 2.);
+  cm.merge (other);
+  print_line (cm, 0);
+  print_line (cm, 10);
+  print_line (cm, 300);
+  deallog << "Last entry of line 300: "
+          << (*cm.get_constraint_entries (300)).back().first
+          << std::endl;
+
+  // a cycle x_500 = x_501, x_501 = x_502, x_502 = x_500
+  ConstraintMatrix cycle;
+  for (unsigned int i=0; i<3; ++i)
+    {
+      cycle.add_line (500+i);
+      cycle.add_entry (500+i, 500+(i+1)%3, 1.);
+    }
+  try
+    {
+      cycle.close ();
+    }
+  catch (ExceptionBase &e)
+    {
+      deallog << e.get_exc_name() << std::endl;
+    }
+}
+
+
+
+int main ()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.threshold_double(1.e-10);
+
+  test ();
+}
@@ -0,0 +1,124 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that the version of ConstraintMatrix::distribute_local_to_global
+// that takes the contributions of many cells at once gives the same matrix
+// and right hand side as calling the function for one cell after the
+// other, with hanging nodes and inhomogeneous boundary values
+
+#include "../tests.h"
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/constraint_matrix.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_tools.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include <fstream>
+
+
+template <int dim>
+void test ()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  tria.refine_global (2);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim> fe (2);
+  DoFHandler<dim> dof (tria);
+  dof.distribute_dofs (fe);
+
+  ConstraintMatrix constraints;
+  DoFTools::make_hanging_node_constraints (dof, constraints);
+  VectorTools::interpolate_boundary_values (dof, 0, ConstantFunction<dim>(1.),
+                                            constraints);
+  constraints.close();
+
+  SparsityPattern sparsity;
+  {
+    DynamicSparsityPattern dsp (dof.n_dofs(), dof.n_dofs());
+    DoFTools::make_sparsity_pattern (dof, dsp, constraints, false);
+    sparsity.copy_from (dsp);
+  }
+  SparseMatrix<double> matrix (sparsity), batch_matrix (sparsity);
+  Vector<double> rhs (dof.n_dofs()), batch_rhs (dof.n_dofs());
+
+  std::vector<FullMatrix<double> > local_matrices;
+  std::vector<Vector<double> > local_vectors;
+  std::vector<std::vector<types::global_dof_index> > local_dof_indices;
+
+  FullMatrix<double> local_matrix (fe.dofs_per_cell, fe.dofs_per_cell);
+  Vector<double> local_vector (fe.dofs_per_cell);
+  std::vector<types::global_dof_index> dof_indices (fe.dofs_per_cell);
+  for (typename DoFHandler<dim>::active_cell_iterator
+       cell = dof.begin_active(); cell != dof.end(); ++cell)
+    {
+      for (unsigned int i=0; i<fe.dofs_per_cell; ++i)
+        {
+          for (unsigned int j=0; j<fe.dofs_per_cell; ++j)
+            local_matrix(i,j) = (double)Testing::rand() / RAND_MAX;
+          local_matrix(i,i) += fe.dofs_per_cell;
+          local_vector(i) = (double)Testing::rand() / RAND_MAX;
+        }
+      cell->get_dof_indices (dof_indices);
+      constraints.distribute_local_to_global (local_matrix, local_vector,
+                                              dof_indices, matrix, rhs);
+
+      local_matrices.push_back (local_matrix);
+      local_vectors.push_back (local_vector);
+      local_dof_indices.push_back (dof_indices);
+    }
+
+  constraints.distribute_local_to_global (local_matrices, local_vectors,
+                                          local_dof_indices,
+                                          batch_matrix, batch_rhs);
+
+  double matrix_difference = 0;
+  for (unsigned int row=0; row<matrix.m(); ++row)
+    for (SparseMatrix<double>::const_iterator
+         entry = matrix.begin(row); entry != matrix.end(row); ++entry)
+      matrix_difference = std::max (matrix_difference,
+                                    std::abs (entry->value() -
+                                              batch_matrix(row, entry->column())));
+  batch_rhs -= rhs;
+
+  deallog << "Cells: " << tria.n_active_cells() << std::endl;
+  deallog << "Matrix difference: " << matrix_difference << std::endl;
+  deallog << "Vector difference: " << batch_rhs.linfty_norm() << std::endl;
+}
+
+
+int main ()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.threshold_double(1.e-10);
+
+  test<2>();
+  test<3>();
+}
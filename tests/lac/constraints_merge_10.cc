@@ -0,0 +1,134 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 1998 - 2015 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// merging into a closed ConstraintMatrix only closes the lines that are
+// added or changed. check that the result is the same as the one of
+// merging into an open copy and closing it afterwards, for chains of
+// constraints within the second object, chains from the second object into
+// the first one, and both ways of resolving conflicts
+
+#include "../tests.h"
+#include <deal.II/lac/constraint_matrix.h>
+#include <deal.II/base/logstream.h>
+
+#include <fstream>
+#include <sstream>
+
+
+void fill_first (ConstraintMatrix &c)
+{
+  // x_{10i} = 1/2 x_{10i+1} + 1/2 x_{10i+2} + i, and a chain that is
+  // resolved when c is closed: x_{10i+3} = x_{10i}
+  for (unsigned int i=0; i<20; ++i)
+    {
+      c.add_line (10*i);
+      c.add_entry (10*i, 10*i+1, 0.5);
+      c.add_entry (10*i, 10*i+2, 0.5);
+      c.set_inhomogeneity (10*i, i);
+
+      c.add_line (10*i+3);
+      c.add_entry (10*i+3, 10*i, 1.);
+    }
+}
+
+
+
+void fill_second (ConstraintMatrix &c)
+{
+  for (unsigned int i=0; i<20; ++i)
+    {
+      // constrain a dof the first object refers to, via a chain within
+      // this object: x_{10i+1} = x_{10i+5}, x_{10i+5} = 2 x_{10i+6}
+      c.add_line (10*i+1);
+      c.add_entry (10*i+1, 10*i+5, 1.);
+      c.add_line (10*i+5);
+      c.add_entry (10*i+5, 10*i+6, 2.);
+      c.set_inhomogeneity (10*i+5, 1.);
+
+      // refer to a dof constrained in the first object
+      c.add_line (10*i+7);
+      c.add_entry (10*i+7, 10*i+3, 0.25);
+      c.add_entry (10*i+7, 10*i+8, 0.);
+
+      // a conflict with the first object in every other group
+      if (i % 2 == 0)
+        {
+          c.add_line (10*i);
+          c.add_entry (10*i, 10*i+9, 1.);
+        }
+    }
+}
+
+
+
+std::string print (const ConstraintMatrix &c)
+{
+  std::ostringstream out;
+  c.print (out);
+  return out.str();
+}
+
+
+
+void check (const ConstraintMatrix::MergeConflictBehavior behavior,
+            const bool                                    close_second)
+{
+  ConstraintMatrix c2;
+  fill_second (c2);
+  if (close_second)
+    c2.close ();
+
+  // merge into a closed object
+  ConstraintMatrix closed;
+  fill_first (closed);
+  closed.close ();
+  closed.merge (c2, behavior);
+
+  // merge into an open object with the same lines as the closed one had
+  // before the merge, and close it afterwards
+  ConstraintMatrix reference;
+  fill_first (reference);
+  reference.close ();
+  ConstraintMatrix open;
+  for (unsigned int i=0; i<200; ++i)
+    if (reference.is_constrained (i))
+      {
+        open.add_line (i);
+        open.add_entries (i, *reference.get_constraint_entries (i));
+        open.set_inhomogeneity (i, reference.get_inhomogeneity (i));
+      }
+  open.merge (c2, behavior);
+  open.close ();
+
+  deallog << "Behavior " << behavior
+          << ", second object " << (close_second ? "closed" : "open")
+          << ": " << closed.n_constraints() << " constraints, same result: "
+          << (print (closed) == print (open)) << std::endl;
+}
+
+
+
+int main ()
+{
+  initlog();
+
+  for (unsigned int close_second=0; close_second<2; ++close_second)
+    {
+      check (ConstraintMatrix::left_object_wins, close_second);
+      check (ConstraintMatrix::right_object_wins, close_second);
+    }
+}
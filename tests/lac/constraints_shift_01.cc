@@ -0,0 +1,78 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2016 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// ConstraintMatrix::close() stores the entries of all lines contiguously.
+// check that distribute(), distribute_local_to_global() and get_dof_values()
+// use the right entries also after shift() was called on a closed object
+
+#include "../tests.h"
+#include <deal.II/lac/constraint_matrix.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/base/logstream.h>
+
+#include <fstream>
+
+
+void test ()
+{
+  ConstraintMatrix cm;
+  cm.add_line (1);
+  cm.add_entry (1, 0, 0.5);
+  cm.add_entry (1, 2, 0.5);
+  cm.add_line (3);
+  cm.add_entry (3, 4, 1.);
+  cm.set_inhomogeneity (3, 2.);
+  cm.close ();
+  cm.shift (5);
+
+  Vector<double> v (10);
+  for (unsigned int i=0; i<v.size(); ++i)
+    v(i) = i;
+  cm.distribute (v);
+  deallog << "distribute: " << v(6) << ' ' << v(8) << std::endl;
+
+  std::vector<types::global_dof_index> indices (4);
+  for (unsigned int i=0; i<indices.size(); ++i)
+    indices[i] = 5+i;
+
+  Vector<double> local (4), global (10);
+  local = 1.;
+  cm.distribute_local_to_global (local, indices, global);
+  deallog << "distribute_local_to_global:";
+  for (unsigned int i=5; i<global.size(); ++i)
+    deallog << ' ' << global(i);
+  deallog << std::endl;
+
+  for (unsigned int i=0; i<v.size(); ++i)
+    v(i) = i;
+  cm.get_dof_values (v, indices.begin(), local.begin(), local.end());
+  deallog << "get_dof_values:";
+  for (unsigned int i=0; i<local.size(); ++i)
+    deallog << ' ' << local(i);
+  deallog << std::endl;
+}
+
+
+
+int main ()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.threshold_double(1.e-10);
+
+  test ();
+}